@@ -1,9 +1,9 @@
 #version 330 core
-out vec4 FragColor;
 
+in vec3 color;
 
-uniform vec3 input_col;
+out vec4 FragColor;
 
 void main() {
-    FragColor = vec4(input_col*vec3(1.0, 1.0, 1.0), 1.0);  
-}
\ No newline at end of file
+    FragColor = vec4(color, 1.0);
+}
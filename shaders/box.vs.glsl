@@ -1,10 +1,16 @@
 #version 330 core
-in vec3 in_position;
+
+// Debug lines, both ends of a segment in world coordinates
+layout(location = 0) in vec2 in_position;
+layout(location = 1) in vec3 in_color;
+
+out vec3 color;
 
 uniform mat3 transform;
 uniform mat3 projection;
 
 void main() {
-    vec3 pos =  projection * transform * vec3(in_position.xy, 1.0);;
-    gl_Position = vec4(pos.xy, in_position.z, 1.0);
-}
\ No newline at end of file
+    color = in_color;
+    vec3 pos = projection * transform * vec3(in_position, 1.0);
+    gl_Position = vec4(pos.xy, 0.0, 1.0);
+}
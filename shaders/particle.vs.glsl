@@ -0,0 +1,21 @@
+#version 330
+
+// Per vertex, a corner of the unit quad
+layout(location = 0) in vec2 in_corner;
+// Per particle: position, size, opacity
+layout(location = 1) in vec4 in_instance;
+
+// Passed to fragment shader
+out vec2 texcoord;
+out float opacity;
+
+// Application data
+uniform mat3 projection;
+
+void main()
+{
+	texcoord = in_corner + vec2(0.5);
+	opacity = in_instance.w;
+	vec3 pos = projection * vec3(in_instance.xy + in_corner * in_instance.z, 1.0);
+	gl_Position = vec4(pos.xy, 0.0, 1.0);
+}
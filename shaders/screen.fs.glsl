@@ -1,62 +1,54 @@
 #version 330
 
+// The post pass prepends POST_VARIANT and a define per effect in use, see
+// RenderSystem::postProgram. Without them this is a plain copy, used by the
+// start, game over and cutscene screens.
+
 uniform sampler2D screen_texture;
 uniform float fade_in_factor;
 uniform float darken_screen_factor;
 uniform float nighttime_factor;
 uniform vec2 spotlight_center;
 uniform float spotlight_radius;
-uniform vec2 glow_center;
-uniform float glow_radius;
-uniform float glow_intensity;
-uniform float time;
+
+#ifdef POST_VARIANT
+// share of the screen texture the world was drawn into
+uniform vec2 uv_scale;
+#else
+const vec2 uv_scale = vec2(1.0);
+#endif
 
 in vec2 texcoord;
 
 layout(location = 0) out vec4 color;
 
 vec4 apply_fade_and_darken(vec4 in_color) {
-    if (darken_screen_factor > 0.0) {
-        in_color = mix(in_color, vec4(0.1, 0.1, 0.1, 1.0), darken_screen_factor);
-    }
-    if (fade_in_factor > 0.0) {
-        in_color = mix(vec4(0.0, 0.0, 0.0, 1.0), in_color, 1.0 - fade_in_factor);
-    }
+#ifdef POST_DARKEN
+    in_color = mix(in_color, vec4(0.1, 0.1, 0.1, 1.0), darken_screen_factor);
+#endif
+#ifdef POST_FADE
+    in_color = mix(vec4(0.0, 0.0, 0.0, 1.0), in_color, 1.0 - fade_in_factor);
+#endif
     return in_color;
 }
 
 vec4 apply_nighttime_with_diffused_spotlight(vec4 original_color, vec4 nighttime_color, vec2 uv) {
-    if (nighttime_factor > 0.0) {
-        vec2 spotlight_uv = uv - spotlight_center;
-        spotlight_uv.y *= 0.7;
-        float distance_to_center = length(spotlight_uv);
-        float inner_radius = spotlight_radius * 0.2;
-        float outer_radius = spotlight_radius * 0.6;
-        float spotlight_effect = smoothstep(inner_radius, outer_radius, distance_to_center);
-        vec4 blended_color = mix(original_color, nighttime_color, nighttime_factor);
-        return mix(blended_color, original_color, 1.0 - spotlight_effect);
-    }
-    return original_color;
-}
-vec4 apply_glow(vec4 original_color, vec2 uv) {
-    vec2 glow_uv = uv - glow_center;
-    float distance_to_glow = length(glow_uv);
-
-    // Create a wavy effect using sine function
-    float wave = 0.5 * sin(time * 2.0) + 0.5; // Oscillates between 0 and 1
-    float dynamic_radius = glow_radius * (1.0 + 0.2 * wave); // Slightly modulate radius
-    float glow_effect = glow_intensity * exp(-distance_to_glow / dynamic_radius);
-
-    // Add red glow effect
-    vec4 glow_color = vec4(1.0, 0.0, 0.0, 1.0) * glow_effect; // Red color
-    return original_color + glow_color;
+    vec2 spotlight_uv = uv - spotlight_center;
+    spotlight_uv.y *= 0.7;
+    float distance_to_center = length(spotlight_uv);
+    float inner_radius = spotlight_radius * 0.2;
+    float outer_radius = spotlight_radius * 0.6;
+    float spotlight_effect = smoothstep(inner_radius, outer_radius, distance_to_center);
+    vec4 blended_color = mix(original_color, nighttime_color, nighttime_factor);
+    return mix(blended_color, original_color, 1.0 - spotlight_effect);
 }
 void main() {
-    vec4 in_color = texture(screen_texture, texcoord);
+    vec4 in_color = texture(screen_texture, texcoord * uv_scale);
     in_color = apply_fade_and_darken(in_color);
+#ifdef POST_NIGHT
     vec4 nighttime_color = vec4(0.05, 0.05, 0.2, 1.0);
     in_color = apply_nighttime_with_diffused_spotlight(in_color, nighttime_color, texcoord);
-    in_color = apply_glow(in_color, texcoord);
+#endif
 
     color = in_color;
 }
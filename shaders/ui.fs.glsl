@@ -0,0 +1,17 @@
+#version 330
+
+// From vertex shader
+in vec2 texcoord;
+in vec4 vcolor;
+
+// Application data
+uniform sampler2D sampler0;
+
+// Output color
+layout(location = 0) out vec4 color;
+
+void main()
+{
+	// the glyph atlas is swizzled to read as white with its coverage in alpha
+	color = vcolor * texture(sampler0, texcoord);
+}
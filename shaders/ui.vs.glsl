@@ -0,0 +1,21 @@
+#version 330
+
+// Window pixels, y going down
+layout(location = 0) in vec2 in_position;
+layout(location = 1) in vec2 in_texcoord;
+layout(location = 2) in vec4 in_color;
+
+// Passed to fragment shader
+out vec2 texcoord;
+out vec4 vcolor;
+
+// Application data
+uniform mat3 projection;
+
+void main()
+{
+	texcoord = in_texcoord;
+	vcolor = in_color;
+	vec3 pos = projection * vec3(in_position, 1.0);
+	gl_Position = vec4(pos.xy, 0.0, 1.0);
+}
@@ -1,20 +1,21 @@
 // internal
 // robot ai will be shifted here
 #include "ai_system.hpp"
+#include "job_system.hpp"
 
-vec2 AISystem::calculateSeparation(Entity entity) {
-    Motion& entity_motion = registry.motions.get(entity);
-    Boid& boid = registry.boids.get(entity);
+vec2 AISystem::calculateSeparation(size_t i, const std::vector<FlockMember>& flock) {
+    const FlockMember& self = flock[i];
+    const Boid& boid = *self.boid;
     vec2 steering(0, 0);
     int count = 0;
 
-    for (Entity other : registry.boids.entities) {
-        if (other.id != entity.id) {
-            Motion& other_motion = registry.motions.get(other);
-            float d = length(other_motion.position - entity_motion.position);
+    for (size_t j = 0; j < flock.size(); j++) {
+        if (j != i) {
+            const FlockMember& other = flock[j];
+            float d = length(other.position - self.position);
 
             if (d > 0 && d < boid.avoid_radius.x) {
-                vec2 diff = normalize(entity_motion.position - other_motion.position);
+                vec2 diff = normalize(self.position - other.position);
                 diff /= d;
                 steering += diff;
                 count++;
@@ -26,7 +27,7 @@ vec2 AISystem::calculateSeparation(Entity entity) {
         steering /= count;
         if (length(steering) > 0) {
             steering = normalize(steering) * boid.max_speed;
-            steering -= entity_motion.velocity;
+            steering -= self.velocity;
             if (length(steering) > boid.max_force) {
                 steering = normalize(steering) * boid.max_force;
             }
@@ -35,19 +36,19 @@ vec2 AISystem::calculateSeparation(Entity entity) {
     return steering;
 }
 
-vec2 AISystem::calculateAlignment(Entity entity) {
-    Motion& entity_motion = registry.motions.get(entity);
-    Boid& boid = registry.boids.get(entity);
+vec2 AISystem::calculateAlignment(size_t i, const std::vector<FlockMember>& flock) {
+    const FlockMember& self = flock[i];
+    const Boid& boid = *self.boid;
     vec2 steering(0, 0);
     int count = 0;
 
-    for (Entity other : registry.boids.entities) {
-        if (other.id != entity.id) {
-            Motion& other_motion = registry.motions.get(other);
-            float d = length(other_motion.position - entity_motion.position);
+    for (size_t j = 0; j < flock.size(); j++) {
+        if (j != i) {
+            const FlockMember& other = flock[j];
+            float d = length(other.position - self.position);
 
             if (d > 0 && d < boid.search_radius.x) {
-                steering += other_motion.velocity;
+                steering += other.velocity;
                 count++;
             }
         }
@@ -56,7 +57,7 @@ vec2 AISystem::calculateAlignment(Entity entity) {
     if (count > 0) {
         steering /= count;
         steering = normalize(steering) * boid.max_speed;
-        steering -= entity_motion.velocity;
+        steering -= self.velocity;
         if (length(steering) > boid.max_force) {
             steering = normalize(steering) * boid.max_force;
         }
@@ -64,19 +65,19 @@ vec2 AISystem::calculateAlignment(Entity entity) {
     return steering;
 }
 
-vec2 AISystem::calculateCohesion(Entity entity) {
-    Motion& entity_motion = registry.motions.get(entity);
-    Boid& boid = registry.boids.get(entity);
+vec2 AISystem::calculateCohesion(size_t i, const std::vector<FlockMember>& flock) {
+    const FlockMember& self = flock[i];
+    const Boid& boid = *self.boid;
     vec2 center(0, 0);
     int count = 0;
 
-    for (Entity other : registry.boids.entities) {
-        if (other.id != entity.id) {
-            Motion& other_motion = registry.motions.get(other);
-            float d = length(other_motion.position - entity_motion.position);
+    for (size_t j = 0; j < flock.size(); j++) {
+        if (j != i) {
+            const FlockMember& other = flock[j];
+            float d = length(other.position - self.position);
 
             if (d > 0 && d < boid.search_radius.x) {
-                center += other_motion.position;
+                center += other.position;
                 count++;
             }
         }
@@ -84,9 +85,9 @@ vec2 AISystem::calculateCohesion(Entity entity) {
 
     if (count > 0) {
         center /= count;
-        vec2 desired = center - entity_motion.position;
+        vec2 desired = center - self.position;
         desired = normalize(desired) * boid.max_speed;
-        vec2 steering = desired - entity_motion.velocity;
+        vec2 steering = desired - self.velocity;
         if (length(steering) > boid.max_force) {
             steering = normalize(steering) * boid.max_force;
         }
@@ -95,24 +96,18 @@ vec2 AISystem::calculateCohesion(Entity entity) {
     return vec2(0, 0);
 }
 
-vec2 AISystem::chasePlayer(Entity entity) {
-    if (registry.players.entities.empty()) return vec2(0, 0);
-
-    Motion& entity_motion = registry.motions.get(entity);
-    Boid& boid = registry.boids.get(entity);
-    Entity player = registry.players.entities[0];
-    Motion& player_motion = registry.motions.get(player);
-
-    vec2 to_player = player_motion.position - entity_motion.position;
+vec2 AISystem::chasePlayer(const FlockMember& self, vec2 player_position) {
+    const Boid& boid = *self.boid;
+    vec2 to_player = player_position - self.position;
     float dist = length(to_player);
 
     if (dist < boid.attack_radius.x) {
 
-        return normalize(-to_player) * boid.max_speed - entity_motion.velocity;
+        return normalize(-to_player) * boid.max_speed - self.velocity;
     }
     else {
 
-        return normalize(to_player) * boid.max_speed - entity_motion.velocity;
+        return normalize(to_player) * boid.max_speed - self.velocity;
     }
 } 
 
@@ -131,21 +126,42 @@ vec2 AISystem::calculateWander(Entity entity) {
 void AISystem::step(float elapsed_ms) {
     float dt = elapsed_ms / 1000.f;
 
-    for (Entity entity : registry.boids.entities) {
-        Boid& boid = registry.boids.get(entity);
-        Motion& motion = registry.motions.get(entity);
-
-        vec2 separation = calculateSeparation(entity) * boid.separation_weight;
-        vec2 alignment = calculateAlignment(entity) * boid.alignment_weight;
-        vec2 cohesion = calculateCohesion(entity) * boid.cohesion_weight;
+    // every boid reads the whole flock, so steering is computed from a copy taken
+    // before any of them moves and the flock can be split across the job system
+    size_t count = registry.boids.entities.size();
+    flock.resize(count);
+    for (size_t i = 0; i < count; i++) {
+        const Motion& motion = registry.motions.peek(registry.boids.entities[i]);
+        flock[i] = { motion.position, motion.velocity, &registry.boids.components[i] };
+    }
+    bool has_player = !registry.players.entities.empty();
+    vec2 player_position = has_player ? registry.motions.peek(registry.players.entities[0]).position : vec2(0);
+
+    steering.resize(count);
+    jobs.parallel_for(count, 16, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++) {
+            const Boid& boid = *flock[i].boid;
+            BoidSteering& out = steering[i];
+            vec2 separation = calculateSeparation(i, flock) * boid.separation_weight;
+            vec2 alignment = calculateAlignment(i, flock) * boid.alignment_weight;
+            vec2 cohesion = calculateCohesion(i, flock) * boid.cohesion_weight;
+            out.flocking = separation + alignment + cohesion;
+            out.chase = has_player ? chasePlayer(flock[i], player_position) * boid.chase_weight : vec2(0);
+        }
+    });
 
-        vec2 flocking = separation + alignment + cohesion;
+    // wander draws from rand(), so applying stays on this thread
+    for (size_t i = 0; i < count; i++) {
+        Entity entity = registry.boids.entities[i];
+        Boid& boid = registry.boids.components[i];
+        Motion& motion = registry.motions.get(entity);
 
+        vec2 flocking = steering[i].flocking;
         float flocking_strength = length(flocking);
         vec2 acceleration = flocking;
 
         if (flocking_strength < boid.max_force * 0.7f) {
-            vec2 chase = chasePlayer(entity) * boid.chase_weight;
+            vec2 chase = steering[i].chase;
             vec2 wander = calculateWander(entity) * 0.8f;
 
             if (length(chase) < 0.1f) {
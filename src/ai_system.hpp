@@ -11,9 +11,24 @@ public:
 	void step(float elapsed_ms);
 
 private:
-    vec2 calculateSeparation(Entity entity);
-    vec2 calculateAlignment(Entity entity);
-    vec2 calculateCohesion(Entity entity);
-    vec2 chasePlayer(Entity entity);
+    // what a boid needs to know about the rest of its flock
+    struct FlockMember {
+        vec2 position;
+        vec2 velocity;
+        const Boid* boid;
+    };
+    struct BoidSteering {
+        vec2 flocking;
+        vec2 chase;
+    };
+
+    vec2 calculateSeparation(size_t i, const std::vector<FlockMember>& flock);
+    vec2 calculateAlignment(size_t i, const std::vector<FlockMember>& flock);
+    vec2 calculateCohesion(size_t i, const std::vector<FlockMember>& flock);
+    vec2 chasePlayer(const FlockMember& self, vec2 player_position);
     vec2 calculateWander(Entity entity);
+
+    // kept between frames so stepping doesn't allocate
+    std::vector<FlockMember> flock;
+    std::vector<BoidSteering> steering;
 };
\ No newline at end of file
@@ -0,0 +1,123 @@
+#include "animation_system.hpp"
+
+// stlib
+#include <cstdio>
+#include <fstream>
+#include <vector>
+
+// internal
+#include "tiny_ecs_registry.hpp"
+
+std::array<SpriteSheet, sprite_sheet_count> sprite_sheets;
+
+// Keys in animations.json, indexed by SPRITE_SHEET_ID
+static const char* sheet_names[sprite_sheet_count] = {
+	"player",
+	"robot",
+	"ice_robot",
+	"boss_robot",
+	"spider_robot"
+};
+
+// Each sheet's states in the order of its state enum in components.hpp, indexed by
+// SPRITE_SHEET_ID. Animations index the table by enum value, so the file has to match.
+static const std::vector<const char*> state_names[sprite_sheet_count] = {
+	{ "IDLE", "ATTACK", "BLOCK", "DEAD", "PROJ", "SECOND", "WALK" }, // AnimationState
+	{ "WALK", "IDLE", "DEAD", "HURT", "ATTACK" },                     // RobotState
+	{ "WALK", "ATTACK", "IDLE", "DEAD" },                             // IceRobotState
+	{ "ATTACK", "WALK", "IDLE" },                                     // BossRobotState
+	{ "ATTACK", "IDLE", "WALK" }                                      // SpiderRobotState
+};
+
+static bool read_end(const std::string& name, AnimationEnd& end) {
+	if (name == "loop")
+		end = AnimationEnd::LOOP;
+	else if (name == "hold")
+		end = AnimationEnd::HOLD;
+	else if (name == "return")
+		end = AnimationEnd::RETURN;
+	else
+		return false;
+	return true;
+}
+
+static int find_state(const json& states, const std::string& name) {
+	for (size_t i = 0; i < states.size(); i++) {
+		if (states[i].at("name").get<std::string>() == name)
+			return (int)i;
+	}
+	return -1;
+}
+
+static bool read_sheet(const json& j, SpriteSheet& sheet, const char* name, const std::vector<const char*>& expected) {
+	j.at("sprite_size").get_to(sheet.sprite_size);
+	j.at("width").get_to(sheet.width);
+	j.at("height").get_to(sheet.height);
+	j.at("frame_time").get_to(sheet.frame_time);
+	j.at("direction_rows").get_to(sheet.direction_rows);
+
+	const json& states = j.at("states");
+	if (states.size() != expected.size() || states.size() > SpriteSheet::MAX_STATES) {
+		fprintf(stderr, "Sprite sheet %s has %d states, its state enum has %d\n", name, (int)states.size(), (int)expected.size());
+		return false;
+	}
+	sheet.state_count = (int)states.size();
+	for (int i = 0; i < sheet.state_count; i++) {
+		std::string state_name = states[i].at("name").get<std::string>();
+		if (state_name != expected[i]) {
+			fprintf(stderr, "Sprite sheet %s has state %s at %d, expected %s\n", name, state_name.c_str(), i, expected[i]);
+			return false;
+		}
+		SpriteSheetState& state = sheet.states[i];
+		states[i].at("frames").get_to(state.frames);
+		if (state.frames < 1 || !read_end(states[i].at("end").get<std::string>(), state.end)) {
+			fprintf(stderr, "Sprite sheet %s has a bad state %d\n", name, i);
+			return false;
+		}
+	}
+
+	sheet.idle_state = find_state(states, j.at("idle").get<std::string>());
+	sheet.walk_state = find_state(states, j.at("walk").get<std::string>());
+	if (sheet.idle_state < 0 || sheet.walk_state < 0) {
+		fprintf(stderr, "Sprite sheet %s names an idle or walk state it doesn't have\n", name);
+		return false;
+	}
+
+	sheet.frame_uv = vec2((float)sheet.sprite_size / sheet.width, (float)sheet.sprite_size / sheet.height);
+	return true;
+}
+
+bool load_sprite_sheets(const std::string& path) {
+	std::ifstream file(path);
+	if (!file.is_open()) {
+		fprintf(stderr, "Failed to open %s, make sure the data directory is present\n", path.c_str());
+		return false;
+	}
+
+	json j;
+	file >> j;
+	for (int i = 0; i < sprite_sheet_count; i++) {
+		if (!read_sheet(j.at(sheet_names[i]), sprite_sheets[i], sheet_names[i], state_names[i]))
+			return false;
+	}
+	return true;
+}
+
+template <typename Animation>
+static void update_container(ComponentContainer<Animation>& container, float elapsed_s) {
+	const SpriteSheet& sheet = Animation::sheet();
+	std::vector<Animation>& anims = container.components;
+	for (unsigned int i = 0; i < (unsigned int)anims.size(); i++) {
+		if (anims[i].update(sheet, elapsed_s))
+			container.mark_dirty(i);
+	}
+}
+
+void update_sprite_animations(float elapsed_ms) {
+	float elapsed_s = elapsed_ms / 1000.f;
+	update_container(registry.animations, elapsed_s);
+	update_container(registry.robotAnimations, elapsed_s);
+	update_container(registry.iceRobotAnimations, elapsed_s);
+	update_container(registry.bossRobotAnimations, elapsed_s);
+	update_container(registry.spiderRobotAnimations, elapsed_s);
+}
@@ -0,0 +1,16 @@
+#pragma once
+
+// stlib
+#include <string>
+
+// internal
+#include "components.hpp"
+
+// Reads the sprite sheet tables into sprite_sheets. Prints what is wrong and returns false
+// when the file is missing or describes a sheet the game can't use.
+bool load_sprite_sheets(const std::string& path);
+
+// Moves every character animation on by elapsed_ms: one loop per animation container over
+// its packed components, with the sheet looked up once per container. Only the components
+// whose frame changed are marked dirty.
+void update_sprite_animations(float elapsed_ms);
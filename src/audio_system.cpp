@@ -0,0 +1,366 @@
+#include "audio_system.hpp"
+
+// stlib
+#include <algorithm>
+#include <cstdio>
+
+#include <SDL.h>
+#include <SDL_mixer.h>
+
+AudioSystem audio;
+
+// Indexed by SOUND_ID. Hits and barks that come in swarms get few voices and a low
+// priority, the player's own feedback always gets through.
+static const std::array<SoundDef, sound_count> sound_defs = { {
+	{ "death_hq.wav",           SOUND_BANK::CORE,   10, 1 }, // PLAYER_DEAD
+	{ "win.wav",                SOUND_BANK::CORE,    6, 2 }, // KEY
+	{ "wall_contact.wav",       SOUND_BANK::CORE,    1, 1 }, // COLLISION
+	{ "attack_sound.wav",       SOUND_BANK::CORE,    5, 2 }, // ATTACK
+	{ "armor_break.wav",        SOUND_BANK::CORE,    8, 1 }, // ARMOR_BREAK
+	{ "door_open.wav",          SOUND_BANK::DOORS,   4, 2 }, // DOOR_OPEN
+	{ "robot_attack.wav",       SOUND_BANK::ROBOTS,  3, 4 }, // ROBOT_ATTACK
+	{ "robot_ready_attack.wav", SOUND_BANK::ROBOTS,  2, 2 }, // ROBOT_READY_ATTACK
+	{ "robot_death.wav",        SOUND_BANK::ROBOTS,  4, 3 }, // ROBOT_DEATH
+	{ "robot_awake.wav",        SOUND_BANK::ROBOTS,  2, 2 }, // ROBOT_AWAKE
+	{ "Upgrade.wav",            SOUND_BANK::CORE,    7, 1 }, // UPGRADE
+	{ "teleport_sound.wav",     SOUND_BANK::CORE,    7, 1 }, // TELEPORT
+	{ "using_item.wav",         SOUND_BANK::CORE,    6, 2 }, // USING_ITEM
+	{ "insert_card.wav",        SOUND_BANK::DOORS,   6, 1 }, // INSERT_CARD
+} };
+
+static const char* music_file = "Galactic.wav";
+
+//////////////////////////////////////
+// SDL_mixer backend
+
+class SdlAudioBackend : public AudioBackend
+{
+public:
+	bool open(int channels) override {
+		if (SDL_Init(SDL_INIT_AUDIO) < 0) {
+			fprintf(stderr, "Failed to initialize SDL Audio");
+			return false;
+		}
+		if (Mix_OpenAudio(44100, MIX_DEFAULT_FORMAT, 2, 2048) == -1) {
+			fprintf(stderr, "Failed to open audio device");
+			return false;
+		}
+		Mix_AllocateChannels(channels);
+		return true;
+	}
+
+	void close() override {
+		Mix_HaltChannel(-1);
+		if (music != nullptr)
+			Mix_FreeMusic(music);
+		music = nullptr;
+		for (Mix_Chunk*& chunk : chunks) {
+			if (chunk != nullptr)
+				Mix_FreeChunk(chunk);
+			chunk = nullptr;
+		}
+		Mix_CloseAudio();
+	}
+
+	// Mix_LoadWAV converts to the format the device was opened with, so mixing is a plain copy
+	bool load(SOUND_ID sound, const std::string& path) override {
+		chunks[(int)sound] = Mix_LoadWAV(path.c_str());
+		return chunks[(int)sound] != nullptr;
+	}
+
+	void unload(SOUND_ID sound) override {
+		Mix_Chunk*& chunk = chunks[(int)sound];
+		if (chunk != nullptr)
+			Mix_FreeChunk(chunk);
+		chunk = nullptr;
+	}
+
+	// Mix_Music streams, it reads the file as the mixer needs more
+	bool load_music(const std::string& path) override {
+		music = Mix_LoadMUS(path.c_str());
+		return music != nullptr;
+	}
+
+	void play(int channel, SOUND_ID sound, float volume) override {
+		Mix_Volume(channel, (int)(volume * MIX_MAX_VOLUME));
+		Mix_PlayChannel(channel, chunks[(int)sound], 0);
+	}
+
+	void stop(int channel) override { Mix_HaltChannel(channel); }
+	bool playing(int channel) override { return Mix_Playing(channel) != 0; }
+
+	void play_music() override {
+		if (music != nullptr)
+			Mix_PlayMusic(music, -1);
+	}
+
+private:
+	std::array<Mix_Chunk*, sound_count> chunks = {};
+	Mix_Music* music = nullptr;
+};
+
+std::unique_ptr<AudioBackend> make_sdl_audio_backend() {
+	return std::unique_ptr<AudioBackend>(new SdlAudioBackend());
+}
+
+//////////////////////////////////////
+// Null backend
+
+bool NullAudioBackend::open(int channels) {
+	ends.assign(channels, 0.f);
+	opened = std::chrono::steady_clock::now();
+	return true;
+}
+
+float NullAudioBackend::now_ms() const {
+	return std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - opened).count();
+}
+
+void NullAudioBackend::play(int channel, SOUND_ID, float) {
+	ends[channel] = now_ms() + voice_ms;
+}
+
+void NullAudioBackend::stop(int channel) {
+	ends[channel] = 0.f;
+}
+
+bool NullAudioBackend::playing(int channel) {
+	return ends[channel] > now_ms();
+}
+
+//////////////////////////////////////
+// Audio system
+
+AudioSystem::~AudioSystem() {
+	stop();
+}
+
+bool AudioSystem::start(std::unique_ptr<AudioBackend> backend) {
+	stop();
+	if (!backend->open(CHANNELS))
+		return false;
+
+	output = std::move(backend);
+	pending.fill(0.f);
+	music_pending = false;
+	banks_pending = false;
+	queue_head = 0;
+	queue_tail = 0;
+	voices.assign(CHANNELS, Voice());
+	voice_count = 0;
+	sound_states.fill(SoundState::UNLOADED);
+	banks_in_use = bank_bit(SOUND_BANK::CORE);
+	music_loaded = false;
+
+	running = true;
+	// the first pass starts on CORE
+	wake = true;
+	thread = std::thread(&AudioSystem::thread_loop, this);
+	return true;
+}
+
+void AudioSystem::stop() {
+	if (!thread.joinable())
+		return;
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		running = false;
+	}
+	cv.notify_one();
+	thread.join();
+	output->close();
+}
+
+void AudioSystem::play(SOUND_ID sound) {
+	pending[(int)sound] = 1.f;
+}
+
+void AudioSystem::play(SOUND_ID sound, vec2 position) {
+	float distance = length(position - listener);
+	float volume = 1.f - (distance - NEAR_DISTANCE) / (FAR_DISTANCE - NEAR_DISTANCE);
+	volume = std::min(std::max(volume, 0.f), 1.f);
+	// the same sound again this frame only makes the one voice louder
+	float& loudest = pending[(int)sound];
+	loudest = std::max(loudest, volume);
+}
+
+void AudioSystem::play_music() {
+	music_pending = true;
+}
+
+void AudioSystem::use_banks(uint32_t banks) {
+	pending_banks = banks;
+	banks_pending = true;
+}
+
+void AudioSystem::push(const Request& request) {
+	uint32_t tail = queue_tail.load(std::memory_order_relaxed);
+	if (tail - queue_head.load(std::memory_order_acquire) == QUEUE_CAPACITY) {
+		dropped_sounds++;
+		return;
+	}
+	queue[tail % QUEUE_CAPACITY] = request;
+	queue_tail.store(tail + 1, std::memory_order_release);
+}
+
+void AudioSystem::end_frame(vec2 listener_position) {
+	listener = listener_position;
+	if (!running)
+		return;
+
+	bool pushed = false;
+	if (banks_pending) {
+		push({ RequestType::BANKS, SOUND_ID::SOUND_COUNT, 0.f, pending_banks });
+		banks_pending = false;
+		pushed = true;
+	}
+	if (music_pending) {
+		push({ RequestType::MUSIC, SOUND_ID::SOUND_COUNT, 1.f, 0 });
+		music_pending = false;
+		pushed = true;
+	}
+	for (int i = 0; i < sound_count; i++) {
+		// out of earshot sounds never take a voice
+		if (pending[i] > 0.f) {
+			push({ RequestType::PLAY, (SOUND_ID)i, pending[i], 0 });
+			pushed = true;
+		}
+		pending[i] = 0.f;
+	}
+	if (!pushed)
+		return;
+
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		wake = true;
+	}
+	cv.notify_one();
+}
+
+void AudioSystem::start_voice(const Request& request) {
+	const SoundDef& def = sound_defs[(int)request.sound];
+	if (sound_states[(int)request.sound] != SoundState::LOADED) {
+		// first use of a bank nobody asked for, it is there next time
+		banks_in_use |= bank_bit(def.bank);
+		dropped_sounds++;
+		return;
+	}
+
+	int same = 0;
+	int free_channel = -1;
+	int victim = -1;
+	for (int c = 0; c < (int)voices.size(); c++) {
+		const Voice& voice = voices[c];
+		if (voice.sound == SOUND_ID::SOUND_COUNT) {
+			if (free_channel < 0)
+				free_channel = c;
+			continue;
+		}
+		if (voice.sound == request.sound)
+			same++;
+		if (victim < 0 || voice.priority < voices[victim].priority
+			|| (voice.priority == voices[victim].priority && voice.started < voices[victim].started))
+			victim = c;
+	}
+
+	// a sound at its cap keeps the voices it has, so one triggered every frame doesn't keep restarting
+	int channel;
+	if (same >= def.max_voices)
+		channel = -1;
+	else if (free_channel >= 0)
+		channel = free_channel;
+	else if (victim >= 0 && voices[victim].priority <= def.priority)
+		channel = victim;
+	else
+		channel = -1;
+	if (channel < 0) {
+		dropped_sounds++;
+		return;
+	}
+
+	if (voices[channel].sound != SOUND_ID::SOUND_COUNT) {
+		output->stop(channel);
+		stolen_voices++;
+	}
+	output->play(channel, request.sound, request.volume);
+	voices[channel].sound = request.sound;
+	voices[channel].priority = def.priority;
+	voices[channel].started = voice_count++;
+}
+
+void AudioSystem::free_unused_banks() {
+	for (int i = 0; i < sound_count; i++) {
+		if (sound_states[i] != SoundState::LOADED || (banks_in_use & bank_bit(sound_defs[i].bank)))
+			continue;
+		for (Voice& voice : voices) {
+			if (voice.sound == (SOUND_ID)i)
+				voice.sound = SOUND_ID::SOUND_COUNT;
+		}
+		output->unload((SOUND_ID)i);
+		sound_states[i] = SoundState::UNLOADED;
+	}
+}
+
+bool AudioSystem::load_next_sound() {
+	for (int i = 0; i < sound_count; i++) {
+		if (sound_states[i] != SoundState::UNLOADED || !(banks_in_use & bank_bit(sound_defs[i].bank)))
+			continue;
+		std::string path = audio_path(sound_defs[i].file);
+		if (output->load((SOUND_ID)i, path))
+			sound_states[i] = SoundState::LOADED;
+		else {
+			fprintf(stderr, "Failed to load sound %s, make sure the data directory is present\n", path.c_str());
+			sound_states[i] = SoundState::MISSING;
+		}
+		return true;
+	}
+	return false;
+}
+
+void AudioSystem::thread_loop() {
+	std::unique_lock<std::mutex> lock(mutex);
+	bool loading = false;
+	while (true) {
+		// keeps going without waiting while there are sounds to load
+		cv.wait(lock, [&] { return wake || loading || !running; });
+		if (!running)
+			break;
+		wake = false;
+		lock.unlock();
+
+		for (int c = 0; c < (int)voices.size(); c++) {
+			if (voices[c].sound != SOUND_ID::SOUND_COUNT && !output->playing(c))
+				voices[c].sound = SOUND_ID::SOUND_COUNT;
+		}
+
+		uint32_t head = queue_head.load(std::memory_order_relaxed);
+		uint32_t tail = queue_tail.load(std::memory_order_acquire);
+		for (; head != tail; head++) {
+			const Request& request = queue[head % QUEUE_CAPACITY];
+			switch (request.type) {
+			case RequestType::PLAY:
+				start_voice(request);
+				break;
+			case RequestType::MUSIC:
+				if (!music_loaded) {
+					music_loaded = output->load_music(audio_path(music_file));
+					if (!music_loaded)
+						fprintf(stderr, "Failed to load music %s\n", audio_path(music_file).c_str());
+				}
+				if (music_loaded)
+					output->play_music();
+				break;
+			case RequestType::BANKS:
+				banks_in_use = request.banks | bank_bit(SOUND_BANK::CORE);
+				free_unused_banks();
+				break;
+			}
+		}
+		queue_head.store(head, std::memory_order_release);
+
+		// one sound per pass, so requests arriving meanwhile wait at most one file
+		loading = load_next_sound();
+
+		lock.lock();
+	}
+}
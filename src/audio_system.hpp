@@ -0,0 +1,216 @@
+#pragma once
+
+// stlib
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// internal
+#include "common.hpp"
+
+enum class SOUND_ID {
+	PLAYER_DEAD = 0,
+	KEY = PLAYER_DEAD + 1,
+	COLLISION = KEY + 1,
+	ATTACK = COLLISION + 1,
+	ARMOR_BREAK = ATTACK + 1,
+	DOOR_OPEN = ARMOR_BREAK + 1,
+	ROBOT_ATTACK = DOOR_OPEN + 1,
+	ROBOT_READY_ATTACK = ROBOT_ATTACK + 1,
+	ROBOT_DEATH = ROBOT_READY_ATTACK + 1,
+	ROBOT_AWAKE = ROBOT_DEATH + 1,
+	UPGRADE = ROBOT_AWAKE + 1,
+	TELEPORT = UPGRADE + 1,
+	USING_ITEM = TELEPORT + 1,
+	INSERT_CARD = USING_ITEM + 1,
+	SOUND_COUNT = INSERT_CARD + 1
+};
+const int sound_count = (int)SOUND_ID::SOUND_COUNT;
+
+// Sounds are loaded and freed a bank at a time. CORE is the player's and the menus'
+// and stays loaded, the others only while a level needs them.
+enum class SOUND_BANK {
+	CORE = 0,
+	ROBOTS = CORE + 1,
+	DOORS = ROBOTS + 1,
+	BANK_COUNT = DOORS + 1
+};
+inline uint32_t bank_bit(SOUND_BANK bank) { return 1u << (int)bank; }
+
+// How a sound competes for voices. A new voice may replace a playing one of the same
+// or lower priority once all channels are busy, and a sound never has more than
+// max_voices playing at once, requests past that are dropped.
+struct SoundDef {
+	const char* file;
+	SOUND_BANK bank;
+	int priority;
+	int max_voices;
+};
+
+// Where the mixed sound goes. Everything between open and close is called from the
+// audio thread only.
+class AudioBackend
+{
+public:
+	virtual ~AudioBackend() {}
+
+	virtual bool open(int channels) = 0;
+	virtual void close() = 0;
+	// Decodes the whole sound into memory, converted to the device's format
+	virtual bool load(SOUND_ID sound, const std::string& path) = 0;
+	// Stops the voices playing it first
+	virtual void unload(SOUND_ID sound) = 0;
+	// Only opens the track, it is decoded from disk a piece at a time while it plays
+	virtual bool load_music(const std::string& path) = 0;
+
+	// volume from 0 to 1
+	virtual void play(int channel, SOUND_ID sound, float volume) = 0;
+	virtual void stop(int channel) = 0;
+	virtual bool playing(int channel) = 0;
+	// loops until closed
+	virtual void play_music() = 0;
+};
+
+// SDL_mixer, one mixer channel per voice
+std::unique_ptr<AudioBackend> make_sdl_audio_backend();
+
+// Plays nothing, for running without an audio device. Every voice lasts voice_ms, so
+// voice caps and stealing behave as they would with sound.
+class NullAudioBackend : public AudioBackend
+{
+public:
+	bool open(int channels) override;
+	void close() override {}
+	bool load(SOUND_ID, const std::string&) override { return true; }
+	void unload(SOUND_ID) override {}
+	bool load_music(const std::string&) override { return true; }
+	void play(int channel, SOUND_ID sound, float volume) override;
+	void stop(int channel) override;
+	bool playing(int channel) override;
+	void play_music() override {}
+
+	float voice_ms = 500.f;
+
+private:
+	// when each channel's voice ends, in ms since open
+	std::vector<float> ends;
+	std::chrono::steady_clock::time_point opened;
+	float now_ms() const;
+};
+
+// All game sounds go through here. The simulation asks for sounds on the main thread,
+// requests for the same sound within a frame are merged into one, and end_frame() hands
+// them to the audio thread through a single producer single consumer ring. The audio
+// thread owns the channels: it keeps every sound within its voice cap, and once all
+// channels are busy a new voice takes the channel of the lowest priority, oldest voice
+// or is dropped when everything playing matters more.
+//
+// Sounds given a position fade out with their distance from the listener, the centre of
+// the camera as of the last end_frame().
+//
+// Nothing is loaded up front. The audio thread loads the banks in use one sound at a time
+// between requests, so the game starts and switches levels without waiting on decoding.
+// A sound whose bank isn't loaded yet is dropped, and its bank loaded if it wasn't in use.
+class AudioSystem
+{
+public:
+	// voices playing at once over all sounds
+	static const int CHANNELS = 16;
+	// requests between two wake ups of the audio thread, more are dropped
+	static const uint32_t QUEUE_CAPACITY = 256;
+	// full volume up to NEAR_DISTANCE from the listener, silent from FAR_DISTANCE on
+	static constexpr float NEAR_DISTANCE = 400.f;
+	static constexpr float FAR_DISTANCE = 1400.f;
+
+	~AudioSystem();
+
+	// Opens the backend and starts the audio thread, which starts loading CORE
+	bool start(std::unique_ptr<AudioBackend> backend);
+	// Joins the audio thread and closes the backend
+	void stop();
+
+	// Main thread only
+	void play(SOUND_ID sound);
+	void play(SOUND_ID sound, vec2 position);
+	void play_music();
+	// Banks to keep loaded besides CORE, as bank_bit()s. The others are freed.
+	void use_banks(uint32_t banks);
+	// Once per frame, sends this frame's requests and moves the listener
+	void end_frame(vec2 listener);
+
+	// Since start, written by the audio thread and shown with the FPS counter
+	std::atomic<unsigned int> stolen_voices{ 0 };
+	std::atomic<unsigned int> dropped_sounds{ 0 };
+
+private:
+	enum class RequestType : uint8_t {
+		PLAY,
+		MUSIC,
+		BANKS
+	};
+
+	struct Request {
+		RequestType type;
+		SOUND_ID sound;
+		float volume;
+		uint32_t banks;
+	};
+
+	enum class SoundState : uint8_t {
+		UNLOADED,
+		LOADED,
+		// the file failed to load, not tried again
+		MISSING
+	};
+
+	struct Voice {
+		// SOUND_COUNT while the channel is free
+		SOUND_ID sound = SOUND_ID::SOUND_COUNT;
+		int priority = 0;
+		uint64_t started = 0;
+	};
+
+	void push(const Request& request);
+	void thread_loop();
+	void start_voice(const Request& request);
+	void free_unused_banks();
+	// Loads one sound of the banks in use, false once they are all loaded
+	bool load_next_sound();
+
+	std::unique_ptr<AudioBackend> output;
+	vec2 listener = { 0.f, 0.f };
+	// loudest request of each sound this frame, 0 when there is none
+	std::array<float, sound_count> pending;
+	bool music_pending = false;
+	bool banks_pending = false;
+	uint32_t pending_banks = 0;
+
+	// written by the main thread at tail, read by the audio thread at head
+	std::array<Request, QUEUE_CAPACITY> queue;
+	std::atomic<uint32_t> queue_head{ 0 };
+	std::atomic<uint32_t> queue_tail{ 0 };
+
+	// audio thread only
+	std::vector<Voice> voices;
+	uint64_t voice_count = 0;
+	std::array<SoundState, sound_count> sound_states;
+	uint32_t banks_in_use = 0;
+	bool music_loaded = false;
+
+	std::thread thread;
+	std::mutex mutex;
+	std::condition_variable cv;
+	// written by the main thread only, the audio thread reads it under the mutex
+	bool running = false;
+	bool wake = false;
+};
+
+// Shared by the world and physics systems
+extern AudioSystem audio;
@@ -0,0 +1,146 @@
+#include "autosave.hpp"
+#include "save_journal.hpp"
+
+// stlib
+#include <chrono>
+#include <iostream>
+
+using Clock = std::chrono::high_resolution_clock;
+
+Autosaver::Autosaver(const std::string& path) : path(path)
+{
+}
+
+Autosaver::~Autosaver()
+{
+	stop();
+}
+
+void Autosaver::start(ECSRegistry& reg, uint32_t loaded_epoch)
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	if (running)
+		return;
+	start_journaling(reg);
+	epoch = loaded_epoch;
+	// the first capture is a full snapshot, so the journal never builds on a save that wasn't ours
+	need_checkpoint = true;
+	running = true;
+	writer = std::thread(&Autosaver::writer_loop, this);
+}
+
+void Autosaver::stop()
+{
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		if (!running)
+			return;
+		running = false;
+	}
+	cv.notify_all();
+	if (writer.joinable())
+		writer.join();
+}
+
+void Autosaver::step(float elapsed_ms, ECSRegistry& reg, const WorldSystem& world)
+{
+	ms_since_save += elapsed_ms;
+	if (ms_since_save < JOURNAL_INTERVAL_MS)
+		return;
+	ms_since_save = 0.f;
+	request_save(reg, world);
+}
+
+bool Autosaver::request_save(ECSRegistry& reg, const WorldSystem& world)
+{
+	Job job;
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		if (!running)
+			return false;
+		if (in_flight >= MAX_IN_FLIGHT) {
+			// the dirty flags are left alone, the next record picks the changes up
+			skipped_saves++;
+			return false;
+		}
+		in_flight++;
+		job.full = need_checkpoint || records_since_checkpoint >= RECORDS_PER_CHECKPOINT;
+		need_checkpoint = false;
+		if (!free_buffers.empty()) {
+			job.data = std::move(free_buffers.back());
+			free_buffers.pop_back();
+		}
+	}
+
+	auto t0 = Clock::now();
+	SnapshotWriter w;
+	w.buffer = std::move(job.data);
+	w.buffer.clear();
+	if (job.full) {
+		epoch++;
+		build_snapshot(reg, world, w, epoch);
+		clear_dirty_components(reg);
+		records_since_checkpoint = 0;
+	}
+	else {
+		build_journal_record(reg, world, w);
+		records_since_checkpoint++;
+	}
+	job.epoch = epoch;
+	job.data = std::move(w.buffer);
+	last_capture_ms = (float)(std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - t0)).count() / 1000;
+
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		pending.push_back(std::move(job));
+	}
+	cv.notify_one();
+	return true;
+}
+
+bool Autosaver::save_now(ECSRegistry& reg, const WorldSystem& world)
+{
+	epoch++;
+	if (!save_snapshot(reg, world, path, epoch))
+		return false;
+	clear_dirty_components(reg);
+	return reset_journal(journal_path(path), epoch);
+}
+
+void Autosaver::writer_loop()
+{
+	std::vector<char> packed;
+	// records are only appended on top of a checkpoint that made it to disk
+	bool journal_valid = false;
+	while (true) {
+		Job job;
+		{
+			std::unique_lock<std::mutex> lock(mutex);
+			cv.wait(lock, [this] { return !pending.empty() || !running; });
+			// drain the queue before exiting so a save requested right before shutdown still lands
+			if (pending.empty())
+				return;
+			job = std::move(pending.front());
+			pending.pop_front();
+		}
+
+		bool ok = true;
+		if (job.full) {
+			compress_snapshot(job.data, packed);
+			ok = write_snapshot_file(path, packed.data(), packed.size());
+			// a crash between these two leaves a journal with an older epoch, which load ignores
+			ok = ok && reset_journal(journal_path(path), job.epoch);
+			journal_valid = ok;
+		}
+		else if (journal_valid) {
+			ok = append_journal_record(journal_path(path), job.data.data(), job.data.size());
+		}
+
+		std::lock_guard<std::mutex> lock(mutex);
+		// a lost checkpoint or record can't be patched by later records, start over from a snapshot
+		if (!ok || !journal_valid)
+			need_checkpoint = true;
+		free_buffers.push_back(std::move(job.data));
+		in_flight--;
+	}
+}
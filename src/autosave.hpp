@@ -0,0 +1,76 @@
+#pragma once
+
+// stlib
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// internal
+#include "snapshot.hpp"
+
+// Periodic save that never blocks the game loop on compression or disk I/O.
+// Captures happen on the main thread between frames and are mostly small journal
+// records of the components dirtied since the previous capture. Every few records a
+// full snapshot is taken instead, which compacts the journal back to empty.
+// A writer thread compresses snapshots, renames them over the previous save and
+// appends the records.
+class Autosaver
+{
+public:
+	// time between two captures
+	static constexpr float JOURNAL_INTERVAL_MS = 5000.f;
+	// journal records between two full snapshots
+	static const int RECORDS_PER_CHECKPOINT = 6;
+	// captures not yet on disk, further captures are skipped until one finishes
+	static const int MAX_IN_FLIGHT = 2;
+
+	Autosaver(const std::string& path = snapshot_path());
+	~Autosaver();
+
+	// Turns on dirty tracking; epoch is the one of the snapshot that was loaded
+	void start(ECSRegistry& reg, uint32_t epoch);
+
+	// Finishes the snapshots already queued, then joins the writer thread
+	void stop();
+
+	// Call at a frame boundary, captures once the interval has passed
+	void step(float elapsed_ms, ECSRegistry& reg, const WorldSystem& world);
+
+	// Captures right away. Returns false when the writer is too far behind and the save was skipped.
+	bool request_save(ECSRegistry& reg, const WorldSystem& world);
+
+	// Synchronous full snapshot for shutdown, call after stop()
+	bool save_now(ECSRegistry& reg, const WorldSystem& world);
+
+	// main thread cost of the last capture
+	float last_capture_ms = 0.f;
+	unsigned int skipped_saves = 0;
+
+private:
+	struct Job {
+		bool full = false;
+		uint32_t epoch = 0;
+		std::vector<char> data;
+	};
+
+	void writer_loop();
+
+	std::string path;
+	float ms_since_save = 0.f;
+	// epoch of the newest full snapshot, the journal on disk belongs to it
+	uint32_t epoch = 0;
+	int records_since_checkpoint = 0;
+	bool need_checkpoint = true;
+
+	std::thread writer;
+	std::mutex mutex;
+	std::condition_variable cv;
+	bool running = false;
+	int in_flight = 0;
+	std::deque<Job> pending;
+	// finished buffers are handed back so captures don't reallocate
+	std::vector<std::vector<char>> free_buffers;
+};
@@ -5,6 +5,7 @@
 #include "../ext/stb_image/stb_image.h"
 
 // stlib
+#include <algorithm>
 #include <iostream>
 #include <sstream>
 
@@ -198,14 +199,6 @@ void from_json(const json& j, DeathTimer& timer) {
 	j.get_to(timer.counter_ms);
 }
 
-void to_json(json& j, const Collision& collision) {
-	j = json{ {"other", collision.other} };
-}
-
-void from_json(const json& j, Collision& collision) {
-	j.at("other").get_to(collision.other);
-}
-
 void to_json(json& j, const Player& player) {
 	j = json{
 		{"inventory", player.inventory},  // Serialize Inventory
@@ -234,50 +227,46 @@ void from_json(const json& j, Player& player) {
 	j.at("max_stamina").get_to(player.max_stamina);
 }
 
-void to_json(json& j, const BaseAnimation& anim) {
+// The sheet itself comes from sprite_sheets, only the state of the animation is stored
+template <SPRITE_SHEET_ID SHEET, typename State>
+static void animation_to_json(json& j, const SheetAnimation<SHEET, State>& anim) {
 	j = json{
-		{"sprite_size", anim.sprite_size},
-		{"s_width", anim.s_width},
-		{"s_height", anim.s_height},
 		{"current_frame_time", anim.current_frame_time},
 		{"current_frame", anim.current_frame},
-		{"current_dir", anim.current_dir}
+		{"current_state", static_cast<int>(anim.current_state)},
+		{"current_dir", static_cast<int>(anim.current_dir)}
 	};
 }
 
-void from_json(const json& j, BaseAnimation& anim) {
-	j.at("sprite_size").get_to(anim.sprite_size);
-	j.at("s_width").get_to(anim.s_width);
-	j.at("s_height").get_to(anim.s_height);
+// Older saves have no current_state for the player, it starts over idle
+template <SPRITE_SHEET_ID SHEET, typename State>
+static void animation_from_json(const json& j, SheetAnimation<SHEET, State>& anim) {
 	j.at("current_frame_time").get_to(anim.current_frame_time);
 	j.at("current_frame").get_to(anim.current_frame);
-	j.at("current_dir").get_to(anim.current_dir);
+	anim.current_state = static_cast<State>(j.value("current_state", static_cast<int>(anim.current_state)));
+	anim.current_dir = static_cast<Direction>(j.at("current_dir").get<int>());
+	// the frame may be past the end of a state the sheet has fewer frames for now
+	anim.current_frame = std::min(anim.current_frame, anim.getMaxFrames() - 1);
 }
 
 void to_json(json& j, const PlayerAnimation& anim) {
-	to_json(j, static_cast<const BaseAnimation&>(anim)); 
+	animation_to_json(j, anim);
 	j["is_walking"] = anim.is_walking;
 	j["can_attack"] = anim.can_attack;
 }
 
 void from_json(const json& j, PlayerAnimation& anim) {
-	from_json(j, static_cast<BaseAnimation&>(anim)); 
+	animation_from_json(j, anim);
 	j.at("is_walking").get_to(anim.is_walking);
 	j.at("can_attack").get_to(anim.can_attack);
 }
 
 void to_json(json& j, const RobotAnimation& anim) {
-	to_json(j, static_cast<const BaseAnimation&>(anim));
-	j["current_state"] = anim.current_state;
-	j["current_dir"] = anim.current_dir;
-	j["is_moving"] = anim.is_moving;
+	animation_to_json(j, anim);
 }
 
 void from_json(const json& j, RobotAnimation& anim) {
-	from_json(j, static_cast<BaseAnimation&>(anim));
-	j.at("current_state").get_to(anim.current_state);
-	j.at("current_dir").get_to(anim.current_dir);
-	j.at("is_moving").get_to(anim.is_moving);
+	animation_from_json(j, anim);
 }
 
 void to_json(json& j, const RenderRequest& request) {
@@ -454,60 +443,20 @@ void to_json(json& j, const Spaceship& ap) {
 void from_json(const json& j, Spaceship& ap) {
 }
 
-void to_json(nlohmann::json& j, const projectile& p) {
-	j = nlohmann::json{
-		{"dmg", p.dmg},
-		{"ice", p.ice},
-		{"friendly", p.friendly}
-	};
-}
-
-void from_json(const nlohmann::json& j, projectile& p) {
-	j.at("dmg").get_to(p.dmg);
-	j.at("ice").get_to(p.ice);
-	j.at("friendly").get_to(p.friendly);
-}
-
 void to_json(json& j, const IceRobotAnimation& animation) {
-	j = static_cast<const BaseAnimation&>(animation);
-	j["current_state"] = static_cast<int>(animation.current_state);
-	j["current_dir"] = static_cast<int>(animation.current_dir);
-	j["is_moving"] = animation.is_moving;
+	animation_to_json(j, animation);
 }
 
 void from_json(const json& j, IceRobotAnimation& animation) {
-	j.get_to(static_cast<BaseAnimation&>(animation));
-	animation.current_state = static_cast<IceRobotState>(j.at("current_state").get<int>());
-	animation.current_dir = static_cast<Direction>(j.at("current_dir").get<int>());
-	animation.is_moving = j.at("is_moving").get<bool>();
+	animation_from_json(j, animation);
 }
 
 void to_json(json& j, const BossRobotAnimation& animation) {
-	j = static_cast<const BaseAnimation&>(animation);
-	j["current_state"] = static_cast<int>(animation.current_state);
-	j["current_dir"] = static_cast<int>(animation.current_dir);
+	animation_to_json(j, animation);
 }
 
 void from_json(const json& j, BossRobotAnimation& animation) {
-	j.get_to(static_cast<BaseAnimation&>(animation));
-	animation.current_state = static_cast<BossRobotState>(j.at("current_state").get<int>());
-	animation.current_dir = static_cast<Direction>(j.at("current_dir").get<int>());
-}
-
-void to_json(json& j, const bossProjectile& projectile) {
-	j = json{
-		{"dmg", projectile.dmg},
-		{"amplitude", projectile.amplitude},
-		{"frequency", projectile.frequency},
-		{"time", projectile.time}
-	};
-}
-
-void from_json(const json& j, bossProjectile& projectile) {
-	j.at("dmg").get_to(projectile.dmg);
-	j.at("amplitude").get_to(projectile.amplitude);
-	j.at("frequency").get_to(projectile.frequency);
-	j.at("time").get_to(projectile.time);
+	animation_from_json(j, animation);
 }
 
 void to_json(json& j, const BossRobot& robot) {
@@ -518,7 +467,10 @@ void to_json(json& j, const BossRobot& robot) {
 		{"death_cd", robot.death_cd},
 		{"search_box", {robot.search_box.x, robot.search_box.y}},
 		{"attack_box", {robot.attack_box.x, robot.attack_box.y}},
-		{"panic_box", {robot.panic_box.x, robot.panic_box.y}}
+		{"panic_box", {robot.panic_box.x, robot.panic_box.y}},
+		{"shoot_timer", robot.attack.shoot_timer},
+		{"volleys", robot.attack.volleys},
+		{"dash_timer", robot.attack.dash_timer}
 	};
 }
 
@@ -534,6 +486,9 @@ void from_json(const json& j, BossRobot& robot) {
 	robot.attack_box = vec2{ box[0], box[1] };
 	j.at("panic_box").get_to(box);
 	robot.panic_box = vec2{ box[0], box[1] };
+	robot.attack.shoot_timer = j.value("shoot_timer", 0.f);
+	robot.attack.volleys = j.value("volleys", 0);
+	robot.attack.dash_timer = j.value("dash_timer", 0.f);
 }
 
 void to_json(json& j, const Door& door) {
@@ -624,15 +579,11 @@ void from_json(const json& j, SpiderRobot& robot) {
 
 
 void to_json(json& j, const SpiderRobotAnimation& animation) {
-	j = static_cast<const BaseAnimation&>(animation);
-	j["current_state"] = static_cast<int>(animation.current_state);
-	j["current_dir"] = static_cast<int>(animation.current_dir);
+	animation_to_json(j, animation);
 }
 
 void from_json(const json& j, SpiderRobotAnimation& animation) {
-	j.get_to(static_cast<BaseAnimation&>(animation));
-	animation.current_state = static_cast<SpiderRobotState>(j.at("current_state").get<int>());
-	animation.current_dir = static_cast<Direction>(j.at("current_dir").get<int>());
+	animation_from_json(j, animation);
 }
 
 void to_json(json& j, const Boid& b) {
@@ -4,6 +4,7 @@
 #define COMPONENT_HPP
 
 #include "common.hpp"
+#include <array>
 #include <vector>
 #include <unordered_map>
 #include "../ext/stb_image/stb_image.h"
@@ -15,7 +16,7 @@
 
 using json = nlohmann::json;
 
-enum class AnimationState {
+enum class AnimationState : uint8_t {
 	IDLE = 0,
 	ATTACK,
 	BLOCK,
@@ -25,7 +26,7 @@ enum class AnimationState {
 	WALK
 };
 
-enum class RobotState {
+enum class RobotState : uint8_t {
 	WALK = 0,    
 	IDLE = 1,
 	DEAD = 2,
@@ -33,16 +34,23 @@ enum class RobotState {
 	ATTACK = 4
 };
 
-enum class BossRobotState {
+enum class BossRobotState : uint8_t {
 	ATTACK = 0,
 	WALK  = 1,
 	IDLE = 2
 };
-enum class SpiderRobotState {
+enum class SpiderRobotState : uint8_t {
 	ATTACK = 0,
 	IDLE = 1,
 	WALK = 2
 };
+
+enum class IceRobotState : uint8_t {
+	WALK = 0,
+	ATTACK = 1,
+	IDLE = 2,
+	DEAD = 3
+};
 struct Radiation {
 	float intensity;    
 	float damagePerSecond; 
@@ -83,90 +91,127 @@ struct attackBox {
 	bool friendly;
 };
 
-struct BaseAnimation {
-	static constexpr float FRAME_TIME = 0.2f;
-
-	static constexpr float FRAME_TIME_PLAYER = 0.1f;
-
-	static constexpr float FRAME_TIME_ROBOT = 0.3f;
-
-	int sprite_size;
-	int s_width;
-	int s_height;
+// Sprite sheets of the animated characters
+enum class SPRITE_SHEET_ID : uint8_t {
+	PLAYER = 0,
+	ROBOT = PLAYER + 1,
+	ICE_ROBOT = ROBOT + 1,
+	BOSS_ROBOT = ICE_ROBOT + 1,
+	SPIDER_ROBOT = BOSS_ROBOT + 1,
+	SHEET_COUNT = SPIDER_ROBOT + 1
+};
+const int sprite_sheet_count = (int)SPRITE_SHEET_ID::SHEET_COUNT;
+
+// What a state does after its last frame
+enum class AnimationEnd : uint8_t {
+	LOOP,
+	// stays on the last frame
+	HOLD,
+	// goes back to walking or idle, for actions that play once
+	RETURN
+};
+
+struct SpriteSheetState {
+	int frames = 1;
+	AnimationEnd end = AnimationEnd::HOLD;
+};
+
+// Layout and timing of a sprite sheet, read from data/animations.json. A state's frames run
+// left to right along its row, which is state * 4 + direction, or just the state on sheets
+// drawn facing one way.
+struct SpriteSheet {
+	static const int MAX_STATES = 8;
+	int sprite_size = 0;
+	int width = 0;
+	int height = 0;
+	// seconds per frame
+	float frame_time = 0.2f;
+	bool direction_rows = true;
+	// where RETURN states go
+	int idle_state = 0;
+	int walk_state = 0;
+	int state_count = 0;
+	std::array<SpriteSheetState, MAX_STATES> states;
+	// size of one frame in texture coordinates
+	vec2 frame_uv = { 0.f, 0.f };
+};
+
+// Indexed by SPRITE_SHEET_ID, filled by load_sprite_sheets()
+extern std::array<SpriteSheet, sprite_sheet_count> sprite_sheets;
+
+// Animation of one character. Only what changes per entity is stored, the sheet is looked up
+// in sprite_sheets, so a container of these is a packed array of plain data that
+// update_sprite_animations() goes through without virtual calls and snapshots copy as bytes.
+template <SPRITE_SHEET_ID SHEET, typename State>
+struct SheetAnimation {
 	float current_frame_time = 0.f;
 	int current_frame = 0;
-
-
-public:
-	BaseAnimation(int sprite_size = 64, int s_width = 448, int s_height = 1280) :
-		sprite_size(sprite_size),
-		s_width(s_width),
-		s_height(s_height) {}
-
+	State current_state = State::IDLE;
 	Direction current_dir = Direction::RIGHT;
-	virtual int getMaxFrames() const = 0;
-	virtual bool loop() const = 0;
-	virtual int getRow() const = 0;
-	virtual void update(float elapsed_ms) = 0;
-
-	std::pair<vec2, vec2> getCurrentTexCoords() const {
-		int row = getRow();
-
-		int frame_use = current_frame;
-
-		float frame_width = static_cast<float>(sprite_size) / static_cast<float>(s_width);
-		float frame_height = static_cast<float>(sprite_size) / static_cast<float>(s_height);
+	// used by the player's actions
+	bool is_walking = false;
+	bool can_attack = true;
 
-		vec2 top_left = {
-			frame_use * frame_width,
-			row * frame_height
-		};
+	static const SpriteSheet& sheet() { return sprite_sheets[(int)SHEET]; }
+	// seconds per frame
+	static float frameTime() { return sheet().frame_time; }
 
-		vec2 bottom_right = {
-			(frame_use + 1) * frame_width,
-			(row + 1) * frame_height
-		};
+	int getMaxFrames() const { return sheet().states[(int)current_state].frames; }
 
-		return { top_left, bottom_right };
+	int getRow() const {
+		if (!sheet().direction_rows)
+			return static_cast<int>(current_state);
+		return static_cast<int>(current_state) * 4 + static_cast<int>(current_dir);
 	}
 
-	virtual ~BaseAnimation() {}
-};
-
-class PlayerAnimation : public BaseAnimation {
-
-
-public:
-	PlayerAnimation(int sprite_size = 64, int s_width = 448, int s_height = 1280)
-		: BaseAnimation(sprite_size, s_width, s_height), can_attack(true) {}
+	std::pair<vec2, vec2> getCurrentTexCoords() const {
+		vec2 frame_uv = sheet().frame_uv;
+		vec2 top_left = { current_frame * frame_uv.x, getRow() * frame_uv.y };
+		return { top_left, top_left + frame_uv };
+	}
 
-	AnimationState current_state = AnimationState::IDLE;
-	bool is_walking = false;
-	bool can_attack;
-
-	int getMaxFrames() const override {
-		switch (current_state) {
-		case AnimationState::IDLE: return 3;
-		case AnimationState::ATTACK: return 7;
-		case AnimationState::BLOCK: return 5;
-		case AnimationState::DEAD: return 7;
-		case AnimationState::PROJ: return 6;
-		case AnimationState::SECOND: return 7;
-		case AnimationState::WALK: return 5;
-		default: return 0;
+	// Starts over on a new state, or on a new direction when the sheet has a row for it
+	void setState(State newState, Direction newDir) {
+		bool restart = newState != current_state || (newDir != current_dir && sheet().direction_rows);
+		current_state = newState;
+		current_dir = newDir;
+		if (restart) {
+			current_frame = 0;
+			current_frame_time = 0;
 		}
 	}
 
-	bool loop() const override {
-		return current_state == AnimationState::IDLE ||
-			current_state == AnimationState::WALK;
-	}
+	// sheet is sheet(), passed in so a batch looks it up once. Returns whether the frame changed.
+	bool update(const SpriteSheet& s, float elapsed_s) {
+		current_frame_time += elapsed_s;
+		if (current_frame_time < s.frame_time)
+			return false;
+		current_frame_time = 0;
 
-	int getRow() const override {
-		int state_off = static_cast<int>(current_state) * 4;
-		return state_off + static_cast<int>(current_dir);
+		const SpriteSheetState& state = s.states[(int)current_state];
+		if (current_frame + 1 < state.frames) {
+			current_frame++;
+			return true;
+		}
+		switch (state.end) {
+		case AnimationEnd::LOOP:
+			current_frame = 0;
+			return true;
+		case AnimationEnd::HOLD:
+			current_frame = state.frames - 1;
+			return false;
+		case AnimationEnd::RETURN:
+			can_attack = false;
+			current_state = static_cast<State>(is_walking ? s.walk_state : s.idle_state);
+			current_frame = 0;
+			return true;
+		}
+		return false;
 	}
+};
 
+// Walking doesn't cut the player's actions short, it only turns the player until they end
+struct PlayerAnimation : SheetAnimation<SPRITE_SHEET_ID::PLAYER, AnimationState> {
 	void setState(AnimationState newState, Direction newDir) {
 
 		if (current_state == AnimationState::WALK && (newState == AnimationState::ATTACK || newState == AnimationState::BLOCK || newState == AnimationState::SECOND || newState == AnimationState::PROJ)) {
@@ -182,112 +227,14 @@ public:
 			}
 		}
 
-		if (newState != current_state || newDir != current_dir) {
-
-			current_state = newState;
-			current_dir = newDir;
-			current_frame = 0;
-			current_frame_time = 0;
-		}
-	}
-
-	void update(float elapsed_ms) override{
-		current_frame_time += elapsed_ms / 1000.f;
-
-		if (current_frame_time >= FRAME_TIME_PLAYER) {
-			current_frame_time = 0;
-			/*current_frame++;*/
-
-			if (!(current_state == AnimationState::DEAD && current_frame >= getMaxFrames() - 1)) {
-				current_frame++;
-			}
-
-			int max_frames = getMaxFrames();
-
-			if (current_state == AnimationState::ATTACK || current_state == AnimationState::BLOCK || current_state == AnimationState::SECOND || current_state == AnimationState::PROJ) {
-				if (current_frame >= max_frames) {
-					can_attack = false;
-					setState(is_walking ? AnimationState::WALK : AnimationState::IDLE, current_dir);
-				}
-			}
-			else if (current_frame >= max_frames) {
-				if (loop()) {
-					current_frame = 0;
-				}
-				else if (current_state != AnimationState::DEAD) {
-					setState(AnimationState::IDLE, current_dir);
-				}
-				else {
-					current_frame = max_frames - 1;
-				}
-			}
-		}
+		SheetAnimation::setState(newState, newDir);
 	}
 };
 
-class RobotAnimation : public BaseAnimation {
-
-public:
-	RobotAnimation(int sprite_size = 64, int s_width = 640, int s_height = 1280)
-		: BaseAnimation(sprite_size, s_width, s_height) {}
-
-
-	RobotState current_state = RobotState::IDLE;
-	Direction current_dir = Direction::RIGHT;
-	bool is_moving = false;
-
-	int getMaxFrames() const override {
-		switch (current_state) {
-		case RobotState::WALK: return 7;
-		case RobotState::IDLE: return 4;
-		case RobotState::DEAD: return 8;
-		case RobotState::HURT: return 3;
-		case RobotState::ATTACK: return 10;
-
-		default: return 0;
-		}
-	}
-
-	bool loop() const override {
-		return current_state == RobotState::WALK;
-	}
-
-	int getRow() const override {
-		int state_off = static_cast<int>(current_state) * 4;
-		int dir_off = static_cast<int>(current_dir);
-		int row = state_off + dir_off;
-
-		return row;
-	}
-
-	void setState(RobotState newState, Direction newDir) {
-		if (newState != current_state || newDir != current_dir) {
-			current_state = newState;
-			current_dir = newDir;
-			current_frame = 0;
-			current_frame_time = 0;
-		}
-	}
-
-	void update(float elapsed_ms) override {
-		current_frame_time += elapsed_ms / 1000.f;
-		if (current_frame_time >= FRAME_TIME) {
-			current_frame_time = 0;
-			current_frame++;
-			//std::cout << current_frame << std::endl;
-			int max_frames = getMaxFrames();
-			
-			if (current_frame >= max_frames) {
-				if (loop()) {
-					current_frame = 0;
-				}
-				else {
-					current_frame = max_frames - 1;
-				}
-			}
-		}
-	}
-};
+typedef SheetAnimation<SPRITE_SHEET_ID::ROBOT, RobotState> RobotAnimation;
+typedef SheetAnimation<SPRITE_SHEET_ID::ICE_ROBOT, IceRobotState> IceRobotAnimation;
+typedef SheetAnimation<SPRITE_SHEET_ID::BOSS_ROBOT, BossRobotState> BossRobotAnimation;
+typedef SheetAnimation<SPRITE_SHEET_ID::SPIDER_ROBOT, SpiderRobotState> SpiderRobotAnimation;
 
 enum class TutorialState {
 	INTRO,
@@ -304,187 +251,6 @@ enum class TutorialState {
 	COMPLETED
 };
 
-enum class IceRobotState {
-	WALK = 0,
-	ATTACK = 1,
-	IDLE = 2,
-	DEAD = 3
-};
-
-class IceRobotAnimation : public BaseAnimation {
-
-public:
-	IceRobotAnimation(int sprite_size = 64, int s_width = 832, int s_height = 1024)
-		: BaseAnimation(sprite_size, s_width, s_height) {}
-
-
-	IceRobotState current_state = IceRobotState::IDLE;
-	Direction current_dir = Direction::RIGHT;
-	bool is_moving = false;
-
-	int getMaxFrames() const override {
-		switch (current_state) {
-		case IceRobotState::WALK: return 9;
-		case IceRobotState::IDLE: return 5;
-		case IceRobotState::DEAD: return 5;
-		case IceRobotState::ATTACK: return 13;
-
-		default: return 0;
-		}
-	}
-
-	bool loop() const override {
-		return current_state == IceRobotState::WALK;
-	}
-
-	int getRow() const override {
-		int state_off = static_cast<int>(current_state) * 4;
-		int dir_off = static_cast<int>(current_dir);
-		int row = state_off + dir_off;
-
-		return row;
-	}
-
-	void setState(IceRobotState newState, Direction newDir) {
-		if (newState != current_state || newDir != current_dir) {
-			current_state = newState;
-			current_dir = newDir;
-			current_frame = 0;
-			current_frame_time = 0;
-		}
-	}
-
-	void update(float elapsed_ms) override {
-		current_frame_time += elapsed_ms / 1000.f;
-		if (current_frame_time >= FRAME_TIME) {
-			current_frame_time = 0;
-			current_frame++;
-			//std::cout << current_frame << std::endl;
-			int max_frames = getMaxFrames();
-
-			if (current_frame >= max_frames) {
-				if (loop()) {
-					current_frame = 0;
-				}
-				else {
-					current_frame = max_frames - 1;
-				}
-			}
-		}
-	}
-};
-
-class BossRobotAnimation : public BaseAnimation {
-public:
-    BossRobotAnimation(int sprite_size = 128, int s_width = 1792, int s_height = 384)
-        : BaseAnimation(sprite_size, s_width, s_height) {}
-
-    BossRobotState current_state = BossRobotState::IDLE;
-    Direction current_dir = Direction::RIGHT;
-
-    int getMaxFrames() const override {
-        switch (current_state) {
-            case BossRobotState::ATTACK: return 14;
-			case BossRobotState::WALK: return 12;
-            case BossRobotState::IDLE: return 10;
-            default: return 0;
-        }
-    }
-
-    bool loop() const override {
-        return current_state == BossRobotState::WALK || current_state == BossRobotState::IDLE || current_state == BossRobotState::ATTACK;
-    }
-
-    int getRow() const override {
-        //int state_off = static_cast<int>(current_state) * 4;
-        //int dir_off = static_cast<int>(current_dir);
-        //return state_off + dir_off;
-		return static_cast<int>(current_state);
-    }
-
-    void setState(BossRobotState newState, Direction newDir) {
-        if (newState != current_state /* || newDir != current_dir*/) {
-            current_state = newState;
-            current_dir = newDir;
-            current_frame = 0;
-            current_frame_time = 0;
-        }
-    }
-
-    void update(float elapsed_ms) override {
-        current_frame_time += elapsed_ms / 1000.f;
-        if (current_frame_time >= FRAME_TIME_ROBOT) {
-            current_frame_time = 0;
-            current_frame++;
-
-            int max_frames = getMaxFrames();
-            if (current_frame >= max_frames) {
-                if (loop()) {
-                    current_frame = 0;
-                } else {
-                    current_frame = max_frames - 1;
-                }
-            }
-        }
-    }
-};
-
-class SpiderRobotAnimation : public BaseAnimation {
-public:
-	SpiderRobotAnimation(int sprite_size = 16, int s_width = 104, int s_height = 88)
-		: BaseAnimation(sprite_size, s_width, s_height) {}
-
-	SpiderRobotState current_state = SpiderRobotState::IDLE;
-	Direction current_dir = Direction::DOWN;
-
-	int getMaxFrames() const override {
-		switch (current_state) {
-		case SpiderRobotState::ATTACK: return 4;
-		case SpiderRobotState::WALK: return 4;
-		case SpiderRobotState::IDLE: return 1;
-		default: return 0;
-		}
-	}
-
-	bool loop() const override {
-		return current_state == SpiderRobotState::WALK || current_state == SpiderRobotState::IDLE || current_state == SpiderRobotState::ATTACK;
-	}
-
-	int getRow() const override {
-		int state_off = static_cast<int>(current_state) * 4;
-		int dir_off = static_cast<int>(current_dir);
-		return state_off + dir_off;
-	}
-
-	void setState(SpiderRobotState newState, Direction newDir) {
-		if (newState != current_state || newDir != current_dir) {
-			current_state = newState;
-			current_dir = newDir;
-			current_frame = 0;
-			current_frame_time = 0;
-		}
-	}
-
-	void update(float elapsed_ms) override {
-		current_frame_time += elapsed_ms / 1000.f;
-		if (current_frame_time >= FRAME_TIME) {
-			current_frame_time = 0;
-			current_frame++;
-
-			int max_frames = getMaxFrames();
-			if (current_frame >= max_frames) {
-				if (loop()) {
-					current_frame = 0;
-				}
-				else {
-					current_frame = max_frames - 1;
-				}
-			}
-		}
-	}
-};
-
-
 class DoorAnimation {
 public:
 	static constexpr float FRAME_TIME = 0.2f;
@@ -538,13 +304,6 @@ struct Door {
 	bool notification_active;
 };
 
-struct Particle {
-	float lifetime = 0.f;
-	float max_lifetime = 3.0f;
-	float opacity = 1.f;
-	float size = 15.f;
-};
-
 
 // Player component
 struct Player
@@ -598,6 +357,16 @@ struct Robot
 	std::vector<Item> disassembleItems;
 };
 
+// The boss's volley and dash cycle, advanced by its think step
+struct BossAttack
+{
+	// seconds since the last volley
+	float shoot_timer = 0.f;
+	// volleys since the last dash
+	int volleys = 0;
+	// seconds into the dash while above 0
+	float dash_timer = 0.f;
+};
 struct BossRobot
 {
 	// remember change back 200
@@ -609,6 +378,7 @@ struct BossRobot
 	vec2 search_box;
 	vec2 attack_box;
 	vec2 panic_box;
+	BossAttack attack;
 };
 struct SpiderRobot
 {
@@ -623,20 +393,6 @@ struct SpiderRobot
 	vec2 panic_box;
 };
 
-struct projectile {
-	int dmg = 0;
-	bool ice;
-	bool friendly = false;
-};
-
-struct bossProjectile {
-	int dmg = 0;
-	float amplitude = 0.0f;
-    float frequency = 1.0f;
-    float time = 0.0f; 
-    bool has_bounced = false;
-};
-
 struct Key
 {
 
@@ -686,8 +442,34 @@ struct Character {
 	glm::ivec2   bearing;    // Offset from baseline to left/top of glyph
 	unsigned int advance;    // Offset to advance to next glyph
 	char character;
+	vec2 atlas_top_left;     // Where the glyph is in the glyph atlas
+	vec2 atlas_bottom_right;
+};
+
+
+// Collision layers, every entity that takes part in contacts is on exactly one
+enum CollisionLayer : uint32_t {
+	LAYER_NONE = 0,
+	LAYER_PLAYER = 1 << 0,
+	LAYER_ENEMY = 1 << 1,
+	LAYER_COMPANION = 1 << 2,
+	LAYER_PROJECTILE_FRIENDLY = 1 << 3,
+	LAYER_PROJECTILE_HOSTILE = 1 << 4,
+	LAYER_PICKUP = 1 << 5,
+	LAYER_DOOR = 1 << 6,
+	LAYER_STATIC = 1 << 7
+};
+
+// Which pairs the physics step tests for contacts. A pair is tested when either side's
+// mask has the other's layer, entities on LAYER_NONE are never tested.
+struct CollisionFilter {
+	uint32_t layer = LAYER_NONE;
+	uint32_t mask = 0;
 };
 
+inline bool filters_collide(const CollisionFilter& a, const CollisionFilter& b) {
+	return (a.mask & b.layer) != 0 || (b.mask & a.layer) != 0;
+}
 
 // All data relevant to the shape and motion of entities
 struct Motion {
@@ -707,14 +489,6 @@ struct Motion {
 	vec2 bb = vec2(0);
 };
 
-// Stucture to store collision information
-struct Collision
-{
-	// Note, the first object is stored in the ECS container.entities
-	Entity other; // the second object involved in the collision
-	Collision(Entity& other) { this->other = other; };
-};
-
 // Data structure for toggling debug mode
 struct Debug {
 	bool in_debug_mode = 0;
@@ -967,7 +741,9 @@ enum class EFFECT_ASSET_ID {
 	BOX = SCREEN + 1,
 	FONT = BOX + 1,
 	SPACESHIP = FONT + 1,
-	EFFECT_COUNT = SPACESHIP + 1
+	PARTICLE = SPACESHIP + 1,
+	UI = PARTICLE + 1,
+	EFFECT_COUNT = UI + 1
 };
 const int effect_count = (int)EFFECT_ASSET_ID::EFFECT_COUNT;
 
@@ -1004,12 +780,8 @@ void to_json(json& j, const Motion& motion);
 void from_json(const json& j, Motion& motion);
 void to_json(json& j, const DeathTimer& timer);
 void from_json(const json& j, DeathTimer& timer);
-void to_json(json& j, const Collision& collision);
-void from_json(const json& j, Collision& collision);
 void to_json(json& j, const Player& player);
 void from_json(const json& j, Player& player);
-void to_json(json& j, const BaseAnimation& anim);
-void from_json(const json& j, BaseAnimation& anim);
 void to_json(json& j, const RobotAnimation& anim);
 void from_json(const json& j, RobotAnimation& anim);
 void to_json(json& j, const PlayerAnimation& anim);
@@ -1069,14 +841,10 @@ void to_json(json& j, const T_map& t_map);
 void from_json(const json& j, T_map& t_map);
 void to_json(json& j, const Spaceship& ap);
 void from_json(const json& j, Spaceship& ap);
-void to_json(nlohmann::json& j, const projectile& p);
-void from_json(const nlohmann::json& j, projectile& p);
 void to_json(json& j, const IceRobotAnimation& animation);
 void from_json(const json& j, IceRobotAnimation& animation);
 void to_json(json& j, const BossRobotAnimation& animation);
 void from_json(const json& j, BossRobotAnimation& animation);
-void to_json(json& j, const bossProjectile& projectile);
-void from_json(const json& j, bossProjectile& projectile);
 void to_json(json& j, const BossRobot& robot);
 void from_json(const json& j, BossRobot& robot);
 void to_json(json& j, const Door& door);
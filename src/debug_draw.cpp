@@ -0,0 +1,94 @@
+#include "debug_draw.hpp"
+#include "components.hpp"
+
+// stlib
+#include <cmath>
+
+DebugDraw debug_draw;
+
+// Indexed by DEBUG_CATEGORY
+static const char* category_names[debug_category_count] = {
+	"bounding boxes",
+	"reaction boxes",
+	"pathfinding",
+	"chunks",
+};
+
+const char* debug_category_name(DEBUG_CATEGORY category) {
+	return category_names[(int)category];
+}
+
+void debug_line(std::vector<DebugVertex>& out, vec2 from, vec2 to, vec3 color) {
+	out.push_back({ from, color });
+	out.push_back({ to, color });
+}
+
+void debug_rect(std::vector<DebugVertex>& out, vec2 center, vec2 size, vec3 color) {
+	vec2 half = abs(size) / 2.f;
+	vec2 top_left = center - half;
+	vec2 top_right = center + vec2(half.x, -half.y);
+	vec2 bottom_right = center + half;
+	vec2 bottom_left = center + vec2(-half.x, half.y);
+	debug_line(out, top_left, top_right, color);
+	debug_line(out, top_right, bottom_right, color);
+	debug_line(out, bottom_right, bottom_left, color);
+	debug_line(out, bottom_left, top_left, color);
+}
+
+void debug_circle(std::vector<DebugVertex>& out, vec2 center, float radius, vec3 color, int segments) {
+	vec2 previous = center + vec2(radius, 0.f);
+	for (int i = 1; i <= segments; i++) {
+		float angle = 2.f * (float)M_PI * i / segments;
+		vec2 next = center + radius * vec2(cos(angle), sin(angle));
+		debug_line(out, previous, next, color);
+		previous = next;
+	}
+}
+
+bool DebugDraw::enabled(DEBUG_CATEGORY category) const {
+	return debugging.in_debug_mode && (enabled_categories & (1u << (int)category));
+}
+
+bool DebugDraw::toggle(DEBUG_CATEGORY category) {
+	enabled_categories ^= 1u << (int)category;
+	return (enabled_categories & (1u << (int)category)) != 0;
+}
+
+void DebugDraw::line(DEBUG_CATEGORY category, vec2 from, vec2 to, vec3 color) {
+	if (!enabled(category))
+		return;
+	std::lock_guard<std::mutex> lock(mutex);
+	debug_line(vertices, from, to, color);
+}
+
+void DebugDraw::rect(DEBUG_CATEGORY category, vec2 center, vec2 size, vec3 color) {
+	if (!enabled(category))
+		return;
+	std::lock_guard<std::mutex> lock(mutex);
+	debug_rect(vertices, center, size, color);
+}
+
+void DebugDraw::circle(DEBUG_CATEGORY category, vec2 center, float radius, vec3 color) {
+	if (!enabled(category))
+		return;
+	std::lock_guard<std::mutex> lock(mutex);
+	debug_circle(vertices, center, radius, color);
+}
+
+void DebugDraw::polyline(DEBUG_CATEGORY category, const std::vector<vec2>& points, vec3 color) {
+	if (!enabled(category))
+		return;
+	std::lock_guard<std::mutex> lock(mutex);
+	for (size_t i = 1; i < points.size(); i++)
+		debug_line(vertices, points[i - 1], points[i], color);
+}
+
+void DebugDraw::clear() {
+	std::lock_guard<std::mutex> lock(mutex);
+	vertices.clear();
+}
+
+void DebugDraw::copy_to(std::vector<DebugVertex>& out) const {
+	std::lock_guard<std::mutex> lock(mutex);
+	out.insert(out.end(), vertices.begin(), vertices.end());
+}
@@ -0,0 +1,63 @@
+#pragma once
+
+// stlib
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+// internal
+#include "common.hpp"
+
+// What a debug shape shows, each can be switched off on its own
+enum class DEBUG_CATEGORY {
+	BOUNDING_BOX = 0,
+	REACTION_BOX = BOUNDING_BOX + 1, // robot search, attack and panic ranges
+	PATHFINDING = REACTION_BOX + 1,
+	CHUNKS = PATHFINDING + 1,
+	CATEGORY_COUNT = CHUNKS + 1
+};
+const int debug_category_count = (int)DEBUG_CATEGORY::CATEGORY_COUNT;
+
+const char* debug_category_name(DEBUG_CATEGORY category);
+
+// One end of a debug line, in world coordinates
+struct DebugVertex {
+	vec2 position;
+	vec3 color;
+};
+
+// Shapes as line segments, two vertices each, appended to out
+void debug_line(std::vector<DebugVertex>& out, vec2 from, vec2 to, vec3 color);
+void debug_rect(std::vector<DebugVertex>& out, vec2 center, vec2 size, vec3 color);
+void debug_circle(std::vector<DebugVertex>& out, vec2 center, float radius, vec3 color, int segments = 16);
+
+// Collects the debug shapes of a simulation step from any system, the renderer copies
+// them into its packet and draws them all as one GL_LINES call on top of the world.
+// Shapes are only kept in debug mode and for enabled categories, so the calls cost a
+// branch otherwise. Recording may happen on job system workers, it takes a lock.
+class DebugDraw
+{
+public:
+	// Whether shapes of the category are kept right now
+	bool enabled(DEBUG_CATEGORY category) const;
+	// Returns whether the category is on now
+	bool toggle(DEBUG_CATEGORY category);
+
+	void line(DEBUG_CATEGORY category, vec2 from, vec2 to, vec3 color);
+	void rect(DEBUG_CATEGORY category, vec2 center, vec2 size, vec3 color);
+	void circle(DEBUG_CATEGORY category, vec2 center, float radius, vec3 color);
+	// Lines through the points in order
+	void polyline(DEBUG_CATEGORY category, const std::vector<vec2>& points, vec3 color);
+
+	// Drops the shapes of the last step, called before the systems step
+	void clear();
+	// Appends the shapes of this step
+	void copy_to(std::vector<DebugVertex>& out) const;
+
+private:
+	uint32_t enabled_categories = (1u << debug_category_count) - 1;
+	std::vector<DebugVertex> vertices;
+	mutable std::mutex mutex;
+};
+
+extern DebugDraw debug_draw;
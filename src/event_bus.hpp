@@ -0,0 +1,81 @@
+#pragma once
+
+// stlib
+#include <cstdint>
+#include <vector>
+
+// internal
+#include "projectile_system.hpp"
+#include "tiny_ecs.hpp"
+
+// Two entities touched this step, reported once per pair by the physics system.
+// The layers are their CollisionLayer when the pair was tested.
+struct ContactEvent {
+	Entity entity;
+	Entity other;
+	uint32_t entity_layer;
+	uint32_t other_layer;
+};
+
+// A projectile touched something it may hurt, reported by the projectile system
+struct ProjectileHitEvent {
+	ProjectileHandle projectile;
+	Entity target;
+};
+
+// Health lost by a player, robot or boss
+struct DamageEvent {
+	Entity target;
+	float amount;
+	// players only: the armor stat soaks it up first
+	bool armor;
+	// bosses only: removed outright instead of playing their death
+	bool remove_on_death;
+};
+
+// The player stands on something the pickup key would take
+struct PickupEvent {
+	Entity item;
+	ItemId item_id;
+};
+
+// All event types: X(type, queue member). Handlers go through them in this order,
+// so an event type may only emit events of the types after it.
+#define EVENT_LIST(X) \
+	X(ContactEvent, contacts) \
+	X(ProjectileHitEvent, projectile_hits) \
+	X(DamageEvent, damages) \
+	X(PickupEvent, pickups)
+
+// Events of one simulation step, with an array per event type so a handler walks one
+// homogeneous array at a time. The arrays keep their capacity when cleared, so once
+// warmed up a frame's events cost no allocations.
+// Events hold entities by value: a handler checks the entity still has the components
+// it needs, an earlier event may have removed it.
+class EventBus
+{
+public:
+	template <typename Event>
+	void emit(const Event& event) { queue<Event>().push_back(event); }
+
+	template <typename Event>
+	std::vector<Event>& queue();
+
+	// Drops the events of this step
+	void clear()
+	{
+#define EVENT_CLEAR_QUEUE(type, name) name.clear();
+		EVENT_LIST(EVENT_CLEAR_QUEUE)
+#undef EVENT_CLEAR_QUEUE
+	}
+
+private:
+#define EVENT_DECLARE_QUEUE(type, name) std::vector<type> name;
+	EVENT_LIST(EVENT_DECLARE_QUEUE)
+#undef EVENT_DECLARE_QUEUE
+};
+
+#define EVENT_QUEUE_ACCESSOR(type, name) \
+	template <> inline std::vector<type>& EventBus::queue<type>() { return name; }
+EVENT_LIST(EVENT_QUEUE_ACCESSOR)
+#undef EVENT_QUEUE_ACCESSOR
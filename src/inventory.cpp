@@ -7,51 +7,79 @@ Inventory::Inventory(int rows, int columns, glm::vec2 slotSize)
     slots.resize(rows * columns + 2);  // +2 for armor and weapon slots
     slots[slots.size() - 2].type = InventorySlotType::ARMOR;   // Second last slot as Armor slot
     slots.back().type = InventorySlotType::WEAPON;             // Last slot as Weapon slot
+    slotHints.fill(-1);
 }
-const std::vector<Item> Inventory::disassembleItems = {
-     {"Energy Core", 1},
-    {"Robot Parts", 1},
-    {"Teleporter", 1},
-    {"ArmorPlate", 1}
-};
-// Add item to inventory, increase quantity if it already exists
-void Inventory::addItem(const std::string& itemName, int quantity) {
 
-    for (auto& slot : slots) {
-        if (slot.item.name == itemName && !slot.item.isRobotCompanion) {
-            slot.item.quantity += quantity;
-            return;
+// Indexed by ItemId, names are the ones older saves used
+const std::array<ItemDef, item_count> item_defs = { {
+    // name              texture                               disassembly
+    { "",               TEXTURE_ASSET_ID::TEXTURE_COUNT,       0, 0 }, // NONE
+    { "Key",            TEXTURE_ASSET_ID::KEY,                 0, 0 },
+    { "ArmorPlate",     TEXTURE_ASSET_ID::ARMORPLATE,          1, 1 },
+    { "HealthPotion",   TEXTURE_ASSET_ID::HEALTHPOTION,        0, 0 },
+    { "CompanionRobot", TEXTURE_ASSET_ID::COMPANION_CROCKBOT,  0, 0 },
+    { "IceRobot",       TEXTURE_ASSET_ID::ICE_ROBOT,           0, 0 },
+    { "Energy Core",    TEXTURE_ASSET_ID::ENERGY_CORE,         1, 1 },
+    { "Robot Parts",    TEXTURE_ASSET_ID::ROBOT_PART,          1, 3 },
+    { "Teleporter",     TEXTURE_ASSET_ID::TELEPORTER,          1, 3 },
+} };
+
+ItemId item_id_from_name(const std::string& name) {
+    for (int i = 1; i < item_count; i++) {
+        if (name == item_defs[i].name)
+            return (ItemId)i;
+    }
+    return ItemId::NONE;
+}
+
+int Inventory::findSlot(ItemId id) const {
+    if (id == ItemId::NONE)
+        return -1;
+    int hint = slotHints[(int)id];
+    if (hint >= 0 && hint < (int)slots.size() && slots[hint].item.id == id)
+        return hint;
+    for (int i = 0; i < (int)slots.size(); i++) {
+        if (slots[i].item.id == id) {
+            slotHints[(int)id] = i;
+            return i;
         }
     }
-    for (auto& slot : slots) {
-        if (slot.item.name.empty()) {
-            slot.item = Item(itemName, quantity);
+    return -1;
+}
+
+// Add item to inventory, increase quantity if it already exists
+void Inventory::addItem(ItemId id, int quantity) {
+    int found = findSlot(id);
+    if (found >= 0) {
+        Item& item = slots[found].item;
+        if (!item.isRobotCompanion) {
+            item.quantity += quantity;
             return;
         }
     }
-}
-bool Inventory::containsItem(const std::string& itemName)  {
-    for (const auto& slot : slots) {
-        if (slot.item.name == itemName) { // Assuming slot.item has a 'name' field
-            return true;
+    for (int i = 0; i < (int)slots.size(); i++) {
+        if (slots[i].item.empty()) {
+            slots[i].item = Item(id, quantity);
+            slotHints[(int)id] = i;
+            return;
         }
     }
-    return false;
 }
-void Inventory::addCompanionRobot(const std::string& name, int health, int damage, int speed) {
+
+void Inventory::addCompanionRobot(ItemId id, int health, int damage, int speed) {
     //// Check if the robot companion with the same name already exists
     //for (const auto& slot : slots) {
-    //    if (slot.item.isRobotCompanion && slot.item.name == name) {
-    //        std::cout << "Companion robot '" << name << "' already exists in the inventory!" << std::endl;
+    //    if (slot.item.isRobotCompanion && slot.item.id == id) {
+    //        std::cout << "Companion robot '" << item_def(id).name << "' already exists in the inventory!" << std::endl;
     //        return;
     //    }
     //}
 
     for (auto& slot : slots) {
-        if (slot.item.name.empty()) {
-            slot.item = Item(name, health, damage, speed);
+        if (slot.item.empty()) {
+            slot.item = Item(id, health, damage, speed);
             slot.item.isRobotCompanion = true; 
-            std::cout << "Companion robot '" << name << "' added to the inventory." << std::endl;
+            std::cout << "Companion robot '" << item_def(id).name << "' added to the inventory." << std::endl;
             return;
         }
     }
@@ -59,45 +87,37 @@ void Inventory::addCompanionRobot(const std::string& name, int health, int damag
     std::cout << "No empty slot available to add the companion robot!" << std::endl;
 }
 
-void Inventory::removeItem(const std::string& itemName, int quantity) {
-    for (size_t i = 0; i < slots.size(); ++i) {
-        InventorySlot& slot = slots[i];
-        if (slot.item.name == itemName) {
-            if (!slot.item.isRobotCompanion) {
-                slot.item.quantity -= quantity;
-                if (slot.item.quantity <= 0) {
-                    slot.item = Item();
-                    for (size_t j = i; j < slots.size() - 1; ++j) {
-                        slots[j].item = slots[j + 1].item;
-                    }
-                    slots.back().item = Item();
-                }
-            }
-            else {
-                // For robot companions, just remove the item
-                slot.item = Item();
-                for (size_t j = i; j < slots.size() - 1; ++j) {
-                    slots[j].item = slots[j + 1].item;
-                }
-                slots.back().item = Item(); 
-            }
+void Inventory::removeItem(ItemId id, int quantity) {
+    int found = findSlot(id);
+    if (found < 0)
+        return;
+    size_t i = (size_t)found;
+    InventorySlot& slot = slots[i];
+    if (!slot.item.isRobotCompanion) {
+        slot.item.quantity -= quantity;
+        if (slot.item.quantity > 0)
             return;
-        }
     }
+    // the slot is empty now, or held a robot companion which is removed whole
+    slot.item = Item();
+    for (size_t j = i; j < slots.size() - 1; ++j) {
+        slots[j].item = slots[j + 1].item;
+    }
+    slots.back().item = Item();
 }
 
 
 void Inventory::display() const {
     for (const auto& slot : slots) {
-        if (!slot.item.name.empty()) {
+        if (!slot.item.empty()) {
             if (slot.item.isRobotCompanion) {
-                std::cout << "Companion Robot: " << slot.item.name
+                std::cout << "Companion Robot: " << slot.item.name()
                     << ", Health: " << slot.item.health
                     << ", Damage: " << slot.item.damage
                     << ", Speed: " << slot.item.speed << std::endl;
             }
             else {
-                std::cout << slot.item.name << " x" << slot.item.quantity << std::endl;
+                std::cout << slot.item.name() << " x" << slot.item.quantity << std::endl;
             }
         }
     }
@@ -110,17 +130,6 @@ void Inventory::setSelectedSlot(int slot) {
     }
 }
 
-// Get all non-empty items in the inventory
-std::vector<Item> Inventory::getItems() const {
-    std::vector<Item> nonEmptyItems;
-    for (const auto& slot : slots) {
-        if (!slot.item.name.empty()) {
-            nonEmptyItems.push_back(slot.item);
-        }
-    }
-    return nonEmptyItems;
-}
-
 // Swap items between two slots
 void Inventory::swapItems(int draggedSlot, int targetSlot) {
     if (draggedSlot >= 0 && draggedSlot < static_cast<int>(slots.size()) &&
@@ -133,7 +142,7 @@ void Inventory::placeItemInSlot(int draggedSlotIndex, int targetSlotIndex) {
     // Check if dragged item is valid
     InventorySlot& draggedSlot = slots[draggedSlotIndex];
     Item draggedItem = draggedSlot.item;
-    if (draggedItem.name.empty() || draggedItem.quantity <= 0) {
+    if (draggedItem.empty() || draggedItem.quantity <= 0) {
         std::cerr << "No item to place in the target slot." << std::endl;
         return;
     }
@@ -144,17 +153,17 @@ void Inventory::placeItemInSlot(int draggedSlotIndex, int targetSlotIndex) {
     // Place in armor slot if target is armor
     if (targetSlotIndex == slots.size() - 2) {
         slots[slots.size() - 2].item = draggedItem;
-        std::cout << "Placed " << draggedItem.name << " in armor slot." << std::endl;
+        std::cout << "Placed " << draggedItem.name() << " in armor slot." << std::endl;
     }
     // Place in weapon slot if target is weapon
     else if (targetSlotIndex == slots.size() - 1) {
         slots.back().item = draggedItem;
-        std::cout << "Placed " << draggedItem.name << " in weapon slot." << std::endl;
+        std::cout << "Placed " << draggedItem.name() << " in weapon slot." << std::endl;
     }
     else {
         // Otherwise, place in the target slot
         slots[targetSlotIndex].item = draggedItem;
-        std::cout << "Placed " << draggedItem.name << " in slot index " << targetSlotIndex << "." << std::endl;
+        std::cout << "Placed " << draggedItem.name() << " in slot index " << targetSlotIndex << "." << std::endl;
     }
 }
 
@@ -169,18 +178,18 @@ InventorySlot& Inventory::getWeaponSlot() {
 }
 
 // Retrieve the armor item
-Item Inventory::getArmorItem() {
+Item Inventory::getArmorItem() const {
     return slots[slots.size() - 2].item;
 }
 
 // Retrieve the weapon item
-Item Inventory::getWeaponItem() {
+Item Inventory::getWeaponItem() const {
     return slots.back().item;
 }
 
 bool Inventory::isFull() {
     for (int i = 0; i < 10; ++i) { // Check slots 09
-        if (slots[i].item.name.empty()) {
+        if (slots[i].item.empty()) {
             return false; // Found an empty slot
         }
     }
@@ -190,7 +199,7 @@ bool Inventory::isFull() {
 //TODO: FIX JSON
 void to_json(json& j, const Item& item) {
     j = json{
-        {"name", item.name},
+        {"name", item.name()},
         {"quantity", item.quantity},
         {"isRobotCompanion", item.isRobotCompanion},
         { "health", item.health },
@@ -200,7 +209,7 @@ void to_json(json& j, const Item& item) {
 }
 
 void from_json(const json& j, Item& item) {
-    j.at("name").get_to(item.name);
+    item.id = item_id_from_name(j.at("name").get<std::string>());
     j.at("quantity").get_to(item.quantity);
     j.at("isRobotCompanion").get_to(item.isRobotCompanion);
     j.at("health").get_to(item.health);
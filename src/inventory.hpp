@@ -1,4 +1,6 @@
 #pragma once
+#include <array>
+#include <cstdint>
 #include <string>
 #include <vector>
 #include <iostream>
@@ -9,8 +11,41 @@ using json = nlohmann::json;
 
 enum class InventorySlotType { GENERAL, ARMOR, WEAPON };
 
+// defined in components.hpp, which includes this file
+enum class TEXTURE_ASSET_ID;
+
+// Every kind of item, indexes item_defs. NONE is an empty slot.
+enum class ItemId : uint16_t {
+    NONE = 0,
+    KEY,
+    ARMOR_PLATE,
+    HEALTH_POTION,
+    COMPANION_ROBOT,
+    ICE_ROBOT,
+    ENERGY_CORE,
+    ROBOT_PARTS,
+    TELEPORTER,
+    ITEM_COUNT
+};
+const int item_count = (int)ItemId::ITEM_COUNT;
+
+struct ItemDef {
+    // shown to the player, and what saves store
+    const char* name;
+    TEXTURE_ASSET_ID texture;
+    // how many a disassembled robot may drop, 0 when it never does
+    int disassemble_min;
+    int disassemble_max;
+};
+
+extern const std::array<ItemDef, item_count> item_defs;
+
+inline const ItemDef& item_def(ItemId id) { return item_defs[(int)id]; }
+// Only for loading saves, NONE for a name no item has
+ItemId item_id_from_name(const std::string& name);
+
 struct Item {
-    std::string name;  // Name of the item
+    ItemId id = ItemId::NONE;
     int quantity = 1;       
     //companion robot stats
     bool isRobotCompanion = false; 
@@ -20,12 +55,15 @@ struct Item {
     Item() = default;
 
     // Constructor for regular items
-    Item(const std::string& name, int quantity = 1)
-        : name(name), quantity(quantity), isRobotCompanion(false) {}
+    Item(ItemId id, int quantity = 1)
+        : id(id), quantity(quantity), isRobotCompanion(false) {}
 
     // Constructor for companion robots
-    Item(const std::string& name, int health, int damage, int speed)
-        : name(name), quantity(1), isRobotCompanion(true), health(health), damage(damage), speed(speed) {}
+    Item(ItemId id, int health, int damage, int speed)
+        : id(id), quantity(1), isRobotCompanion(true), health(health), damage(damage), speed(speed) {}
+
+    bool empty() const { return id == ItemId::NONE; }
+    const char* name() const { return item_def(id).name; }
 };
 
 struct InventorySlot {
@@ -39,10 +77,10 @@ public:
     Inventory(int rows = 2, int columns = 5, glm::vec2 slotSize = glm::vec2(64.f, 64.f));
 
     // Add a specified quantity of an item
-    void addItem(const std::string& itemName, int quantity);
-    void Inventory::addCompanionRobot(const std::string& name, int health, int damage, int speed);
+    void addItem(ItemId id, int quantity);
+    void Inventory::addCompanionRobot(ItemId id, int health, int damage, int speed);
     // Remove a specified quantity of an item
-    void removeItem(const std::string& itemName, int quantity);
+    void removeItem(ItemId id, int quantity);
 
     // Display the contents of the inventory (in console for now)
     void display() const;
@@ -52,10 +90,9 @@ public:
 
     // Get the currently selected slot index
     int getSelectedSlot() const { return selectedSlot; }
-    bool Inventory::containsItem(const std::string& itemName);
-    // Get non-empty items
-    std::vector<Item> getItems() const;
-    static const std::vector<Item> disassembleItems;
+    bool Inventory::containsItem(ItemId id) const { return findSlot(id) >= 0; }
+    // Index of a slot holding the item, -1 if none does
+    int findSlot(ItemId id) const;
     // Swap item from dragged slot to target slot
     void swapItems(int draggedSlot, int targetSlot);
 
@@ -65,8 +102,8 @@ public:
     void placeItemInSlot(int draggedSlotIndex, int targetSlotIndex);
     InventorySlot& getArmorSlot();
     InventorySlot& getWeaponSlot();
-    Item getArmorItem();
-    Item getWeaponItem();
+    Item getArmorItem() const;
+    Item getWeaponItem() const;
     void moveItem(int fromSlot, int toSlot);
     bool Inventory::isFull();
     std::vector<InventorySlot> slots; // List of inventory slots
@@ -79,6 +116,9 @@ public:
 
 
 private:
+    // Slot each item was last found in. Anyone may rearrange slots, so a hint is
+    // checked before use and the slots are only scanned when it went stale.
+    mutable std::array<int, item_count> slotHints;
     int selectedSlot = 0;             // Index of the currently selected slot
     int rows;
     int columns;
@@ -0,0 +1,213 @@
+#include "job_system.hpp"
+
+// stlib
+#include <algorithm>
+#include <cstdio>
+
+JobSystem jobs;
+
+// queue of the worker running on this thread, -1 on the main thread
+static thread_local int worker_index = -1;
+
+JobSystem::~JobSystem()
+{
+	stop();
+}
+
+void JobSystem::start(unsigned int threads)
+{
+	if (running)
+		return;
+	if (threads == 0) {
+		unsigned int hardware = std::thread::hardware_concurrency();
+		threads = hardware > 1 ? hardware - 1 : 0;
+	}
+	running = true;
+	for (unsigned int i = 0; i < threads; i++)
+		queues.push_back(std::unique_ptr<WorkQueue>(new WorkQueue()));
+	for (unsigned int i = 0; i < threads; i++)
+		workers.push_back(std::thread(&JobSystem::worker_loop, this, (int)i));
+	printf("Job system running %u worker threads\n", threads);
+}
+
+void JobSystem::stop()
+{
+	{
+		std::lock_guard<std::mutex> lock(sleep_mutex);
+		if (!running)
+			return;
+		running = false;
+	}
+	sleep_cv.notify_all();
+	for (std::thread& worker : workers)
+		worker.join();
+	workers.clear();
+	queues.clear();
+}
+
+JobHandle JobSystem::submit(std::function<void()> work, const std::vector<JobHandle>& deps)
+{
+	JobHandle job = std::make_shared<Job>();
+	job->work = std::move(work);
+	for (const JobHandle& dep : deps) {
+		if (!dep)
+			continue;
+		std::lock_guard<std::mutex> lock(dep->mutex);
+		if (dep->done)
+			continue;
+		job->unfinished++;
+		dep->continuations.push_back(job);
+	}
+	// drop the submission guard, the last finishing dependency queues it otherwise
+	if (--job->unfinished == 0)
+		enqueue(job);
+	return job;
+}
+
+void JobSystem::enqueue(const JobHandle& job, int queue)
+{
+	if (queues.empty()) {
+		execute(job);
+		return;
+	}
+	if (queue < 0)
+		queue = worker_index >= 0 ? worker_index : (int)(next_queue++ % queues.size());
+	{
+		std::lock_guard<std::mutex> lock(queues[queue]->mutex);
+		queues[queue]->jobs.push_back(job);
+	}
+	queued++;
+	// taking the lock orders this against a worker that just found nothing and is about to sleep
+	{ std::lock_guard<std::mutex> lock(sleep_mutex); }
+	sleep_cv.notify_all();
+}
+
+void JobSystem::execute(const JobHandle& job)
+{
+	job->work();
+	job->work = nullptr;
+
+	std::vector<JobHandle> ready;
+	{
+		std::lock_guard<std::mutex> lock(job->mutex);
+		job->done = true;
+		ready.swap(job->continuations);
+	}
+	for (const JobHandle& next : ready) {
+		if (--next->unfinished == 0)
+			enqueue(next);
+	}
+	if (!queues.empty()) {
+		// wakes threads blocked in wait()
+		{ std::lock_guard<std::mutex> lock(sleep_mutex); }
+		sleep_cv.notify_all();
+	}
+}
+
+JobHandle JobSystem::take_job(int own)
+{
+	// own queue newest first, the data is likely still in cache
+	if (own >= 0) {
+		WorkQueue& queue = *queues[own];
+		std::lock_guard<std::mutex> lock(queue.mutex);
+		if (!queue.jobs.empty()) {
+			JobHandle job = std::move(queue.jobs.back());
+			queue.jobs.pop_back();
+			queued--;
+			return job;
+		}
+	}
+	if (deterministic)
+		return nullptr;
+
+	// steal the oldest job, it is the most likely to spawn more work
+	size_t count = queues.size();
+	size_t start = own >= 0 ? (size_t)own + 1 : 0;
+	for (size_t i = 0; i < count; i++) {
+		WorkQueue& queue = *queues[(start + i) % count];
+		std::lock_guard<std::mutex> lock(queue.mutex);
+		if (!queue.jobs.empty()) {
+			JobHandle job = std::move(queue.jobs.front());
+			queue.jobs.pop_front();
+			queued--;
+			return job;
+		}
+	}
+	return nullptr;
+}
+
+void JobSystem::worker_loop(int index)
+{
+	worker_index = index;
+	while (true) {
+		JobHandle job = take_job(index);
+		if (job) {
+			execute(job);
+			continue;
+		}
+		std::unique_lock<std::mutex> lock(sleep_mutex);
+		if (!running)
+			return;
+		// in deterministic mode a worker only cares about its own queue
+		sleep_cv.wait(lock, [&] {
+			if (!running)
+				return true;
+			if (!deterministic)
+				return queued > 0;
+			std::lock_guard<std::mutex> queue_lock(queues[index]->mutex);
+			return !queues[index]->jobs.empty();
+		});
+	}
+}
+
+void JobSystem::wait(const JobHandle& job)
+{
+	if (!job)
+		return;
+	while (!job->done) {
+		// help out instead of blocking, this is what keeps nested waits on workers from deadlocking
+		JobHandle other = take_job(worker_index);
+		if (other) {
+			execute(other);
+			continue;
+		}
+		std::unique_lock<std::mutex> lock(sleep_mutex);
+		sleep_cv.wait(lock, [&] { return job->done || (!deterministic && queued > 0); });
+	}
+}
+
+void JobSystem::wait_all(const std::vector<JobHandle>& jobs)
+{
+	for (const JobHandle& job : jobs)
+		wait(job);
+}
+
+void JobSystem::parallel_for(size_t count, size_t grain, const std::function<void(size_t, size_t)>& body)
+{
+	if (count == 0)
+		return;
+	if (grain == 0)
+		grain = 1;
+	if (queues.empty() || count <= grain) {
+		body(0, count);
+		return;
+	}
+
+	// a few ranges per worker lets stealing even out uneven items
+	size_t range = grain;
+	if (!deterministic)
+		range = std::max(grain, (count + queues.size() * 4 - 1) / (queues.size() * 4));
+
+	std::vector<JobHandle> ranges;
+	ranges.reserve((count + range - 1) / range);
+	for (size_t begin = 0; begin < count; begin += range) {
+		size_t end = std::min(count, begin + range);
+		JobHandle job = std::make_shared<Job>();
+		job->unfinished = 0;
+		job->work = [&body, begin, end] { body(begin, end); };
+		int queue = deterministic ? (int)(ranges.size() % queues.size()) : -1;
+		ranges.push_back(job);
+		enqueue(job, queue);
+	}
+	wait_all(ranges);
+}
@@ -0,0 +1,83 @@
+#pragma once
+
+// stlib
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// A unit of work. Only the job system touches the fields, callers hold a JobHandle.
+struct Job {
+	std::function<void()> work;
+	// dependencies still running, plus one while the job is being submitted
+	std::atomic<int> unfinished{ 1 };
+	std::atomic<bool> done{ false };
+	// guards continuations, and done against a dependent being added as it finishes
+	std::mutex mutex;
+	std::vector<std::shared_ptr<Job>> continuations;
+};
+using JobHandle = std::shared_ptr<Job>;
+
+// Fixed pool of worker threads, each with its own queue. A worker runs its own jobs
+// newest first and steals the oldest job of another worker when it runs dry.
+// Jobs only start once the jobs they depend on have finished.
+//
+// With no workers (one core, or start() never called) every job runs inline on the
+// submitting thread in submission order, which is also the fallback when debugging.
+//
+// Deterministic mode is for benchmarking: parallel_for splits ranges by grain alone,
+// range k always goes to worker k % workers and nothing is stolen, so the same input
+// gives the same partitioning and thread assignment on every run and machine.
+class JobSystem
+{
+public:
+	~JobSystem();
+
+	// threads = 0 uses one worker per hardware thread, minus the main thread
+	void start(unsigned int threads = 0);
+	void stop();
+
+	// only change while no jobs are in flight
+	void set_deterministic(bool enabled) { deterministic = enabled; }
+	bool is_deterministic() const { return deterministic; }
+	unsigned int worker_count() const { return (unsigned int)queues.size(); }
+
+	// Queues work once all of deps are done. Null handles in deps are ignored.
+	JobHandle submit(std::function<void()> work, const std::vector<JobHandle>& deps = {});
+
+	// Blocks until job is done, running queued jobs on this thread meanwhile
+	void wait(const JobHandle& job);
+	void wait_all(const std::vector<JobHandle>& jobs);
+
+	// Calls body(begin, end) over [0, count) split into ranges of at least grain items
+	// and returns once all of them ran. Ranges must not write to shared state.
+	void parallel_for(size_t count, size_t grain, const std::function<void(size_t, size_t)>& body);
+
+private:
+	struct WorkQueue {
+		std::mutex mutex;
+		std::deque<JobHandle> jobs;
+	};
+
+	void enqueue(const JobHandle& job, int queue = -1);
+	void execute(const JobHandle& job);
+	JobHandle take_job(int own);
+	void worker_loop(int index);
+
+	std::vector<std::unique_ptr<WorkQueue>> queues;
+	std::vector<std::thread> workers;
+	std::atomic<unsigned int> next_queue{ 0 };
+	// jobs sitting in queues, workers sleep while it is zero
+	std::atomic<int> queued{ 0 };
+	std::mutex sleep_mutex;
+	std::condition_variable sleep_cv;
+	bool running = false;
+	bool deterministic = false;
+};
+
+// Shared by the simulation systems, started in main
+extern JobSystem jobs;
@@ -12,7 +12,6 @@ std::vector<std::string> required_keys = {
     "attackBox",
     "DeathTimer",
     "IceAni",
-    "bossProjectile",
     "bossRobotAnimations",
     "bossRobots",
     "doorAnimations",
@@ -32,7 +31,6 @@ std::vector<std::string> required_keys = {
     "colors",
     "maps",
     "spaceships",
-    "projectile",
     "motion",
     "notifications",
     "spiderRobots",
@@ -67,7 +65,6 @@ void generate_json(const ECSRegistry& rej, const WorldSystem& wor)
     j["DeathTimer"] = rej.deathTimers;
     j["IceAni"] = rej.iceRobotAnimations;
 
-    j["bossProjectile"] = rej.bossProjectile;
     j["bossRobotAnimations"] = rej.bossRobotAnimations;
     j["bossRobots"] = rej.bossRobots;
     j["doorAnimations"] = rej.doorAnimations;
@@ -92,7 +89,6 @@ void generate_json(const ECSRegistry& rej, const WorldSystem& wor)
     j["maps"] = rej.maps;
 
     j["spaceships"] = rej.spaceships;
-    j["projectile"] = rej.projectile;
 
     j["motion"] = rej.motions;
     j["spiderRobots"] = rej.spiderRobots;
@@ -138,7 +134,6 @@ void load_json(ECSRegistry& rej, WorldSystem& wor) {
         from_json(j.at("radiations"), rej.radiations);
         from_json(j.at("boids"), rej.boids);
 
-        from_json(j.at("bossProjectile"), rej.bossProjectile);
         from_json(j.at("bossRobotAnimations"), rej.bossRobotAnimations);
         from_json(j.at("bossRobots"), rej.bossRobots);
         from_json(j.at("doors"), rej.doors);
@@ -156,9 +151,9 @@ void load_json(ECSRegistry& rej, WorldSystem& wor) {
         from_json(j.at("colors"), rej.colors);
         from_json(j.at("maps"), rej.maps);
         from_json(j.at("spaceships"), rej.spaceships);
-        from_json(j.at("projectile"), rej.projectile);
         from_json(j.at("motion"), rej.motions);
         from_json(j.at("spiderRobots"), rej.spiderRobots);
+        rej.rebuild_component_masks();
         std::cout << "JSON loaded successfully from " << s << std::endl;
     }
     else {
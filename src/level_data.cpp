@@ -0,0 +1,99 @@
+#include "level_data.hpp"
+
+// stlib
+#include <cstdio>
+#include <iostream>
+#include <utility>
+
+// Takes count records of size bytes off what is left of the file, so a corrupt count
+// fails here instead of resizing to whatever the header claims
+static bool take_bytes(size_t& remaining, size_t count, size_t size) {
+	if (count > remaining / size)
+		return false;
+	remaining -= count * size;
+	return true;
+}
+
+static bool read_table(FILE* file, size_t& remaining, std::vector<LevelEntry>& table, uint32_t count) {
+	if (!take_bytes(remaining, count, sizeof(LevelEntry)))
+		return false;
+	table.resize(count);
+	return count == 0 || fread(table.data(), sizeof(LevelEntry), count, file) == count;
+}
+
+static bool read_grid(FILE* file, size_t& remaining, LevelGrid& grid, int width, int height) {
+	if (!take_bytes(remaining, (size_t)width * height, sizeof(uint16_t)))
+		return false;
+	grid.resize(width, height);
+	return grid.tiles.empty() || fread(grid.tiles.data(), sizeof(uint16_t), grid.tiles.size(), file) == grid.tiles.size();
+}
+
+bool load_level_data(const std::string& path, LevelData& level) {
+	FILE* file = fopen(path.c_str(), "rb");
+	if (!file) {
+		std::cerr << "No level file at " << path << std::endl;
+		return false;
+	}
+
+	fseek(file, 0, SEEK_END);
+	long file_size = ftell(file);
+	fseek(file, 0, SEEK_SET);
+
+	// level stays as it was unless the whole file reads
+	LevelData loaded;
+	LevelFileHeader header;
+	bool ok = file_size >= (long)sizeof(header) && fread(&header, sizeof(header), 1, file) == 1;
+	size_t remaining = ok ? (size_t)file_size - sizeof(header) : 0;
+	if (ok && (header.magic != LEVEL_MAGIC || header.version != LEVEL_VERSION)) {
+		std::cerr << "Level file " << path << " has version " << header.version << ", expected " << LEVEL_VERSION << std::endl;
+		ok = false;
+	}
+	ok = ok && read_grid(file, remaining, loaded.base, header.width, header.height);
+	ok = ok && read_grid(file, remaining, loaded.obstacles, header.width, header.height);
+	ok = ok && read_table(file, remaining, loaded.spawns, header.spawn_count);
+	ok = ok && read_table(file, remaining, loaded.items, header.item_count);
+	ok = ok && read_table(file, remaining, loaded.doors, header.door_count);
+	fclose(file);
+
+	if (!ok) {
+		std::cerr << "Level file " << path << " is truncated or corrupt." << std::endl;
+		return false;
+	}
+	loaded.tile_size = header.tile_size;
+	loaded.atlas = header.atlas;
+	loaded.player_x = header.player_x;
+	loaded.player_y = header.player_y;
+	level = std::move(loaded);
+	return true;
+}
+
+bool save_level_data(const std::string& path, const LevelData& level) {
+	FILE* file = fopen(path.c_str(), "wb");
+	if (!file) {
+		std::cerr << "Failed to open " << path << " for writing." << std::endl;
+		return false;
+	}
+
+	LevelFileHeader header;
+	header.width = (uint16_t)level.base.width;
+	header.height = (uint16_t)level.base.height;
+	header.tile_size = (uint16_t)level.tile_size;
+	header.atlas = level.atlas;
+	header.player_x = level.player_x;
+	header.player_y = level.player_y;
+	header.spawn_count = (uint32_t)level.spawns.size();
+	header.item_count = (uint32_t)level.items.size();
+	header.door_count = (uint32_t)level.doors.size();
+
+	bool ok = fwrite(&header, sizeof(header), 1, file) == 1;
+	ok = ok && fwrite(level.base.tiles.data(), sizeof(uint16_t), level.base.tiles.size(), file) == level.base.tiles.size();
+	ok = ok && fwrite(level.obstacles.tiles.data(), sizeof(uint16_t), level.obstacles.tiles.size(), file) == level.obstacles.tiles.size();
+	ok = ok && fwrite(level.spawns.data(), sizeof(LevelEntry), level.spawns.size(), file) == level.spawns.size();
+	ok = ok && fwrite(level.items.data(), sizeof(LevelEntry), level.items.size(), file) == level.items.size();
+	ok = ok && fwrite(level.doors.data(), sizeof(LevelEntry), level.doors.size(), file) == level.doors.size();
+	ok = (fclose(file) == 0) && ok;
+
+	if (!ok)
+		std::cerr << "Failed to write level file " << path << std::endl;
+	return ok;
+}
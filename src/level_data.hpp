@@ -0,0 +1,96 @@
+#pragma once
+
+// stlib
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Binary level files under data/levels, generated by tools/export_levels.cpp.
+// Layout: LevelFileHeader, width*height uint16 base tiles, width*height uint16
+// obstacle tiles (0 = none), then the spawn, item and door tables as LevelEntry records.
+// Grids are row-major. Everything is little-endian, like the snapshots.
+const uint32_t LEVEL_MAGIC = 0x564C5345; // "ESLV"
+const uint32_t LEVEL_VERSION = 1;
+
+// Which tile atlas the tile ids index into
+enum class LevelAtlas : uint16_t {
+	OUTDOOR = 0, // TILE_ATLAS
+	INDOOR = 1   // TILE_ATLAS_LEVELS
+};
+
+enum class LevelEntityKind : uint16_t {
+	// spawn table
+	ROBOT = 1,
+	ICE_ROBOT,
+	SPIDER_ROBOT,
+	BOSS_ROBOT,
+	BAT_SWARM,
+	SPACESHIP,
+	// item table
+	POTION,
+	ARMOR_PLATE,
+	KEY,
+	// door table
+	RIGHT_DOOR,
+	BOTTOM_DOOR
+};
+
+// LevelEntry::flags
+const uint16_t LEVEL_ENTRY_CAPTURABLE = 1 << 0;
+
+struct LevelEntry {
+	LevelEntityKind kind = LevelEntityKind::ROBOT;
+	uint16_t flags = 0;
+	// size of a bat swarm, 1 otherwise
+	uint32_t count = 1;
+	// world position in pixels
+	float x = 0.f;
+	float y = 0.f;
+};
+
+struct LevelFileHeader {
+	uint32_t magic = LEVEL_MAGIC;
+	uint32_t version = LEVEL_VERSION;
+	uint16_t width = 0;
+	uint16_t height = 0;
+	uint16_t tile_size = 64;
+	LevelAtlas atlas = LevelAtlas::OUTDOOR;
+	float player_x = 0.f;
+	float player_y = 0.f;
+	uint32_t spawn_count = 0;
+	uint32_t item_count = 0;
+	uint32_t door_count = 0;
+};
+
+// Contiguous row-major grid of tile ids
+struct LevelGrid {
+	int width = 0;
+	int height = 0;
+	std::vector<uint16_t> tiles;
+
+	void resize(int w, int h) {
+		width = w;
+		height = h;
+		tiles.assign((size_t)w * h, 0);
+	}
+	bool in_bounds(int x, int y) const { return x >= 0 && y >= 0 && x < width && y < height; }
+	uint16_t at(int x, int y) const { return tiles[(size_t)y * width + x]; }
+	uint16_t& at(int x, int y) { return tiles[(size_t)y * width + x]; }
+};
+
+struct LevelData {
+	int tile_size = 64;
+	LevelAtlas atlas = LevelAtlas::OUTDOOR;
+	LevelGrid base;
+	LevelGrid obstacles;
+	float player_x = 0.f;
+	float player_y = 0.f;
+	std::vector<LevelEntry> spawns;
+	std::vector<LevelEntry> items;
+	std::vector<LevelEntry> doors;
+};
+
+// Each section is read straight into its grid or table, returns false and leaves level
+// untouched on a missing or bad file
+bool load_level_data(const std::string& path, LevelData& level);
+bool save_level_data(const std::string& path, const LevelData& level);
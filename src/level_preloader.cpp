@@ -0,0 +1,128 @@
+#include "level_preloader.hpp"
+
+// stlib
+#include <string>
+
+static void prepare_layer(PreparedLevel& out, const LevelGrid& grid, TEXTURE_ASSET_ID atlas, bool walkable) {
+	int tilesize = out.data.tile_size;
+	for (int y = 0; y < grid.height; y++) {
+		for (int x = 0; x < grid.width; x++) {
+			int tile_id = grid.at(x, y);
+			// 0 is an empty cell on the obstacle layer
+			if (!walkable && tile_id == 0)
+				continue;
+
+			PreparedTile prepared;
+			prepared.motion.position = { x * tilesize - (tilesize / 2) + tilesize, y * tilesize - (tilesize / 2) + tilesize };
+			prepared.motion.scale = { tilesize, -tilesize };
+			prepared.motion.bb = prepared.motion.scale;
+			prepared.tile.tileset_id = 0;
+			prepared.tile.tile_id = tile_id;
+			prepared.tile.walkable = walkable;
+			auto uv = out.tileset.tile_textures.find(tile_id);
+			prepared.tile.tile_data = uv != out.tileset.tile_textures.end() ? uv->second : TileData();
+			prepared.tile.atlas = atlas;
+			out.tiles.push_back(prepared);
+		}
+	}
+}
+
+bool prepare_level(int level, PreparedLevel& out) {
+	out.level = -1;
+	out.tiles.clear();
+	if (!load_level_data(data_path() + "/levels/level_" + std::to_string(level) + ".lvl", out.data))
+		return false;
+
+	out.tileset = TileSet();
+	out.tileset.initializeTileTextureMap(7, 52); // atlas size
+
+	TEXTURE_ASSET_ID atlas = out.data.atlas == LevelAtlas::INDOOR ? TEXTURE_ASSET_ID::TILE_ATLAS_LEVELS : TEXTURE_ASSET_ID::TILE_ATLAS;
+	out.tiles.reserve(out.data.base.tiles.size() + out.data.obstacles.tiles.size());
+	prepare_layer(out, out.data.base, atlas, true);
+	prepare_layer(out, out.data.obstacles, atlas, false);
+	out.level = level;
+	return true;
+}
+
+LevelPreloader::~LevelPreloader()
+{
+	stop();
+}
+
+void LevelPreloader::start()
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	if (running)
+		return;
+	running = true;
+	worker = std::thread(&LevelPreloader::worker_loop, this);
+}
+
+void LevelPreloader::stop()
+{
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		if (!running)
+			return;
+		running = false;
+	}
+	cv.notify_all();
+	if (worker.joinable())
+		worker.join();
+}
+
+void LevelPreloader::request(int level)
+{
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		if (!running || preparing == level || (has_ready && ready.level == level))
+			return;
+		requested = level;
+	}
+	cv.notify_all();
+}
+
+bool LevelPreloader::take(int level, PreparedLevel& out)
+{
+	std::unique_lock<std::mutex> lock(mutex);
+	cv.wait(lock, [&] { return preparing != level; });
+	// not started yet, the caller builds it now
+	if (requested == level)
+		requested = -1;
+	if (!has_ready || ready.level != level)
+		return false;
+	out = std::move(ready);
+	has_ready = false;
+	return true;
+}
+
+void LevelPreloader::worker_loop()
+{
+	while (true) {
+		int level;
+		{
+			std::unique_lock<std::mutex> lock(mutex);
+			cv.wait(lock, [this] { return requested >= 0 || !running; });
+			if (!running)
+				return;
+			level = requested;
+			requested = -1;
+			preparing = level;
+		}
+
+		// built outside the lock, then swapped in
+		PreparedLevel prepared;
+		bool ok = prepare_level(level, prepared);
+
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			if (ok) {
+				ready = std::move(prepared);
+				has_ready = true;
+				printf("Preloaded level %d (%zu tiles)\n", level, ready.tiles.size());
+			}
+			preparing = -1;
+		}
+		cv.notify_all();
+	}
+}
@@ -0,0 +1,60 @@
+#pragma once
+
+// stlib
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// internal
+#include "components.hpp"
+#include "level_data.hpp"
+
+// Components of one tile entity, ready to be inserted
+struct PreparedTile {
+	Motion motion;
+	Tile tile;
+};
+
+// Everything about a level that doesn't need the registry or GL, built off the game thread
+struct PreparedLevel {
+	int level = -1;
+	LevelData data;
+	TileSet tileset;
+	// base layer first, then the obstacles, in the order the entities are created
+	std::vector<PreparedTile> tiles;
+};
+
+// Reads the level file and builds its tile components. Touches no globals, so it is
+// safe to call from the preloader thread.
+bool prepare_level(int level, PreparedLevel& out);
+
+// Prepares the next level on a worker thread while the current one is played,
+// so a level transition only has to insert the prebuilt components.
+class LevelPreloader
+{
+public:
+	~LevelPreloader();
+
+	void start();
+	void stop();
+
+	// Queues a level for preparation, replacing a request the worker hasn't picked up yet
+	void request(int level);
+
+	// Hands over the level if it was prepared. Waits when the worker is still on it,
+	// finishing that is never slower than starting over on the game thread.
+	bool take(int level, PreparedLevel& out);
+
+private:
+	void worker_loop();
+
+	std::thread worker;
+	std::mutex mutex;
+	std::condition_variable cv;
+	bool running = false;
+	int requested = -1;
+	int preparing = -1;
+	bool has_ready = false;
+	PreparedLevel ready;
+};
@@ -11,6 +11,11 @@
 #include "world_system.hpp"
 
 #include "json.hpp"
+#include "snapshot.hpp"
+#include "autosave.hpp"
+#include "job_system.hpp"
+#include "render_thread.hpp"
+#include "audio_system.hpp"
 
 using Clock = std::chrono::high_resolution_clock;
 
@@ -31,11 +36,23 @@ int main()
 		return EXIT_FAILURE;
 	}
 
+	// simulation systems split their dense loops across the job system
+	jobs.start();
+
 	// initialize the main systems
 	renderer.init(window);
 	world.init(&renderer);
-	load_json(registry, world);
+	// the binary snapshot is the save format, data.json is only read to migrate older saves
+	uint32_t save_epoch = 0;
+	if (!load_snapshot(registry, world, snapshot_path(), &save_epoch))
+		load_json(registry, world);
 	renderer.player = world.get_player();
+
+	Autosaver autosaver;
+	autosaver.start(registry, save_epoch);
+	// from here on GL calls belong on the render thread
+	RenderThread render_thread;
+	render_thread.start(window, &renderer);
 	// variable timestep loop
 	auto t = Clock::now();
 	while (!world.is_over()) {
@@ -51,12 +68,28 @@ int main()
 
 
 		if (!renderer.isHelpVisible() && !world.uiScreenShown && !renderer.game_paused && !renderer.show_start_screen /*&& !renderer.playing_cutscene*/) {
+			// the systems record this step's debug shapes
+			debug_draw.clear();
 			world.step(elapsed_ms);
 			physics.step(elapsed_ms, &world);
 			world.handle_collisions();
+			// frame boundary, safe to capture the registry
+			autosaver.step(elapsed_ms, registry, world);
+			renderer.save_capture_ms = autosaver.last_capture_ms;
+			renderer.path_frame_stats = path_stats.last_frame;
 		}
-		renderer.draw();
+		// sounds of this frame, heard from the centre of the screen
+		audio.end_frame(renderer.getCameraPosition() + vec2(window_width_px, window_height_px) / 2.f);
+		renderer.stolen_voices = audio.stolen_voices;
+		renderer.dropped_sounds = audio.dropped_sounds;
+		render_thread.submit();
 	}
-	generate_json(registry, world);
+	render_thread.stop();
+	autosaver.stop();
+	autosaver.save_now(registry, world);
+	jobs.stop();
+	// readable export of the same state for debugging
+	if (debugging.in_debug_mode)
+		generate_json(registry, world);
 	return EXIT_SUCCESS;
 }
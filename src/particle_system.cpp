@@ -0,0 +1,143 @@
+#include "particle_system.hpp"
+
+// stlib
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+
+ParticleSystem particles;
+
+static float random_range(float lo, float hi) {
+	return lo + static_cast<float>(rand()) / RAND_MAX * (hi - lo);
+}
+
+int ParticleSystem::add_emitter(const ParticleEmitterDef& def, vec2 position) {
+	size_t index = emitters.size();
+	for (size_t i = 0; i < emitters.size(); i++) {
+		if (!emitters[i].active && emitters[i].count == 0) {
+			index = i;
+			break;
+		}
+	}
+	if (index == emitters.size())
+		emitters.emplace_back();
+
+	ParticleEmitter& e = emitters[index];
+	e.def = def;
+	e.position = position;
+	e.timer_ms = 0.f;
+	e.active = true;
+	e.head = 0;
+	e.count = 0;
+	e.capacity = 1;
+	while (e.capacity < (uint32_t)std::max(def.max_alive, 1))
+		e.capacity <<= 1;
+	for (std::vector<float>* array : { &e.x, &e.y, &e.vx, &e.vy, &e.age, &e.inv_lifetime, &e.size, &e.opacity, &e.scale, &e.alpha })
+		array->assign(e.capacity, 0.f);
+	return (int)index;
+}
+
+void ParticleSystem::move_emitter(int emitter, vec2 position) {
+	emitters[emitter].position = position;
+}
+
+void ParticleSystem::remove_emitter(int emitter) {
+	emitters[emitter].active = false;
+}
+
+void ParticleSystem::clear() {
+	emitters.clear();
+}
+
+void ParticleSystem::spawn(ParticleEmitter& e) {
+	const ParticleEmitterDef& def = e.def;
+	uint32_t mask = e.capacity - 1;
+	uint32_t max_alive = (uint32_t)std::max(def.max_alive, 1);
+	for (int n = 0; n < def.burst_count; n++) {
+		// full, the oldest makes room
+		if (e.count == max_alive) {
+			e.head = (e.head + 1) & mask;
+			e.count--;
+		}
+		uint32_t i = (e.head + e.count) & mask;
+		e.count++;
+
+		e.x[i] = e.position.x + random_range(def.offset_min.x, def.offset_max.x);
+		e.y[i] = e.position.y + random_range(def.offset_min.y, def.offset_max.y);
+		e.vx[i] = random_range(def.velocity_min.x, def.velocity_max.x);
+		e.vy[i] = random_range(def.velocity_min.y, def.velocity_max.y);
+		e.age[i] = 0.f;
+		e.inv_lifetime[i] = 1.f / random_range(def.lifetime_min, def.lifetime_max);
+		e.size[i] = random_range(def.size_min, def.size_max);
+		e.opacity[i] = random_range(def.opacity_min, def.opacity_max);
+		e.scale[i] = e.size[i];
+		e.alpha[i] = e.opacity[i];
+	}
+}
+
+// Plain loops over the arrays with the emitter's parameters hoisted, so the compiler can vectorize them
+void ParticleSystem::simulate(ParticleEmitter& e, float step_seconds, uint32_t begin, uint32_t end) {
+	const ParticleEmitterDef& def = e.def;
+	float* x = e.x.data();
+	float* y = e.y.data();
+	float* vx = e.vx.data();
+	float* vy = e.vy.data();
+	float* age = e.age.data();
+	const float* inv_lifetime = e.inv_lifetime.data();
+	const float* size = e.size.data();
+	const float* opacity = e.opacity.data();
+	float* scale = e.scale.data();
+	float* alpha = e.alpha.data();
+
+	for (uint32_t i = begin; i < end; i++) {
+		age[i] += step_seconds;
+		float life = std::min(age[i] * inv_lifetime[i], 1.f);
+
+		vy[i] -= (def.rise + life * def.rise_growth) * step_seconds;
+		vx[i] += sin(age[i] * def.wiggle_frequency) * (def.wiggle + life * def.wiggle_growth) * step_seconds;
+		vx[i] *= def.drag;
+		vy[i] *= def.drag;
+		x[i] += vx[i] * step_seconds;
+		y[i] += vy[i] * step_seconds;
+
+		scale[i] = size[i] * (1.f + life * def.size_growth);
+		// dead particles end at zero, they are skipped when drawing
+		float alive = life < 1.f ? 1.f : 0.f;
+		alpha[i] = std::max(0.f, opacity[i] * (1.f - def.fade * life * life)) * alive;
+	}
+}
+
+void ParticleSystem::update(float elapsed_ms) {
+	float step_seconds = elapsed_ms / 1000.f;
+	for (ParticleEmitter& e : emitters) {
+		if (e.active) {
+			e.timer_ms += elapsed_ms;
+			if (e.timer_ms >= e.def.interval_ms) {
+				spawn(e);
+				e.timer_ms = 0.f;
+			}
+		}
+
+		// the ring is at most two stretches of the arrays
+		uint32_t first_end = std::min(e.head + e.count, e.capacity);
+		simulate(e, step_seconds, e.head, first_end);
+		simulate(e, step_seconds, 0, e.head + e.count - first_end);
+
+		uint32_t mask = e.capacity - 1;
+		while (e.count > 0 && e.age[e.head] * e.inv_lifetime[e.head] >= 1.f) {
+			e.head = (e.head + 1) & mask;
+			e.count--;
+		}
+	}
+}
+
+void ParticleSystem::append_instances(size_t emitter, vec2 camera_position, std::vector<ParticleInstance>& out) const {
+	const ParticleEmitter& e = emitters[emitter];
+	uint32_t mask = e.capacity - 1;
+	for (uint32_t n = 0; n < e.count; n++) {
+		uint32_t i = (e.head + n) & mask;
+		if (e.alpha[i] <= 0.f)
+			continue;
+		out.push_back({ vec2(e.x[i], e.y[i]) - camera_position, e.scale[i], e.alpha[i] });
+	}
+}
@@ -0,0 +1,110 @@
+#pragma once
+
+// stlib
+#include <cstdint>
+#include <vector>
+
+// internal
+#include "common.hpp"
+#include "components.hpp"
+
+// How an emitter spawns particles and how they change over their life. Ranges are
+// picked uniformly per particle. life runs from 0 at spawn to 1 when the particle dies.
+struct ParticleEmitterDef {
+	TEXTURE_ASSET_ID texture = TEXTURE_ASSET_ID::SMOKE;
+	// burst_count particles every interval_ms
+	float interval_ms = 50.f;
+	int burst_count = 1;
+	// particles alive at once, a burst past it replaces the oldest ones
+	int max_alive = 64;
+	// spawn position relative to the emitter
+	vec2 offset_min = { 0.f, 0.f };
+	vec2 offset_max = { 0.f, 0.f };
+	vec2 velocity_min = { 0.f, 0.f };
+	vec2 velocity_max = { 0.f, 0.f };
+	float size_min = 16.f;
+	float size_max = 16.f;
+	// seconds
+	float lifetime_min = 1.f;
+	float lifetime_max = 1.f;
+	float opacity_min = 1.f;
+	float opacity_max = 1.f;
+
+	// upward acceleration, rise + life * rise_growth
+	float rise = 0.f;
+	float rise_growth = 0.f;
+	// sideways acceleration, sin(age * wiggle_frequency) * (wiggle + life * wiggle_growth)
+	float wiggle = 0.f;
+	float wiggle_growth = 0.f;
+	float wiggle_frequency = 1.f;
+	// share of the velocity kept each update
+	float drag = 1.f;
+	// size * (1 + life * size_growth)
+	float size_growth = 0.f;
+	// opacity * (1 - fade * life^2)
+	float fade = 1.f;
+};
+
+// One particle as the instanced particle shader reads it
+struct ParticleInstance {
+	vec2 position; // relative to the camera
+	float size;
+	float opacity;
+};
+
+// An emitter and its particles, kept as a ring of parallel arrays with the oldest at head.
+// Particles die in spawn order as long as their lifetimes are close, the ones dying early
+// stay in the ring with zero opacity until head passes them.
+struct ParticleEmitter {
+	ParticleEmitterDef def;
+	vec2 position = { 0.f, 0.f };
+	float timer_ms = 0.f;
+	// stopped emitters keep their particles until they die out
+	bool active = false;
+
+	// max_alive rounded up to a power of two, so ring indices wrap with a mask
+	uint32_t capacity = 0;
+	uint32_t head = 0;
+	uint32_t count = 0;
+	std::vector<float> x, y;
+	std::vector<float> vx, vy;
+	std::vector<float> age;
+	std::vector<float> inv_lifetime;
+	std::vector<float> size;
+	std::vector<float> opacity;
+	// results of the last update
+	std::vector<float> scale;
+	std::vector<float> alpha;
+};
+
+// Particle effects outside the registry. Each emitter owns a fixed ring, the update
+// runs over its arrays in at most two contiguous stretches without branching per
+// particle, and the render system copies the results straight into one instanced draw
+// per emitter.
+class ParticleSystem
+{
+public:
+	// Returns the emitter's index, used by the other calls
+	int add_emitter(const ParticleEmitterDef& def, vec2 position);
+	void move_emitter(int emitter, vec2 position);
+	// Stops spawning, the index is reused once its particles are gone
+	void remove_emitter(int emitter);
+	// Drops every emitter and particle
+	void clear();
+
+	void update(float elapsed_ms);
+
+	size_t emitter_count() const { return emitters.size(); }
+	const ParticleEmitter& emitter(size_t i) const { return emitters[i]; }
+	// Appends the emitter's visible particles
+	void append_instances(size_t emitter, vec2 camera_position, std::vector<ParticleInstance>& out) const;
+
+private:
+	void spawn(ParticleEmitter& e);
+	void simulate(ParticleEmitter& e, float step_seconds, uint32_t begin, uint32_t end);
+
+	std::vector<ParticleEmitter> emitters;
+};
+
+// Shared by the world and render systems
+extern ParticleSystem particles;
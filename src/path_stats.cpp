@@ -0,0 +1,31 @@
+#include "path_stats.hpp"
+
+PathStats path_stats;
+
+void PathStats::record(int query_expansions, int64_t query_us) {
+	queries.fetch_add(1, std::memory_order_relaxed);
+	expansions.fetch_add(query_expansions, std::memory_order_relaxed);
+	search_us.fetch_add(query_us, std::memory_order_relaxed);
+	int max = max_expansions.load(std::memory_order_relaxed);
+	while (query_expansions > max && !max_expansions.compare_exchange_weak(max, query_expansions, std::memory_order_relaxed)) {
+	}
+}
+
+void PathStats::fail(PATH_FAILURE reason, int query_expansions, int64_t query_us) {
+	record(query_expansions, query_us);
+	failures[(int)reason].fetch_add(1, std::memory_order_relaxed);
+}
+
+void PathStats::sectors_rebuilt(int sectors) {
+	rebuilt.fetch_add(sectors, std::memory_order_relaxed);
+}
+
+void PathStats::end_frame() {
+	last_frame.queries = queries.exchange(0, std::memory_order_relaxed);
+	last_frame.expansions = expansions.exchange(0, std::memory_order_relaxed);
+	last_frame.max_expansions = max_expansions.exchange(0, std::memory_order_relaxed);
+	last_frame.search_ms = search_us.exchange(0, std::memory_order_relaxed) / 1000.f;
+	for (int i = 0; i < path_failure_count; i++)
+		last_frame.failures[i] = failures[i].exchange(0, std::memory_order_relaxed);
+	last_frame.sectors_rebuilt = rebuilt.exchange(0, std::memory_order_relaxed);
+}
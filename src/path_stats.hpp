@@ -0,0 +1,53 @@
+#pragma once
+
+// stlib
+#include <atomic>
+#include <cstdint>
+
+// Why a path query came back without a path
+enum class PATH_FAILURE {
+	OUT_OF_MAP = 0,                 // the robot or the player is outside the tile map
+	UNREACHABLE = OUT_OF_MAP + 1,   // the search ran out of tiles
+	FAILURE_COUNT = UNREACHABLE + 1
+};
+const int path_failure_count = (int)PATH_FAILURE::FAILURE_COUNT;
+
+// The robots' path queries of one frame, summed
+struct PathFrameStats {
+	int queries = 0;
+	// nodes taken off the open set, the cost that grows with the map
+	int expansions = 0;
+	// of the costliest query
+	int max_expansions = 0;
+	// summed over the worker threads, so it can exceed the frame time
+	float search_ms = 0.f;
+	int failures[path_failure_count] = {};
+	// path graph sectors recomputed because doors opened or closed
+	int sectors_rebuilt = 0;
+};
+
+// Counts path queries as the robots make them. Queries run on the job system workers,
+// so the running counters are atomic. end_frame publishes them as last_frame once the
+// workers are done, the overlay shows that.
+class PathStats
+{
+public:
+	void record(int expansions, int64_t search_us);
+	void fail(PATH_FAILURE reason, int expansions, int64_t search_us);
+	// Main thread, from Pathfinder::update
+	void sectors_rebuilt(int sectors);
+	// Main thread, after the robots thought
+	void end_frame();
+
+	PathFrameStats last_frame;
+
+private:
+	std::atomic<int> queries{ 0 };
+	std::atomic<int> expansions{ 0 };
+	std::atomic<int> max_expansions{ 0 };
+	std::atomic<int64_t> search_us{ 0 };
+	std::atomic<int> failures[path_failure_count] = {};
+	std::atomic<int> rebuilt{ 0 };
+};
+
+extern PathStats path_stats;
@@ -0,0 +1,348 @@
+#include "pathfinder.hpp"
+#include "path_stats.hpp"
+
+// stlib
+#include <algorithm>
+#include <climits>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <queue>
+
+Pathfinder pathfinder;
+
+// stop tile of a sector search that runs until the sector is exhausted
+static const PathTile NO_TILE = { -1, -1 };
+
+void Pathfinder::build(const std::vector<std::vector<int>>& tile_map, int tile_size_px) {
+	clear();
+	rows = (int)tile_map.size();
+	cols = rows > 0 ? (int)tile_map[0].size() : 0;
+	tile_size = tile_size_px;
+	walls.assign((size_t)rows * cols, 0);
+	blocked.assign((size_t)rows * cols, 0);
+	for (int r = 0; r < rows; r++)
+		for (int c = 0; c < cols; c++)
+			walls[r * cols + c] = tile_map[r][c] != 0 ? 1 : 0;
+
+	sectors_y = (rows + PATH_SECTOR_TILES - 1) / PATH_SECTOR_TILES;
+	sectors_x = (cols + PATH_SECTOR_TILES - 1) / PATH_SECTOR_TILES;
+	sectors.resize((size_t)sectors_x * sectors_y);
+	for (int sy = 0; sy < sectors_y; sy++) {
+		for (int sx = 0; sx < sectors_x; sx++) {
+			Sector& sector = sectors[sy * sectors_x + sx];
+			sector.row = sy * PATH_SECTOR_TILES;
+			sector.col = sx * PATH_SECTOR_TILES;
+			sector.rows = std::min(PATH_SECTOR_TILES, rows - sector.row);
+			sector.cols = std::min(PATH_SECTOR_TILES, cols - sector.col);
+		}
+	}
+	changed = true;
+	update();
+	printf("Path graph: %d sectors, %d portals\n", (int)sectors.size(), portal_count());
+}
+
+void Pathfinder::clear() {
+	rows = cols = 0;
+	sectors_x = sectors_y = 0;
+	walls.clear();
+	blocked.clear();
+	blockers.clear();
+	sectors.clear();
+	node_tile.clear();
+	node_sector.clear();
+	node_partner.clear();
+	changed = false;
+}
+
+void Pathfinder::set_blocker(unsigned int id, vec2 min, vec2 max, bool blocking) {
+	if (rows == 0 || tile_size <= 0)
+		return;
+	auto found = blockers.find(id);
+	if ((found != blockers.end()) == blocking)
+		return;
+	if (!blocking) {
+		// frees what it blocked when it started, even if it moved since
+		add_blockers(found->second, -1);
+		blockers.erase(found);
+		return;
+	}
+	// an edge on a tile border doesn't reach into the next tile
+	TileRect rect;
+	rect.row0 = std::max(0, (int)floor(min.y / tile_size));
+	rect.row1 = std::min(rows - 1, (int)ceil(max.y / tile_size) - 1);
+	rect.col0 = std::max(0, (int)floor(min.x / tile_size));
+	rect.col1 = std::min(cols - 1, (int)ceil(max.x / tile_size) - 1);
+	blockers[id] = rect;
+	add_blockers(rect, 1);
+}
+
+void Pathfinder::add_blockers(const TileRect& rect, int delta) {
+	for (int r = rect.row0; r <= rect.row1; r++) {
+		for (int c = rect.col0; c <= rect.col1; c++) {
+			uint16_t& count = blocked[r * cols + c];
+			bool was_blocked = count != 0;
+			count = (uint16_t)(count + delta);
+			if (was_blocked == (count != 0))
+				continue;
+			// portals on the borders are found again by update, whichever sector they are in
+			sectors[sector_of({ r, c })].dirty = true;
+			changed = true;
+		}
+	}
+}
+
+void Pathfinder::find_entrances(int a, int b, std::vector<std::vector<PathTile>>& portals, std::vector<PortalPair>& pairs) const {
+	const Sector& sa = sectors[a];
+	// b is a's right neighbour, or else the one below it
+	bool right = sectors[b].row == sa.row;
+	int length = right ? sa.rows : sa.cols;
+	auto tile_a = [&](int i) {
+		return right ? PathTile(sa.row + i, sa.col + sa.cols - 1) : PathTile(sa.row + sa.rows - 1, sa.col + i);
+	};
+	auto tile_b = [&](int i) {
+		return right ? PathTile(sa.row + i, sa.col + sa.cols) : PathTile(sa.row + sa.rows, sa.col + i);
+	};
+	auto add = [&](int i) {
+		pairs.push_back({ a, (int)portals[a].size(), b, (int)portals[b].size() });
+		portals[a].push_back(tile_a(i));
+		portals[b].push_back(tile_b(i));
+	};
+
+	int start = -1;
+	for (int i = 0; i <= length; i++) {
+		bool open = i < length && walkable(tile_a(i).first, tile_a(i).second) && walkable(tile_b(i).first, tile_b(i).second);
+		if (open && start < 0)
+			start = i;
+		if (open || start < 0)
+			continue;
+		// the opening is start .. i - 1
+		if (i - start >= PATH_WIDE_ENTRANCE) {
+			add(start);
+			add(i - 1);
+		}
+		else {
+			add((start + i - 1) / 2);
+		}
+		start = -1;
+	}
+}
+
+void Pathfinder::update() {
+	if (!changed)
+		return;
+	changed = false;
+
+	// entrances are cheap to find, only the distances within a sector cost a search per portal
+	std::vector<std::vector<PathTile>> portals(sectors.size());
+	std::vector<PortalPair> pairs;
+	for (int sy = 0; sy < sectors_y; sy++) {
+		for (int sx = 0; sx < sectors_x; sx++) {
+			int s = sy * sectors_x + sx;
+			if (sx + 1 < sectors_x)
+				find_entrances(s, s + 1, portals, pairs);
+			if (sy + 1 < sectors_y)
+				find_entrances(s, s + sectors_x, portals, pairs);
+		}
+	}
+
+	int rebuilt = 0;
+	SectorSearch search;
+	for (size_t s = 0; s < sectors.size(); s++) {
+		Sector& sector = sectors[s];
+		if (!sector.dirty && sector.portals == portals[s])
+			continue;
+		sector.dirty = false;
+		sector.portals = portals[s];
+		size_t count = sector.portals.size();
+		sector.distances.assign(count * count, -1);
+		for (size_t i = 0; i < count; i++) {
+			search_sector(sector, sector.portals[i], NO_TILE, search);
+			for (size_t j = 0; j < count; j++)
+				sector.distances[i * count + j] = search.distance[local_index(sector, sector.portals[j])];
+		}
+		rebuilt++;
+	}
+
+	// node ids follow the sectors' portal order
+	int nodes = 0;
+	for (Sector& sector : sectors) {
+		sector.first_node = nodes;
+		nodes += (int)sector.portals.size();
+	}
+	node_tile.resize(nodes);
+	node_sector.resize(nodes);
+	node_partner.resize(nodes);
+	for (size_t s = 0; s < sectors.size(); s++) {
+		const Sector& sector = sectors[s];
+		for (size_t i = 0; i < sector.portals.size(); i++) {
+			node_tile[sector.first_node + i] = sector.portals[i];
+			node_sector[sector.first_node + i] = (int)s;
+		}
+	}
+	for (const PortalPair& pair : pairs) {
+		int a = sectors[pair.a].first_node + pair.a_index;
+		int b = sectors[pair.b].first_node + pair.b_index;
+		node_partner[a] = b;
+		node_partner[b] = a;
+	}
+	// a full rebuild is a level load, only door changes count
+	if (rebuilt < (int)sectors.size())
+		path_stats.sectors_rebuilt(rebuilt);
+}
+
+int Pathfinder::search_sector(const Sector& sector, PathTile from, PathTile stop, SectorSearch& out) const {
+	const int dr[4] = { 0, 0, -1, 1 };
+	const int dc[4] = { -1, 1, 0, 0 };
+	out.distance.fill(-1);
+	out.parent.fill(-1);
+	std::array<int, PATH_SECTOR_TILES * PATH_SECTOR_TILES> queue;
+	int head = 0, tail = 0;
+	int first = local_index(sector, from);
+	out.distance[first] = 0;
+	queue[tail++] = first;
+
+	int expansions = 0;
+	while (head < tail) {
+		int current = queue[head++];
+		expansions++;
+		int r = sector.row + current / sector.cols;
+		int c = sector.col + current % sector.cols;
+		if (PathTile(r, c) == stop)
+			break;
+		for (int i = 0; i < 4; i++) {
+			int nr = r + dr[i];
+			int nc = c + dc[i];
+			if (nr < sector.row || nr >= sector.row + sector.rows || nc < sector.col || nc >= sector.col + sector.cols)
+				continue;
+			int next = local_index(sector, { nr, nc });
+			if (out.distance[next] >= 0 || !walkable(nr, nc))
+				continue;
+			out.distance[next] = out.distance[current] + 1;
+			out.parent[next] = current;
+			queue[tail++] = next;
+		}
+	}
+	return expansions;
+}
+
+void Pathfinder::trace(const Sector& sector, const SectorSearch& search, PathTile to, std::vector<PathTile>& out) const {
+	size_t end = out.size();
+	for (int at = local_index(sector, to); search.parent[at] >= 0; at = search.parent[at])
+		out.push_back({ sector.row + at / sector.cols, sector.col + at % sector.cols });
+	std::reverse(out.begin() + end, out.end());
+}
+
+std::vector<PathTile> Pathfinder::find_path(PathTile start, PathTile goal, int& expansions) const {
+	expansions = 0;
+	if (rows == 0 || start.first < 0 || start.second < 0 || start.first >= rows || start.second >= cols
+		|| goal.first < 0 || goal.second < 0 || goal.first >= rows || goal.second >= cols)
+		return {};
+	if (start == goal)
+		return { start };
+	if (!walkable(goal.first, goal.second))
+		return {};
+
+	int start_sector = sector_of(start);
+	int goal_sector = sector_of(goal);
+	const Sector& ss = sectors[start_sector];
+	const Sector& gs = sectors[goal_sector];
+	SectorSearch from_start, from_goal;
+	expansions += search_sector(ss, start, start_sector == goal_sector ? goal : NO_TILE, from_start);
+	// a goal reachable without leaving the sector doesn't need the portal graph
+	if (start_sector == goal_sector && from_start.distance[local_index(ss, goal)] >= 0) {
+		std::vector<PathTile> path = { start };
+		trace(ss, from_start, goal, path);
+		return path;
+	}
+	expansions += search_sector(gs, goal, NO_TILE, from_goal);
+
+	// A* over the portals plus the start and goal, manhattan distance fits 4 connected unit steps
+	const int node_count = (int)node_tile.size();
+	const int START = node_count;
+	const int GOAL = node_count + 1;
+	auto tile_of = [&](int node) { return node == START ? start : node == GOAL ? goal : node_tile[node]; };
+	auto heuristic = [&](int node) {
+		PathTile tile = tile_of(node);
+		return abs(tile.first - goal.first) + abs(tile.second - goal.second);
+	};
+	std::vector<int> g(node_count + 2, INT_MAX);
+	std::vector<int> came_from(node_count + 2, -1);
+	std::vector<bool> closed(node_count + 2, false);
+	typedef std::pair<int, int> Entry; // (f cost, node)
+	std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> open_set;
+	auto relax = [&](int from, int to, int cost) {
+		if (closed[to] || g[from] + cost >= g[to])
+			return;
+		g[to] = g[from] + cost;
+		came_from[to] = from;
+		open_set.push({ g[to] + heuristic(to), to });
+	};
+
+	g[START] = 0;
+	open_set.push({ heuristic(START), START });
+	while (!open_set.empty()) {
+		int current = open_set.top().second;
+		open_set.pop();
+		if (closed[current])
+			continue;
+		closed[current] = true;
+		expansions++;
+		if (current == GOAL)
+			break;
+
+		if (current == START) {
+			for (size_t i = 0; i < ss.portals.size(); i++) {
+				int d = from_start.distance[local_index(ss, ss.portals[i])];
+				if (d >= 0)
+					relax(START, ss.first_node + (int)i, d);
+			}
+			continue;
+		}
+		const Sector& sector = sectors[node_sector[current]];
+		size_t count = sector.portals.size();
+		size_t index = current - sector.first_node;
+		relax(current, node_partner[current], 1);
+		for (size_t j = 0; j < count; j++) {
+			int d = sector.distances[index * count + j];
+			if (j != index && d >= 0)
+				relax(current, sector.first_node + (int)j, d);
+		}
+		if (node_sector[current] == goal_sector) {
+			int d = from_goal.distance[local_index(gs, node_tile[current])];
+			if (d >= 0)
+				relax(current, GOAL, d);
+		}
+	}
+	if (!closed[GOAL])
+		return {};
+
+	std::vector<PathTile> waypoints;
+	for (int node = GOAL; node >= 0; node = came_from[node])
+		waypoints.push_back(tile_of(node));
+	std::reverse(waypoints.begin(), waypoints.end());
+
+	// tiles until the first step is known, the start's own search already covers the first leg
+	std::vector<PathTile> path = { start };
+	size_t next = 1;
+	while (path.size() < 2 && next < waypoints.size()) {
+		PathTile from = waypoints[next - 1];
+		PathTile to = waypoints[next++];
+		int sector = sector_of(from);
+		if (sector != sector_of(to)) {
+			// partners, side by side across their border
+			path.push_back(to);
+		}
+		else if (next == 2) {
+			trace(ss, from_start, to, path);
+		}
+		else {
+			SectorSearch leg;
+			expansions += search_sector(sectors[sector], from, to, leg);
+			trace(sectors[sector], leg, to, path);
+		}
+	}
+	path.insert(path.end(), waypoints.begin() + next, waypoints.end());
+	return path;
+}
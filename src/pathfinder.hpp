@@ -0,0 +1,112 @@
+#pragma once
+
+// stlib
+#include <array>
+#include <cstdint>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+// internal
+#include "common.hpp"
+
+// Sectors are square blocks of tiles, each with its own part of the portal graph
+const int PATH_SECTOR_TILES = 8;
+// An opening between two sectors at least this wide gets a portal at each end instead of
+// one in the middle, so paths along a wide border don't detour through its center
+const int PATH_WIDE_ENTRANCE = 6;
+
+// A tile as (row, column), the way T_map::tile_map is indexed
+typedef std::pair<int, int> PathTile;
+
+// Hierarchical pathfinder over the level's tile map, 4-connected with unit costs.
+// The map is cut into sectors. Where two neighbouring sectors have walkable tiles side by
+// side their border gets portals, and each sector keeps the distances between its own
+// portals. A query links its start and goal to the portals of their sectors, searches the
+// small portal graph and refines only the first leg into tiles: robots ask again every
+// frame and only step to path[1], so the rest of the path is left as portal waypoints.
+//
+// Tiles can be blocked on top of the map's walls, closed doors are. Each tile counts the
+// blockers over it, so opening one door leaves a tile another closed door covers blocked.
+// update() only recomputes the portal distances of sectors whose tiles or portals changed.
+// find_path may run on the job system workers, everything else is main thread only and
+// not while robots think.
+class Pathfinder
+{
+public:
+	// Builds the portal graph of a level, tile_map is T_map::tile_map
+	void build(const std::vector<std::vector<int>>& tile_map, int tile_size);
+	void clear();
+
+	// Blocks the tiles under an area in pixels while blocking is set, by blocker id.
+	// Calls that don't change whether id blocks do nothing. The map's own walls stay.
+	void set_blocker(unsigned int id, vec2 min, vec2 max, bool blocking);
+	// Rebuilds the portals and distances changed by set_blocker since the last update
+	void update();
+
+	// Tiles from start to goal, see above, empty when there is no path. expansions
+	// counts the nodes searched on both levels.
+	std::vector<PathTile> find_path(PathTile start, PathTile goal, int& expansions) const;
+
+	int portal_count() const { return (int)node_tile.size(); }
+
+private:
+	struct Sector {
+		// tile bounds, sectors on the right and bottom edge may be smaller
+		int row = 0, col = 0, rows = 0, cols = 0;
+		std::vector<PathTile> portals;
+		// from portal to portal within the sector, portals.size() squared, -1 when not connected
+		std::vector<int> distances;
+		// node id of portals[0]
+		int first_node = 0;
+		bool dirty = true;
+	};
+
+	// Breadth first search within one sector, by tile index within the sector
+	struct SectorSearch {
+		std::array<int, PATH_SECTOR_TILES * PATH_SECTOR_TILES> distance;
+		std::array<int, PATH_SECTOR_TILES * PATH_SECTOR_TILES> parent;
+	};
+
+	bool walkable(int row, int col) const { return walls[row * cols + col] == 0 && blocked[row * cols + col] == 0; }
+	int sector_of(PathTile tile) const { return (tile.first / PATH_SECTOR_TILES) * sectors_x + tile.second / PATH_SECTOR_TILES; }
+	int local_index(const Sector& sector, PathTile tile) const { return (tile.first - sector.row) * sector.cols + tile.second - sector.col; }
+	// Tiles covered by a blocker, inclusive, empty when row1 < row0 or col1 < col0
+	struct TileRect {
+		int row0, row1, col0, col1;
+	};
+	// Adds delta to the blocker count of each tile in rect
+	void add_blockers(const TileRect& rect, int delta);
+	// Searches from a tile, which may itself be blocked, until stop is reached or the sector
+	// is exhausted. Returns the expansions.
+	int search_sector(const Sector& sector, PathTile from, PathTile stop, SectorSearch& out) const;
+	// Appends the tiles after the search's start up to and including to
+	void trace(const Sector& sector, const SectorSearch& search, PathTile to, std::vector<PathTile>& out) const;
+	// Two portals facing each other across a border, by sector and index in its portals
+	struct PortalPair {
+		int a, a_index, b, b_index;
+	};
+	// Portals of the border between sector a and its right or bottom neighbour b
+	void find_entrances(int a, int b, std::vector<std::vector<PathTile>>& portals, std::vector<PortalPair>& pairs) const;
+
+	int rows = 0;
+	int cols = 0;
+	int tile_size = 0;
+	int sectors_x = 0;
+	int sectors_y = 0;
+	// by row * cols + col, blocked counts the blockers over a tile
+	std::vector<uint8_t> walls;
+	std::vector<uint16_t> blocked;
+	// the tiles of each blocker that currently blocks, by id
+	std::unordered_map<unsigned int, TileRect> blockers;
+	std::vector<Sector> sectors;
+	bool changed = false;
+
+	// Portal graph, a node is a sector's portal. Each has one partner on the other side of
+	// its border at cost 1, and reaches the other portals of its sector by Sector::distances.
+	std::vector<PathTile> node_tile;
+	std::vector<int> node_sector;
+	std::vector<int> node_partner;
+};
+
+extern Pathfinder pathfinder;
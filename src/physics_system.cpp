@@ -3,23 +3,27 @@
 #include "world_init.hpp"
 #include "math_utils.hpp"
 #include "render_system.hpp"
+#include "job_system.hpp"
+#include "audio_system.hpp"
+#include "debug_draw.hpp"
+#include "path_stats.hpp"
+#include "pathfinder.hpp"
 #include <queue>
 
 #include <vector>
 #include <map>
 #include <cmath>
 #include <algorithm>
+#include <chrono>
 
 
 void bound_check(Motion& mo);
 
 void dumb_ai(Motion& mo);
 
+// expansions counts the nodes the search took off its queue
 std::vector<std::pair<int, int>> bfs(const std::vector<std::vector<int>>& tile_map,
-	std::pair<int, int> start, std::pair<int, int> end);
-
-std::vector<std::pair<int, int>> a_star(const std::vector<std::vector<int>>& tile_map, 
-        std::pair<int, int> start, std::pair<int, int> end);
+	std::pair<int, int> start, std::pair<int, int> end, int& expansions);
 
 std::pair<int, int> translate_vec2(Motion x);
 
@@ -57,10 +61,11 @@ bool spiderShouldattack(Entity e);
 
 bool bossShouldidle(Entity e);
 
-void handelRobot(Entity entity, float elapsed_ms, WorldSystem* world);
+void handelRobot(Entity entity, float elapsed_ms);
 
+void think_boss(RobotIntent& intent, float elapsed_ms);
 void handelBossRobot(Entity entity, float elapsed_ms, WorldSystem* world);
-void handleSpiderRobot(Entity entity, float elapsed_ms, WorldSystem* world);
+void handleSpiderRobot(Entity entity, bool patrol, float elapsed_ms);
 bool wall_hit(Motion start, Motion end) {
 	std::pair<int, int> end_p = translate_vec2(end);
 	std::pair<int, int> start_p = translate_vec2(start);
@@ -84,7 +89,7 @@ bool wall_hit(Motion start, Motion end) {
 
 
 	Entity T = registry.maps.entities[0];
-	T_map m = registry.maps.get(T);
+	const T_map& m = registry.maps.peek(T);
 
 	int map_width = m.tile_map.size();
 	int map_height = (map_width > 0) ? m.tile_map[0].size() : 0;
@@ -273,14 +278,14 @@ struct close_enemy {
 close_enemy companion_close_enemy(Entity entity) {
 	auto& robot_registry = registry.robots;
 	float curr_min = std::numeric_limits<float>::max();
-	Motion companion = registry.motions.get(entity);
+	const Motion& companion = registry.motions.peek(entity);
 	close_enemy temp;
 	temp.i = entity;
 	temp.dist = 0.f;
 	for (uint i = 0; i < robot_registry.size(); i++) {
 		Entity e = robot_registry.entities[i];
-		Motion m = registry.motions.get(e);
-		Robot r = registry.robots.get(e);
+		const Motion& m = registry.motions.peek(e);
+		const Robot& r = robot_registry.components[i];
 		if (e.id != entity.id) {
 			if (length(companion.position - m.position) < curr_min && !r.companion) {
 				curr_min = length(companion.position - m.position);
@@ -291,17 +296,21 @@ close_enemy companion_close_enemy(Entity entity) {
 	}
 	return temp;
 }
-void handelCompanion(Entity entity, float elapsed_ms, WorldSystem* world) {
+// Decision half of the companion AI: fight the boss or the closest enemy, otherwise follow the player.
+// Runs on the job system, so it only reads the registry and writes the intent.
+void think_companion(RobotIntent& intent) {
+	Entity entity = intent.entity;
 	close_enemy temp = companion_close_enemy(entity);
-	Motion& motion = registry.motions.get(entity);
+	Motion& motion = intent.motion;
+	const Robot& ro = registry.robots.peek(entity);
 
 	bool attacking = false;
 
 	if (registry.robotAnimations.has(entity)) {
-		RobotAnimation& ra = registry.robotAnimations.get(entity);
+		RobotAnimation& ra = intent.robot_animation;
 
 		for (Entity boss_entity : registry.bossRobots.entities) {
-			Motion& boss_motion = registry.motions.get(boss_entity);
+			const Motion& boss_motion = registry.motions.peek(boss_entity);
 			float distance_to_boss = glm::length(boss_motion.position - motion.position);
 
 			if (distance_to_boss < 384.f) {
@@ -309,18 +318,17 @@ void handelCompanion(Entity entity, float elapsed_ms, WorldSystem* world) {
 
 				if (ra.current_state != RobotState::ATTACK) {
 					ra.setState(RobotState::ATTACK, ra.current_dir);
-					world->play_ready_attack_sound();
+					intent.play(RobotCommandType::READY_ATTACK_SOUND);
 				}
 				else if (ra.current_frame == ra.getMaxFrames() - 1) {
 					ra.current_frame = 0;
 
-					Robot& ro = registry.robots.get(entity);
 					vec2 target_velocity = normalize((boss_motion.position - motion.position)) * 225.f;
 					vec2 temp = motion.position - boss_motion.position;
 					float angle = atan2(temp.y, temp.x);
 					angle += 3.14;
-					createProjectile(motion.position, target_velocity, angle, ro.ice_proj, true);
-					world->play_attack_sound();
+					intent.fire(motion.position, target_velocity, angle, ro.ice_proj, true);
+					intent.play(RobotCommandType::ATTACK_SOUND);
 				}
 
 				attacking = true;
@@ -333,20 +341,18 @@ void handelCompanion(Entity entity, float elapsed_ms, WorldSystem* world) {
 
 			if (ra.current_state != RobotState::ATTACK) {
 				ra.setState(RobotState::ATTACK, ra.current_dir);
-				world->play_ready_attack_sound();
+				intent.play(RobotCommandType::READY_ATTACK_SOUND);
 			}
 			else if (ra.current_frame == ra.getMaxFrames() - 1) {
 				ra.current_frame = 0;
 
-				Robot& ro = registry.robots.get(entity);
-
-				Motion& enemy_motion = registry.motions.get(temp.i);
+				const Motion& enemy_motion = registry.motions.peek(temp.i);
 				vec2 target_velocity = normalize((enemy_motion.position - motion.position)) * 225.f;
 				vec2 temp = motion.position - enemy_motion.position;
 				float angle = atan2(temp.y, temp.x);
 				angle += 3.14;
-				createProjectile(motion.position, target_velocity, angle, ro.ice_proj, true);
-				world->play_attack_sound();
+				intent.fire(motion.position, target_velocity, angle, ro.ice_proj, true);
+				intent.play(RobotCommandType::ATTACK_SOUND);
 			}
 
 			attacking = true;
@@ -356,29 +362,14 @@ void handelCompanion(Entity entity, float elapsed_ms, WorldSystem* world) {
 			Direction a = bfs_ai(motion);
 			ra.setState(RobotState::WALK, a);
 		}
-
-		Robot& ro = registry.robots.get(entity);
-		if (ro.current_health <= 0) {
-			if (!ro.should_die) {
-				ro.should_die = true;
-				ra.setState(RobotState::DEAD, ra.current_dir);
-				world->play_death_sound();
-				ro.death_cd = ra.getMaxFrames() * ra.FRAME_TIME * 1000.f;
-			}
-			else {
-				ro.death_cd -= elapsed_ms;
-				if (ro.death_cd < 0) {
-					registry.remove_all_components_of(entity);
-				}
-			}
-		}
+		return;
 	}
 
 	if (registry.iceRobotAnimations.has(entity)) {
-		IceRobotAnimation& ra = registry.iceRobotAnimations.get(entity);
+		IceRobotAnimation& ra = intent.ice_animation;
 
 		for (Entity boss_entity : registry.bossRobots.entities) {
-			Motion& boss_motion = registry.motions.get(boss_entity);
+			const Motion& boss_motion = registry.motions.peek(boss_entity);
 			float distance_to_boss = glm::length(boss_motion.position - motion.position);
 
 			if (distance_to_boss < 384.f) {
@@ -386,18 +377,17 @@ void handelCompanion(Entity entity, float elapsed_ms, WorldSystem* world) {
 
 				if (ra.current_state != IceRobotState::ATTACK) {
 					ra.setState(IceRobotState::ATTACK, ra.current_dir);
-					world->play_ready_attack_sound();
+					intent.play(RobotCommandType::READY_ATTACK_SOUND);
 				}
 				else if (ra.current_frame == ra.getMaxFrames() - 1) {
 					ra.current_frame = 0;
 
-					Robot& ro = registry.robots.get(entity);
 					vec2 target_velocity = normalize((boss_motion.position - motion.position)) * 225.f;
 					vec2 temp = motion.position - boss_motion.position;
 					float angle = atan2(temp.y, temp.x);
 					angle += 3.14;
-					createProjectile(motion.position, target_velocity, angle, ro.ice_proj, true);
-					world->play_attack_sound();
+					intent.fire(motion.position, target_velocity, angle, ro.ice_proj, true);
+					intent.play(RobotCommandType::ATTACK_SOUND);
 				}
 
 				attacking = true;
@@ -410,20 +400,18 @@ void handelCompanion(Entity entity, float elapsed_ms, WorldSystem* world) {
 
 			if (ra.current_state != IceRobotState::ATTACK) {
 				ra.setState(IceRobotState::ATTACK, ra.current_dir);
-				world->play_ready_attack_sound();
+				intent.play(RobotCommandType::READY_ATTACK_SOUND);
 			}
 			else if (ra.current_frame == ra.getMaxFrames() - 1) {
 				ra.current_frame = 0;
 
-				Robot& ro = registry.robots.get(entity);
-
-				Motion& enemy_motion = registry.motions.get(temp.i);
+				const Motion& enemy_motion = registry.motions.peek(temp.i);
 				vec2 target_velocity = normalize((enemy_motion.position - motion.position)) * 225.f;
 				vec2 temp = motion.position - enemy_motion.position;
 				float angle = atan2(temp.y, temp.x);
 				angle += 3.14;
-				createProjectile(motion.position, target_velocity, angle, ro.ice_proj, true);
-				world->play_attack_sound();
+				intent.fire(motion.position, target_velocity, angle, ro.ice_proj, true);
+				intent.play(RobotCommandType::ATTACK_SOUND);
 			}
 
 			attacking = true;
@@ -433,224 +421,310 @@ void handelCompanion(Entity entity, float elapsed_ms, WorldSystem* world) {
 			Direction a = a_star_ai(motion);
 			ra.setState(IceRobotState::WALK, a);
 		}
-
-		Robot& ro = registry.robots.get(entity);
-		if (ro.current_health <= 0) {
-			if (!ro.should_die) {
-				ro.should_die = true;
-				ra.setState(IceRobotState::DEAD, ra.current_dir);
-				world->play_death_sound();
-				ro.death_cd = ra.getMaxFrames() * ra.FRAME_TIME * 1000.f;
-			}
-			else {
-				ro.death_cd -= elapsed_ms;
-				if (ro.death_cd < 0) {
-					registry.remove_all_components_of(entity);
-				}
-			}
-		}
-		return;
 	}
-
-
 }
 
+// Decision half of the robot AI: walk towards the player, shoot when in range, hold still when too close
+void think_robot(RobotIntent& intent) {
+	Entity entity = intent.entity;
+	Motion& motion = intent.motion;
+	const Robot& ro = registry.robots.peek(entity);
+	if (ro.companion) {
+		think_companion(intent);
+		return;
+	}
 
-void handelRobot(Entity entity, float elapsed_ms, WorldSystem* world) {
-	Motion& motion = registry.motions.get(entity);
 	Entity player = registry.players.entities[0];
-	Motion& player_motion = registry.motions.get(player);
+	const Motion& player_motion = registry.motions.peek(player);
 	if (registry.robotAnimations.has(entity)) {
-		RobotAnimation& ra = registry.robotAnimations.get(entity);
-
-		Robot& ro = registry.robots.get(entity);
-		if (ro.companion) {
-			handelCompanion(entity, elapsed_ms, world);
-			return;
-		}
+		RobotAnimation& ra = intent.robot_animation;
 
-		if (shouldmv(entity) && registry.robotAnimations.get(entity).current_state != RobotState::DEAD) {
+		if (shouldmv(entity) && ra.current_state != RobotState::DEAD) {
 			Direction a = a_star_ai(motion);
-			RobotAnimation& ra = registry.robotAnimations.get(entity);
 			ra.setState(RobotState::WALK, a);
 		}
 
-		if (shouldattack(entity) && registry.robotAnimations.get(entity).current_state != RobotState::DEAD) {
-			RobotAnimation& ra = registry.robotAnimations.get(entity);
+		if (shouldattack(entity) && ra.current_state != RobotState::DEAD) {
 			motion.velocity = vec2(0);
 			if (wall_hit(motion, player_motion)) {
 				Direction a = a_star_ai(motion);
-				RobotAnimation& ra = registry.robotAnimations.get(entity);
 				ra.setState(RobotState::WALK, a);
 			}
 			else if (ra.current_state != RobotState::ATTACK) {
 				ra.setState(RobotState::ATTACK, ra.current_dir);
-				world->play_ready_attack_sound();
+				intent.play(RobotCommandType::READY_ATTACK_SOUND);
 			}
 			else if (ra.current_frame == ra.getMaxFrames() - 1) {
 				ra.current_frame = 0;
-				Robot& ro = registry.robots.get(entity);
-				//std::cout << "fire shot" << std::endl;
-				Entity player = registry.players.entities[0];
-				Motion& player_motion = registry.motions.get(player);
 				vec2 target_velocity = normalize((player_motion.position - motion.position)) * 225.f;
 				vec2 temp = motion.position - player_motion.position;
 				float angle = atan2(temp.y, temp.x);
 				angle += 3.14;
-				createProjectile(motion.position, target_velocity, angle, ro.ice_proj, false);
-				world->play_attack_sound();
-				//ro.ice_proj = !ro.ice_proj;
+				intent.fire(motion.position, target_velocity, angle, ro.ice_proj, false);
+				intent.play(RobotCommandType::ATTACK_SOUND);
 			}
 		}
 
-
-		if (shouldidle(entity) && registry.robotAnimations.get(entity).current_state != RobotState::DEAD) {
+		if (shouldidle(entity) && ra.current_state != RobotState::DEAD) {
 			motion.velocity = vec2(0);
 			ra.setState(RobotState::IDLE, ra.current_dir);
 		}
-		if (registry.robots.has(entity)) {
-			Robot& ro = registry.robots.get(entity);
-			if (ro.current_health <= 0) {
-				if (!ro.should_die) {
-					ro.should_die = true;
-					ra.setState(RobotState::DEAD, ra.current_dir);
-					world->play_death_sound();
-					ro.death_cd = ra.getMaxFrames() * ra.FRAME_TIME * 1000.f;
-					if (ro.isCapturable) {
-						ro.showCaptureUI = true;
-						ro.current_health = ro.max_health/2;
-					}
-					else {
-						ro.death_cd -= elapsed_ms;
-
-						if (ro.death_cd < 0) {
-							registry.remove_all_components_of(entity);
-						}
-
-					}
-				}
-				else {
-					ro.death_cd -= elapsed_ms;
-					if (ro.death_cd < 0) {
-						registry.remove_all_components_of(entity);
-					}
-				}
-			}
-		}
 		return;
 	}
-	
-	if (registry.iceRobotAnimations.has(entity)) {
-		IceRobotAnimation& ra = registry.iceRobotAnimations.get(entity);
 
-		Robot& ro = registry.robots.get(entity);
-		if (ro.companion) {
-			handelCompanion(entity, elapsed_ms, world);
-			return;
-		}
+	if (registry.iceRobotAnimations.has(entity)) {
+		IceRobotAnimation& ra = intent.ice_animation;
 
-		if (shouldmv(entity) && registry.iceRobotAnimations.get(entity).current_state != IceRobotState::DEAD) {
+		if (shouldmv(entity) && ra.current_state != IceRobotState::DEAD) {
 			Direction a = a_star_ai(motion);
-			IceRobotAnimation& ra = registry.iceRobotAnimations.get(entity);
 			ra.setState(IceRobotState::WALK, a);
 		}
 
-		if (shouldattack(entity) && registry.iceRobotAnimations.get(entity).current_state != IceRobotState::DEAD) {
-			IceRobotAnimation& ra = registry.iceRobotAnimations.get(entity);
+		if (shouldattack(entity) && ra.current_state != IceRobotState::DEAD) {
 			motion.velocity = vec2(0);
 			if (wall_hit(motion, player_motion)) {
 				Direction a = a_star_ai(motion);
-				IceRobotAnimation& ra = registry.iceRobotAnimations.get(entity);
 				ra.setState(IceRobotState::WALK, a);
 			}
 			else if (ra.current_state != IceRobotState::ATTACK) {
 				ra.setState(IceRobotState::ATTACK, ra.current_dir);
-				world->play_ready_attack_sound();
+				intent.play(RobotCommandType::READY_ATTACK_SOUND);
 			}
 			else if (ra.current_frame == 8) {
 				ra.current_frame++;
-				Robot& ro = registry.robots.get(entity);
-				Entity player = registry.players.entities[0];
-				Motion& player_motion = registry.motions.get(player);
 				vec2 target_velocity = normalize((player_motion.position - motion.position)) * 225.f;
 				vec2 temp = motion.position - player_motion.position;
 				float angle = atan2(temp.y, temp.x);
 				angle += 3.14;
-				createProjectile(motion.position, target_velocity, angle, ro.ice_proj, false);
-				world->play_attack_sound();
+				intent.fire(motion.position, target_velocity, angle, ro.ice_proj, false);
+				intent.play(RobotCommandType::ATTACK_SOUND);
 			}
 			else if (ra.current_frame == ra.getMaxFrames() - 1) {
 				ra.current_frame = 0;
 			}
 		}
 
-
-		if (shouldidle(entity) && registry.iceRobotAnimations.get(entity).current_state != IceRobotState::DEAD) {
+		if (shouldidle(entity) && ra.current_state != IceRobotState::DEAD) {
 			motion.velocity = vec2(0);
 			ra.setState(IceRobotState::IDLE, ra.current_dir);
 		}
-		if (registry.robots.has(entity)) {
-			Robot& ro = registry.robots.get(entity);
-			if (ro.current_health <= 0) {
-				if (!ro.should_die) {
-					ro.should_die = true;
-					ra.setState(IceRobotState::DEAD, ra.current_dir);
-					world->play_death_sound();
-					ro.death_cd = ra.getMaxFrames() * ra.FRAME_TIME * 1000.f;
-					if (ro.isCapturable) {
-						ro.showCaptureUI = true;
-						ro.current_health = ro.max_health/2;
-					}
-					else {
-						ro.death_cd -= elapsed_ms;
+	}
+}
 
-						if (ro.death_cd < 0) {
-							registry.remove_all_components_of(entity);
-						}
+// Decision half of the spider AI, patrolling is left to the apply step
+void think_spider(RobotIntent& intent) {
+	Entity entity = intent.entity;
+	Motion& motion = intent.motion;
+	SpiderRobotAnimation& ra = intent.spider_animation;
 
-					}
+	const float attack_range = 50.0f;
+	const float follow_speed = 50.0f;
+
+	Entity player = registry.players.entities[0];
+	const Motion& player_motion = registry.motions.peek(player);
+
+	float distance_to_player = glm::distance(motion.position, player_motion.position);
+
+	if (distance_to_player <= attack_range) {
+		motion.velocity = vec2(0);
+		if (ra.current_state != SpiderRobotState::ATTACK) {
+			ra.setState(SpiderRobotState::ATTACK, ra.current_dir);
+			intent.play(RobotCommandType::AWAKE_SOUND);
+		}
+	}
+	else if (spiderShouldmv(entity)) {
+		Direction direction = bfs_ai(motion);
+		ra.setState(SpiderRobotState::WALK, direction);
+		motion.velocity = normalize(player_motion.position - motion.position) * follow_speed;
+	}
+	else {
+		intent.spider_patrol = true;
+	}
+}
+
+void think_robot_intent(RobotIntent& intent, float elapsed_ms) {
+	intent.commands.clear();
+	intent.spider_patrol = false;
+	if (registry.bossRobots.has(intent.entity))
+		think_boss(intent, elapsed_ms);
+	else if (registry.spiderRobots.has(intent.entity))
+		think_spider(intent);
+	else
+		think_robot(intent);
+}
+
+// Writes back what think decided and runs its commands, in the order they were made
+void apply_robot_intent(const RobotIntent& intent) {
+	Entity entity = intent.entity;
+	registry.motions.get(entity).velocity = intent.motion.velocity;
+	if (registry.robotAnimations.has(entity))
+		registry.robotAnimations.get(entity) = intent.robot_animation;
+	if (registry.iceRobotAnimations.has(entity))
+		registry.iceRobotAnimations.get(entity) = intent.ice_animation;
+	if (registry.spiderRobotAnimations.has(entity))
+		registry.spiderRobotAnimations.get(entity) = intent.spider_animation;
+	if (registry.bossRobotAnimations.has(entity))
+		registry.bossRobotAnimations.get(entity) = intent.boss_animation;
+	if (registry.bossRobots.has(entity))
+		registry.bossRobots.get(entity).attack = intent.boss_attack;
+
+	for (const RobotCommand& command : intent.commands) {
+		switch (command.type) {
+		case RobotCommandType::READY_ATTACK_SOUND: audio.play(SOUND_ID::ROBOT_READY_ATTACK, intent.motion.position); break;
+		case RobotCommandType::ATTACK_SOUND: audio.play(SOUND_ID::ROBOT_ATTACK, intent.motion.position); break;
+		case RobotCommandType::AWAKE_SOUND: audio.play(SOUND_ID::ROBOT_AWAKE, intent.motion.position); break;
+		case RobotCommandType::PROJECTILE:
+			createProjectile(command.position, command.velocity, command.angle, command.ice, command.friendly);
+			break;
+		case RobotCommandType::BOSS_PROJECTILE:
+			createBossProjectile(command.position, command.velocity, command.angle, 10);
+			break;
+		case RobotCommandType::DASH_HIT:
+			registry.players.get(registry.players.entities[0]).current_health -= 30;
+			break;
+		}
+	}
+}
+
+void handelCompanion(Entity entity, float elapsed_ms) {
+	if (registry.robotAnimations.has(entity)) {
+		RobotAnimation& ra = registry.robotAnimations.get(entity);
+		Robot& ro = registry.robots.get(entity);
+		if (ro.current_health <= 0) {
+			if (!ro.should_die) {
+				ro.should_die = true;
+				ra.setState(RobotState::DEAD, ra.current_dir);
+				audio.play(SOUND_ID::ROBOT_DEATH, registry.motions.peek(entity).position);
+				ro.death_cd = ra.getMaxFrames() * ra.frameTime() * 1000.f;
+			}
+			else {
+				ro.death_cd -= elapsed_ms;
+				if (ro.death_cd < 0) {
+					registry.remove_all_components_of(entity);
+				}
+			}
+		}
+		return;
+	}
+
+	if (registry.iceRobotAnimations.has(entity)) {
+		IceRobotAnimation& ra = registry.iceRobotAnimations.get(entity);
+		Robot& ro = registry.robots.get(entity);
+		if (ro.current_health <= 0) {
+			if (!ro.should_die) {
+				ro.should_die = true;
+				ra.setState(IceRobotState::DEAD, ra.current_dir);
+				audio.play(SOUND_ID::ROBOT_DEATH, registry.motions.peek(entity).position);
+				ro.death_cd = ra.getMaxFrames() * ra.frameTime() * 1000.f;
+			}
+			else {
+				ro.death_cd -= elapsed_ms;
+				if (ro.death_cd < 0) {
+					registry.remove_all_components_of(entity);
+				}
+			}
+		}
+	}
+}
+
+// Serial half of the robot AI, the decisions were made by think_robot
+void handelRobot(Entity entity, float elapsed_ms) {
+	if (registry.robots.peek(entity).companion) {
+		handelCompanion(entity, elapsed_ms);
+		return;
+	}
+
+	if (registry.robotAnimations.has(entity)) {
+		RobotAnimation& ra = registry.robotAnimations.get(entity);
+		Robot& ro = registry.robots.get(entity);
+		if (ro.current_health <= 0) {
+			if (!ro.should_die) {
+				ro.should_die = true;
+				ra.setState(RobotState::DEAD, ra.current_dir);
+				audio.play(SOUND_ID::ROBOT_DEATH, registry.motions.peek(entity).position);
+				ro.death_cd = ra.getMaxFrames() * ra.frameTime() * 1000.f;
+				if (ro.isCapturable) {
+					ro.showCaptureUI = true;
+					ro.current_health = ro.max_health/2;
 				}
 				else {
 					ro.death_cd -= elapsed_ms;
+
 					if (ro.death_cd < 0) {
 						registry.remove_all_components_of(entity);
 					}
+
+				}
+			}
+			else {
+				ro.death_cd -= elapsed_ms;
+				if (ro.death_cd < 0) {
+					registry.remove_all_components_of(entity);
 				}
 			}
 		}
 		return;
 	}
+	
+	if (registry.iceRobotAnimations.has(entity)) {
+		IceRobotAnimation& ra = registry.iceRobotAnimations.get(entity);
+		Robot& ro = registry.robots.get(entity);
+		if (ro.current_health <= 0) {
+			if (!ro.should_die) {
+				ro.should_die = true;
+				ra.setState(IceRobotState::DEAD, ra.current_dir);
+				audio.play(SOUND_ID::ROBOT_DEATH, registry.motions.peek(entity).position);
+				ro.death_cd = ra.getMaxFrames() * ra.frameTime() * 1000.f;
+				if (ro.isCapturable) {
+					ro.showCaptureUI = true;
+					ro.current_health = ro.max_health/2;
+				}
+				else {
+					ro.death_cd -= elapsed_ms;
+
+					if (ro.death_cd < 0) {
+						registry.remove_all_components_of(entity);
+					}
+
+				}
+			}
+			else {
+				ro.death_cd -= elapsed_ms;
+				if (ro.death_cd < 0) {
+					registry.remove_all_components_of(entity);
+				}
+			}
+		}
+	}
 }
 
-void handelBossRobot(Entity entity, float elapsed_ms, WorldSystem* world) {
-	Motion& motion = registry.motions.get(entity);
-	BossRobotAnimation& ra = registry.bossRobotAnimations.get(entity);
+// Decision half of the boss AI: volleys at the closest target, a dash at the player after every
+// few volleys, otherwise walk towards the player. Works on the intent's copies like think_robot.
+void think_boss(RobotIntent& intent, float elapsed_ms) {
+	Entity entity = intent.entity;
+	Motion& motion = intent.motion;
+	BossRobotAnimation& ra = intent.boss_animation;
+	BossAttack& attack = intent.boss_attack;
 
-	static float shoot_timer = 0.0f;
 	const float shoot_interval = 3.0f;
 	Entity player = registry.players.entities[0];
-	Motion& player_motion = registry.motions.get(player);
+	const Motion& player_motion = registry.motions.peek(player);
 
-	static int projectile_count = 0;
 	const int max_projectiles = 4;
-	static float dash_timer = 0.0f;
 	const float dash_duration = 4.0f;
 	const float dash_speed = 200.0f;
 
-	Entity target_entity = player;
-	Motion target_motion = player_motion;
+	vec2 target_position = player_motion.position;
 	float closest_distance = glm::distance(motion.position, player_motion.position);
 
 	// Find the closest target between the player and companion robots
 	for (Entity companion_entity : registry.robots.entities) {
-		Robot& companion_robot = registry.robots.get(companion_entity);
-		if (companion_robot.companion) {
-			Motion& companion_motion = registry.motions.get(companion_entity);
+		if (registry.robots.peek(companion_entity).companion) {
+			const Motion& companion_motion = registry.motions.peek(companion_entity);
 			float companion_distance = glm::distance(motion.position, companion_motion.position);
 
 			if (companion_distance < closest_distance) {
-				target_entity = companion_entity;
-				target_motion = companion_motion;
+				target_position = companion_motion.position;
 				closest_distance = companion_distance;
 			}
 		}
@@ -668,23 +742,23 @@ void handelBossRobot(Entity entity, float elapsed_ms, WorldSystem* world) {
 		}
 		else if (ra.current_state != BossRobotState::ATTACK) {
 			ra.setState(BossRobotState::ATTACK, ra.current_dir);
-			world->play_ready_attack_sound();
-			shoot_timer = 0.0f;
+			intent.play(RobotCommandType::READY_ATTACK_SOUND);
+			attack.shoot_timer = 0.0f;
 		}
 		else {
-			shoot_timer += elapsed_ms / 1000.0f;
-			if (shoot_timer >= shoot_interval) {
-				shoot_timer = 0.0f;
+			attack.shoot_timer += elapsed_ms / 1000.0f;
+			if (attack.shoot_timer >= shoot_interval) {
+				attack.shoot_timer = 0.0f;
 
 				// Fire bullets
-				vec2 central_velocity = normalize(target_motion.position - motion.position) * 185.0f;
-				createBossProjectile(motion.position, central_velocity, atan2(central_velocity.y, central_velocity.x), 10);
-				world->play_attack_sound();
+				vec2 central_velocity = normalize(target_position - motion.position) * 185.0f;
+				intent.fire_boss(motion.position, central_velocity);
+				intent.play(RobotCommandType::ATTACK_SOUND);
 
 				for (int i = -3; i <= 3; ++i) {
 					if (i == 0) continue;
 					float angle_offset = i * glm::radians(15.0f);
-					vec2 target_velocity = normalize(target_motion.position - motion.position);
+					vec2 target_velocity = normalize(target_position - motion.position);
 
 					float cos_angle = cos(angle_offset);
 					float sin_angle = sin(angle_offset);
@@ -693,15 +767,14 @@ void handelBossRobot(Entity entity, float elapsed_ms, WorldSystem* world) {
 						target_velocity.x * sin_angle + target_velocity.y * cos_angle
 					);
 
-					target_velocity = rotated_velocity * 185.0f;
-					createBossProjectile(motion.position, target_velocity, atan2(target_velocity.y, target_velocity.x), 10);
-					world->play_attack_sound();
+					intent.fire_boss(motion.position, rotated_velocity * 185.0f);
+					intent.play(RobotCommandType::ATTACK_SOUND);
 				}
 
-				projectile_count++;
-				if (projectile_count >= max_projectiles) {
-					projectile_count = 0;
-					dash_timer = 0.1f;
+				attack.volleys++;
+				if (attack.volleys >= max_projectiles) {
+					attack.volleys = 0;
+					attack.dash_timer = 0.1f;
 				}
 			}
 		}
@@ -727,30 +800,31 @@ void handelBossRobot(Entity entity, float elapsed_ms, WorldSystem* world) {
 	}
 
 	// Handle dash attack
-	if (dash_timer > 0.0f) {
+	if (attack.dash_timer > 0.0f) {
 		motion.velocity = normalize(player_motion.position - motion.position) * dash_speed;
-		dash_timer += elapsed_ms / 1000.0f;
+		attack.dash_timer += elapsed_ms / 1000.0f;
 
-		if (wall_hit(motion, player_motion)) {
-			Direction dir = a_star_ai(motion);
-		}
+		// steers around the wall, a_star_ai sets the velocity
+		if (wall_hit(motion, player_motion))
+			a_star_ai(motion);
 
 		if (collides(motion, player_motion)) {
-			Player& pl = registry.players.get(player);
-			pl.current_health -= 30;
-			dash_timer = -1.0f;
+			intent.commands.push_back({ RobotCommandType::DASH_HIT });
+			attack.dash_timer = -1.0f;
 			motion.velocity = vec2(0);
 		}
 
-		if (dash_timer >= dash_duration) {
-			dash_timer = -1.0f;
+		if (attack.dash_timer >= dash_duration) {
+			attack.dash_timer = -1.0f;
 			motion.velocity = vec2(0);
 			ra.setState(BossRobotState::IDLE, ra.current_dir);
 		}
 	}
+}
 
-	// Update animation state
-	ra.update(elapsed_ms);
+// Serial half of the boss AI, its death ends the game
+void handelBossRobot(Entity entity, float elapsed_ms, WorldSystem* world) {
+	const BossRobotAnimation& ra = registry.bossRobotAnimations.peek(entity);
 
 	// Handle boss death
 	if (registry.bossRobots.has(entity)) {
@@ -758,7 +832,7 @@ void handelBossRobot(Entity entity, float elapsed_ms, WorldSystem* world) {
 		if (ro.current_health <= 0) {
 			if (!ro.should_die) {
 				ro.should_die = true;
-				ro.death_cd = ra.getMaxFrames() * ra.FRAME_TIME * 1000.f;
+				ro.death_cd = ra.getMaxFrames() * ra.frameTime() * 1000.f;
 			}
 			else {
 				ro.death_cd -= elapsed_ms;
@@ -780,33 +854,17 @@ void handelBossRobot(Entity entity, float elapsed_ms, WorldSystem* world) {
 	}
 }
 
-void handleSpiderRobot(Entity entity, float elapsed_ms, WorldSystem* world) {
+// Serial half of the spider AI: patrolling, which shares one timer and draws from rand(), and death
+void handleSpiderRobot(Entity entity, bool patrol, float elapsed_ms) {
 	Motion& motion = registry.motions.get(entity);
 	SpiderRobotAnimation& ra = registry.spiderRobotAnimations.get(entity);
 
-	const float attack_range = 50.0f;
 	const float patrol_speed = 100.0f;
-	const float follow_speed = 50.0f;
 	const float direction_change_interval = 3.0f;
 
 	Entity player = registry.players.entities[0];
-	Motion& player_motion = registry.motions.get(player);
 
-	float distance_to_player = glm::distance(motion.position, player_motion.position);
-
-	if (distance_to_player <= attack_range) {
-		motion.velocity = vec2(0);
-		if (ra.current_state != SpiderRobotState::ATTACK) {
-			ra.setState(SpiderRobotState::ATTACK, ra.current_dir);
-			world->play_awake_sound();
-		}
-	}
-	else if (spiderShouldmv(entity)) {
-		Direction direction = bfs_ai(motion);
-		ra.setState(SpiderRobotState::WALK, direction);
-		motion.velocity = normalize(player_motion.position - motion.position) * follow_speed;
-	}
-	else {
+	if (patrol) {
 		static float patrol_timer = 0.0f;
 		patrol_timer += elapsed_ms / 1000.0f;
 
@@ -841,29 +899,89 @@ void handleSpiderRobot(Entity entity, float elapsed_ms, WorldSystem* world) {
 		if (ro.current_health <= 0) {
 			if (!ro.should_die) {
 				ro.should_die = true;
-				ro.death_cd = ra.getMaxFrames() * ra.FRAME_TIME * 1000.f;
+				ro.death_cd = ra.getMaxFrames() * ra.frameTime() * 1000.f;
 			}
 			else {
 				ro.death_cd -= elapsed_ms;
 				if (ro.death_cd < 0) {
 					Player& p = registry.players.get(player);
-					p.inventory.addItem("Robot Parts", 1);
+					p.inventory.addItem(ItemId::ROBOT_PARTS, 1);
 					registry.remove_all_components_of(entity);
 				}
 			}
 		}
 	}
+}
 
-	ra.update(elapsed_ms);
+void PhysicsSystem::think_robots(float elapsed_ms)
+{
+	robot_intent_index.clear();
+	robot_intent_count = 0;
+	if (registry.players.entities.empty())
+		return;
+
+	auto add_intent = [&](Entity entity) {
+		if (!registry.motions.has(entity))
+			return;
+		if (robot_intent_count == robot_intents.size())
+			robot_intents.emplace_back();
+		RobotIntent& intent = robot_intents[robot_intent_count];
+		intent.entity = entity;
+		intent.motion = registry.motions.peek(entity);
+		if (registry.robotAnimations.has(entity))
+			intent.robot_animation = registry.robotAnimations.peek(entity);
+		if (registry.iceRobotAnimations.has(entity))
+			intent.ice_animation = registry.iceRobotAnimations.peek(entity);
+		if (registry.spiderRobotAnimations.has(entity))
+			intent.spider_animation = registry.spiderRobotAnimations.peek(entity);
+		if (registry.bossRobotAnimations.has(entity))
+			intent.boss_animation = registry.bossRobotAnimations.peek(entity);
+		if (registry.bossRobots.has(entity))
+			intent.boss_attack = registry.bossRobots.peek(entity).attack;
+		robot_intent_index[entity.id] = (unsigned int)robot_intent_count++;
+	};
+	for (Entity entity : registry.robots.entities)
+		add_intent(entity);
+	for (Entity entity : registry.spiderRobots.entities)
+		add_intent(entity);
+	for (Entity entity : registry.bossRobots.entities)
+		add_intent(entity);
+
+	// pathfinding makes robots uneven, small ranges let the workers balance them
+	jobs.parallel_for(robot_intent_count, 4, [this, elapsed_ms](size_t begin, size_t end) {
+		for (size_t i = begin; i < end; i++)
+			think_robot_intent(robot_intents[i], elapsed_ms);
+	});
 }
 
+RobotIntent* PhysicsSystem::find_intent(Entity entity)
+{
+	auto it = robot_intent_index.find(entity.id);
+	return it != robot_intent_index.end() ? &robot_intents[it->second] : nullptr;
+}
+
+// Closed doors stop robots, their paths go around them until they open
+static void update_path_blockers() {
+	for (Entity entity : registry.doors.entities) {
+		if (!registry.motions.has(entity))
+			continue;
+		const Motion& motion = registry.motions.peek(entity);
+		vec2 half = abs(motion.bb) / 2.f;
+		pathfinder.set_blocker(entity, motion.position - half, motion.position + half, !registry.doors.peek(entity).is_open);
+	}
+	pathfinder.update();
+}
 
 void PhysicsSystem::step(float elapsed_ms, WorldSystem* world)
 {
+	// the path graph is only read while the robots think
+	update_path_blockers();
+	// robots decide in parallel against this frame's positions, the motion loop applies the decisions
+	think_robots(elapsed_ms);
+
 
 	ComponentContainer<Motion>& motion_container = registry.motions;
 	// Move entities based on the time passed, ensuring entities move at consistent speeds
-	std::vector<Entity> should_remove;
 	auto& motion_registry = registry.motions;
 	for (Entity entity : registry.spiderRobots.entities) {
 		SpiderRobot& spider = registry.spiderRobots.get(entity);
@@ -877,22 +995,30 @@ void PhysicsSystem::step(float elapsed_ms, WorldSystem* world)
 		Entity entity = motion_registry.entities[i];
 		float step_seconds = elapsed_ms / 1000.f;
 
-		bool flag = true;
 		if (registry.tiles.has(entity)) {
 			continue;
 		}
+		// indexed access bypasses get(), flag it for the save journal
+		motion_registry.mark_dirty(i);
 
 		lerp_rotate(motion);
 
 		if (registry.robots.has(entity)) {
-			handelRobot(entity, elapsed_ms, world);
+			if (RobotIntent* intent = find_intent(entity))
+				apply_robot_intent(*intent);
+			handelRobot(entity, elapsed_ms);
 		}
 		
 		if (registry.bossRobots.has(entity)) {
-			handelBossRobot(entity,elapsed_ms, world);
+			if (RobotIntent* intent = find_intent(entity))
+				apply_robot_intent(*intent);
+			handelBossRobot(entity, elapsed_ms, world);
 		}
 		if (registry.spiderRobots.has(entity)) {
-			handleSpiderRobot(entity, elapsed_ms, world);
+			RobotIntent* intent = find_intent(entity);
+			if (intent)
+				apply_robot_intent(*intent);
+			handleSpiderRobot(entity, intent && intent->spider_patrol, elapsed_ms);
 		//	printf("spidercreated here");
 			//handelBossRobot(entity, elapsed_m, world);
 
@@ -1002,52 +1128,6 @@ void PhysicsSystem::step(float elapsed_ms, WorldSystem* world)
 		motion.position += motion.velocity * step_seconds;
 
 
-		if (registry.projectile.has(entity) || registry.bossProjectile.has(entity)) {
-			if (motion.position.x < 0.0f || motion.position.x > map_width * 64.f ||
-				motion.position.y < 0.0f || motion.position.y > map_height * 64.f) {
-				registry.remove_all_components_of(entity);
-				printf("entity removed");
-				continue;
-			}
-		}
-		
-		if (registry.bossProjectile.has(entity)) {
-			bossProjectile& proj = registry.bossProjectile.get(entity);
-			// Update the time variable for sine wave calculation
-			proj.time += elapsed_ms / 1000.0f;
-			// Calculate the new vertical position based on the sine wave
-			// float sine_offset = proj.amplitude * sin(proj.frequency * proj.time);
-			// motion.position.y += sine_offset;
-			
-			// Check for out-of-bounds and remove if necessary
-			if (motion.position.x < 0.0f || motion.position.x > map_width * 64.f ||
-			motion.position.y < 0.0f || motion.position.y > map_height * 64.f) {
-				registry.remove_all_components_of(entity);
-				printf("Boss projectile removed");
-				continue;
-			}
-
-			// companion robot dmg
-			/*for (Entity robot_entity : registry.robots.entities) {
-				Robot& robot = registry.robots.get(robot_entity);
-				if (robot.companion && robot.showCaptureUI) {
-					continue;
-				}
-				if (robot.companion) { 
-					Motion& robot_motion = registry.motions.get(robot_entity);
-
-					if (collides(motion, robot_motion)) {
-						robot.current_health -= proj.dmg; 
-						registry.remove_all_components_of(entity);
-						if (robot.current_health <= 0) {
-							robot.should_die = true;
-						}
-						break; 
-					}
-				}
-			}*/
-		}
-
 		if (registry.robots.has(entity) || registry.players.has(entity)) {
 			attackbox_check(entity);
 		}
@@ -1071,11 +1151,9 @@ void PhysicsSystem::step(float elapsed_ms, WorldSystem* world)
 				if (collides(motion, motion_j))
 				{
 					Entity entity_j = motion_container.entities[j];
-					// Create a collisions event
-					// We are abusing the ECS system a bit in that we potentially insert muliple collisions for the same entity
 
 					if (registry.tiles.has(entity_j)) {
-						if (!registry.tiles.get(entity_j).walkable) {
+						if (!registry.tiles.peek(entity_j).walkable) {
 							if (registry.boids.has(entity)) {
 								Motion& motion = registry.motions.get(entity);
 								Boid& boid = registry.boids.get(entity);
@@ -1106,57 +1184,7 @@ void PhysicsSystem::step(float elapsed_ms, WorldSystem* world)
 								motion.position = pos;
 								if (registry.players.has(entity)) {
 									motion.velocity = vec2(0);
-									world->play_collision_sound();
-								}
-								if (registry.projectile.has(entity)) {
-									motion.velocity = vec2(0);
-									flag = false;
-									should_remove.push_back(entity);
-								}
-
-								if (registry.bossProjectile.has(entity)) {
-									bossProjectile& proj = registry.bossProjectile.get(entity);
-									proj.time += elapsed_ms / 1000.0f;
-									// float sine_offset = proj.amplitude * sin(proj.frequency * proj.time);
-									// motion.position.y += sine_offset;
-									motion.position += motion.velocity * (elapsed_ms / 1000.0f);
-									
-									// Check for out-of-bounds and remove if necessary
-									if (motion.position.x < 0.0f || motion.position.x > map_width * 64.f ||
-									motion.position.y < 0.0f || motion.position.y > map_height * 64.f) {
-										registry.remove_all_components_of(entity);
-										printf("Boss projectile removed\n");
-										continue;
-									}
-									
-									// Check for collision with non-walkable tiles
-									for (uint j = 0; j < motion_container.components.size(); j++) {
-										Motion& motion_j = motion_container.components[j];
-										Entity entity_j = motion_container.entities[j];
-										
-										if (registry.tiles.has(entity_j) && !registry.tiles.get(entity_j).walkable) {
-											if (collides(motion, motion_j)) {
-												if (!proj.has_bounced) {
-													// Calculate the bounce velocity in the opposite direction
-													vec2 collision_normal = glm::normalize(motion.position - motion_j.position)* 2.5f;
-													motion.target_velocity = -motion.target_velocity;
-													motion.velocity = -motion.velocity;
-
-													motion.angle += 3.14;
-													// Push the projectile far away in the opposite direction
-													// motion.position += collision_normal * 30.0f;
-													
-													proj.has_bounced = true;
-													printf("Projectile bounced and pushed to: (%.2f, %.2f)\n", motion.position.x, motion.position.y);
-												}
-												else {
-													should_remove.push_back(entity);
-													printf("Boss projectile removed after second collision\n");
-												}
-												break;
-											}
-										}
-									}
+									audio.play(SOUND_ID::COLLISION);
 								}
 							}
 						}
@@ -1166,9 +1194,7 @@ void PhysicsSystem::step(float elapsed_ms, WorldSystem* world)
 				}
 			}
 
-			if (!registry.bossProjectile.has(entity) && !registry.projectile.has(entity)) {
-				bound_check(motion);
-			}
+			bound_check(motion);
 		}
 
 		/*if (!registry.tiles.has(entity) && !registry.bossRobots.has(entity)) {
@@ -1184,11 +1210,11 @@ void PhysicsSystem::step(float elapsed_ms, WorldSystem* world)
 					// We are abusing the ECS system a bit in that we potentially insert muliple collisions for the same entity
 
 					if (registry.tiles.has(entity_j)) {
-						if (!registry.tiles.get(entity_j).walkable) {
+						if (!registry.tiles.peek(entity_j).walkable) {
 							motion.position = pos;
 							if (registry.players.has(entity)) {
        								motion.velocity = vec2(0);
-								world->play_collision_sound();
+								audio.play(SOUND_ID::COLLISION);
 							}
 							if (registry.bossProjectile.has(entity)) {
 								bossProjectile& proj = registry.bossProjectile.get(entity);
@@ -1208,7 +1234,7 @@ void PhysicsSystem::step(float elapsed_ms, WorldSystem* world)
 									Motion& motion_j = motion_container.components[j];
 									Entity entity_j = motion_container.entities[j];
 									
-									if (registry.tiles.has(entity_j) && !registry.tiles.get(entity_j).walkable) {
+									if (registry.tiles.has(entity_j) && !registry.tiles.peek(entity_j).walkable) {
 										if (collides(motion, motion_j)) {
 											if (!proj.has_bounced) {
 												float angle = atan2(motion.velocity.y, motion.velocity.x) + glm::radians(150.0f);
@@ -1247,17 +1273,14 @@ void PhysicsSystem::step(float elapsed_ms, WorldSystem* world)
 
 			if (registry.meshPtrs.has(spaceship_entity)) {
 				const Mesh* mesh = registry.meshPtrs.get(spaceship_entity);
-				if (mesh && checkMeshCollision(registry.motions.get(spaceship_entity), motion, mesh)) {
+				if (mesh && checkMeshCollision(registry.motions.peek(spaceship_entity), motion, mesh)) {
 
 					motion.position = pos;
 					motion.velocity = vec2(0.f);
 					motion.target_velocity = vec2(0.f);
 
 					if (registry.players.has(entity)) {
-						world->play_collision_sound();
-					}
-					if (registry.projectile.has(entity)) {
-						registry.remove_all_components_of(entity);
+						audio.play(SOUND_ID::COLLISION);
 					}
 
 				}
@@ -1266,11 +1289,6 @@ void PhysicsSystem::step(float elapsed_ms, WorldSystem* world)
 		}
 	}
 
-	for (Entity e : should_remove) {
-		registry.remove_all_components_of(e);
-	}
-
-
 	// Add after motion.position += motion.velocity * step_seconds;
 	// and before the robot/player checks
 
@@ -1278,79 +1296,104 @@ void PhysicsSystem::step(float elapsed_ms, WorldSystem* world)
 
 
 
-	// Check for collisions between all moving entities
-	for (uint i = 0; i < motion_container.components.size(); i++)
-	{
-		Motion& motion_i = motion_container.components[i];
-		Entity entity_i = motion_container.entities[i];
-		if (registry.tiles.has(entity_i)) {
+	// Check for collisions between all moving entities.
+	// The layer masks drop the pairs nothing reacts to before any shape test. The pair
+	// tests only read motions, so they run on the job system against the positions at
+	// this point; the pairs are then handled here in (i, j) order and reported to the
+	// world as contact events.
+	moving.clear();
+	moving_filters.clear();
+	for (uint i = 0; i < motion_container.components.size(); i++) {
+		Entity entity = motion_container.entities[i];
+		if (registry.tiles.has(entity))
 			continue;
-		}
-
-		// note starting j at i+1 to compare all (i,j) pairs only once (and to not compare with itself)
-		for (uint j = i + 1; j < motion_container.components.size(); j++)
-		{
-			Motion& motion_j = motion_container.components[j];
-			Entity entity_j = motion_container.entities[j];
-			if (registry.tiles.has(entity_j)) {
-				continue;
+		if (!registry.collisionFilters.has(entity))
+			registry.collisionFilters.insert(entity, collision_filter_for(entity));
+		const CollisionFilter& filter = registry.collisionFilters.peek(entity);
+		if (filter.layer == LAYER_NONE)
+			continue;
+		moving.push_back(i);
+		moving_filters.push_back(filter);
+	}
+	pair_hits.resize(moving.size());
+	jobs.parallel_for(moving.size(), 32, [&](size_t begin, size_t end) {
+		for (size_t a = begin; a < end; a++) {
+			std::vector<uint>& hits = pair_hits[a];
+			hits.clear();
+			const Motion& motion_a = motion_container.components[moving[a]];
+			const CollisionFilter& filter_a = moving_filters[a];
+			// note starting b at a+1 to compare all pairs only once (and to not compare with itself)
+			for (size_t b = a + 1; b < moving.size(); b++) {
+				if (filters_collide(filter_a, moving_filters[b]) && collides(motion_a, motion_container.components[moving[b]]))
+					hits.push_back((uint)b);
 			}
+		}
+	});
 
-			if (collides(motion_i, motion_j))
-			{
-				// Create a collisions event
-				// We are abusing the ECS system a bit in that we potentially insert muliple collisions for the same entity
-				static bool notification_active = false;
-				if (registry.doors.has(entity_j)) {
-					Door& door = registry.doors.get(entity_j);
-
-					if (door.is_locked || !door.is_open) {
-						// Block the player's motion
-						motion_i.position -= motion_i.velocity * (elapsed_ms / 1000.f);
-						motion_i.velocity = vec2(0);
-
-						// Check if a notification can be displayed
-						//if (!door.notification_active && door.in_range) {
-						//	static std::vector<std::string> messages = {
-						//		"Hmm, it's locked.",
-						//		"Seems like I need a keycard to open this.",
-						//		"This door won't budge.",
-						//		"Looks like I can't get through without a keycard.",
-						//		"Locked. I need a keycard. Maybe one of these robots would have it."
-						//	};
-						//	std::random_device rd;
-						//	std::mt19937 rng(rd());
-						//	std::uniform_int_distribution<int> dist(0, messages.size() - 1);
-
-						//	std::string message = messages[dist(rng)];
-						//	createNotification(message, 4.0f);
-
-						//	door.notification_active = true; // Mark the notification as active for this door
-						//}
-						//else if (!door.in_range) {
-						//	// Reset the state when out of range
-						//	door.notification_active = false;
-						//}
-
-					}
-
-					if (registry.projectile.has(entity_i)) {
-						registry.remove_all_components_of(entity_i);
-					}
-				}
-
-				// Reset notification_active after all notifications are processed
-				if (registry.notifications.entities.empty()) {
-					notification_active = false; // Allow new notifications
-				}
+	// entities are captured before handling, removing one moves others in the container
+	std::vector<ContactEvent> colliding;
+	for (size_t a = 0; a < moving.size(); a++) {
+		for (uint b : pair_hits[a]) {
+			colliding.push_back({ motion_container.entities[moving[a]], motion_container.entities[moving[b]],
+				moving_filters[a].layer, moving_filters[b].layer });
+		}
+	}
+	for (const ContactEvent& contact : colliding)
+	{
+		Entity entity_i = contact.entity;
+		Entity entity_j = contact.other;
+		if (!motion_container.has(entity_i) || !motion_container.has(entity_j))
+			continue;
+		Motion& motion_i = motion_container.components[motion_container.map_entity_componentID[entity_i]];
+		static bool notification_active = false;
+		if (registry.doors.has(entity_j)) {
+			Door& door = registry.doors.get(entity_j);
+
+			if (door.is_locked || !door.is_open) {
+				// Block the player's motion
+				motion_i.position -= motion_i.velocity * (elapsed_ms / 1000.f);
+				motion_i.velocity = vec2(0);
+
+				// Check if a notification can be displayed
+				//if (!door.notification_active && door.in_range) {
+				//	static std::vector<std::string> messages = {
+				//		"Hmm, it's locked.",
+				//		"Seems like I need a keycard to open this.",
+				//		"This door won't budge.",
+				//		"Looks like I can't get through without a keycard.",
+				//		"Locked. I need a keycard. Maybe one of these robots would have it."
+				//	};
+				//	std::random_device rd;
+				//	std::mt19937 rng(rd());
+				//	std::uniform_int_distribution<int> dist(0, messages.size() - 1);
+
+				//	std::string message = messages[dist(rng)];
+				//	createNotification(message, 4.0f);
+
+				//	door.notification_active = true; // Mark the notification as active for this door
+				//}
+				//else if (!door.in_range) {
+				//	// Reset the state when out of range
+				//	door.notification_active = false;
+				//}
 
-				registry.collisions.emplace_with_duplicates(entity_i, entity_j);
-				registry.collisions.emplace_with_duplicates(entity_j, entity_i);
 			}
 		}
+
+		// Reset notification_active after all notifications are processed
+		if (registry.notifications.entities.empty()) {
+			notification_active = false; // Allow new notifications
+		}
+
+		world->events.emit(contact);
 	}
 
+	// after the pair pass, which gave every entity a projectile may hit its filter
+	projectiles.step(elapsed_ms, world->events);
+
 	registry.attackbox.clear();
+	// every robot and boss has looked for its path by now
+	path_stats.end_frame();
 }
 
 void dumb_ai(Motion& mo) {
@@ -1361,7 +1404,7 @@ void dumb_ai(Motion& mo) {
 
 void bound_check(Motion& mo) {
 	Entity T = registry.maps.entities[0];
-	T_map m = registry.maps.get(T);
+	const T_map& m = registry.maps.peek(T);
 
 	// Calculate the boundary based on the map size and tile size
 	float map_width_px = m.tile_size * m.tile_map[0].size();
@@ -1372,17 +1415,38 @@ void bound_check(Motion& mo) {
 	mo.position.y = max(min(map_height_px - (mo.scale.y / 2), mo.position.y), mo.scale.y / 2);
 }
 
+// Tile centers of a path found for a robot, in debug mode
+static void debug_path(const std::vector<std::pair<int, int>>& path) {
+	if (path.empty() || !debug_draw.enabled(DEBUG_CATEGORY::PATHFINDING))
+		return;
+	const vec3 color = vec3(0.2f, 1.f, 0.4f);
+	std::vector<vec2> points;
+	points.reserve(path.size());
+	for (const std::pair<int, int>& tile : path)
+		points.push_back(translate_pair(tile) + vec2(32.f));
+	debug_draw.polyline(DEBUG_CATEGORY::PATHFINDING, points, color);
+	debug_draw.circle(DEBUG_CATEGORY::PATHFINDING, points.back(), 8.f, color);
+}
+
 Direction bfs_ai(Motion& mo) {
 	Entity player = registry.players.entities[0];
-	Motion& player_motion = registry.motions.get(player);
+	const Motion& player_motion = registry.motions.peek(player);
 
 	Entity T = registry.maps.entities[0];
-	T_map m = registry.maps.get(T);
+	const T_map& m = registry.maps.peek(T);
 
 	std::pair<int, int> end = translate_vec2(player_motion);
 	std::pair<int, int> start = translate_vec2(mo);
 
-	std::vector<std::pair<int, int>> temp = bfs(m.tile_map, start, end);
+	int expansions = 0;
+	auto search_start = std::chrono::steady_clock::now();
+	std::vector<std::pair<int, int>> temp = bfs(m.tile_map, start, end, expansions);
+	int64_t search_us = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - search_start).count();
+	if (temp.empty())
+		path_stats.fail(PATH_FAILURE::UNREACHABLE, expansions, search_us);
+	else
+		path_stats.record(expansions, search_us);
+	debug_path(temp);
 	if (!temp.empty()) {
 		vec2 bk = translate_pair(temp.back());
 		//std::cout << "BK first: " << bk.x << " BK second: " << bk.y << std::endl;
@@ -1417,10 +1481,10 @@ Direction bfs_ai(Motion& mo) {
 
 Direction a_star_ai(Motion& mo) {
     Entity player = registry.players.entities[0];
-    Motion& player_motion = registry.motions.get(player);
+    const Motion& player_motion = registry.motions.peek(player);
 
     Entity T = registry.maps.entities[0];
-    T_map m = registry.maps.get(T);
+    const T_map& m = registry.maps.peek(T);
 
     std::pair<int, int> end = translate_vec2(player_motion);
     std::pair<int, int> start = translate_vec2(mo);
@@ -1428,13 +1492,22 @@ Direction a_star_ai(Motion& mo) {
 	if (start.first < 0 || start.second < 0 || end.first < 0 || end.second < 0 ||
 		start.first >= m.tile_map.size() || start.second >= m.tile_map[0].size() ||
 		end.first >= m.tile_map.size() || end.second >= m.tile_map[0].size()) {
-		std::cerr << "Invalid start/end position for a_star.\n";
+		// counted instead of logged, it happens every frame while it lasts
+		path_stats.fail(PATH_FAILURE::OUT_OF_MAP, 0, 0);
 		mo.velocity = vec2(0); 
 		return Direction::LEFT; 
 	}
 
 
-    std::vector<std::pair<int, int>> path = a_star(m.tile_map, start, end);
+    int expansions = 0;
+    auto search_start = std::chrono::steady_clock::now();
+    std::vector<std::pair<int, int>> path = pathfinder.find_path(start, end, expansions);
+    int64_t search_us = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - search_start).count();
+    if (path.empty())
+        path_stats.fail(PATH_FAILURE::UNREACHABLE, expansions, search_us);
+    else
+        path_stats.record(expansions, search_us);
+    debug_path(path);
     if (!path.empty()&& path.size()>=2) {
         vec2 target = translate_pair(path[1]);
         mo.velocity = normalize(vec2(target.x + 32, target.y + 32) - mo.position) * 64.f;
@@ -1458,7 +1531,7 @@ Direction a_star_ai(Motion& mo) {
 
 std::pair<int, int> translate_vec2(Motion x) {
 	Entity T = registry.maps.entities[0];
-	T_map m = registry.maps.get(T);
+	const T_map& m = registry.maps.peek(T);
 
 
 	std::pair<int, int> temp;
@@ -1472,7 +1545,7 @@ std::pair<int, int> translate_vec2(Motion x) {
 
 vec2 translate_pair(std::pair<int, int> p) {
 	Entity T = registry.maps.entities[0];
-	T_map m = registry.maps.get(T);
+	const T_map& m = registry.maps.peek(T);
 	vec2 temp;
 	temp.x = p.second * m.tile_size;
 	temp.y = p.first * m.tile_size;
@@ -1480,7 +1553,7 @@ vec2 translate_pair(std::pair<int, int> p) {
 }
 
 
-std::vector<std::pair<int, int>> bfs(const std::vector<std::vector<int>>& tile_map, std::pair<int, int> start, std::pair<int, int> end) {
+std::vector<std::pair<int, int>> bfs(const std::vector<std::vector<int>>& tile_map, std::pair<int, int> start, std::pair<int, int> end, int& expansions) {
 	int rows = tile_map.size();
 	int cols = tile_map[0].size();
 
@@ -1506,6 +1579,7 @@ std::vector<std::pair<int, int>> bfs(const std::vector<std::vector<int>>& tile_m
 	while (!path_q.empty()) {
 		std::vector<std::pair<int, int>> current_path = path_q.front();
 		path_q.pop();
+		expansions++;
 
 		std::pair<int, int> current = current_path.back();
 
@@ -1534,62 +1608,6 @@ std::vector<std::pair<int, int>> bfs(const std::vector<std::vector<int>>& tile_m
 	return {};
 }
 
-std::vector<std::pair<int, int>> a_star(const std::vector<std::vector<int>>& tile_map, 
-        std::pair<int, int> start, std::pair<int, int> end) {
-    int rows = tile_map.size();
-    int cols = tile_map[0].size();
-
-    // Priority queue for the open set
-    using Pair = std::pair<float, std::pair<int, int>>; // (f_cost, position)
-    std::priority_queue<Pair, std::vector<Pair>, std::greater<Pair>> open_set;
-
-    // tracking costs and paths
-    std::map<std::pair<int, int>, std::pair<int, int>> came_from;
-    std::map<std::pair<int, int>, float> g_costs;
-
-    open_set.push({0, start});
-    g_costs[start] = 0;
-
-    int dirX[4] = {0, 0, -1, 1};
-    int dirY[4] = {-1, 1, 0, 0};
-
-    while (!open_set.empty()) {
-	// getting position
-        auto current = open_set.top().second; 
-        open_set.pop();
-
-        if (current == end) {
-            // Reconstruct the path
-            std::vector<std::pair<int, int>> path;
-            for (auto at = end; at != start; at = came_from[at]) {
-                path.push_back(at);
-            }
-            path.push_back(start);
-            std::reverse(path.begin(), path.end());
-            return path;
-        }
-
-        for (int i = 0; i < 4; ++i) {
-            int x = current.first + dirX[i];
-            int y = current.second + dirY[i];
-
-            if (x >= 0 && x < rows && y >= 0 && y < cols && tile_map[x][y] == 0) {
-                float tentative_g_cost = g_costs[current] + 1; // Cost to move to adjacent node
-                std::pair<int, int> neighbor = {x, y};
-
-                if (g_costs.find(neighbor) == g_costs.end() || tentative_g_cost < g_costs[neighbor]) {
-                    came_from[neighbor] = current;
-                    g_costs[neighbor] = tentative_g_cost;
-                    float h_cost = static_cast<float>(std::hypot(end.first - x, end.second - y));
-                    open_set.push({tentative_g_cost + h_cost, neighbor});
-                }
-            }
-        }
-    }
-
-    return {};
-}
-
 float lerp_float(float start, float end, float t) {
 	return start * (1.f - t) + end * t;
 }
@@ -1618,7 +1636,7 @@ void attackbox_check(Entity en) {
 		attackBox& attack_i = attack_container.components[i];
 		Entity entity_i = attack_container.entities[i];
 
-		Motion mo = registry.motions.get(en);
+		Motion mo = registry.motions.peek(en);
 
 		if (attack_hit(mo, attack_i)) {
 			if (registry.robots.has(en) && attack_i.friendly) {
@@ -1715,63 +1733,62 @@ bool inbox(const Motion& motion1, vec2 box, vec2 pos)
 
 
 bool shouldmv(Entity e) {
-	Robot r = registry.robots.get(e);
-	Motion m = registry.motions.get(e);
+	const Robot& r = registry.robots.peek(e);
+	const Motion& m = registry.motions.peek(e);
 
 	Entity pl = registry.players.entities[0];
-	Motion plm = registry.motions.get(pl);
+	const Motion& plm = registry.motions.peek(pl);
 	return inbox(plm, r.search_box, m.position) && !inbox(plm, r.attack_box, m.position) && !inbox(plm, r.panic_box, m.position);
 }
 
 bool shouldattack(Entity e) {
-	Robot r = registry.robots.get(e);
-	Motion m = registry.motions.get(e);
+	const Robot& r = registry.robots.peek(e);
+	const Motion& m = registry.motions.peek(e);
 
 	Entity pl = registry.players.entities[0];
-	Motion plm = registry.motions.get(pl);
+	const Motion& plm = registry.motions.peek(pl);
 	return inbox(plm, r.attack_box, m.position) && !inbox(plm, r.panic_box, m.position);
 }
 
 bool shouldidle(Entity e) {
-	Robot r = registry.robots.get(e);
-	Motion m = registry.motions.get(e);
+	const Robot& r = registry.robots.peek(e);
+	const Motion& m = registry.motions.peek(e);
 
 	Entity pl = registry.players.entities[0];
-	Motion plm = registry.motions.get(pl);
+	const Motion& plm = registry.motions.peek(pl);
 	return inbox(plm, r.panic_box, m.position);
 }
 
 
 bool bossShouldmv(Entity e) {
-	BossRobot r = registry.bossRobots.get(e);
-	Motion m = registry.motions.get(e);
+	const BossRobot& r = registry.bossRobots.peek(e);
+	const Motion& m = registry.motions.peek(e);
 
 	Entity pl = registry.players.entities[0];
-	Motion plm = registry.motions.get(pl);
+	const Motion& plm = registry.motions.peek(pl);
 	return inbox(plm,r.search_box,m.position)&&!inbox(plm, r.attack_box, m.position)&&!inbox(plm, r.panic_box, m.position);
 }
 bool spiderShouldmv(Entity e) {
-	SpiderRobot r = registry.spiderRobots.get(e);
-	Motion m = registry.motions.get(e);
+	const SpiderRobot& r = registry.spiderRobots.peek(e);
+	const Motion& m = registry.motions.peek(e);
 
 	Entity pl = registry.players.entities[0];
-	Motion plm = registry.motions.get(pl);
+	const Motion& plm = registry.motions.peek(pl);
 	return inbox(plm, r.search_box, m.position) && !inbox(plm, r.attack_box, m.position) && !inbox(plm, r.panic_box, m.position);
 }
 bool bossShouldattack(Entity e) {
-    BossRobot r = registry.bossRobots.get(e);
-    Motion m = registry.motions.get(e);
+    const Motion& m = registry.motions.peek(e);
 
     Entity pl = registry.players.entities[0];
-    Motion plm = registry.motions.get(pl);
+    const Motion& plm = registry.motions.peek(pl);
     
     float attack_range = 480;
 	bool player_in_range = glm::distance(plm.position, m.position) <= attack_range;
 
 	for (Entity companion_entity : registry.robots.entities) {
-		Robot& companion_robot = registry.robots.get(companion_entity);
+		const Robot& companion_robot = registry.robots.peek(companion_entity);
 		if (companion_robot.companion) {
-			Motion& companion_motion = registry.motions.get(companion_entity);
+			const Motion& companion_motion = registry.motions.peek(companion_entity);
 			if (glm::distance(companion_motion.position, m.position) <= attack_range) {
 				return true;
 			}
@@ -1783,19 +1800,18 @@ bool bossShouldattack(Entity e) {
 
 
 bool spiderShouldattack(Entity e) {
-	SpiderRobot r = registry.spiderRobots.get(e);
-	Motion m = registry.motions.get(e);
+	const Motion& m = registry.motions.peek(e);
 
 	Entity pl = registry.players.entities[0];
-	Motion plm = registry.motions.get(pl);
+	const Motion& plm = registry.motions.peek(pl);
 
 	float attack_range = 600;
 	bool player_in_range = glm::distance(plm.position, m.position) <= attack_range;
 
 	for (Entity companion_entity : registry.robots.entities) {
-		Robot& companion_robot = registry.robots.get(companion_entity);
+		const Robot& companion_robot = registry.robots.peek(companion_entity);
 		if (companion_robot.companion) {
-			Motion& companion_motion = registry.motions.get(companion_entity);
+			const Motion& companion_motion = registry.motions.peek(companion_entity);
 			if (glm::distance(companion_motion.position, m.position) <= attack_range) {
 				return true;
 			}
@@ -1805,10 +1821,10 @@ bool spiderShouldattack(Entity e) {
 	return player_in_range;
 }
 bool bossShouldidle(Entity e) {
-	BossRobot r = registry.bossRobots.get(e);
-	Motion m = registry.motions.get(e);
+	const BossRobot& r = registry.bossRobots.peek(e);
+	const Motion& m = registry.motions.peek(e);
 
 	Entity pl = registry.players.entities[0];
-	Motion plm = registry.motions.get(pl);
+	const Motion& plm = registry.motions.peek(pl);
 	return inbox(plm, r.panic_box, m.position);
 }
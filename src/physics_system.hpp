@@ -6,6 +6,69 @@
 #include "tiny_ecs_registry.hpp"
 #include "world_system.hpp"
 
+// Something a robot decided to do that has to happen on the main thread
+enum class RobotCommandType {
+	READY_ATTACK_SOUND,
+	ATTACK_SOUND,
+	AWAKE_SOUND,
+	PROJECTILE,
+	BOSS_PROJECTILE,
+	// the boss's dash reached the player
+	DASH_HIT
+};
+
+struct RobotCommand {
+	RobotCommandType type;
+	// only used by PROJECTILE and BOSS_PROJECTILE
+	vec2 position = { 0, 0 };
+	vec2 velocity = { 0, 0 };
+	float angle = 0.f;
+	bool ice = false;
+	bool friendly = false;
+};
+
+// Output of a robot's think step. The decision code runs on copies of the robot's
+// motion and animation, the apply step copies them back and runs the commands.
+struct RobotIntent {
+	Entity entity;
+	Motion motion;
+	RobotAnimation robot_animation;
+	IceRobotAnimation ice_animation;
+	SpiderRobotAnimation spider_animation;
+	BossRobotAnimation boss_animation;
+	BossAttack boss_attack;
+	// spider out of reach of the player, it patrols on a shared timer with rand() in the apply step
+	bool spider_patrol = false;
+	// reused between frames, so thinking doesn't allocate once warmed up
+	std::vector<RobotCommand> commands;
+
+	void play(RobotCommandType sound) {
+		RobotCommand command;
+		command.type = sound;
+		commands.push_back(command);
+	}
+
+	void fire(vec2 position, vec2 velocity, float angle, bool ice, bool friendly) {
+		RobotCommand command;
+		command.type = RobotCommandType::PROJECTILE;
+		command.position = position;
+		command.velocity = velocity;
+		command.angle = angle;
+		command.ice = ice;
+		command.friendly = friendly;
+		commands.push_back(command);
+	}
+
+	void fire_boss(vec2 position, vec2 velocity) {
+		RobotCommand command;
+		command.type = RobotCommandType::BOSS_PROJECTILE;
+		command.position = position;
+		command.velocity = velocity;
+		command.angle = atan2(velocity.y, velocity.x);
+		commands.push_back(command);
+	}
+};
+
 // A simple physics system that moves rigid bodies and checks for collision
 class PhysicsSystem
 {
@@ -17,7 +80,19 @@ public:
 	}
 private: 
 	bool checkMeshCollision(const Motion& motion1, const Motion& motion2, const Mesh* mesh);
-	
+
+	// Runs the read-only half of the robot, spider and boss AI for all of them on the job system
+	void think_robots(float elapsed_ms);
+	RobotIntent* find_intent(Entity entity);
+
+	std::vector<RobotIntent> robot_intents;
+	size_t robot_intent_count = 0;
+	std::unordered_map<unsigned int, unsigned int> robot_intent_index;
+
+	// scratch for the moving entity pair tests, kept so a step doesn't allocate
+	std::vector<unsigned int> moving;
+	std::vector<CollisionFilter> moving_filters;
+	std::vector<std::vector<unsigned int>> pair_hits;
 };
 
 
@@ -0,0 +1,306 @@
+#include "projectile_system.hpp"
+#include "event_bus.hpp"
+#include "job_system.hpp"
+#include "snapshot.hpp"
+#include "tiny_ecs_registry.hpp"
+
+// stlib
+#include <cmath>
+
+ProjectileSystem projectiles;
+
+// collision box of every projectile, the sprite is drawn larger
+const vec2 PROJECTILE_BB = { 32.f, 32.f };
+
+// Same layers and masks the pair pass in the physics step uses for entities
+static CollisionFilter projectile_filter(uint8_t flags) {
+	CollisionFilter filter;
+	if (flags & PROJECTILE_FRIENDLY) {
+		filter.layer = LAYER_PROJECTILE_FRIENDLY;
+		filter.mask = LAYER_ENEMY | LAYER_DOOR;
+	}
+	else if (flags & PROJECTILE_BOSS) {
+		filter.layer = LAYER_PROJECTILE_HOSTILE;
+		filter.mask = LAYER_PLAYER | LAYER_COMPANION | LAYER_DOOR;
+	}
+	else {
+		filter.layer = LAYER_PROJECTILE_HOSTILE;
+		filter.mask = LAYER_PLAYER | LAYER_COMPANION | LAYER_ENEMY | LAYER_DOOR;
+	}
+	return filter;
+}
+
+// Walks the tile grid cell by cell along from -> to, true if it passes through a wall.
+// Cells outside the grid are open, leaving the map is handled separately.
+static bool crosses_wall(const T_map& map, vec2 from, vec2 to) {
+	int rows = (int)map.tile_map.size();
+	int cols = rows > 0 ? (int)map.tile_map[0].size() : 0;
+	if (cols == 0 || map.tile_size <= 0)
+		return false;
+	float size = (float)map.tile_size;
+
+	int x = (int)floor(from.x / size);
+	int y = (int)floor(from.y / size);
+	int end_x = (int)floor(to.x / size);
+	int end_y = (int)floor(to.y / size);
+	vec2 dir = to - from;
+	int step_x = dir.x > 0 ? 1 : -1;
+	int step_y = dir.y > 0 ? 1 : -1;
+	// distance along the path, as a fraction of it, to the next cell border on each axis
+	float t_delta_x = dir.x != 0.f ? size / abs(dir.x) : INFINITY;
+	float t_delta_y = dir.y != 0.f ? size / abs(dir.y) : INFINITY;
+	float t_max_x = dir.x != 0.f ? ((step_x > 0 ? (x + 1) * size : x * size) - from.x) / dir.x : INFINITY;
+	float t_max_y = dir.y != 0.f ? ((step_y > 0 ? (y + 1) * size : y * size) - from.y) / dir.y : INFINITY;
+
+	while (true) {
+		if (x >= 0 && x < cols && y >= 0 && y < rows && map.tile_map[y][x] != 0)
+			return true;
+		if (x == end_x && y == end_y)
+			return false;
+		if (t_max_x < t_max_y) {
+			if (t_max_x > 1.f)
+				return false;
+			x += step_x;
+			t_max_x += t_delta_x;
+		}
+		else {
+			if (t_max_y > 1.f)
+				return false;
+			y += step_y;
+			t_max_y += t_delta_y;
+		}
+	}
+}
+
+static bool boxes_overlap(vec2 min1, vec2 max1, vec2 min2, vec2 max2) {
+	return min1.x <= max2.x && max1.x >= min2.x && min1.y <= max2.y && max1.y >= min2.y;
+}
+
+ProjectileSystem::ProjectileSystem() {
+	position.resize(PROJECTILE_CAPACITY);
+	velocity.resize(PROJECTILE_CAPACITY);
+	angle.resize(PROJECTILE_CAPACITY);
+	dmg.resize(PROJECTILE_CAPACITY);
+	flags.resize(PROJECTILE_CAPACITY);
+	dead.resize(PROJECTILE_CAPACITY);
+	target_hits.resize(PROJECTILE_CAPACITY);
+	ids.resize(PROJECTILE_CAPACITY);
+	index.assign(PROJECTILE_CAPACITY, PROJECTILE_CAPACITY);
+	generations.assign(PROJECTILE_CAPACITY, 0);
+	free_ids.reserve(PROJECTILE_CAPACITY);
+	// popped from the back, so the low ids are used first
+	for (uint32_t id = PROJECTILE_CAPACITY; id > 0; id--)
+		free_ids.push_back(id - 1);
+}
+
+ProjectileHandle ProjectileSystem::spawn(vec2 p, vec2 v, float a, int damage, uint8_t f) {
+	ProjectileHandle handle;
+	// a full pool drops the shot, the handle refers to nothing
+	handle.id = PROJECTILE_CAPACITY;
+	if (free_ids.empty())
+		return handle;
+
+	uint32_t id = free_ids.back();
+	free_ids.pop_back();
+	uint32_t i = count++;
+	ids[i] = id;
+	index[id] = i;
+	position[i] = p;
+	velocity[i] = v;
+	angle[i] = a;
+	dmg[i] = damage;
+	flags[i] = f;
+
+	handle.id = id;
+	handle.generation = generations[id];
+	return handle;
+}
+
+int ProjectileSystem::index_of(ProjectileHandle handle) const {
+	if (handle.id >= PROJECTILE_CAPACITY || generations[handle.id] != handle.generation)
+		return -1;
+	uint32_t i = index[handle.id];
+	return i < count ? (int)i : -1;
+}
+
+void ProjectileSystem::release(ProjectileHandle handle) {
+	int i = index_of(handle);
+	if (i >= 0)
+		release_at((uint32_t)i);
+}
+
+void ProjectileSystem::release_at(uint32_t i) {
+	uint32_t id = ids[i];
+	generations[id]++;
+	index[id] = PROJECTILE_CAPACITY;
+	free_ids.push_back(id);
+
+	// the last projectile fills the gap
+	uint32_t last = --count;
+	if (i != last) {
+		position[i] = position[last];
+		velocity[i] = velocity[last];
+		angle[i] = angle[last];
+		dmg[i] = dmg[last];
+		flags[i] = flags[last];
+		ids[i] = ids[last];
+		index[ids[i]] = i;
+	}
+}
+
+void ProjectileSystem::clear() {
+	while (count > 0)
+		release_at(count - 1);
+}
+
+void ProjectileSystem::reflect(ProjectileHandle handle) {
+	int i = index_of(handle);
+	if (i < 0)
+		return;
+	velocity[i] = -velocity[i];
+	angle[i] += 3.14f;
+	flags[i] |= PROJECTILE_FRIENDLY;
+}
+
+void ProjectileSystem::gather_targets() {
+	targets.clear();
+	const uint32_t hurtable = LAYER_PLAYER | LAYER_ENEMY | LAYER_COMPANION | LAYER_DOOR;
+	// every moving entity got its filter in the pair pass of the physics step
+	ComponentContainer<CollisionFilter>& filters = registry.collisionFilters;
+	for (size_t i = 0; i < filters.components.size(); i++) {
+		const CollisionFilter& filter = filters.components[i];
+		Entity entity = filters.entities[i];
+		if (!(filter.layer & hurtable) || !registry.motions.has(entity))
+			continue;
+		const Motion& motion = registry.motions.peek(entity);
+		vec2 half = abs(motion.bb) / 2.f;
+		targets.push_back({ entity, filter, motion.position - half, motion.position + half, filter.layer == LAYER_DOOR });
+	}
+
+	spaceship_points.clear();
+	for (Entity e : registry.spaceships.entities) {
+		if (!registry.meshPtrs.has(e) || !registry.motions.has(e))
+			continue;
+		const Mesh* mesh = registry.meshPtrs.components[registry.meshPtrs.map_entity_componentID[e]];
+		if (!mesh)
+			continue;
+		const Motion& motion = registry.motions.peek(e);
+		for (const ColoredVertex& vertex : mesh->vertices)
+			spaceship_points.push_back(motion.position + vec2(vertex.position.x * motion.scale.x, vertex.position.y * motion.scale.y));
+	}
+	if (!spaceship_points.empty()) {
+		spaceship_min = spaceship_max = spaceship_points[0];
+		for (vec2 point : spaceship_points) {
+			spaceship_min = min(spaceship_min, point);
+			spaceship_max = max(spaceship_max, point);
+		}
+	}
+}
+
+void ProjectileSystem::step(float elapsed_ms, EventBus& events) {
+	if (count == 0)
+		return;
+	float step_seconds = elapsed_ms / 1000.f;
+	gather_targets();
+	const T_map* map = registry.maps.size() > 0 ? &registry.maps.components[0] : nullptr;
+	vec2 map_max = { map_width * 64.f, map_height * 64.f };
+	vec2 half = PROJECTILE_BB / 2.f;
+
+	// each projectile only writes its own slot, the registry is only read
+	jobs.parallel_for(count, 256, [&](size_t begin, size_t end) {
+		for (size_t i = begin; i < end; i++) {
+			std::vector<uint32_t>& hits = target_hits[i];
+			hits.clear();
+			dead[i] = 0;
+
+			vec2 from = position[i];
+			vec2 to = from + velocity[i] * step_seconds;
+			if (to.x < 0.f || to.x > map_max.x || to.y < 0.f || to.y > map_max.y) {
+				dead[i] = 1;
+				continue;
+			}
+			if (map && crosses_wall(*map, from, to)) {
+				// boss projectiles come back once, staying where they were
+				if ((flags[i] & PROJECTILE_BOSS) && !(flags[i] & PROJECTILE_BOUNCED)) {
+					velocity[i] = -velocity[i];
+					angle[i] += 3.14f;
+					flags[i] |= PROJECTILE_BOUNCED;
+					to = from;
+				}
+				else {
+					dead[i] = 1;
+					continue;
+				}
+			}
+			position[i] = to;
+
+			vec2 box_min = to - half;
+			vec2 box_max = to + half;
+			if (!spaceship_points.empty() && boxes_overlap(box_min, box_max, spaceship_min, spaceship_max)) {
+				for (vec2 point : spaceship_points) {
+					if (point.x >= box_min.x && point.x <= box_max.x && point.y >= box_min.y && point.y <= box_max.y) {
+						dead[i] = 1;
+						break;
+					}
+				}
+				if (dead[i])
+					continue;
+			}
+
+			CollisionFilter filter = projectile_filter(flags[i]);
+			for (uint32_t t = 0; t < (uint32_t)targets.size(); t++) {
+				const Target& target = targets[t];
+				if (!filters_collide(filter, target.filter) || !boxes_overlap(box_min, box_max, target.min, target.max))
+					continue;
+				// doors stop every projectile, open or not
+				if (target.door) {
+					dead[i] = 1;
+					break;
+				}
+				hits.push_back(t);
+			}
+		}
+	});
+
+	for (uint32_t i = 0; i < count; i++) {
+		if (dead[i])
+			continue;
+		ProjectileHandle handle = { ids[i], generations[ids[i]] };
+		for (uint32_t t : target_hits[i])
+			events.emit(ProjectileHitEvent{ handle, targets[t].entity });
+	}
+	// back to front, so the projectile moved into a released slot was already looked at
+	for (uint32_t i = count; i > 0; i--) {
+		if (dead[i - 1])
+			release_at(i - 1);
+	}
+}
+
+void ProjectileSystem::write(SnapshotWriter& w) const {
+	for (uint32_t i = 0; i < count; i++) {
+		w.write(position[i]);
+		w.write(velocity[i]);
+		w.write(angle[i]);
+		w.write(dmg[i]);
+		w.write(flags[i]);
+	}
+}
+
+bool ProjectileSystem::read(SnapshotReader& r, uint32_t saved) {
+	clear();
+	for (uint32_t i = 0; i < saved; i++) {
+		vec2 p, v;
+		float a = 0.f;
+		int damage = 0;
+		uint8_t f = 0;
+		r.read(p);
+		r.read(v);
+		r.read(a);
+		r.read(damage);
+		r.read(f);
+		if (r.failed)
+			return false;
+		spawn(p, v, a, damage, f);
+	}
+	return true;
+}
@@ -0,0 +1,102 @@
+#pragma once
+
+// stlib
+#include <cstdint>
+#include <vector>
+
+// internal
+#include "common.hpp"
+#include "components.hpp"
+
+class EventBus;
+class SnapshotWriter;
+class SnapshotReader;
+
+// Most projectiles alive at once, spawns past it are dropped
+const uint32_t PROJECTILE_CAPACITY = 4096;
+
+enum ProjectileFlags : uint8_t {
+	PROJECTILE_ICE = 1 << 0,
+	// fired by the player or reflected by their block, hurts enemies instead of the player
+	PROJECTILE_FRIENDLY = 1 << 1,
+	// boss volley: bounces off the first wall and only hurts the player and companions
+	PROJECTILE_BOSS = 1 << 2,
+	PROJECTILE_BOUNCED = 1 << 3
+};
+
+// Refers to one projectile. It goes stale once the projectile is released, the
+// generation tells it apart from a later projectile reusing the slot.
+struct ProjectileHandle {
+	uint32_t id = 0;
+	uint32_t generation = 0;
+};
+
+// All projectiles in the game, outside the registry. The state is a set of parallel
+// arrays packed in [0, size()), a released projectile is replaced by the last one.
+// Handles go through an id table, so they stay valid while projectiles move around.
+//
+// step() moves them, drops the ones that left the map or ran into a wall, door or the
+// spaceship and reports the ones touching something they may hurt as ProjectileHitEvent.
+// Walls are found by marching each projectile's path through the level's tile grid
+// rather than by testing it against the tile entities.
+class ProjectileSystem
+{
+public:
+	ProjectileSystem();
+
+	// Returns a stale handle when the pool is full
+	ProjectileHandle spawn(vec2 position, vec2 velocity, float angle, int dmg, uint8_t flags);
+	void release(ProjectileHandle handle);
+	void clear();
+
+	// Index into the arrays, -1 once the projectile is released
+	int index_of(ProjectileHandle handle) const;
+	bool alive(ProjectileHandle handle) const { return index_of(handle) >= 0; }
+	uint32_t size() const { return count; }
+
+	// Turns a projectile around and hands it to the player, for blocked shots
+	void reflect(ProjectileHandle handle);
+
+	void step(float elapsed_ms, EventBus& events);
+
+	void write(SnapshotWriter& w) const;
+	bool read(SnapshotReader& r, uint32_t count);
+
+	// [0, size()) is live
+	std::vector<vec2> position;
+	std::vector<vec2> velocity;
+	std::vector<float> angle;
+	std::vector<int> dmg;
+	std::vector<uint8_t> flags;
+
+private:
+	// What a projectile can run into this step, gathered once per step
+	struct Target {
+		Entity entity;
+		CollisionFilter filter;
+		vec2 min;
+		vec2 max;
+		bool door;
+	};
+
+	void release_at(uint32_t index);
+	void gather_targets();
+
+	uint32_t count = 0;
+	// dense index -> id, and id -> dense index or PROJECTILE_CAPACITY while free
+	std::vector<uint32_t> ids;
+	std::vector<uint32_t> index;
+	std::vector<uint32_t> generations;
+	std::vector<uint32_t> free_ids;
+
+	// scratch, kept so a step doesn't allocate
+	std::vector<Target> targets;
+	std::vector<vec2> spaceship_points;
+	vec2 spaceship_min = { 0.f, 0.f };
+	vec2 spaceship_max = { 0.f, 0.f };
+	std::vector<uint8_t> dead;
+	std::vector<std::vector<uint32_t>> target_hits;
+};
+
+// Shared by the physics, world and render systems
+extern ProjectileSystem projectiles;
@@ -5,6 +5,7 @@
 #include "inventory.hpp"
 #include "tiny_ecs_registry.hpp"
 #include "world_system.hpp"
+#include "projectile_system.hpp"
 // fonts
 #include <ft2build.h>
 #include FT_FREETYPE_H
@@ -17,33 +18,89 @@
 #include <assert.h>
 #include <fstream>			// for ifstream
 #include <sstream>			// for ostringstream
-void RenderSystem::drawTexturedMesh(Entity entity, const mat3& projection)
+#include <cstddef>			// for offsetof
+void RenderSystem::extractSprite(Entity entity, RenderPacket& packet)
 {
-	glBindVertexArray(default_vao);
-	Motion& motion = registry.motions.get(entity);
-	Transform transform;
-	vec2 render_position = motion.position - camera_position;
-	transform.translate(render_position);
-	transform.rotate(motion.angle);
-	transform.scale(motion.scale);
-	// Apply scaling back to 1.0
-	transform.scale(vec2(1.0f, 1.0f));
+	// peek, the render packet is built every frame and must not mark the autosave journal dirty
+	const Motion& motion = registry.motions.peek(entity);
+	assert(registry.renderRequests.has(entity));
+	const RenderRequest& render_request = registry.renderRequests.peek(entity);
 
+	SpriteDraw sprite;
+	sprite.position = motion.position - packet.camera_position;
+	sprite.angle = motion.angle;
+	sprite.scale = motion.scale;
 	if (registry.players.has(entity)) {
-		transform.scale(vec2(1.20f, 1.20f));
+		sprite.scale *= 1.20f;
+	}
+	sprite.texture = render_request.used_texture;
+	sprite.effect = render_request.used_effect;
+	sprite.geometry = render_request.used_geometry;
+	if (registry.colors.has(entity)) {
+		sprite.color = registry.colors.peek(entity);
 	}
 
 	if (debugging.in_debug_mode) {
-		drawBoundingBox(entity, projection);
-		drawReactionBox(entity, projection);
-		drawBossReactionBox(entity, projection);
+		extractDebugBoxes(entity, packet);
 	}
 
-	assert(registry.renderRequests.has(entity));
-	const RenderRequest& render_request = registry.renderRequests.get(entity);
+	std::pair<vec2, vec2> coords;
+	bool animated = true;
+	if (render_request.used_texture == TEXTURE_ASSET_ID::TILE_ATLAS ||
+		render_request.used_texture == TEXTURE_ASSET_ID::TILE_ATLAS_LEVELS) {
+		assert(registry.tiles.has(entity));
+		const Tile& tile = registry.tiles.peek(entity);
+		const TileSetComponent& tileset_component = registry.tilesets.peek(registry.tilesets.entities[0]);
+		const TileData& tile_data = tileset_component.tileset.getTileData(tile.tile_id);
+		sprite.uv = SpriteUV::TILE;
+		sprite.top_left = tile_data.top_left;
+		sprite.bottom_right = tile_data.bottom_right;
+		packet.sprites.push_back(sprite);
+		return;
+	}
+	else if (render_request.used_effect == EFFECT_ASSET_ID::SPACESHIP) {
+		animated = false;
+	}
+	else if (registry.animations.has(entity) && render_request.used_texture == TEXTURE_ASSET_ID::PLAYER_FULLSHEET) {
+		coords = registry.animations.peek(entity).getCurrentTexCoords();
+	}
+	else if (registry.doorAnimations.has(entity) && (render_request.used_texture == TEXTURE_ASSET_ID::RIGHTDOORSHEET || render_request.used_texture == TEXTURE_ASSET_ID::BOTTOMDOORSHEET)) {
+		coords = registry.doorAnimations.peek(entity).getCurrentTexCoords();
+	}
+	else if (registry.robotAnimations.has(entity) && (render_request.used_texture == TEXTURE_ASSET_ID::CROCKBOT_FULLSHEET || render_request.used_texture == TEXTURE_ASSET_ID::COMPANION_CROCKBOT_FULLSHEET)) {
+		coords = registry.robotAnimations.peek(entity).getCurrentTexCoords();
+	}
+	else if (registry.iceRobotAnimations.has(entity) && (render_request.used_texture == TEXTURE_ASSET_ID::ICE_ROBOT_FULLSHEET || render_request.used_texture == TEXTURE_ASSET_ID::COMPANION_ICE_ROBOT_FULLSHEET)) {
+		coords = registry.iceRobotAnimations.peek(entity).getCurrentTexCoords();
+	}
+	else if (registry.bossRobotAnimations.has(entity) && render_request.used_texture == TEXTURE_ASSET_ID::BOSS_FULLSHEET) {
+		coords = registry.bossRobotAnimations.peek(entity).getCurrentTexCoords();
+	}
+	else if (registry.spiderRobotAnimations.has(entity) && render_request.used_texture == TEXTURE_ASSET_ID::SPIDERROBOT_FULLSHEET) {
+		coords = registry.spiderRobotAnimations.peek(entity).getCurrentTexCoords();
+	}
+	else {
+		animated = false;
+	}
+
+	if (animated) {
+		sprite.uv = SpriteUV::SHEET;
+		sprite.top_left = coords.first;
+		sprite.bottom_right = coords.second;
+	}
+	packet.sprites.push_back(sprite);
+}
+
+void RenderSystem::drawSprite(const SpriteDraw& sprite, const mat3& projection)
+{
+	glBindVertexArray(default_vao);
+	Transform transform;
+	transform.translate(sprite.position);
+	transform.rotate(sprite.angle);
+	transform.scale(sprite.scale);
 
 	// Select shader program
-	const GLuint used_effect_enum = (GLuint)render_request.used_effect;
+	const GLuint used_effect_enum = (GLuint)sprite.effect;
 	assert(used_effect_enum != (GLuint)EFFECT_ASSET_ID::EFFECT_COUNT);
 	const GLuint program = (GLuint)effects[used_effect_enum];
 
@@ -52,27 +109,13 @@ void RenderSystem::drawTexturedMesh(Entity entity, const mat3& projection)
 	gl_has_errors();
 
 	// Set up the tile-specific texture and vertices
-	if (render_request.used_texture == TEXTURE_ASSET_ID::TILE_ATLAS ||
-		render_request.used_texture == TEXTURE_ASSET_ID::TILE_ATLAS_LEVELS) {
-
-		assert(registry.tiles.has(entity));
-		const Tile& tile = registry.tiles.get(entity);
-
-		// Get the texture ID based on the tile atlas type
-		GLuint texture_id = texture_gl_handles[(GLuint)tile.atlas];
-		glBindTexture(GL_TEXTURE_2D, texture_id);
-		gl_has_errors();
-
-		// Get tile data for the tile atlas
-		const TileSetComponent& tileset_component = registry.tilesets.get(registry.tilesets.entities[0]);
-		const TileData& tile_data = tileset_component.tileset.getTileData(tile.tile_id);
-
+	if (sprite.uv == SpriteUV::TILE) {
 		// Create vertices using tile's texture coordinates
 		TexturedVertex vertices[4] = {
-			{ vec3(-0.5f, 0.5f, -0.1f), tile_data.top_left },   // top-left
-			{ vec3(0.5f, 0.5f, -0.1f), vec2(tile_data.bottom_right.x, tile_data.top_left.y) },  // top-right
-			{ vec3(0.5f, -0.5f, -0.1f), tile_data.bottom_right },  // bottom-right
-			{ vec3(-0.5f, -0.5f, -0.1f), vec2(tile_data.top_left.x, tile_data.bottom_right.y) }  // bottom-left
+			{ vec3(-0.5f, 0.5f, -0.1f), sprite.top_left },   // top-left
+			{ vec3(0.5f, 0.5f, -0.1f), vec2(sprite.bottom_right.x, sprite.top_left.y) },  // top-right
+			{ vec3(0.5f, -0.5f, -0.1f), sprite.bottom_right },  // bottom-right
+			{ vec3(-0.5f, -0.5f, -0.1f), vec2(sprite.top_left.x, sprite.bottom_right.y) }  // bottom-left
 		};
 
 		// Setup the VBO and IBO for the tiles
@@ -93,13 +136,9 @@ void RenderSystem::drawTexturedMesh(Entity entity, const mat3& projection)
 		gl_has_errors();
 	}
 
-	else if (render_request.used_effect == EFFECT_ASSET_ID::SPACESHIP) {
-		GLuint program = effects[(GLuint)EFFECT_ASSET_ID::SPACESHIP];
-		glUseProgram(program);
-		gl_has_errors();
-
-		const GLuint vbo = vertex_buffers[(GLuint)render_request.used_geometry];
-		const GLuint ibo = index_buffers[(GLuint)render_request.used_geometry];
+	else if (sprite.effect == EFFECT_ASSET_ID::SPACESHIP) {
+		const GLuint vbo = vertex_buffers[(GLuint)sprite.geometry];
+		const GLuint ibo = index_buffers[(GLuint)sprite.geometry];
 		glBindBuffer(GL_ARRAY_BUFFER, vbo);
 		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ibo);
 		gl_has_errors();
@@ -116,21 +155,13 @@ void RenderSystem::drawTexturedMesh(Entity entity, const mat3& projection)
 			sizeof(ColoredVertex), (void*)sizeof(vec3));
 		gl_has_errors();
 
-		Transform transform;
-		vec2 render_position = motion.position - camera_position;
-		transform.translate(render_position);
-		transform.rotate(motion.angle);
-		transform.scale(motion.scale);
-
 		GLint transform_loc = glGetUniformLocation(program, "transform");
 		GLint projection_loc = glGetUniformLocation(program, "projection");
 		GLint color_uloc = glGetUniformLocation(program, "fcolor");
 
 		glUniformMatrix3fv(transform_loc, 1, GL_FALSE, (float*)&transform.mat);
 		glUniformMatrix3fv(projection_loc, 1, GL_FALSE, (float*)&projection);
-
-		vec3 color = registry.colors.has(entity) ? registry.colors.get(entity) : vec3(1.0f);
-		glUniform3fv(color_uloc, 1, (float*)&color);
+		glUniform3fv(color_uloc, 1, (float*)&sprite.color);
 		gl_has_errors();
 
 		GLsizei num_indices = 0;
@@ -142,41 +173,19 @@ void RenderSystem::drawTexturedMesh(Entity entity, const mat3& projection)
 		return;
 	}
 
-
-	
 	else {
 		// Render non-tile entities
-		const GLuint vbo = vertex_buffers[(GLuint)render_request.used_geometry];
-		const GLuint ibo = index_buffers[(GLuint)render_request.used_geometry];
+		const GLuint vbo = vertex_buffers[(GLuint)sprite.geometry];
+		const GLuint ibo = index_buffers[(GLuint)sprite.geometry];
 
 		glBindBuffer(GL_ARRAY_BUFFER, vbo);
 		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ibo);
 		gl_has_errors();
 
-
-		if (registry.animations.has(entity) && render_request.used_texture == TEXTURE_ASSET_ID::PLAYER_FULLSHEET) {
-			// Player with animation
-			const auto& anim = registry.animations.get(entity);
-			std::pair<vec2, vec2> coords = anim.getCurrentTexCoords();
-			vec2 top_left = coords.first;
-			vec2 bottom_right = coords.second;
-
-
-			TexturedVertex vertices[4] = {
-			{{-0.5f, +0.5f, 0.f}, {top_left.x, bottom_right.y}},
-			{{+0.5f, +0.5f, 0.f}, {bottom_right.x, bottom_right.y}},
-			{{+0.5f, -0.5f, 0.f}, {bottom_right.x, top_left.y}},
-			{{-0.5f, -0.5f, 0.f}, {top_left.x, top_left.y}}
-			};
-
-			glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_DYNAMIC_DRAW);
-		}
-
-		else if (registry.doorAnimations.has(entity) && (render_request.used_texture == TEXTURE_ASSET_ID::RIGHTDOORSHEET || render_request.used_texture == TEXTURE_ASSET_ID::BOTTOMDOORSHEET)) {
-			const auto& anim = registry.doorAnimations.get(entity);
-			std::pair<vec2, vec2> coords = anim.getCurrentTexCoords();
-			vec2 top_left = coords.first;
-			vec2 bottom_right = coords.second;
+		if (sprite.uv == SpriteUV::SHEET) {
+			// current frame of the animation sheet
+			vec2 top_left = sprite.top_left;
+			vec2 bottom_right = sprite.bottom_right;
 
 			TexturedVertex vertices[4] = {
 				{{-0.5f, +0.5f, 0.f}, {top_left.x, bottom_right.y}},     // Top-left
@@ -187,79 +196,6 @@ void RenderSystem::drawTexturedMesh(Entity entity, const mat3& projection)
 
 			glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_DYNAMIC_DRAW);
 		}
-
-		else if (registry.robotAnimations.has(entity) && render_request.used_texture == TEXTURE_ASSET_ID::CROCKBOT_FULLSHEET || render_request.used_texture == TEXTURE_ASSET_ID::COMPANION_CROCKBOT_FULLSHEET) {
-				// Player with animation
-				const auto& anim = registry.robotAnimations.get(entity);
-				std::pair<vec2, vec2> coords = anim.getCurrentTexCoords();
-				vec2 top_left = coords.first;
-				vec2 bottom_right = coords.second;
-
-
-				TexturedVertex vertices[4] = {
-				{{-0.5f, +0.5f, 0.f}, {top_left.x, bottom_right.y}},
-				{{+0.5f, +0.5f, 0.f}, {bottom_right.x, bottom_right.y}},
-				{{+0.5f, -0.5f, 0.f}, {bottom_right.x, top_left.y}},
-				{{-0.5f, -0.5f, 0.f}, {top_left.x, top_left.y}}
-				};
-
-				glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_DYNAMIC_DRAW);
-			//	drawRobotHealthBar(entity, projection);
-			
-		}
-		else if (registry.iceRobotAnimations.has(entity) && render_request.used_texture == TEXTURE_ASSET_ID::ICE_ROBOT_FULLSHEET  || render_request.used_texture == TEXTURE_ASSET_ID::COMPANION_ICE_ROBOT_FULLSHEET) {
-			// Player with animation
-			const auto& anim = registry.iceRobotAnimations.get(entity);
-			std::pair<vec2, vec2> coords = anim.getCurrentTexCoords();
-			vec2 top_left = coords.first;
-			vec2 bottom_right = coords.second;
-
-
-			TexturedVertex vertices[4] = {
-			{{-0.5f, +0.5f, 0.f}, {top_left.x, bottom_right.y}},
-			{{+0.5f, +0.5f, 0.f}, {bottom_right.x, bottom_right.y}},
-			{{+0.5f, -0.5f, 0.f}, {bottom_right.x, top_left.y}},
-			{{-0.5f, -0.5f, 0.f}, {top_left.x, top_left.y}}
-			};
-
-			glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_DYNAMIC_DRAW);
-			//	drawRobotHealthBar(entity, projection);
-
-		}
-		else if (registry.bossRobotAnimations.has(entity) && render_request.used_texture == TEXTURE_ASSET_ID::BOSS_FULLSHEET) {
-				// Player with animation
-				const auto& anim = registry.bossRobotAnimations.get(entity);
-				std::pair<vec2, vec2> coords = anim.getCurrentTexCoords();
-				vec2 top_left = coords.first;
-				vec2 bottom_right = coords.second;
-
-
-				TexturedVertex vertices[4] = {
-				{{-0.5f, +0.5f, 0.f}, {top_left.x, bottom_right.y}},
-				{{+0.5f, +0.5f, 0.f}, {bottom_right.x, bottom_right.y}},
-				{{+0.5f, -0.5f, 0.f}, {bottom_right.x, top_left.y}},
-				{{-0.5f, -0.5f, 0.f}, {top_left.x, top_left.y}}
-				};
-
-				glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_DYNAMIC_DRAW);
-		} 
-		else if (registry.spiderRobotAnimations.has(entity) && render_request.used_texture == TEXTURE_ASSET_ID::SPIDERROBOT_FULLSHEET) {
-			// Player with animation
-			const auto& anim = registry.spiderRobotAnimations.get(entity);
-			std::pair<vec2, vec2> coords = anim.getCurrentTexCoords();
-			vec2 top_left = coords.first;
-			vec2 bottom_right = coords.second;
-
-
-			TexturedVertex vertices[4] = {
-			{{-0.5f, +0.5f, 0.f}, {top_left.x, bottom_right.y}},
-			{{+0.5f, +0.5f, 0.f}, {bottom_right.x, bottom_right.y}},
-			{{+0.5f, -0.5f, 0.f}, {bottom_right.x, top_left.y}},
-			{{-0.5f, -0.5f, 0.f}, {top_left.x, top_left.y}}
-			};
-
-			glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_DYNAMIC_DRAW);
-		}
 		else {
 			TexturedVertex vertices[4] = {
 				{{-0.5f, +0.5f, 0.f}, {0.f, 1.f}},  
@@ -292,7 +228,7 @@ void RenderSystem::drawTexturedMesh(Entity entity, const mat3& projection)
 
 	// Activate the texture
 	glActiveTexture(GL_TEXTURE0);
-	GLuint texture_id = texture_gl_handles[(GLuint)render_request.used_texture];
+	GLuint texture_id = texture_gl_handles[(GLuint)sprite.texture];
 	glBindTexture(GL_TEXTURE_2D, texture_id);
 
 	// Set texture parameters (optional for tiles)
@@ -302,8 +238,7 @@ void RenderSystem::drawTexturedMesh(Entity entity, const mat3& projection)
 
 	// Set uniform values for the shader
 	GLint color_uloc = glGetUniformLocation(program, "fcolor");
-	const vec3 color = registry.colors.has(entity) ? registry.colors.get(entity) : vec3(1);
-	glUniform3fv(color_uloc, 1, (float*)&color);
+	glUniform3fv(color_uloc, 1, (float*)&sprite.color);
 	gl_has_errors();
 
 	// Get the number of indices
@@ -324,17 +259,70 @@ void RenderSystem::drawTexturedMesh(Entity entity, const mat3& projection)
 	glDrawElements(GL_TRIANGLES, num_indices, GL_UNSIGNED_SHORT, nullptr);
 	gl_has_errors();
 }
-void RenderSystem::drawToScreen()
+GLuint RenderSystem::postProgram(uint32_t passes)
+{
+	GLuint& program = post_programs[passes];
+	if (program != 0)
+		return program;
+
+	std::string defines = "#define POST_VARIANT\n";
+	if (passes & POST_FADE)
+		defines += "#define POST_FADE\n";
+	if (passes & POST_DARKEN)
+		defines += "#define POST_DARKEN\n";
+	if (passes & POST_NIGHT)
+		defines += "#define POST_NIGHT\n";
+	program = shaders.get(effect_paths[(GLuint)EFFECT_ASSET_ID::SCREEN], defines);
+	return program;
+}
+
+void RenderSystem::reloadShaders()
+{
+#ifndef NDEBUG
+	double now = glfwGetTime();
+	if (now < next_shader_check)
+		return;
+	next_shader_check = now + 0.5;
+	// relinking resets the uniforms, the font's projection is the only one set just once
+	if (shaders.reload_changed() > 0)
+		setFontProjection();
+#endif
+}
+
+void RenderSystem::drawToScreen(const RenderPacket& packet)
 {
+	// Only the effects in use this frame go into the shader
+	uint32_t passes = 0;
+	if (packet.fade_in_factor > 0.f)
+		passes |= POST_FADE;
+	if (packet.darken_screen_factor > 0.f)
+		passes |= POST_DARKEN;
+	if (packet.nighttime_factor > 0.f)
+		passes |= POST_NIGHT;
+
+	int world_width = (int)(packet.frame_width * packet.render_scale);
+	int world_height = (int)(packet.frame_height * packet.render_scale);
+
+	// Nothing to shade, a blit copies and upscales the world
+	if (passes == 0) {
+		glBindFramebuffer(GL_READ_FRAMEBUFFER, frame_buffer);
+		glBindFramebuffer(GL_DRAW_FRAMEBUFFER, 0);
+		glViewport(0, 0, packet.frame_width, packet.frame_height);
+		glBlitFramebuffer(0, 0, world_width, world_height, 0, 0, packet.frame_width, packet.frame_height,
+			GL_COLOR_BUFFER_BIT, world_width == packet.frame_width ? GL_NEAREST : GL_LINEAR);
+		glBindFramebuffer(GL_FRAMEBUFFER, 0);
+		gl_has_errors();
+		return;
+	}
+
 	// Setting shaders
-	glUseProgram(effects[(GLuint)EFFECT_ASSET_ID::SCREEN]);
+	const GLuint screen_program = postProgram(passes);
+	glUseProgram(screen_program);
 	gl_has_errors();
 
 	// Clearing backbuffer
-	int w, h;
-	glfwGetFramebufferSize(window, &w, &h);
 	glBindFramebuffer(GL_FRAMEBUFFER, 0);
-	glViewport(0, 0, w, h);
+	glViewport(0, 0, packet.frame_width, packet.frame_height);
 	glDepthRange(0, 10);
 	glClearColor(1.f, 0, 0, 1.0);
 	glClearDepth(1.f);
@@ -350,79 +338,26 @@ void RenderSystem::drawToScreen()
 	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, index_buffers[(GLuint)GEOMETRY_BUFFER_ID::SCREEN_TRIANGLE]);
 	gl_has_errors();
 
-	// Get shader program
-	const GLuint screen_program = effects[(GLuint)EFFECT_ASSET_ID::SCREEN];
-
 	// Set uniforms
-	GLuint fade_in_uloc = glGetUniformLocation(screen_program, "fade_in_factor");
-	GLuint darken_uloc = glGetUniformLocation(screen_program, "darken_screen_factor");
-	GLuint nighttime_uloc = glGetUniformLocation(screen_program, "nighttime_factor");
-
-	ScreenState& screen = registry.screenStates.get(screen_state_entity);
-	glUniform1f(fade_in_uloc, screen.fade_in_factor);
-	glUniform1f(darken_uloc, screen.darken_screen_factor);
-	glUniform1f(nighttime_uloc, screen.nighttime_factor);
-
-	if (!playing_cutscene) {
-		if (screen.nighttime_factor > 0.0f && registry.players.has(player)) {
-			Motion& motion = registry.motions.get(player);
-			vec2 player_world_position = motion.position;
-			// if camera position is not moving  on the y axis
-			float ndc_x;
-			float ndc_y;
-
-			if (camera_position.y == 0) {
-				ndc_x = (player_world_position.x - camera_position.x) / window_width_px;
-				ndc_y = 0.5f + -((player_world_position.y / window_height_px) - 0.5f);
-
-			}
-
-			else if (camera_position.y == 1840.0f) {
-				int map_height_px = map_height * 64;
-				ndc_x = (player_world_position.x - camera_position.x) / window_width_px;
-
-				ndc_y = 2.465f - ((player_world_position.y) / window_height_px) * 0.64f;
+	GLuint uv_scale_uloc = glGetUniformLocation(screen_program, "uv_scale");
+	glUniform2f(uv_scale_uloc, (float)world_width / packet.frame_width, (float)world_height / packet.frame_height);
+	if (passes & POST_FADE)
+		glUniform1f(glGetUniformLocation(screen_program, "fade_in_factor"), packet.fade_in_factor);
+	if (passes & POST_DARKEN)
+		glUniform1f(glGetUniformLocation(screen_program, "darken_screen_factor"), packet.darken_screen_factor);
+	if (passes & POST_NIGHT)
+		glUniform1f(glGetUniformLocation(screen_program, "nighttime_factor"), packet.nighttime_factor);
 
-			}
-			else {
-				ndc_x = (player_world_position.x - camera_position.x) / window_width_px;
-				ndc_y = (player_world_position.y - camera_position.y) / window_height_px;
-			}
-			//	printf("Camera Position: (%.2f, %.2f)\n", camera_position.x, camera_position.y);
-			GLuint spotlight_center_uloc = glGetUniformLocation(screen_program, "spotlight_center");
-			GLuint spotlight_radius_uloc = glGetUniformLocation(screen_program, "spotlight_radius");
+	if (packet.spotlight && (passes & POST_NIGHT)) {
+		GLuint spotlight_center_uloc = glGetUniformLocation(screen_program, "spotlight_center");
+		GLuint spotlight_radius_uloc = glGetUniformLocation(screen_program, "spotlight_radius");
 
-			vec2 spotlight_center = vec2(ndc_x, ndc_y);
-			float spotlight_radius = 0.25f;
+		float spotlight_radius = 0.25f;
 
-			glUniform2fv(spotlight_center_uloc, 1, glm::value_ptr(spotlight_center));
-			glUniform1f(spotlight_radius_uloc, spotlight_radius);
-		}
+		glUniform2fv(spotlight_center_uloc, 1, glm::value_ptr(packet.spotlight_center));
+		glUniform1f(spotlight_radius_uloc, spotlight_radius);
 	}
-	//vec2 door_position = vec2(64 * 21, 64 * 7); // Door's position in world coordinates
-	//float glow_radius = 0.2f;
-	//float glow_intensity = 0.5f;
-
-	//// Calculate the door position in texture coordinates relative to the camera
-	//float glow_texcoord_x = (door_position.x - camera_position.x) / window_width_px;
-	//float glow_texcoord_y = (door_position.y - camera_position.y) / window_height_px;
-
-	//// Pass uniforms to the shader
-	//GLuint glow_center_uloc = glGetUniformLocation(screen_program, "glow_center");
-	//GLuint glow_radius_uloc = glGetUniformLocation(screen_program, "glow_radius");
-	//GLuint glow_intensity_uloc = glGetUniformLocation(screen_program, "glow_intensity");
-
-	//// Pass the current time to the shader
-	//float current_time = static_cast<float>(glfwGetTime());
-	//GLuint time_uloc = glGetUniformLocation(screen_program, "time");
-
-	//glUniform1f(time_uloc, current_time);
-	//glUniform2f(glow_center_uloc, glow_texcoord_x, glow_texcoord_y); // Glow center in texture coordinates
-	//glUniform1f(glow_radius_uloc, glow_radius);
-	//glUniform1f(glow_intensity_uloc, glow_intensity);
-
-	//gl_has_errors();
-
+	gl_has_errors();
 
 	// Set vertex position and texture coordinates
 	GLint in_position_loc = glGetAttribLocation(screen_program, "in_position");
@@ -440,14 +375,9 @@ void RenderSystem::drawToScreen()
 	gl_has_errors();
 }
 
-void RenderSystem::drawSpaceshipTexture(Entity entity, const mat3& projection)
+void RenderSystem::drawSpaceshipTexture(const SpriteDraw& sprite, const mat3& projection)
 {
-	assert(registry.motions.has(entity));
-	Motion& motion = registry.motions.get(entity);
-	assert(registry.renderRequests.has(entity));
-	const RenderRequest& render_request = registry.renderRequests.get(entity);
-
-	assert(render_request.used_texture == TEXTURE_ASSET_ID::SPACESHIP);
+	assert(sprite.texture == TEXTURE_ASSET_ID::SPACESHIP);
 
 	GLuint program = effects[(GLuint)EFFECT_ASSET_ID::TEXTURED];
 	glUseProgram(program);
@@ -459,12 +389,12 @@ void RenderSystem::drawSpaceshipTexture(Entity entity, const mat3& projection)
 	gl_has_errors();
 
 	Transform transform;
-	vec2 render_position = motion.position - camera_position;
+	vec2 render_position = sprite.position;
 	render_position.y += 0;
 	render_position.x += 2;
 	transform.translate(render_position);
-	transform.rotate(motion.angle);
-	transform.scale(vec2(motion.scale.x * 1.07f, motion.scale.y * 1.33f));
+	transform.rotate(sprite.angle);
+	transform.scale(vec2(sprite.scale.x * 1.07f, sprite.scale.y * 1.33f));
 
 	GLint transform_loc = glGetUniformLocation(program, "transform");
 	GLint projection_loc = glGetUniformLocation(program, "projection");
@@ -514,277 +444,274 @@ void RenderSystem::drawSpaceshipTexture(Entity entity, const mat3& projection)
 
 
 
-// Render our game world
-// http://www.opengl-tutorial.org/intermediate-tutorials/tutorial-14-render-to-texture/
-void RenderSystem::draw()
+// True if any part of the entity is within the camera's frame
+static bool in_camera_frame(const Motion& motion, vec2 camera_position)
 {
-	if (show_start_screen) {
-		int w, h;
-		glfwGetFramebufferSize(window, &w, &h);
-
-
-		glBindFramebuffer(GL_FRAMEBUFFER, 0);
-		gl_has_errors();
-
-		glClearColor(0.f, 0.f, 0.f, 1.0f);
-		glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
-		 
-		glUseProgram(effects[(GLuint)EFFECT_ASSET_ID::SCREEN]);
-		gl_has_errors();
-
-		glActiveTexture(GL_TEXTURE0);
-		glBindTexture(GL_TEXTURE_2D, texture_gl_handles[(GLuint)TEXTURE_ASSET_ID::START_SCREEN]);
-		gl_has_errors();
-
-		glBindVertexArray(startscreen_vao);
-		glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
-		glBindVertexArray(0);
-		gl_has_errors();
+	vec2 size = abs(motion.scale);
+	return motion.position.x + size.x / 2 >= camera_position.x &&
+		motion.position.x - size.x / 2 <= camera_position.x + window_width_px &&
+		motion.position.y + size.y / 2 >= camera_position.y &&
+		motion.position.y - size.y / 2 <= camera_position.y + window_height_px;
+}
 
-		renderStartScreen();
-		helpOverlay.render();
-		glfwSwapBuffers(window);
+void RenderSystem::extract(RenderPacket& packet)
+{
+	// GLFW may only be queried from the main thread
+	glfwGetFramebufferSize(window, &packet.frame_width, &packet.frame_height); // Note, this will be 2x the resolution given to glfwCreateWindow on retina displays
+	double mouse_x, mouse_y;
+	glfwGetCursorPos(window, &mouse_x, &mouse_y);
+	packet.cursor = vec2((float)mouse_x, (float)mouse_y);
+
+	packet.camera_position = camera_position;
+	packet.start_screen = show_start_screen;
+	packet.cutscene = playing_cutscene;
+	packet.sprites.clear();
+	packet.debug_lines.clear();
+	packet.particles.clear();
+	if (show_start_screen) {
 		return;
 	}
 
+	const ScreenState& screen = registry.screenStates.peek(screen_state_entity);
+	packet.fade_in_factor = screen.fade_in_factor;
+	packet.darken_screen_factor = screen.darken_screen_factor;
+	packet.nighttime_factor = screen.nighttime_factor;
+	packet.render_scale = render_scale;
+	packet.spotlight = !playing_cutscene && screen.nighttime_factor > 0.0f && registry.players.has(player);
+	if (packet.spotlight) {
+		vec2 player_world_position = registry.motions.peek(player).position;
+		// if camera position is not moving  on the y axis
+		float ndc_x;
+		float ndc_y;
+
+		if (camera_position.y == 0) {
+			ndc_x = (player_world_position.x - camera_position.x) / window_width_px;
+			ndc_y = 0.5f + -((player_world_position.y / window_height_px) - 0.5f);
+		}
+		else if (camera_position.y == 1840.0f) {
+			ndc_x = (player_world_position.x - camera_position.x) / window_width_px;
+			ndc_y = 2.465f - ((player_world_position.y) / window_height_px) * 0.64f;
+		}
+		else {
+			ndc_x = (player_world_position.x - camera_position.x) / window_width_px;
+			ndc_y = (player_world_position.y - camera_position.y) / window_height_px;
+		}
+		packet.spotlight_center = vec2(ndc_x, ndc_y);
+	}
 
-
-	// Getting size of window
-	int w, h;
-	glfwGetFramebufferSize(window, &w, &h); // Note, this will be 2x the resolution given to glfwCreateWindow on retina displays
-
-	// First render to the custom framebuffer
-	glBindFramebuffer(GL_FRAMEBUFFER, frame_buffer);
-	gl_has_errors();
-	// Clearing backbuffer
-	glViewport(0, 0, w, h);
-	glDepthRange(0.00001, 10);
-	glClearColor(0.0f, 0.0f, 0.0f, 0.0f);
-	glClearDepth(10.f);
-	glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
-	glEnable(GL_BLEND);
-	glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-	glDisable(GL_DEPTH_TEST); // native OpenGL does not work with a depth buffer
-							  // and alpha blending, one would have to sort
-							  // sprites back to front
-	gl_has_errors();
-	mat3 projection_2D = createProjectionMatrix();
-	mat3 ui_projection = createOrthographicProjection(0, window_width_px, 0, window_height_px);
-
-	
-	// Draw all textured meshes that have a position and size component
-	float camera_left = camera_position.x;
-	float camera_right = camera_position.x + window_width_px;
-	float camera_top = camera_position.y;
-	float camera_bottom = camera_position.y + window_height_px;
-
-	// Truely render to the screen
-
-	helpOverlay.render();
-	/*for (Entity entity : registry.tiles.entities) {
-		if (!registry.motions.has(entity)) continue;
-		drawTexturedMesh(entity, projection_2D);
-	}*/
+	// Same order as the world pass draws them
 	for (Entity entity : registry.tiles.entities) {
 		if (!registry.motions.has(entity)) continue;
-
-		// Get tile position and size
-		Motion& motion = registry.motions.get(entity);
-		vec2 tile_position = motion.position;
-		vec2 tile_size = abs(motion.scale);
-
-		// Calculate tile boundaries
-		float tile_left = tile_position.x - tile_size.x / 2;
-		float tile_right = tile_position.x + tile_size.x / 2;
-		float tile_top = tile_position.y - tile_size.y / 2;
-		float tile_bottom = tile_position.y + tile_size.y / 2;
-
-		// Check if the tile is within the camera's frame
-		if (tile_right < camera_left || tile_left > camera_right ||
-			tile_bottom < camera_top || tile_top > camera_bottom) {
-			continue; // Skip rendering tiles outside the camera view
-		}
-
-
-		drawTexturedMesh(entity, projection_2D);
+		// Skip rendering tiles outside the camera view
+		if (in_camera_frame(registry.motions.peek(entity), camera_position))
+			extractSprite(entity, packet);
 	}
 
-	// todo - change this
-
 	for (Entity entity : registry.boids.entities) {
 		if (!registry.motions.has(entity)) continue;
-
-		Motion& motion = registry.motions.get(entity);
-		vec2 boid_position = motion.position;
-		vec2 boid_size = abs(motion.scale);
-
-		float boid_left = boid_position.x - boid_size.x / 2;
-		float boid_right = boid_position.x + boid_size.x / 2;
-		float boid_top = boid_position.y - boid_size.y / 2;
-		float boid_bottom = boid_position.y + boid_size.y / 2;
-
-		if (boid_right >= camera_left && boid_left <= camera_right &&
-			boid_bottom >= camera_top && boid_top <= camera_bottom) {
-			drawTexturedMesh(entity, projection_2D);
-		}
+		if (in_camera_frame(registry.motions.peek(entity), camera_position))
+			extractSprite(entity, packet);
 	}
 
-	// Draw robots within the camera frame
 	for (Entity entity : registry.robots.entities) {
 		if (!registry.motions.has(entity)) continue;
-
-		// Get robot position and size
-		Motion& motion = registry.motions.get(entity);
-		vec2 robot_position = motion.position;
-		vec2 robot_size = abs(motion.scale);
-
-		// Calculate robot boundaries
-		float robot_left = robot_position.x - robot_size.x / 2;
-		float robot_right = robot_position.x + robot_size.x / 2;
-		float robot_top = robot_position.y - robot_size.y / 2;
-		float robot_bottom = robot_position.y + robot_size.y / 2;
-
-		// Check if the robot is within the camera's frame
-		if (robot_right >= camera_left && robot_left <= camera_right &&
-			robot_bottom >= camera_top && robot_top <= camera_bottom) {
-			// check if entity contains registry.iceRobotAnimations.get(entity); {if so print hello world}
-			drawRobotHealthBar(entity, projection_2D);
-			drawTexturedMesh(entity, projection_2D);
+		if (in_camera_frame(registry.motions.peek(entity), camera_position)) {
+			extractRobotHealthBar(entity, packet);
+			extractSprite(entity, packet);
 		}
 	}
 
-
 	for (Entity entity : registry.bossRobots.entities) {
 		if (!registry.motions.has(entity)) continue;
-
-		// Get robot position and size
-		Motion& motion = registry.motions.get(entity);
-		vec2 robot_position = motion.position;
-		vec2 robot_size = abs(motion.scale);
-
-		// Calculate robot boundaries
-		float robot_left = robot_position.x - robot_size.x / 2;
-		float robot_right = robot_position.x + robot_size.x / 2;
-		float robot_top = robot_position.y - robot_size.y / 2;
-		float robot_bottom = robot_position.y + robot_size.y / 2;
-
-		// Check if the robot is within the camera's frame
-		if (robot_right >= camera_left && robot_left <= camera_right &&
-			robot_bottom >= camera_top && robot_top <= camera_bottom) {
-			drawTexturedMesh(entity, projection_2D);
-			drawBossRobotHealthBar(entity, projection_2D);
+		if (in_camera_frame(registry.motions.peek(entity), camera_position)) {
+			extractSprite(entity, packet);
+			extractBossRobotHealthBar(entity, packet);
 		}
 	}
 
-	for (Entity entity : registry.particles.entities) {
-		drawTexturedMesh(entity, projection_2D);
-	}
+	extractParticles(packet);
 	for (Entity entity : registry.spiderRobots.entities) {
 		if (!registry.motions.has(entity)) continue;
-		drawTexturedMesh(entity, projection_2D);
+		extractSprite(entity, packet);
 	}
 
 	if (registry.players.has(player)) {
-		drawTexturedMesh(player, projection_2D);
-		
+		extractSprite(player, packet);
 	}
 
 	for (Entity entity : registry.doors.entities) {
 		if (!registry.motions.has(entity)) continue;
-		drawTexturedMesh(entity, projection_2D);
+		extractSprite(entity, packet);
 	}
 
 	for (Entity entity : registry.potions.entities) {
 		if (!registry.motions.has(entity)) continue;
-		drawTexturedMesh(entity, projection_2D);
+		extractSprite(entity, packet);
 	}
 
 	for (Entity entity : registry.keys.entities) {
 		if (!registry.motions.has(entity)) continue;
-		drawTexturedMesh(entity, projection_2D);
+		extractSprite(entity, packet);
 	}
 	for (Entity entity : registry.armorplates.entities) {
 		if (!registry.motions.has(entity)) continue;
-		drawTexturedMesh(entity, projection_2D);
+		extractSprite(entity, packet);
 	}
 
 	for (Entity entity : registry.spaceships.entities) {
 		if (!registry.motions.has(entity)) continue;
-		Motion& motion = registry.motions.get(entity);
-		drawTexturedMesh(entity, projection_2D);
-		drawSpaceshipTexture(entity, projection_2D);
+		extractSprite(entity, packet);
+		SpriteDraw texture = packet.sprites.back();
+		texture.kind = SpriteKind::SPACESHIP_TEXTURE;
+		packet.sprites.push_back(texture);
 	}
 
+	extractProjectiles(packet);
+	// paths and chunks recorded by the systems this step
+	debug_draw.copy_to(packet.debug_lines);
+}
 
-	for (Entity entity : registry.projectile.entities) {
-		if (!registry.motions.has(entity)) continue;
+void RenderSystem::extractParticles(RenderPacket& packet)
+{
+	for (size_t i = 0; i < particles.emitter_count(); i++) {
+		SpriteDraw batch;
+		batch.kind = SpriteKind::PARTICLES;
+		batch.texture = particles.emitter(i).def.texture;
+		batch.particle_first = (unsigned int)packet.particles.size();
+		particles.append_instances(i, packet.camera_position, packet.particles);
+		batch.particle_count = (unsigned int)packet.particles.size() - batch.particle_first;
+		if (batch.particle_count > 0)
+			packet.sprites.push_back(batch);
+	}
+}
 
-		// Get projectile position and size
-		Motion& motion = registry.motions.get(entity);
-		vec2 projectile_position = motion.position;
-		vec2 projectile_size = abs(motion.scale);
-
-		// Calculate projectile boundaries
-		float projectile_left = projectile_position.x - projectile_size.x / 2;
-		float projectile_right = projectile_position.x + projectile_size.x / 2;
-		float projectile_top = projectile_position.y - projectile_size.y / 2;
-		float projectile_bottom = projectile_position.y + projectile_size.y / 2;
-
-		// Check if the projectile is within the camera's frame
-		if (projectile_right >= camera_left && projectile_left <= camera_right &&
-			projectile_bottom >= camera_top && projectile_top <= camera_bottom) {
-			drawTexturedMesh(entity, projection_2D);
-		}
+void RenderSystem::extractProjectiles(RenderPacket& packet)
+{
+	// drawn bigger than their collision box
+	const vec2 scale = { 127.f, 123.f };
+	vec2 camera_min = packet.camera_position - scale / 2.f;
+	vec2 camera_max = packet.camera_position + vec2(window_width_px, window_height_px) + scale / 2.f;
+	for (uint32_t i = 0; i < projectiles.size(); i++) {
+		vec2 position = projectiles.position[i];
+		if (position.x < camera_min.x || position.x > camera_max.x || position.y < camera_min.y || position.y > camera_max.y)
+			continue;
+		SpriteDraw sprite;
+		sprite.position = position - packet.camera_position;
+		sprite.angle = projectiles.angle[i];
+		sprite.scale = scale;
+		sprite.texture = (projectiles.flags[i] & PROJECTILE_ICE) ? TEXTURE_ASSET_ID::ICE_PROJ : TEXTURE_ASSET_ID::PROJECTILE;
+		packet.sprites.push_back(sprite);
 	}
+}
 
-	for (Entity entity : registry.bossProjectile.entities) {
-		if (!registry.motions.has(entity)) continue;
+// Render our game world
+// http://www.opengl-tutorial.org/intermediate-tutorials/tutorial-14-render-to-texture/
+void RenderSystem::drawWorld(const RenderPacket& packet)
+{
+	if (packet.start_screen) {
+		return;
+	}
+
+	// First render to the custom framebuffer
+	glBindFramebuffer(GL_FRAMEBUFFER, frame_buffer);
+	gl_has_errors();
+	// Clearing backbuffer
+	// the world goes in the bottom left corner, drawToScreen scales it up to the window
+	glViewport(0, 0, (int)(packet.frame_width * packet.render_scale), (int)(packet.frame_height * packet.render_scale));
+	glDepthRange(0.00001, 10);
+	glClearColor(0.0f, 0.0f, 0.0f, 0.0f);
+	glClearDepth(10.f);
+	glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+	glEnable(GL_BLEND);
+	glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+	glDisable(GL_DEPTH_TEST); // native OpenGL does not work with a depth buffer
+							  // and alpha blending, one would have to sort
+							  // sprites back to front
+	gl_has_errors();
+	mat3 projection_2D = createProjectionMatrix();
 
-		// Get projectile position and size
-		Motion& motion = registry.motions.get(entity);
-		vec2 projectile_position = motion.position;
-		vec2 projectile_size = abs(motion.scale);
-
-		// Calculate projectile boundaries
-		float projectile_left = projectile_position.x - projectile_size.x / 2;
-		float projectile_right = projectile_position.x + projectile_size.x / 2;
-		float projectile_top = projectile_position.y - projectile_size.y / 2;
-		float projectile_bottom = projectile_position.y + projectile_size.y / 2;
-
-		// Check if the projectile is within the camera's frame
-		if (projectile_right >= camera_left && projectile_left <= camera_right &&
-			projectile_bottom >= camera_top && projectile_top <= camera_bottom) {
-			drawTexturedMesh(entity, projection_2D);
+	for (const SpriteDraw& sprite : packet.sprites) {
+		switch (sprite.kind) {
+		case SpriteKind::SPRITE:
+			drawSprite(sprite, projection_2D);
+			break;
+		case SpriteKind::SPACESHIP_TEXTURE:
+			drawSpaceshipTexture(sprite, projection_2D);
+			break;
+		case SpriteKind::HEALTH_BAR:
+			drawHealthBar(sprite, projection_2D);
+			break;
+		case SpriteKind::PARTICLES:
+			drawParticles(sprite, packet, projection_2D);
+			break;
 		}
 	}
+	drawDebugLines(packet, projection_2D);
+
+	drawToScreen(packet);
+}
+
+void RenderSystem::drawOverlay(const RenderPacket& packet)
+{
+	cursor_position = packet.cursor;
+	reloadShaders();
+
+	if (packet.start_screen) {
+		glBindFramebuffer(GL_FRAMEBUFFER, 0);
+		gl_has_errors();
+
+		glClearColor(0.f, 0.f, 0.f, 1.0f);
+		glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+		 
+		glUseProgram(effects[(GLuint)EFFECT_ASSET_ID::SCREEN]);
+		gl_has_errors();
 
-	drawToScreen();
+		glActiveTexture(GL_TEXTURE0);
+		glBindTexture(GL_TEXTURE_2D, texture_gl_handles[(GLuint)TEXTURE_ASSET_ID::START_SCREEN]);
+		gl_has_errors();
+
+		glBindVertexArray(startscreen_vao);
+		glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
+		glBindVertexArray(0);
+		gl_has_errors();
 
+		renderStartScreen();
+		helpOverlay.render();
+		return;
+	}
 
-	if (playing_cutscene) {
+	mat3 ui_projection = createOrthographicProjection(0, window_width_px, 0, window_height_px);
+
+	if (packet.cutscene) {
 		renderCutscene();
-		glfwSwapBuffers(window);
 		return;
 	}
 	if (show_game_over_screen) {
 		renderGameOverScreen();
-		glfwSwapBuffers(window);
 		return;
 	}
-	drawHUD(player, ui_projection);
-	Inventory& inventory = registry.players.get(player).inventory;
-	if (inventory.isOpen) {
-		drawInventoryUI();
-	}
+	capture_robots.clear();
 	for (auto entity : registry.robots.entities) {
-		Robot& robot = registry.robots.get(entity);
-		if (robot.showCaptureUI) {
+		if (registry.robots.peek(entity).showCaptureUI) {
 			currentRobotEntity = entity;
-			renderCaptureUI(robot, entity);
+			capture_robots.push_back(entity);
 			show_capture_ui = true;
 		}
 	}
 
+	// The HUD and menus are only rebuilt when something they show has changed
+	makeUIKey(next_ui_key);
+	if (next_ui_key != ui_key) {
+		std::swap(ui_key, next_ui_key);
+		ui_list.clear();
+		buildHUD(ui_list);
+		if (registry.players.peek(player).inventory.isOpen)
+			buildInventoryUI(ui_list);
+		for (Entity entity : capture_robots)
+			buildCaptureUI(ui_list, registry.robots.peek(entity), entity);
+	}
+	drawUIList(ui_list, ui_projection);
+
 	if (key_spawned) {
 		glm::vec3 font_color = glm::vec3(1.0f, 1.0f, 1.0f); // White color
 		glm::mat4 font_trans = glm::mat4(1.0f); // Identity matrix
@@ -803,10 +730,6 @@ void RenderSystem::draw()
 	if (game_paused) {
 		drawPausedUI(ui_projection);
 	}
-
-	// flicker-free display with a double buffer
-	glfwSwapBuffers(window);
-	gl_has_errors();
 }
 
 void RenderSystem::drawPausedUI(const mat3& projection) {
@@ -864,8 +787,7 @@ void RenderSystem::drawPausedUI(const mat3& projection) {
 		{"Restart Game", 420.0f, 260.0f, glm::vec3(1.0f, 1.0f, 1.0f), glm::vec3(0.937f, 0.745f, 0.035f)}
 	};
 
-	double mouse_x, mouse_y;
-	glfwGetCursorPos(window, &mouse_x, &mouse_y);
+	double mouse_x = cursor_position.x, mouse_y = cursor_position.y;
 	mouse_y = window_height_px - mouse_y; 
 
 	hovered_menu_index = -1; 
@@ -909,282 +831,268 @@ mat3 RenderSystem::createProjectionMatrix()
 	float ty = -(top + bottom) / (top - bottom);
 	return {{sx, 0.f, 0.f}, {0.f, sy, 0.f}, {tx, ty, 1.f}};
 }
-void RenderSystem::initHealthBarVBO() {
-	if (!healthbar_vbo_initialized) {
-		glGenVertexArrays(1, &healthbar_vao);
-		glGenBuffers(1, &healthbar_vbo);
+void RenderSystem::initParticleVBO() {
+	glGenVertexArrays(1, &particle_vao);
+	glGenBuffers(1, &particle_quad_vbo);
+	glGenBuffers(1, &particle_instance_vbo);
+
+	glBindVertexArray(particle_vao);
+
+	// corners of a unit quad around the particle, as a triangle strip
+	float corners[] = {
+		-0.5f, -0.5f,
+		 0.5f, -0.5f,
+		-0.5f,  0.5f,
+		 0.5f,  0.5f
+	};
+	glBindBuffer(GL_ARRAY_BUFFER, particle_quad_vbo);
+	glBufferData(GL_ARRAY_BUFFER, sizeof(corners), corners, GL_STATIC_DRAW);
+	glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 2 * sizeof(float), (void*)0);
+	glEnableVertexAttribArray(0);
 
-		glBindVertexArray(healthbar_vao);
+	// position, size and opacity, advancing once per particle
+	glBindBuffer(GL_ARRAY_BUFFER, particle_instance_vbo);
+	glVertexAttribPointer(1, 4, GL_FLOAT, GL_FALSE, sizeof(ParticleInstance), (void*)0);
+	glEnableVertexAttribArray(1);
+	glVertexAttribDivisor(1, 1);
 
-		glBindBuffer(GL_ARRAY_BUFFER, healthbar_vbo);
-		glBufferData(GL_ARRAY_BUFFER, sizeof(float) * 6 * 4, NULL, GL_DYNAMIC_DRAW);  // Reserve space for vertices
+	glBindVertexArray(0);
+	gl_has_errors();
+}
 
-		glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 4 * sizeof(float), (void*)0);
-		glEnableVertexAttribArray(0);
+void RenderSystem::drawParticles(const SpriteDraw& batch, const RenderPacket& packet, const mat3& projection) {
+	glBindVertexArray(particle_vao);
+	glBindBuffer(GL_ARRAY_BUFFER, particle_instance_vbo);
+	size_t size = batch.particle_count * sizeof(ParticleInstance);
+	if (size > particle_instance_capacity) {
+		particle_instance_capacity = size;
+		glBufferData(GL_ARRAY_BUFFER, size, nullptr, GL_STREAM_DRAW);
+	}
+	glBufferSubData(GL_ARRAY_BUFFER, 0, size, &packet.particles[batch.particle_first]);
+	gl_has_errors();
 
-		glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, 4 * sizeof(float), (void*)(2 * sizeof(float)));
-		glEnableVertexAttribArray(1);
+	const GLuint program = effects[(GLuint)EFFECT_ASSET_ID::PARTICLE];
+	glUseProgram(program);
+	glUniformMatrix3fv(glGetUniformLocation(program, "projection"), 1, GL_FALSE, (float*)&projection);
+	glUniform1i(glGetUniformLocation(program, "sampler0"), 0);
+
+	glActiveTexture(GL_TEXTURE0);
+	glBindTexture(GL_TEXTURE_2D, texture_gl_handles[(GLuint)batch.texture]);
+	gl_has_errors();
+
+	glDrawArraysInstanced(GL_TRIANGLE_STRIP, 0, 4, (GLsizei)batch.particle_count);
+	glBindVertexArray(default_vao);
+	gl_has_errors();
+}
+
+void RenderSystem::initUIDrawList() {
+	glGenVertexArrays(1, &ui_list_vao);
+	glGenBuffers(1, &ui_list_vbo);
+
+	glBindVertexArray(ui_list_vao);
+	glBindBuffer(GL_ARRAY_BUFFER, ui_list_vbo);
+	glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, sizeof(UiVertex), (void*)offsetof(UiVertex, position));
+	glEnableVertexAttribArray(0);
+	glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, sizeof(UiVertex), (void*)offsetof(UiVertex, texcoord));
+	glEnableVertexAttribArray(1);
+	glVertexAttribPointer(2, 4, GL_FLOAT, GL_FALSE, sizeof(UiVertex), (void*)offsetof(UiVertex, color));
+	glEnableVertexAttribArray(2);
+	glBindVertexArray(0);
+
+	// flat quads sample it, so they batch with the textured ones
+	const unsigned char white[4] = { 255, 255, 255, 255 };
+	glGenTextures(1, &white_texture);
+	glBindTexture(GL_TEXTURE_2D, white_texture);
+	glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, 1, 1, 0, GL_RGBA, GL_UNSIGNED_BYTE, white);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+	glBindTexture(GL_TEXTURE_2D, 0);
+	ui_list.white_texture = white_texture;
+	gl_has_errors();
+}
+
+void RenderSystem::drawUIList(UiDrawList& ui, const mat3& projection) {
+	glBindVertexArray(ui_list_vao);
+	glBindBuffer(GL_ARRAY_BUFFER, ui_list_vbo);
+	if (ui.changed) {
+		size_t size = ui.vertices.size() * sizeof(UiVertex);
+		if (size > ui_list_capacity) {
+			ui_list_capacity = size;
+			glBufferData(GL_ARRAY_BUFFER, size, nullptr, GL_DYNAMIC_DRAW);
+		}
+		if (size > 0)
+			glBufferSubData(GL_ARRAY_BUFFER, 0, size, ui.vertices.data());
+		ui.changed = false;
+	}
+	gl_has_errors();
+
+	glEnable(GL_BLEND);
+	glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+	const GLuint program = effects[(GLuint)EFFECT_ASSET_ID::UI];
+	glUseProgram(program);
+	glUniformMatrix3fv(glGetUniformLocation(program, "projection"), 1, GL_FALSE, (float*)&projection);
+	glUniform1i(glGetUniformLocation(program, "sampler0"), 0);
+	glActiveTexture(GL_TEXTURE0);
+
+	for (const UiDrawCommand& command : ui.commands) {
+		glBindTexture(GL_TEXTURE_2D, command.texture);
+		glDrawArrays(GL_TRIANGLES, (GLint)command.first, (GLsizei)command.count);
+	}
+	glBindVertexArray(default_vao);
+	gl_has_errors();
+}
+
+void RenderSystem::addText(UiDrawList& ui, const std::string& text, float x, float y, float scale, const vec3& color) {
+	for (char c : text) {
+		auto it = Characters.find(c);
+		if (it == Characters.end())
+			continue;
+		const Character& ch = it->second;
+
+		float xpos = x + ch.bearing.x * scale;
+		float ypos = y - (ch.size.y - ch.bearing.y) * scale;
+		float w = ch.size.x * scale;
+		float h = ch.size.y * scale;
+		if (w > 0.f && h > 0.f) {
+			// the list's y goes down
+			ui.quad(vec2(xpos, window_height_px - (ypos + h)), vec2(w, h), glyph_atlas, ch.atlas_top_left, ch.atlas_bottom_right, vec4(color, 1.f));
+		}
+		x += (ch.advance >> 6) * scale;
+	}
+}
+
+static void add_item_key(UiKey& key, const Item& item) {
+	key.add(item.id);
+	key.add(item.quantity);
+	key.add(item.health);
+	key.add(item.damage);
+	key.add(item.speed);
+}
+
+static bool is_hovered(const vec2& mouse_position, const vec2& position, const vec2& size) {
+	return mouse_position.x >= position.x && mouse_position.x <= (position.x + size.x) &&
+		mouse_position.y >= position.y && mouse_position.y <= (position.y + size.y);
+}
+
+// Everything buildHUD, buildInventoryUI and buildCaptureUI read
+void RenderSystem::makeUIKey(UiKey& key) {
+	key.clear();
+	if (!registry.players.has(player))
+		return;
+	const Player& player_data = registry.players.peek(player);
+	key.add(player_data.current_health);
+	key.add(player_data.max_health);
+	key.add(player_data.current_stamina);
+	key.add(player_data.max_stamina);
+	key.add(player_data.armor_stat);
+	key.add(player_data.weapon_stat);
+	key.add(registry.radiations.peek(*registry.radiations.entities.begin()).intensity);
+
+	const Inventory& inventory = player_data.inventory;
+	key.add(inventory.getSelectedSlot());
+	for (const InventorySlot& slot : inventory.slots)
+		add_item_key(key, slot.item);
+	key.add(inventory.isOpen);
+	if (inventory.isOpen) {
+		add_item_key(key, inventory.getArmorItem());
+		add_item_key(key, inventory.getWeaponItem());
+		key.add(is_hovered(mousePosition, vec2(730.f, 310.f), vec2(100.f, 100.f)));
+		key.add(isDragging);
+		key.add(draggedSlot);
+		if (isDragging)
+			key.add(mousePosition - dragOffset);
+	}
 
-		healthbar_vbo_initialized = true;
+	for (Entity entity : registry.notifications.entities) {
+		const Notification& notification = registry.notifications.peek(entity);
+		if (notification.duration <= 0.0f)
+			continue;
+		key.add(notification.text);
+		key.add(notification.position);
+		key.add(notification.scale);
+	}
+	key.add(tutorial_state != TutorialState::COMPLETED);
+
+	for (Entity entity : capture_robots) {
+		const Robot& robot = registry.robots.peek(entity);
+		key.add(entity.id);
+		key.add(registry.iceRobotAnimations.has(entity));
+		key.add(robot.disassembleItems.size());
+		for (const Item& item : robot.disassembleItems)
+			add_item_key(key, item);
+		key.add(robot.attack);
+		key.add(robot.max_attack);
+		key.add(robot.current_health);
+		key.add(robot.max_health);
+		key.add(robot.speed);
+		key.add(robot.max_speed);
+		key.add(is_hovered(mousePosition, vec2(850.f, 410.f), vec2(110.f, 110.f)));
+		key.add(is_hovered(mousePosition, vec2(375.f, 410.f), vec2(110.f, 110.f)));
 	}
 }
 
-void RenderSystem::drawHUD(Entity player, const mat3& projection)
+void RenderSystem::buildHUD(UiDrawList& ui)
 {
 	if (!registry.players.has(player))
 		return;
-	glEnable(GL_BLEND);
-	glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 	// Get player health values
-	Player& player_data = registry.players.get(player);
-	Inventory& player_inventory = player_data.inventory;
-	const auto& items = player_inventory.getItems();
+	const Player& player_data = registry.players.peek(player);
+	const Inventory& player_inventory = player_data.inventory;
 	Entity radiation_entity = *registry.radiations.entities.begin();
-	Radiation& radiation_data = registry.radiations.get(radiation_entity);
+	const Radiation& radiation_data = registry.radiations.peek(radiation_entity);
 
 	float radiation_percentage = radiation_data.intensity / 1.0f;
 
 	vec2 radiation_bar_position = vec2(window_width_px - 240.f, 20.f);
 	vec2 radiation_bar_size = vec2(170.f, 20.f);
-	/*glDrawArrays(GL_TRIANGLE_FAN, 0, 4);
-	gl_has_errors();*/
-
-	// Radiation icon position and size
-
-
-	TexturedVertex radiation_full_bar_vertices[4] = {
-		{ vec3(radiation_bar_position.x, radiation_bar_position.y, 0.f), vec2(0.f, 1.f) },  // Top-left
-		{ vec3(radiation_bar_position.x + radiation_bar_size.x, radiation_bar_position.y, 0.f), vec2(1.f, 1.f) }, // Top-right
-		{ vec3(radiation_bar_position.x + radiation_bar_size.x, radiation_bar_position.y + radiation_bar_size.y, 0.f), vec2(1.f, 0.f) }, // Bottom-right
-		{ vec3(radiation_bar_position.x, radiation_bar_position.y + radiation_bar_size.y, 0.f), vec2(0.f, 0.f) } // Bottom-left
-	};
 
-	TexturedVertex radiation_current_bar_vertices[4] = {
-		{ vec3(radiation_bar_position.x, radiation_bar_position.y, 0.f), vec2(0.f, 1.f) },  // Top-left
-		{ vec3(radiation_bar_position.x + radiation_bar_size.x * radiation_percentage, radiation_bar_position.y, 0.f), vec2(1.f, 1.f) }, // Top-right (scaled by radiation)
-		{ vec3(radiation_bar_position.x + radiation_bar_size.x * radiation_percentage, radiation_bar_position.y + radiation_bar_size.y, 0.f), vec2(1.f, 0.f) }, // Bottom-right
-		{ vec3(radiation_bar_position.x, radiation_bar_position.y + radiation_bar_size.y, 0.f), vec2(0.f, 0.f) } // Bottom-left
-	};
 	// Health percentage (between 0 and 1)
 	float health_percentage = player_data.current_health / player_data.max_health;
 
 	// Health bar position and size
-	vec2 bar_position = vec2(40.f, window_height_px - 60.f); 
-	vec2 bar_size = vec2(200.f, 20.f);                    
-
-	// Full bar (gray background)
-	TexturedVertex full_bar_vertices[4] = {
-		{ vec3(bar_position.x, bar_position.y, 0.f), vec2(0.f, 1.f) },  // Top-left
-		{ vec3(bar_position.x + bar_size.x, bar_position.y, 0.f), vec2(1.f, 1.f) }, // Top-right
-		{ vec3(bar_position.x + bar_size.x, bar_position.y + bar_size.y, 0.f), vec2(1.f, 0.f) }, // Bottom-right
-		{ vec3(bar_position.x, bar_position.y + bar_size.y, 0.f), vec2(0.f, 0.f) } // Bottom-left
-	};
-
-	// Current health bar (green-to-red portion)
-	TexturedVertex current_bar_vertices[4] = {
-		{ vec3(bar_position.x, bar_position.y, 0.f), vec2(0.f, 1.f) },  // Top-left
-		{ vec3(bar_position.x + bar_size.x * health_percentage, bar_position.y, 0.f), vec2(1.f, 1.f) }, // Top-right (scaled by health)
-		{ vec3(bar_position.x + bar_size.x * health_percentage, bar_position.y + bar_size.y, 0.f), vec2(1.f, 0.f) }, // Bottom-right
-		{ vec3(bar_position.x, bar_position.y + bar_size.y, 0.f), vec2(0.f, 0.f) } // Bottom-left
-	};
+	vec2 bar_position = vec2(40.f, window_height_px - 60.f);
+	vec2 bar_size = vec2(200.f, 20.f);
 
 	vec2 stamina_bar_position = vec2(bar_position.x, bar_position.y + bar_size.y);
 	vec2 stamina_bar_size = vec2(bar_size.x, bar_size.y / 2.f);
 
 	float stamina_percentage = player_data.current_stamina / player_data.max_stamina;
 
-	TexturedVertex stamina_bar_vertices[4] = {
-	{ vec3(stamina_bar_position.x, stamina_bar_position.y, 0.f), vec2(0.f, 1.f) },
-	{ vec3(stamina_bar_position.x + stamina_bar_size.x * stamina_percentage, stamina_bar_position.y, 0.f), vec2(1.f, 1.f) },
-	{ vec3(stamina_bar_position.x + stamina_bar_size.x * stamina_percentage, stamina_bar_position.y + stamina_bar_size.y, 0.f), vec2(1.f, 0.f) },
-	{ vec3(stamina_bar_position.x, stamina_bar_position.y + stamina_bar_size.y, 0.f), vec2(0.f, 0.f) }
-	};
-	TexturedVertex stamina_full_bar_vertices[4] = {
-	{ vec3(stamina_bar_position.x, stamina_bar_position.y, 0.f), vec2(0.f, 1.f) },  // Top-left
-	{ vec3(stamina_bar_position.x + stamina_bar_size.x, stamina_bar_position.y, 0.f), vec2(1.f, 1.f) }, // Top-right
-	{ vec3(stamina_bar_position.x + stamina_bar_size.x, stamina_bar_position.y + stamina_bar_size.y, 0.f), vec2(1.f, 0.f) }, // Bottom-right
-	{ vec3(stamina_bar_position.x, stamina_bar_position.y + stamina_bar_size.y, 0.f), vec2(0.f, 0.f) } // Bottom-left
-	};
 	// Draw the avatar above the health bar
-	vec2 avatar_size = vec2(128.f, 128.f); 
+	vec2 avatar_size = vec2(128.f, 128.f);
 	vec2 avatar_position = vec2(bar_position.x + (bar_size.x / 2) - (avatar_size.x / 2), bar_position.y - 125.f); // Center above health bar
-
-	// Create vertices for the avatar (textured quad)
-	TexturedVertex avatar_vertices[4] = {
-		{ vec3(avatar_position.x, avatar_position.y, 0.f), vec2(0.f, 0.f) },  // Top-left (flipped)
-		{ vec3(avatar_position.x + avatar_size.x, avatar_position.y, 0.f), vec2(1.f, 0.f) }, // Top-right (flipped)
-		{ vec3(avatar_position.x + avatar_size.x, avatar_position.y + avatar_size.y, 0.f), vec2(1.f, 1.f) }, // Bottom-right
-		{ vec3(avatar_position.x, avatar_position.y + avatar_size.y, 0.f), vec2(0.f, 1.f) } // Bottom-left
-	};
-
-	glUseProgram(effects[(GLuint)EFFECT_ASSET_ID::TEXTURED]);
-	gl_has_errors();
-
-	// Bind the VBO for avatar rendering 
-	glBindBuffer(GL_ARRAY_BUFFER, healthbar_vbo);
-	glBufferData(GL_ARRAY_BUFFER, sizeof(avatar_vertices), avatar_vertices, GL_DYNAMIC_DRAW);
-	gl_has_errors();
-
-	GLint in_position_loc = glGetAttribLocation(effects[(GLuint)EFFECT_ASSET_ID::TEXTURED], "in_position");
-	GLint in_texcoord_loc = glGetAttribLocation(effects[(GLuint)EFFECT_ASSET_ID::TEXTURED], "in_texcoord");
-
-	glEnableVertexAttribArray(in_position_loc);
-	glVertexAttribPointer(in_position_loc, 3, GL_FLOAT, GL_FALSE, sizeof(TexturedVertex), (void*)0);
-	glEnableVertexAttribArray(in_texcoord_loc);
-	glVertexAttribPointer(in_texcoord_loc, 2, GL_FLOAT, GL_FALSE, sizeof(TexturedVertex), (void*)sizeof(vec3));
-	gl_has_errors();
-
-	glActiveTexture(GL_TEXTURE0);
-	GLuint avatar_texture_id = texture_gl_handles[(GLuint)TEXTURE_ASSET_ID::AVATAR]; 
-	glBindTexture(GL_TEXTURE_2D, avatar_texture_id);
-	gl_has_errors();
-
-	// Set transformation and projection uniforms for the avatar
-	GLuint transform_loc = glGetUniformLocation(effects[(GLuint)EFFECT_ASSET_ID::TEXTURED], "transform");
-	mat3 identity_transform = mat3(1.0f); // No transform needed for UI
-	glUniformMatrix3fv(transform_loc, 1, GL_FALSE, (float*)&identity_transform);
-	GLuint projection_loc = glGetUniformLocation(effects[(GLuint)EFFECT_ASSET_ID::TEXTURED], "projection");
-	glUniformMatrix3fv(projection_loc, 1, GL_FALSE, (float*)&projection);
-	gl_has_errors();
-
-	// Draw the avatar
-	glDrawArrays(GL_TRIANGLE_FAN, 0, 4);
-	gl_has_errors();
-
+	ui.quad(avatar_position, avatar_size, texture_gl_handles[(GLuint)TEXTURE_ASSET_ID::AVATAR]);
 
 	vec2 armor_icon_size = avatar_size * 0.2f;
-	vec2 armor_icon_position = vec2(
-		40.f,
-		avatar_position.y + 10.0f
-	);
-
-	TexturedVertex armor_icon_vertices[4] = {
-		{ vec3(armor_icon_position.x, armor_icon_position.y, 0.f), vec2(0.f, 0.f) },
-		{ vec3(armor_icon_position.x + armor_icon_size.x, armor_icon_position.y, 0.f), vec2(1.f, 0.f) },
-		{ vec3(armor_icon_position.x + armor_icon_size.x, armor_icon_position.y + armor_icon_size.y, 0.f), vec2(1.f, 1.f) },
-		{ vec3(armor_icon_position.x, armor_icon_position.y + armor_icon_size.y, 0.f), vec2(0.f, 1.f) }
-	};
-
-	glBufferData(GL_ARRAY_BUFFER, sizeof(armor_icon_vertices), armor_icon_vertices, GL_DYNAMIC_DRAW);
-	gl_has_errors();
-	GLuint armor_icon_texture_id = texture_gl_handles[(GLuint)TEXTURE_ASSET_ID::ARMOR_ICON];
-	glBindTexture(GL_TEXTURE_2D, armor_icon_texture_id);
-	gl_has_errors();
-	glDrawArrays(GL_TRIANGLE_FAN, 0, 4);
-	gl_has_errors();
+	vec2 armor_icon_position = vec2(40.f, avatar_position.y + 10.0f);
+	ui.quad(armor_icon_position, armor_icon_size, texture_gl_handles[(GLuint)TEXTURE_ASSET_ID::ARMOR_ICON]);
 
 	vec2 weapon_icon_size = avatar_size * 0.2f;
-	vec2 weapon_icon_position = vec2(
-		40.f,
-		avatar_position.y + 45.0f
-	);
-
-	TexturedVertex weapon_icon_vertices[4] = {
-		{ vec3(weapon_icon_position.x, weapon_icon_position.y, 0.f), vec2(0.f, 0.f) },
-		{ vec3(weapon_icon_position.x + weapon_icon_size.x, weapon_icon_position.y, 0.f), vec2(1.f, 0.f) },
-		{ vec3(weapon_icon_position.x + weapon_icon_size.x, weapon_icon_position.y + weapon_icon_size.y, 0.f), vec2(1.f, 1.f) },
-		{ vec3(weapon_icon_position.x, weapon_icon_position.y + weapon_icon_size.y, 0.f), vec2(0.f, 1.f) }
-	};
+	vec2 weapon_icon_position = vec2(40.f, avatar_position.y + 45.0f);
+	ui.quad(weapon_icon_position, weapon_icon_size, texture_gl_handles[(GLuint)TEXTURE_ASSET_ID::WEAPON_ICON]);
 
-	glBufferData(GL_ARRAY_BUFFER, sizeof(weapon_icon_vertices), weapon_icon_vertices, GL_DYNAMIC_DRAW);
-	gl_has_errors();
-	GLuint weapon_icon_texture_id = texture_gl_handles[(GLuint)TEXTURE_ASSET_ID::WEAPON_ICON];
-	glBindTexture(GL_TEXTURE_2D, weapon_icon_texture_id);
-	gl_has_errors();
-	glDrawArrays(GL_TRIANGLE_FAN, 0, 4);
-	gl_has_errors();
 	// radiation
 	vec2 radiation_icon_size = vec2(30.f, 30.f);
 	vec2 radiation_icon_position = vec2(radiation_bar_position.x - radiation_icon_size.x - 10.f, radiation_bar_position.y - 3.0f);
-	GLuint radiation_icon_texture_id = texture_gl_handles[(GLuint)TEXTURE_ASSET_ID::RADIATION_ICON];
-
-	TexturedVertex radiation_icon_vertices[4] = {
-		{ vec3(radiation_icon_position.x, radiation_icon_position.y, 0.f), vec2(0.f, 1.f) },
-		{ vec3(radiation_icon_position.x + radiation_icon_size.x, radiation_icon_position.y, 0.f), vec2(1.f, 1.f) },
-		{ vec3(radiation_icon_position.x + radiation_icon_size.x, radiation_icon_position.y + radiation_icon_size.y, 0.f), vec2(1.f, 0.f) },
-		{ vec3(radiation_icon_position.x, radiation_icon_position.y + radiation_icon_size.y, 0.f), vec2(0.f, 0.f) }
-	};
-	glBindTexture(GL_TEXTURE_2D, radiation_icon_texture_id);
-	glBufferData(GL_ARRAY_BUFFER, sizeof(radiation_icon_vertices), radiation_icon_vertices, GL_DYNAMIC_DRAW);
-	glDrawArrays(GL_TRIANGLE_FAN, 0, 4);
-	gl_has_errors();
+	ui.quad(radiation_icon_position, radiation_icon_size, texture_gl_handles[(GLuint)TEXTURE_ASSET_ID::RADIATION_ICON], vec2(0.f, 1.f), vec2(1.f, 0.f));
 
 	// weapon text rendering
-	glm::vec3 font_color = glm::vec3(1.0f, 1.0f, 1.0f); // White color
-	glm::mat4 font_trans = glm::mat4(1.0f); // Identity matrix
-	std::string armor_text = std::to_string((int)player_data.armor_stat);
-	renderText(armor_text, 70.0f, 160.0f, 0.35f, font_color, font_trans);
-	std::string weapon_text = std::to_string((int)player_data.weapon_stat);
-	renderText(weapon_text, 70.0f, 125.0f, 0.35f, font_color, font_trans);
-	// Switch back to COLOURED shader for the health bar
-	glUseProgram(effects[(GLuint)EFFECT_ASSET_ID::COLOURED]);
-	gl_has_errors();
-
-	// Bind the VBO for the health bar
-	glBindBuffer(GL_ARRAY_BUFFER, healthbar_vbo);
-
-	// Draw the full (background) health bar
-	glBufferData(GL_ARRAY_BUFFER, sizeof(full_bar_vertices), full_bar_vertices, GL_DYNAMIC_DRAW);
-	gl_has_errors();
+	vec3 font_color = vec3(1.0f, 1.0f, 1.0f); // White color
+	addText(ui, std::to_string((int)player_data.armor_stat), 70.0f, 160.0f, 0.35f, font_color);
+	addText(ui, std::to_string((int)player_data.weapon_stat), 70.0f, 125.0f, 0.35f, font_color);
 
-	// Set up vertex attributes for the health bar
-	in_position_loc = glGetAttribLocation(effects[(GLuint)EFFECT_ASSET_ID::COLOURED], "in_position");
-	glEnableVertexAttribArray(in_position_loc);
-	glVertexAttribPointer(in_position_loc, 3, GL_FLOAT, GL_FALSE, sizeof(TexturedVertex), (void*)0);
-	gl_has_errors();
-
-	// Set the uniform color for the full bar (gray background)
-	GLint color_uloc = glGetUniformLocation(effects[(GLuint)EFFECT_ASSET_ID::COLOURED], "fcolor");
-	vec3 full_bar_color = vec3(0.7f, 0.7f, 0.7f); // Gray color
-	glUniform3fv(color_uloc, 1, (float*)&full_bar_color);
-	gl_has_errors();
-
-	// Set transformation and projection matrices for the health bar
-	transform_loc = glGetUniformLocation(effects[(GLuint)EFFECT_ASSET_ID::COLOURED], "transform");
-	glUniformMatrix3fv(transform_loc, 1, GL_FALSE, (float*)&identity_transform);
-	projection_loc = glGetUniformLocation(effects[(GLuint)EFFECT_ASSET_ID::COLOURED], "projection");
-	glUniformMatrix3fv(projection_loc, 1, GL_FALSE, (float*)&projection);
-	gl_has_errors();
-
-	// Draw the health bar
-	glDrawArrays(GL_TRIANGLE_FAN, 0, 4);
-	gl_has_errors();
-
-	// Interpolate color between green (0, 1, 0) and red (1, 0, 0) based on health percentage
+	// Full bar (gray background), then the current health going from red to green
+	vec3 full_bar_color = vec3(0.7f, 0.7f, 0.7f);
 	vec3 health_color = glm::mix(vec3(1.0f, 0.0f, 0.0f), vec3(0.0627f, 0.8157f, 0.0f), health_percentage);
-	// Draw the current health bar
-	glBufferData(GL_ARRAY_BUFFER, sizeof(current_bar_vertices), current_bar_vertices, GL_DYNAMIC_DRAW);
-	gl_has_errors();
-	// Set the interpolated color for the current health bar
-	glUniform3fv(color_uloc, 1, (float*)&health_color);
-	gl_has_errors();
-	glDrawArrays(GL_TRIANGLE_FAN, 0, 4);
-	gl_has_errors();
+	ui.rect(bar_position, bar_size, full_bar_color);
+	ui.rect(bar_position, vec2(bar_size.x * health_percentage, bar_size.y), health_color);
 
 	// STAMINA BAR
-	glBufferData(GL_ARRAY_BUFFER, sizeof(stamina_full_bar_vertices), stamina_full_bar_vertices, GL_DYNAMIC_DRAW);
-	gl_has_errors();
-	glUniform3fv(color_uloc, 1, (float*)&full_bar_color);
-	gl_has_errors();
-	glDrawArrays(GL_TRIANGLE_FAN, 0, 4);
-	gl_has_errors();
-	glBufferData(GL_ARRAY_BUFFER, sizeof(stamina_bar_vertices), stamina_bar_vertices, GL_DYNAMIC_DRAW);
 	vec3 stamina_color = vec3(0.1804f, 0.5137f, 0.8667f);
-	glUniform3fv(color_uloc, 1, (float*)&stamina_color);
-	glDrawArrays(GL_TRIANGLE_FAN, 0, 4);
-	// radiation bar
-
-	// Draw the full radiation bar (background)
-	glBufferData(GL_ARRAY_BUFFER, sizeof(radiation_full_bar_vertices), radiation_full_bar_vertices, GL_DYNAMIC_DRAW);
-	gl_has_errors();
-	glUniform3fv(color_uloc, 1, (float*)&full_bar_color);
-	gl_has_errors();
-	glDrawArrays(GL_TRIANGLE_FAN, 0, 4);
-	gl_has_errors();
-
-	glBufferData(GL_ARRAY_BUFFER, sizeof(radiation_current_bar_vertices), radiation_current_bar_vertices, GL_DYNAMIC_DRAW);
-	gl_has_errors();
+	ui.rect(stamina_bar_position, stamina_bar_size, full_bar_color);
+	ui.rect(stamina_bar_position, vec2(stamina_bar_size.x * stamina_percentage, stamina_bar_size.y), stamina_color);
 
+	// radiation bar
 	vec3 radiation_color;
 	float t = radiation_percentage;
 	vec3 start_color = vec3(1.0f, 0.65f, 0.0f);
@@ -1197,113 +1105,61 @@ void RenderSystem::drawHUD(Entity player, const mat3& projection)
 	else {
 		radiation_color = glm::mix(mid_color, end_color, (t - 0.5f) * 2.0f);
 	}
+	ui.rect(radiation_bar_position, radiation_bar_size, full_bar_color);
+	ui.rect(radiation_bar_position, vec2(radiation_bar_size.x * radiation_percentage, radiation_bar_size.y), radiation_color);
 
-
-	glUniform3fv(color_uloc, 1, (float*)&radiation_color);
-	gl_has_errors();
-	glDrawArrays(GL_TRIANGLE_FAN, 0, 4);
-	gl_has_errors();
 	// Draw the "Health" label below the health bar
 	float text_scale = 0.35f;
 
-	float text_x = bar_position.x;
 	float text_y = 45.0f;
 	float health_text_x = bar_position.x - 27.0f;
 
-	renderText("HP", health_text_x, text_y, text_scale, font_color, font_trans);
+	addText(ui, "HP", health_text_x, text_y, text_scale, font_color);
 	std::string percentage_text = std::to_string((int)player_data.current_health) + "/" + std::to_string((int)player_data.max_health);
 	float percentage_text_x = bar_position.x + 5.0f;
-	renderText(percentage_text, percentage_text_x, text_y, text_scale, font_color, font_trans);
-	renderText("STA", health_text_x, text_y - 14.0f, text_scale, font_color, font_trans);
+	addText(ui, percentage_text, percentage_text_x, text_y, text_scale, font_color);
+	addText(ui, "STA", health_text_x, text_y - 14.0f, text_scale, font_color);
 	// Inventory Slots
 	vec2 slot_size = vec2(190.f, 110.f);
 	float total_slots_width = (3 * slot_size.x) / 1.5;  // 3 slots
-	vec2 slot_position = vec2((window_width_px - total_slots_width) / 2, bar_position.y - slot_size.y + 10.f); 
+	vec2 slot_position = vec2((window_width_px - total_slots_width) / 2, bar_position.y - slot_size.y + 10.f);
 	// Draw three inventory slots centered on the screen
 	for (int i = 0; i < 3; ++i) {
 		vec2 current_slot_position = slot_position + vec2(i * (slot_size.x) / 1.5, 0.f);
 
-		// Draw Slot Background
-		glUseProgram(effects[(GLuint)EFFECT_ASSET_ID::TEXTURED]);
-		gl_has_errors();
-
-		TexturedVertex slot_vertices[4] = {
-			{ vec3(current_slot_position.x, current_slot_position.y, 0.f), vec2(0.f, 1.f) },
-			{ vec3(current_slot_position.x + slot_size.x, current_slot_position.y, 0.f), vec2(1.f, 1.f) },
-			{ vec3(current_slot_position.x + slot_size.x, current_slot_position.y + slot_size.y, 0.f), vec2(1.f, 0.f) },
-			{ vec3(current_slot_position.x, current_slot_position.y + slot_size.y, 0.f), vec2(0.f, 0.f) }
-		};
-
-		glBindBuffer(GL_ARRAY_BUFFER, healthbar_vbo);
-		glBufferData(GL_ARRAY_BUFFER, sizeof(slot_vertices), slot_vertices, GL_DYNAMIC_DRAW);
-		gl_has_errors();
-
-		GLint in_position_loc = glGetAttribLocation(effects[(GLuint)EFFECT_ASSET_ID::TEXTURED], "in_position");
-		GLint in_texcoord_loc = glGetAttribLocation(effects[(GLuint)EFFECT_ASSET_ID::TEXTURED], "in_texcoord");
-		glEnableVertexAttribArray(in_position_loc);
-		glVertexAttribPointer(in_position_loc, 3, GL_FLOAT, GL_FALSE, sizeof(TexturedVertex), (void*)0);
-		glEnableVertexAttribArray(in_texcoord_loc);
-		glVertexAttribPointer(in_texcoord_loc, 2, GL_FLOAT, GL_FALSE, sizeof(TexturedVertex), (void*)sizeof(vec3));
-		gl_has_errors();
-
 		GLuint slot_texture_id = (i == player_inventory.getSelectedSlot())
 			? texture_gl_handles[(GLuint)TEXTURE_ASSET_ID::INVENTORY_SLOT_SELECTED]
 			: texture_gl_handles[(GLuint)TEXTURE_ASSET_ID::INVENTORY_SLOT];
-
-		glBindTexture(GL_TEXTURE_2D, slot_texture_id);
-		glDrawArrays(GL_TRIANGLE_FAN, 0, 4);
-		gl_has_errors();
+		ui.quad(current_slot_position, slot_size, slot_texture_id, vec2(0.f, 1.f), vec2(1.f, 0.f));
 
 		if (i < player_inventory.slots.size()) {
 			const auto& slot = player_inventory.slots[i];
-			if (!slot.item.name.empty()) {
-				TEXTURE_ASSET_ID item_texture_enum = getTextureIDFromItemName(slot.item.name);
-				GLuint item_texture_id = texture_gl_handles[(GLuint)item_texture_enum];
+			if (!slot.item.empty()) {
+				TEXTURE_ASSET_ID item_texture_enum = item_def(slot.item.id).texture;
 
 				float scale_factor = std::min(slot_size.x / texture_dimensions[(GLuint)item_texture_enum].x,
 					slot_size.y / texture_dimensions[(GLuint)item_texture_enum].y);
 				vec2 item_size = vec2(texture_dimensions[(GLuint)item_texture_enum]) * scale_factor * 0.5f;
 				vec2 item_position = current_slot_position + (slot_size - item_size) / 2.0f;
+				ui.quad(item_position, item_size, texture_gl_handles[(GLuint)item_texture_enum]);
 
-				TexturedVertex item_vertices[4] = {
-					{ vec3(item_position.x, item_position.y, 0.f), vec2(0.f, 0.f) },
-					{ vec3(item_position.x + item_size.x, item_position.y, 0.f), vec2(1.f, 0.f) },
-					{ vec3(item_position.x + item_size.x, item_position.y + item_size.y, 0.f), vec2(1.f, 1.f) },
-					{ vec3(item_position.x, item_position.y + item_size.y, 0.f), vec2(0.f, 1.f) }
-				};
-
-				glBufferData(GL_ARRAY_BUFFER, sizeof(item_vertices), item_vertices, GL_DYNAMIC_DRAW);
-				glBindTexture(GL_TEXTURE_2D, item_texture_id);
-				glDrawArrays(GL_TRIANGLE_FAN, 0, 4);
-				gl_has_errors();
-
-				std::string count_text = std::to_string(slot.item.quantity);
-
-				float text_scale = 0.5f;
-				float count_x = current_slot_position.x + 117.f; 
-				float count_y = current_slot_position.y - 425.f; 
-				vec3 font_color = vec3(1.0f, 1.0f, 1.0f); 
-				mat4 font_transform = mat4(1.0f); 
-
-				glm::mat4 font_trans = glm::mat4(1.0f);
-				renderText(count_text, count_x, count_y, text_scale, font_color, font_transform);
+				float count_x = current_slot_position.x + 117.f;
+				float count_y = current_slot_position.y - 425.f;
+				addText(ui, std::to_string(slot.item.quantity), count_x, count_y, 0.5f, font_color);
 			}
 		}
 	}
 	for (Entity entity : registry.notifications.entities) {
-		const Notification& notification = registry.notifications.get(entity);
+		const Notification& notification = registry.notifications.peek(entity);
 		if (notification.duration <= 0.0f) {
 			continue;
 		}
-		float alpha = 1.0f - (notification.elapsed_time / notification.duration);
-		vec3 color_with_alpha = notification.color * vec3(1.0f, 1.0f, 1.0f) * alpha;
-
-		float textWidth = getTextWidth(notification.text, notification.scale); 
+		float textWidth = getTextWidth(notification.text, notification.scale);
 		float centeredX = notification.position.x - (textWidth / 2.0f);
-		renderText(notification.text, centeredX, notification.position.y, notification.scale, vec3(1.0f, 1.0f, 1.0f), mat4(1.0f));
+		addText(ui, notification.text, centeredX, notification.position.y, notification.scale, vec3(1.0f, 1.0f, 1.0f));
 	}
 	if (tutorial_state != TutorialState::COMPLETED) {
-		renderText("Press ENTER to skip tutorial", window_width_px - 350.0f, 10.0f, 0.5f, vec3(1.0f, 1.0f, 1.0f), mat4(1.0f));
+		addText(ui, "Press ENTER to skip tutorial", window_width_px - 350.0f, 10.0f, 0.5f, vec3(1.0f, 1.0f, 1.0f));
 	}
 }
 
@@ -1321,18 +1177,6 @@ float RenderSystem::getTextWidth(const std::string& text, float scale) {
 	return totalWidth;
 }
 
-TEXTURE_ASSET_ID RenderSystem::getTextureIDFromItemName(const std::string& itemName) {
-	if (itemName == "Key") return TEXTURE_ASSET_ID::KEY;
-	if (itemName == "ArmorPlate") return TEXTURE_ASSET_ID::ARMORPLATE;
-	if (itemName == "HealthPotion") return TEXTURE_ASSET_ID::HEALTHPOTION;
-	if (itemName == "CompanionRobot") return TEXTURE_ASSET_ID::COMPANION_CROCKBOT;
-	if (itemName == "Energy Core") return TEXTURE_ASSET_ID::ENERGY_CORE;
-	if (itemName == "Robot Parts") return TEXTURE_ASSET_ID::ROBOT_PART;
-	if (itemName == "Teleporter") return TEXTURE_ASSET_ID::TELEPORTER;
-	if (itemName == "IceRobot") return TEXTURE_ASSET_ID::ICE_ROBOT;
-	return TEXTURE_ASSET_ID::TEXTURE_COUNT;// default (should replace with empty)
-}
-
 
 
 void RenderSystem::updateCameraPosition(vec2 player_position) {
@@ -1373,79 +1217,72 @@ mat3 RenderSystem::createOrthographicProjection(float left, float right, float t
 }
 
 
-void RenderSystem::drawBoundingBox(Entity entity, const mat3& projection) {
-	Motion& motion = registry.motions.get(entity);
-	vec2 bounding_box = { abs(motion.bb.x), abs(motion.bb.y) };
-
+void RenderSystem::extractDebugBoxes(Entity entity, RenderPacket& packet) {
 	if (registry.tiles.has(entity)) {
 		return;
 	}
 
-	vec2 top_left = vec2(-bounding_box.x / 2, -bounding_box.y / 2);
-	vec2 top_right = vec2(bounding_box.x / 2, -bounding_box.y / 2);
-	vec2 bottom_left = vec2(-bounding_box.x / 2, bounding_box.y / 2);
-	vec2 bottom_right = vec2(bounding_box.x / 2, bounding_box.y / 2);
-
-
+	const Motion& motion = registry.motions.peek(entity);
+	if (debug_draw.enabled(DEBUG_CATEGORY::BOUNDING_BOX))
+		debug_rect(packet.debug_lines, motion.position, motion.bb, vec3(1.f, 0.f, 0.f));
+	if (!debug_draw.enabled(DEBUG_CATEGORY::REACTION_BOX))
+		return;
 
-	float vertices[] = {
-		top_left.x, top_left.y, 0.0f,
-		top_right.x, top_right.y, 0.0f,
-		bottom_right.x, bottom_right.y, 0.0f,
-		bottom_left.x, bottom_left.y, 0.0f
-	};
-	
-	GLuint box_program = effects[(GLuint)EFFECT_ASSET_ID::BOX];
-	glUseProgram(box_program);
-	gl_has_errors();
+	// search, attack and panic ranges
+	const vec3 color = vec3(1.f, 0.6f, 0.f);
+	if (registry.robots.has(entity)) {
+		const Robot& r = registry.robots.peek(entity);
+		for (vec2 box : { r.search_box, r.attack_box, r.panic_box })
+			debug_rect(packet.debug_lines, motion.position, box, color);
+	}
+	if (registry.bossRobots.has(entity)) {
+		const BossRobot& r = registry.bossRobots.peek(entity);
+		for (vec2 box : { r.search_box, r.attack_box, r.panic_box })
+			debug_rect(packet.debug_lines, motion.position, box, color);
+	}
+}
 
+void RenderSystem::initDebugLines() {
+	glGenVertexArrays(1, &debug_line_vao);
+	glGenBuffers(1, &debug_line_vbo);
 
-	GLuint vbo;
-	glGenBuffers(1, &vbo);
-	glBindBuffer(GL_ARRAY_BUFFER, vbo);
-	glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_DYNAMIC_DRAW);
+	glBindVertexArray(debug_line_vao);
+	glBindBuffer(GL_ARRAY_BUFFER, debug_line_vbo);
+	glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, sizeof(DebugVertex), (void*)offsetof(DebugVertex, position));
+	glEnableVertexAttribArray(0);
+	glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(DebugVertex), (void*)offsetof(DebugVertex, color));
+	glEnableVertexAttribArray(1);
+	glBindVertexArray(0);
 	gl_has_errors();
+}
 
+// Every debug shape of the frame in one draw, on top of the sprites
+void RenderSystem::drawDebugLines(const RenderPacket& packet, const mat3& projection) {
+	if (packet.debug_lines.empty())
+		return;
 
-	GLint in_position_loc = glGetAttribLocation(box_program, "in_position");
-	glEnableVertexAttribArray(in_position_loc);
-	glVertexAttribPointer(in_position_loc, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(float), (void*)0);
+	glBindVertexArray(debug_line_vao);
+	glBindBuffer(GL_ARRAY_BUFFER, debug_line_vbo);
+	size_t size = packet.debug_lines.size() * sizeof(DebugVertex);
+	if (size > debug_line_capacity) {
+		debug_line_capacity = size;
+		glBufferData(GL_ARRAY_BUFFER, size, nullptr, GL_STREAM_DRAW);
+	}
+	glBufferSubData(GL_ARRAY_BUFFER, 0, size, packet.debug_lines.data());
 	gl_has_errors();
 
-
-	mat3 mat = { { 1.f, 0.f, 0.f }, { 0.f, 1.f, 0.f}, { 0.f, 0.f, 1.f} };
-	//Transform transform1;
-	//transform1.translate(motion.position);
-	//transform1.rotate(motion.angle);
-
+	const GLuint program = effects[(GLuint)EFFECT_ASSET_ID::BOX];
+	glUseProgram(program);
+	// the lines are in world coordinates
 	Transform transform;
-	vec2 render_position = motion.position - camera_position;
-	transform.translate(render_position);
-
-	GLuint transform_loc = glGetUniformLocation(box_program, "transform");
-	glUniformMatrix3fv(transform_loc, 1, GL_FALSE, (float*)&transform.mat);
-	GLuint projection_loc = glGetUniformLocation(box_program, "projection");
-	glUniformMatrix3fv(projection_loc, 1, GL_FALSE, (float*)&projection);
-
-	GLuint in = glGetUniformLocation(box_program, "input_col");
-	vec3 color;
-
-	if (registry.collisions.has(entity)) {
-		color = vec3(0.f, 1.f, 0.f);
-	}
-	else {
-		color = vec3(1.f,0.f,0.0f);
-	}
-	glUniform3f(in, color.x, color.y, color.z);
+	transform.translate(-packet.camera_position);
+	glUniformMatrix3fv(glGetUniformLocation(program, "transform"), 1, GL_FALSE, (float*)&transform.mat);
+	glUniformMatrix3fv(glGetUniformLocation(program, "projection"), 1, GL_FALSE, (float*)&projection);
 	gl_has_errors();
 
-
-	glLineWidth(3.0f);
-	glDrawArrays(GL_LINE_LOOP, 0, 4);
+	glDrawArrays(GL_LINES, 0, (GLsizei)packet.debug_lines.size());
+	glBindVertexArray(default_vao);
 	gl_has_errors();
-
-
-	glDeleteBuffers(1, &vbo);
 }
 
 
@@ -1540,151 +1377,41 @@ void RenderSystem::renderText(std::string text, float x, float y, float scale, c
 }
 
 
-void RenderSystem::drawInventoryUI() {
+void RenderSystem::buildInventoryUI(UiDrawList& ui) {
 
 	glm::vec2 draggedPosition = mousePosition - dragOffset;
-	Inventory& player_inventory = registry.players.get(player).inventory;
+	const Inventory& player_inventory = registry.players.peek(player).inventory;
 	//  the inventory screen position and size
 	vec2 screen_position = vec2(50.f, 50.f);
 	vec2 screen_size = vec2(window_width_px - 100.f, window_height_px - 100.f);
+	ui.quad(screen_position, screen_size, texture_gl_handles[(GLuint)TEXTURE_ASSET_ID::UI_SCREEN]);
 
-	//vertices for UI_SCREEN and PLAYER_UPGRADE_SLOT
-	TexturedVertex screen_vertices[4] = {
-		{ vec3(screen_position.x, screen_position.y, 0.f), vec2(0.f, 0.f) },                  // Bottom-left
-		{ vec3(screen_position.x + screen_size.x, screen_position.y, 0.f), vec2(1.f, 0.f) },  // Bottom-right
-		{ vec3(screen_position.x + screen_size.x, screen_position.y + screen_size.y, 0.f), vec2(1.f, 1.f) }, // Top-right
-		{ vec3(screen_position.x, screen_position.y + screen_size.y, 0.f), vec2(0.f, 1.f) }   // Top-left
-	};
-
-	// Activate the shader and bind VBO data
-	glUseProgram(effects[(GLuint)EFFECT_ASSET_ID::TEXTURED]);
-	glBindBuffer(GL_ARRAY_BUFFER, ui_vbo);
-	glBufferData(GL_ARRAY_BUFFER, sizeof(screen_vertices), screen_vertices, GL_DYNAMIC_DRAW);
-	gl_has_errors();
-
-	// Set up vertex attributes for UI
-	GLint in_position_loc = glGetAttribLocation(effects[(GLuint)EFFECT_ASSET_ID::TEXTURED], "in_position");
-	GLint in_texcoord_loc = glGetAttribLocation(effects[(GLuint)EFFECT_ASSET_ID::TEXTURED], "in_texcoord");
-
-	glEnableVertexAttribArray(in_position_loc);
-	glVertexAttribPointer(in_position_loc, 3, GL_FLOAT, GL_FALSE, sizeof(TexturedVertex), (void*)0);
-	glEnableVertexAttribArray(in_texcoord_loc);
-	glVertexAttribPointer(in_texcoord_loc, 2, GL_FLOAT, GL_FALSE, sizeof(TexturedVertex), (void*)sizeof(vec3));
-	gl_has_errors();
-
-	// Render UI_SCREEN texture
-	GLuint ui_texture_id = texture_gl_handles[(GLuint)TEXTURE_ASSET_ID::UI_SCREEN];
-	glBindTexture(GL_TEXTURE_2D, ui_texture_id);
-	glDrawArrays(GL_TRIANGLE_FAN, 0, 4);
-	gl_has_errors();
-	//	glActiveTexture(GL_TEXTURE0);
-	//GLuint upgrade_slot_texture_id = texture_gl_handles[(GLuint)TEXTURE_ASSET_ID::PLAYER_UPGRADE_SLOT];
-	//glBindTexture(GL_TEXTURE_2D, upgrade_slot_texture_id);
-	//glDrawArrays(GL_TRIANGLE_FAN, 0, 4);
-	//gl_has_errors();
-
-	//GLuint player_avatar_texture_id = texture_gl_handles[(GLuint)TEXTURE_ASSET_ID::PLAYER_AVATAR];
-	//glBindTexture(GL_TEXTURE_2D, player_avatar_texture_id);
-	//glDrawArrays(GL_TRIANGLE_FAN, 0, 4);
-	//gl_has_errors();
-
-
-	// Define the position and size of the upgrade button
-	vec2 upgrade_button_position = vec2(730.f, 310.f); 
-	vec2 upgrade_button_size = vec2(100.f, 100.f); 
-
-	// Check if the mouse is hovering over the upgrade button
-	bool isHoveringUpgradeButton = (mousePosition.x >= upgrade_button_position.x &&
-		mousePosition.x <= upgrade_button_position.x + upgrade_button_size.x &&
-		mousePosition.y >= upgrade_button_position.y &&
-		mousePosition.y <= upgrade_button_position.y + upgrade_button_size.y);
-
-	// Choose the appropriate texture based on hover status
-	GLuint upgrade_button_texture_id = texture_gl_handles[(GLuint)(isHoveringUpgradeButton ? TEXTURE_ASSET_ID::UPGRADE_BUTTON_HOVER : TEXTURE_ASSET_ID::UPGRADE_BUTTON)];
-
-	// Define vertices for the upgrade button
-	TexturedVertex upgrade_button_vertices[4] = {
-		{ vec3(upgrade_button_position.x, upgrade_button_position.y, 0.f), vec2(0.f, 0.f) },  // Bottom-left (flipped)
-		{ vec3(upgrade_button_position.x + upgrade_button_size.x, upgrade_button_position.y, 0.f), vec2(1.f, 0.f) }, // Bottom-right (flipped)
-		{ vec3(upgrade_button_position.x + upgrade_button_size.x, upgrade_button_position.y + upgrade_button_size.y, 0.f), vec2(1.f, 1.f) }, // Top-right (flipped)
-		{ vec3(upgrade_button_position.x, upgrade_button_position.y + upgrade_button_size.y, 0.f), vec2(0.f, 1.f) } // Top-left (flipped)
-	};
-
-
-	// Render the upgrade button
-	glBindBuffer(GL_ARRAY_BUFFER, ui_vbo);
-	glBufferData(GL_ARRAY_BUFFER, sizeof(upgrade_button_vertices), upgrade_button_vertices, GL_DYNAMIC_DRAW);
-	glBindTexture(GL_TEXTURE_2D, upgrade_button_texture_id);
-	glDrawArrays(GL_TRIANGLE_FAN, 0, 4);
-	gl_has_errors();
+	// Upgrade button, lit while the mouse is over it
+	vec2 upgrade_button_position = vec2(730.f, 310.f);
+	vec2 upgrade_button_size = vec2(100.f, 100.f);
+	addButton(ui, upgrade_button_position, upgrade_button_size, TEXTURE_ASSET_ID::UPGRADE_BUTTON, TEXTURE_ASSET_ID::UPGRADE_BUTTON_HOVER, mousePosition);
 
+	glm::vec3 font_color = glm::vec3(1.0f, 1.0f, 1.0f); // White color
 
-	// Define and render armor slot
+	// Armor slot and its item
 	vec2 armor_slot_position = vec2(620.f, 165.f);
 	vec2 armor_slot_size = vec2(90.f, 90.f);
-	TexturedVertex armor_slot_vertices[4] = {
-	{ vec3(armor_slot_position.x, armor_slot_position.y, 0.f), vec2(0.f, 0.f) },  // Bottom-left
-	{ vec3(armor_slot_position.x + armor_slot_size.x, armor_slot_position.y, 0.f), vec2(1.f, 0.f) }, // Bottom-right
-	{ vec3(armor_slot_position.x + armor_slot_size.x, armor_slot_position.y + armor_slot_size.y, 0.f), vec2(1.f, 1.f) }, // Top-right
-	{ vec3(armor_slot_position.x, armor_slot_position.y + armor_slot_size.y, 0.f), vec2(0.f, 1.f) } // Top-left
-	};
-
-	glBindBuffer(GL_ARRAY_BUFFER, ui_vbo);
-	glBufferData(GL_ARRAY_BUFFER, sizeof(armor_slot_vertices), armor_slot_vertices, GL_DYNAMIC_DRAW);
-	GLuint armor_slot_texture_id = texture_gl_handles[(GLuint)TEXTURE_ASSET_ID::ARMOR_SLOT];
-	glBindTexture(GL_TEXTURE_2D, armor_slot_texture_id);
-	glDrawArrays(GL_TRIANGLE_FAN, 0, 4);
-	gl_has_errors();
+	ui.quad(armor_slot_position, armor_slot_size, texture_gl_handles[(GLuint)TEXTURE_ASSET_ID::ARMOR_SLOT]);
 
-	// Render item in armor slot if present
 	Item armor_item = player_inventory.getArmorItem();
-	if (!armor_item.name.empty()) {
-
-		TEXTURE_ASSET_ID armor_item_texture_enum = getTextureIDFromItemName(armor_item.name);
-		GLuint armor_item_texture_id = texture_gl_handles[(GLuint)armor_item_texture_enum];
+	if (!armor_item.empty()) {
+		TEXTURE_ASSET_ID armor_item_texture_enum = item_def(armor_item.id).texture;
 		ivec2 original_size = texture_dimensions[(GLuint)armor_item_texture_enum];
 		float scale_factor = std::min(armor_slot_size.x / original_size.x, armor_slot_size.y / original_size.y) * 0.8f;
 		vec2 item_size = vec2(original_size.x, original_size.y) * scale_factor;
 		vec2 item_position = armor_slot_position + (armor_slot_size - item_size) / 2.0f;
-
-		// Render the item in the armor slot
-		TexturedVertex armor_item_vertices[4] = {
-		{ vec3(item_position.x, item_position.y, 0.f), vec2(0.f, 0.f) },                    // Bottom-left (flipped)
-		{ vec3(item_position.x + item_size.x, item_position.y, 0.f), vec2(1.f, 0.f) },      // Bottom-right (flipped)
-		{ vec3(item_position.x + item_size.x, item_position.y + item_size.y, 0.f), vec2(1.f, 1.f) }, // Top-right (flipped)
-		{ vec3(item_position.x, item_position.y + item_size.y, 0.f), vec2(0.f, 1.f) }       // Top-left (flipped)
-		};
-
-		glBindBuffer(GL_ARRAY_BUFFER, ui_vbo);
-		glBufferData(GL_ARRAY_BUFFER, sizeof(armor_item_vertices), armor_item_vertices, GL_DYNAMIC_DRAW);
-		glBindTexture(GL_TEXTURE_2D, armor_item_texture_id);
-		glDrawArrays(GL_TRIANGLE_FAN, 0, 4);
-		gl_has_errors();
-
-
-		std::string quantity_text = std::to_string(armor_item.quantity);
-		glm::vec3 font_color = glm::vec3(1.0f, 1.0f, 1.0f);
-		glm::mat4 font_trans = glm::mat4(1.0f);
+		ui.quad(item_position, item_size, texture_gl_handles[(GLuint)armor_item_texture_enum]);
 
 		vec2 text_position = armor_slot_position + vec2(armor_slot_size.x - 22.f, armor_slot_size.y - 70.f);
 		text_position.y = window_height_px - text_position.y;
-		renderText(quantity_text, text_position.x, text_position.y, 0.5f, font_color, font_trans);
-
-
-		glUseProgram(effects[(GLuint)EFFECT_ASSET_ID::TEXTURED]);
-		glBindBuffer(GL_ARRAY_BUFFER, ui_vbo);
-		in_position_loc = glGetAttribLocation(effects[(GLuint)EFFECT_ASSET_ID::TEXTURED], "in_position");
-		in_texcoord_loc = glGetAttribLocation(effects[(GLuint)EFFECT_ASSET_ID::TEXTURED], "in_texcoord");
-
-		glEnableVertexAttribArray(in_position_loc);
-		glVertexAttribPointer(in_position_loc, 3, GL_FLOAT, GL_FALSE, sizeof(TexturedVertex), (void*)0);
-		glEnableVertexAttribArray(in_texcoord_loc);
-		glVertexAttribPointer(in_texcoord_loc, 2, GL_FLOAT, GL_FALSE, sizeof(TexturedVertex), (void*)sizeof(vec3));
-		gl_has_errors();
+		addText(ui, std::to_string(armor_item.quantity), text_position.x, text_position.y, 0.5f, font_color);
 	}
-	if (armor_item.name == "CompanionRobot" || armor_item.name == "IceRobot") {
-		glUseProgram(effects[(GLuint)EFFECT_ASSET_ID::COLOURED]);
-
+	if (armor_item.id == ItemId::COMPANION_ROBOT || armor_item.id == ItemId::ICE_ROBOT) {
 		vec2 bar_start_position = vec2(730.f, 190.f);
 		vec2 bar_size = vec2(100.f, 20.f);
 		float bar_spacing = 55.f;
@@ -1707,124 +1434,29 @@ void RenderSystem::drawInventoryUI() {
 		};
 
 		for (const auto& bar : bars) {
-			vec2 filled_bar_size = vec2(bar_size.x * bar.percentage, bar_size.y);
-
-			TexturedVertex background_bar_vertices[4] = {
-				{ vec3(bar.position.x, bar.position.y, 0.f), vec2(0.f, 0.f) },
-				{ vec3(bar.position.x + bar_size.x, bar.position.y, 0.f), vec2(1.f, 0.f) },
-				{ vec3(bar.position.x + bar_size.x, bar.position.y + bar_size.y, 0.f), vec2(1.f, 1.f) },
-				{ vec3(bar.position.x, bar.position.y + bar_size.y, 0.f), vec2(0.f, 1.f) }
-			};
-
-			TexturedVertex filled_bar_vertices[4] = {
-				{ vec3(bar.position.x, bar.position.y, 0.f), vec2(0.f, 0.f) },
-				{ vec3(bar.position.x + filled_bar_size.x, bar.position.y, 0.f), vec2(1.f, 0.f) },
-				{ vec3(bar.position.x + filled_bar_size.x, bar.position.y + bar_size.y, 0.f), vec2(1.f, 1.f) },
-				{ vec3(bar.position.x, bar.position.y + bar_size.y, 0.f), vec2(0.f, 1.f) }
-			};
-
-			glBindBuffer(GL_ARRAY_BUFFER, robot_healthbar_vbo);
-			glBufferData(GL_ARRAY_BUFFER, sizeof(background_bar_vertices), background_bar_vertices, GL_DYNAMIC_DRAW);
-
-			GLint in_position_loc = glGetAttribLocation(effects[(GLuint)EFFECT_ASSET_ID::COLOURED], "in_position");
-			glEnableVertexAttribArray(in_position_loc);
-			glVertexAttribPointer(in_position_loc, 3, GL_FLOAT, GL_FALSE, sizeof(TexturedVertex), (void*)0);
-
-			GLint color_uloc = glGetUniformLocation(effects[(GLuint)EFFECT_ASSET_ID::COLOURED], "fcolor");
-			glUniform3fv(color_uloc, 1, (float*)&background_color);
-
-			GLuint transform_loc = glGetUniformLocation(effects[(GLuint)EFFECT_ASSET_ID::COLOURED], "transform");
-			GLuint projection_loc = glGetUniformLocation(effects[(GLuint)EFFECT_ASSET_ID::COLOURED], "projection");
-			mat3 identity_transform = mat3(1.0f);
-			glUniformMatrix3fv(transform_loc, 1, GL_FALSE, (float*)&identity_transform);
-
-			glDrawArrays(GL_TRIANGLE_FAN, 0, 4);
-
-			glBufferData(GL_ARRAY_BUFFER, sizeof(filled_bar_vertices), filled_bar_vertices, GL_DYNAMIC_DRAW);
-
 			vec3 bar_color = glm::mix(vec3(1.0f, 0.0f, 0.0f), vec3(0.0f, 1.0f, 0.0f), bar.percentage);
-			glUniform3fv(color_uloc, 1, (float*)&bar_color);
-
-			glDrawArrays(GL_TRIANGLE_FAN, 0, 4);
-
-			glDisableVertexAttribArray(in_position_loc);
-
-			gl_has_errors();
+			ui.rect(bar.position, bar_size, background_color);
+			ui.rect(bar.position, vec2(bar_size.x * bar.percentage, bar_size.y), bar_color);
 		}
 	}
 
-
-
-	glUseProgram(effects[(GLuint)EFFECT_ASSET_ID::TEXTURED]);
-	glBindBuffer(GL_ARRAY_BUFFER, ui_vbo);
-	 in_position_loc = glGetAttribLocation(effects[(GLuint)EFFECT_ASSET_ID::TEXTURED], "in_position");
-	 in_texcoord_loc = glGetAttribLocation(effects[(GLuint)EFFECT_ASSET_ID::TEXTURED], "in_texcoord");
-
-	glEnableVertexAttribArray(in_position_loc);
-	glVertexAttribPointer(in_position_loc, 3, GL_FLOAT, GL_FALSE, sizeof(TexturedVertex), (void*)0);
-	glEnableVertexAttribArray(in_texcoord_loc);
-	glVertexAttribPointer(in_texcoord_loc, 2, GL_FLOAT, GL_FALSE, sizeof(TexturedVertex), (void*)sizeof(vec3));
-	gl_has_errors();
-	// Define and render weapon slot
+	// Weapon slot and its item
 	vec2 weapon_slot_position = vec2(620.f, 260.f);
 	vec2 weapon_slot_size = vec2(90.f, 90.f);
-	TexturedVertex weapon_slot_vertices[4] = {
-		{ vec3(weapon_slot_position.x, weapon_slot_position.y, 0.f), vec2(0.f, 0.f) },
-		{ vec3(weapon_slot_position.x + weapon_slot_size.x, weapon_slot_position.y, 0.f), vec2(1.f, 0.f) },
-		{ vec3(weapon_slot_position.x + weapon_slot_size.x, weapon_slot_position.y + weapon_slot_size.y, 0.f), vec2(1.f, 1.f) },
-		{ vec3(weapon_slot_position.x, weapon_slot_position.y + weapon_slot_size.y, 0.f), vec2(0.f, 1.f) }
-	};
+	ui.quad(weapon_slot_position, weapon_slot_size, texture_gl_handles[(GLuint)TEXTURE_ASSET_ID::WEAPON_SLOT]);
 
-	glBindBuffer(GL_ARRAY_BUFFER, ui_vbo);
-	glBufferData(GL_ARRAY_BUFFER, sizeof(weapon_slot_vertices), weapon_slot_vertices, GL_DYNAMIC_DRAW);
-	GLuint weapon_slot_texture_id = texture_gl_handles[(GLuint)TEXTURE_ASSET_ID::WEAPON_SLOT];
-	glBindTexture(GL_TEXTURE_2D, weapon_slot_texture_id);
-	glDrawArrays(GL_TRIANGLE_FAN, 0, 4);
-	gl_has_errors();
-
-	// Render item in weapon slot if present
 	Item weapon_item = player_inventory.getWeaponItem();
-	if (!weapon_item.name.empty()) {
-		TEXTURE_ASSET_ID weapon_item_texture_enum = getTextureIDFromItemName(weapon_item.name);
-		GLuint weapon_item_texture_id = texture_gl_handles[(GLuint)weapon_item_texture_enum];
+	if (!weapon_item.empty()) {
+		TEXTURE_ASSET_ID weapon_item_texture_enum = item_def(weapon_item.id).texture;
 		ivec2 original_size = texture_dimensions[(GLuint)weapon_item_texture_enum];
 		float scale_factor = std::min(weapon_slot_size.x / original_size.x, weapon_slot_size.y / original_size.y) * 0.8f;
 		vec2 item_size = vec2(original_size.x, original_size.y) * scale_factor;
 		vec2 item_position = weapon_slot_position + (weapon_slot_size - item_size) / 2.0f;
-
-		// Render the item in the armor slot
-		TexturedVertex weapon_item_vertices[4] = {
-		{ vec3(item_position.x, item_position.y, 0.f), vec2(0.f, 0.f) },                    // Bottom-left (flipped)
-		{ vec3(item_position.x + item_size.x, item_position.y, 0.f), vec2(1.f, 0.f) },      // Bottom-right (flipped)
-		{ vec3(item_position.x + item_size.x, item_position.y + item_size.y, 0.f), vec2(1.f, 1.f) }, // Top-right (flipped)
-		{ vec3(item_position.x, item_position.y + item_size.y, 0.f), vec2(0.f, 1.f) }       // Top-left (flipped)
-		};
-
-		glBindBuffer(GL_ARRAY_BUFFER, ui_vbo);
-		glBufferData(GL_ARRAY_BUFFER, sizeof(weapon_item_vertices), weapon_item_vertices, GL_DYNAMIC_DRAW);
-		glBindTexture(GL_TEXTURE_2D, weapon_item_texture_id);
-		glDrawArrays(GL_TRIANGLE_FAN, 0, 4);
-		gl_has_errors();
-
-		std::string quantity_text = std::to_string(weapon_item.quantity);
-		glm::vec3 font_color = glm::vec3(1.0f, 1.0f, 1.0f);
-		glm::mat4 font_trans = glm::mat4(1.0f);
-
-		vec2 text_position = weapon_slot_position + vec2(weapon_slot_size.x - 22.f, weapon_slot_size.y - 70.f);
-		text_position.y = window_height_px - text_position.y;
-		renderText(quantity_text, text_position.x, text_position.y, 0.5f, font_color, font_trans);
-
-
-		glUseProgram(effects[(GLuint)EFFECT_ASSET_ID::TEXTURED]);
-		glBindBuffer(GL_ARRAY_BUFFER, ui_vbo);
-		in_position_loc = glGetAttribLocation(effects[(GLuint)EFFECT_ASSET_ID::TEXTURED], "in_position");
-		in_texcoord_loc = glGetAttribLocation(effects[(GLuint)EFFECT_ASSET_ID::TEXTURED], "in_texcoord");
-
-		glEnableVertexAttribArray(in_position_loc);
-		glVertexAttribPointer(in_position_loc, 3, GL_FLOAT, GL_FALSE, sizeof(TexturedVertex), (void*)0);
-		glEnableVertexAttribArray(in_texcoord_loc);
-		glVertexAttribPointer(in_texcoord_loc, 2, GL_FLOAT, GL_FALSE, sizeof(TexturedVertex), (void*)sizeof(vec3));
-		gl_has_errors();
+		ui.quad(item_position, item_size, texture_gl_handles[(GLuint)weapon_item_texture_enum]);
+
+		vec2 text_position = weapon_slot_position + vec2(weapon_slot_size.x - 22.f, weapon_slot_size.y - 70.f);
+		text_position.y = window_height_px - text_position.y;
+		addText(ui, std::to_string(weapon_item.quantity), text_position.x, text_position.y, 0.5f, font_color);
 	}
 	// Inventory Slots Configuration (2 rows x 5 columns)
 	vec2 slot_size = vec2(90.f, 90.f);
@@ -1835,8 +1467,6 @@ void RenderSystem::drawInventoryUI() {
 		screen_position.x + (screen_size.x - (5 * slot_size.x + 4 * horizontal_spacing)) / 2,
 		screen_position.y + (screen_size.y) - 260.f
 	);
-	// Access player's inventory items
-	const auto& items = player_inventory.getItems();
 
 	// Draw 10 inventory slots in a 2x5 grid, excluding the armor slot
 	for (int slot_index = 0; slot_index < 10; ++slot_index) {
@@ -1844,97 +1474,45 @@ void RenderSystem::drawInventoryUI() {
 			(slot_index % 5) * (slot_size.x + horizontal_spacing),
 			(slot_index / 5) * (slot_size.y + vertical_spacing - 10.f)
 		);
+		ui.quad(current_slot_position, slot_size, texture_gl_handles[(GLuint)TEXTURE_ASSET_ID::INV_SLOT], vec2(0.f, 1.f), vec2(1.f, 0.f));
 
-		// Define vertices for each slot
-		TexturedVertex slot_vertices[4] = {
-			{ vec3(current_slot_position.x, current_slot_position.y, 0.f), vec2(0.f, 1.f) },
-			{ vec3(current_slot_position.x + slot_size.x, current_slot_position.y, 0.f), vec2(1.f, 1.f) },
-			{ vec3(current_slot_position.x + slot_size.x, current_slot_position.y + slot_size.y, 0.f), vec2(1.f, 0.f) },
-			{ vec3(current_slot_position.x, current_slot_position.y + slot_size.y, 0.f), vec2(0.f, 0.f) }
-		};
-
-		glBindBuffer(GL_ARRAY_BUFFER, ui_vbo);
-		glBufferData(GL_ARRAY_BUFFER, sizeof(slot_vertices), slot_vertices, GL_DYNAMIC_DRAW);
-		GLuint slot_texture_id = texture_gl_handles[(GLuint)TEXTURE_ASSET_ID::INV_SLOT];
-		glBindTexture(GL_TEXTURE_2D, slot_texture_id);
-		glDrawArrays(GL_TRIANGLE_FAN, 0, 4);
-		gl_has_errors();
-
-		// Draw item in slot if it’s not being dragged
+		// Draw item in slot if it's not being dragged
 		if (!(isDragging && draggedSlot == slot_index)) {
-			Item item = player_inventory.slots[slot_index].item;
-			if (!item.name.empty()) {
-				TEXTURE_ASSET_ID item_texture_id = getTextureIDFromItemName(item.name);
-				renderInventoryItem(item, current_slot_position, slot_size);
-				std::string quantity_text = std::to_string(item.quantity);
-				glm::vec3 font_color = glm::vec3(1.0f, 1.0f, 1.0f);
-				glm::mat4 font_trans = glm::mat4(1.0f);
+			const Item& item = player_inventory.slots[slot_index].item;
+			if (!item.empty()) {
+				addInventoryItem(ui, item, current_slot_position, slot_size);
 
 				vec2 text_position = current_slot_position + vec2(slot_size.x - 22.f, slot_size.y - 70.f);
 				text_position.y = window_height_px - text_position.y;
-				renderText(quantity_text, text_position.x, text_position.y, 0.5f, font_color, font_trans);
-
-
-				glUseProgram(effects[(GLuint)EFFECT_ASSET_ID::TEXTURED]);
-				glBindBuffer(GL_ARRAY_BUFFER, ui_vbo);
-				in_position_loc = glGetAttribLocation(effects[(GLuint)EFFECT_ASSET_ID::TEXTURED], "in_position");
-				in_texcoord_loc = glGetAttribLocation(effects[(GLuint)EFFECT_ASSET_ID::TEXTURED], "in_texcoord");
-
-				glEnableVertexAttribArray(in_position_loc);
-				glVertexAttribPointer(in_position_loc, 3, GL_FLOAT, GL_FALSE, sizeof(TexturedVertex), (void*)0);
-				glEnableVertexAttribArray(in_texcoord_loc);
-				glVertexAttribPointer(in_texcoord_loc, 2, GL_FLOAT, GL_FALSE, sizeof(TexturedVertex), (void*)sizeof(vec3));
-				gl_has_errors();
+				addText(ui, std::to_string(item.quantity), text_position.x, text_position.y, 0.5f, font_color);
 			}
 		}
-
 	}
 
 	// Render dragged item at dragged position
 	if (isDragging && draggedSlot != -1) {
-		renderInventoryItem(player_inventory.slots[draggedSlot].item, draggedPosition, slot_size);
+		addInventoryItem(ui, player_inventory.slots[draggedSlot].item, draggedPosition, slot_size);
 	}
 	float text_scale = 0.5f;
-	glm::vec3 font_color = glm::vec3(1.0f, 1.0f, 1.0f); // White color
-	glm::mat4 font_trans = glm::mat4(1.0f); // Identity matrix
-
-
 	float health_text_x = 420.0f;
 	float health_text_y = 400.f;
 
-	// Load the font and render the text
-	std::string text = std::to_string((int)registry.players.get(player).armor_stat);
-	renderText("Armor: " + text, health_text_x, health_text_y, text_scale, font_color, font_trans);
-	std::string weapon_text = std::to_string((int)registry.players.get(player).weapon_stat);
-	renderText("Weapon: " + weapon_text, health_text_x, 375.f, text_scale, font_color, font_trans);
-
-
+	std::string text = std::to_string((int)registry.players.peek(player).armor_stat);
+	addText(ui, "Armor: " + text, health_text_x, health_text_y, text_scale, font_color);
+	std::string weapon_text = std::to_string((int)registry.players.peek(player).weapon_stat);
+	addText(ui, "Weapon: " + weapon_text, health_text_x, 375.f, text_scale, font_color);
 }
 
-void RenderSystem::renderInventoryItem(const Item& item, const vec2& position, const vec2& size) {
+void RenderSystem::addInventoryItem(UiDrawList& ui, const Item& item, const vec2& position, const vec2& size) {
 
-	TEXTURE_ASSET_ID item_texture_enum = getTextureIDFromItemName(item.name);
-	GLuint item_texture_id = texture_gl_handles[(GLuint)item_texture_enum];
+	TEXTURE_ASSET_ID item_texture_enum = item_def(item.id).texture;
 
 	float scale_factor = std::min(size.x / texture_dimensions[(GLuint)item_texture_enum].x,
 		size.y / texture_dimensions[(GLuint)item_texture_enum].y);
 	vec2 item_size = vec2(texture_dimensions[(GLuint)item_texture_enum]) * scale_factor * 0.7f;
 
 	vec2 item_position = position + (size - item_size) / 2.0f; // Center item within slot or dragged position
-
-	TexturedVertex item_vertices[4] = {
-	 { vec3(item_position.x, item_position.y, 0.f), vec2(0.f, 0.f) },                  // Bottom-left (flipped)
-	 { vec3(item_position.x + item_size.x, item_position.y, 0.f), vec2(1.f, 0.f) },    // Bottom-right (flipped)
-	 { vec3(item_position.x + item_size.x, item_position.y + item_size.y, 0.f), vec2(1.f, 1.f) }, // Top-right
-	 { vec3(item_position.x, item_position.y + item_size.y, 0.f), vec2(0.f, 1.f) }     // Top-left
-	};
-
-
-	glBindBuffer(GL_ARRAY_BUFFER, ui_vbo);
-	glBufferData(GL_ARRAY_BUFFER, sizeof(item_vertices), item_vertices, GL_DYNAMIC_DRAW);
-	glBindTexture(GL_TEXTURE_2D, item_texture_id);
-	glDrawArrays(GL_TRIANGLE_FAN, 0, 4);
-	gl_has_errors();
+	ui.quad(item_position, item_size, texture_gl_handles[(GLuint)item_texture_enum]);
 }
 
 vec2 RenderSystem::getSlotPosition(int slot_index) const {
@@ -1962,158 +1540,6 @@ vec2 RenderSystem::getSlotPosition(int slot_index) const {
 
 
 
-void RenderSystem::drawReactionBox(Entity entity, const mat3& projection) {
-	Motion& motion = registry.motions.get(entity);
-
-	if (!registry.robots.has(entity)) {
-		return;
-	}
-
-	Robot r = registry.robots.get(entity);
-	std::vector<vec2> boxs = { r.search_box,r.attack_box,r.panic_box };
-
-
-
-	for (vec2 bounding_box : boxs) {
-		vec2 top_left = vec2(-bounding_box.x / 2, -bounding_box.y / 2);
-		vec2 top_right = vec2(bounding_box.x / 2, -bounding_box.y / 2);
-		vec2 bottom_left = vec2(-bounding_box.x / 2, bounding_box.y / 2);
-		vec2 bottom_right = vec2(bounding_box.x / 2, bounding_box.y / 2);
-
-
-
-		float vertices[] = {
-			top_left.x, top_left.y, 0.0f,
-			top_right.x, top_right.y, 0.0f,
-			bottom_right.x, bottom_right.y, 0.0f,
-			bottom_left.x, bottom_left.y, 0.0f
-		};
-
-		GLuint box_program = effects[(GLuint)EFFECT_ASSET_ID::BOX];
-		glUseProgram(box_program);
-		gl_has_errors();
-
-
-		GLuint vbo;
-		glGenBuffers(1, &vbo);
-		glBindBuffer(GL_ARRAY_BUFFER, vbo);
-		glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_DYNAMIC_DRAW);
-		gl_has_errors();
-
-
-		GLint in_position_loc = glGetAttribLocation(box_program, "in_position");
-		glEnableVertexAttribArray(in_position_loc);
-		glVertexAttribPointer(in_position_loc, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(float), (void*)0);
-		gl_has_errors();
-
-
-		Transform transform;
-		vec2 render_position = motion.position - camera_position;
-		transform.translate(render_position);
-
-		GLuint transform_loc = glGetUniformLocation(box_program, "transform");
-		glUniformMatrix3fv(transform_loc, 1, GL_FALSE, (float*)&transform.mat);
-		GLuint projection_loc = glGetUniformLocation(box_program, "projection");
-		glUniformMatrix3fv(projection_loc, 1, GL_FALSE, (float*)&projection);
-
-		GLuint in = glGetUniformLocation(box_program, "input_col");
-		vec3 color;
-
-		if (registry.collisions.has(entity)) {
-			color = vec3(0.f, 1.f, 0.f);
-		}
-		else {
-			color = vec3(1.f, 0.f, 0.0f);
-		}
-		glUniform3f(in, color.x, color.y, color.z);
-		gl_has_errors();
-
-
-		glLineWidth(3.0f);
-		glDrawArrays(GL_LINE_LOOP, 0, 4);
-		gl_has_errors();
-
-
-		glDeleteBuffers(1, &vbo);
-	}
-}
-
-
-void RenderSystem::drawBossReactionBox(Entity entity, const mat3& projection) {
-	Motion& motion = registry.motions.get(entity);
-
-	if (!registry.bossRobots.has(entity)) {
-		return;
-	}
-
-	BossRobot r = registry.bossRobots.get(entity);
-	std::vector<vec2> boxs = { r.search_box,r.attack_box,r.panic_box };
-
-	for (vec2 bounding_box : boxs) {
-		vec2 top_left = vec2(-bounding_box.x / 2, -bounding_box.y / 2);
-		vec2 top_right = vec2(bounding_box.x / 2, -bounding_box.y / 2);
-		vec2 bottom_left = vec2(-bounding_box.x / 2, bounding_box.y / 2);
-		vec2 bottom_right = vec2(bounding_box.x / 2, bounding_box.y / 2);
-
-
-
-		float vertices[] = {
-			top_left.x, top_left.y, 0.0f,
-			top_right.x, top_right.y, 0.0f,
-			bottom_right.x, bottom_right.y, 0.0f,
-			bottom_left.x, bottom_left.y, 0.0f
-		};
-
-		GLuint box_program = effects[(GLuint)EFFECT_ASSET_ID::BOX];
-		glUseProgram(box_program);
-		gl_has_errors();
-
-
-		GLuint vbo;
-		glGenBuffers(1, &vbo);
-		glBindBuffer(GL_ARRAY_BUFFER, vbo);
-		glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_DYNAMIC_DRAW);
-		gl_has_errors();
-
-
-		GLint in_position_loc = glGetAttribLocation(box_program, "in_position");
-		glEnableVertexAttribArray(in_position_loc);
-		glVertexAttribPointer(in_position_loc, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(float), (void*)0);
-		gl_has_errors();
-
-
-		Transform transform;
-		vec2 render_position = motion.position - camera_position;
-		transform.translate(render_position);
-
-		GLuint transform_loc = glGetUniformLocation(box_program, "transform");
-		glUniformMatrix3fv(transform_loc, 1, GL_FALSE, (float*)&transform.mat);
-		GLuint projection_loc = glGetUniformLocation(box_program, "projection");
-		glUniformMatrix3fv(projection_loc, 1, GL_FALSE, (float*)&projection);
-
-		GLuint in = glGetUniformLocation(box_program, "input_col");
-		vec3 color;
-
-		if (registry.collisions.has(entity)) {
-			color = vec3(0.f, 1.f, 0.f);
-		}
-		else {
-			color = vec3(1.f, 0.f, 0.0f);
-		}
-		glUniform3f(in, color.x, color.y, color.z);
-		gl_has_errors();
-
-
-		glLineWidth(3.0f);
-		glDrawArrays(GL_LINE_LOOP, 0, 4);
-		gl_has_errors();
-
-
-		glDeleteBuffers(1, &vbo);
-	}
-}
-
-
 void RenderSystem::updateFPS() {
 	Uint32 current_time = SDL_GetTicks();
 	frame_count++;
@@ -2139,31 +1565,63 @@ void RenderSystem::drawFPSCounter(const mat3& projection) {
 	std::string fps_text = "FPS: " + std::to_string(static_cast<int>(fps));
 	glm::mat4 font_trans = glm::mat4(1.0f); 
 	renderText(fps_text, fps_x, fps_y, text_scale, font_color, font_trans);
+
+	std::string save_text = "Save capture: " + std::to_string(save_capture_ms).substr(0, 4) + " ms";
+	renderText(save_text, fps_x, fps_y - 30.f, text_scale * 0.6f, font_color, font_trans);
+
+	const PathFrameStats& paths = path_frame_stats;
+	std::string path_text = "Paths: " + std::to_string(paths.queries) + " queries, "
+		+ std::to_string(paths.expansions) + " nodes (max " + std::to_string(paths.max_expansions) + "), "
+		+ std::to_string(paths.search_ms).substr(0, 4) + " ms, "
+		+ std::to_string(paths.sectors_rebuilt) + " sectors rebuilt";
+	renderText(path_text, fps_x, fps_y - 50.f, text_scale * 0.6f, font_color, font_trans);
+	std::string failure_text = "Path failures: " + std::to_string(paths.failures[(int)PATH_FAILURE::OUT_OF_MAP]) + " off map, "
+		+ std::to_string(paths.failures[(int)PATH_FAILURE::UNREACHABLE]) + " unreachable";
+	renderText(failure_text, fps_x, fps_y - 70.f, text_scale * 0.6f, font_color, font_trans);
+
+	std::string voice_text = "Sounds: " + std::to_string(dropped_sounds) + " dropped, "
+		+ std::to_string(stolen_voices) + " voices stolen";
+	renderText(voice_text, fps_x, fps_y - 90.f, text_scale * 0.6f, font_color, font_trans);
 }
 
-void RenderSystem::drawRobotHealthBar(Entity robot, const mat3& projection) {
-	if (!registry.robots.has(robot) || !robot_healthbar_vbo_initialized)
+void RenderSystem::extractRobotHealthBar(Entity robot, RenderPacket& packet) {
+	if (!registry.robots.has(robot))
 		return;
 
-	// Bind the shader program for coloring
-	glUseProgram(effects[(GLuint)EFFECT_ASSET_ID::COLOURED]);
-	gl_has_errors();
-
-	// Retrieve the robot�s health information
-	Robot& robot_data = registry.robots.get(robot);
+	// Retrieve the robot's health information
+	const Robot& robot_data = registry.robots.peek(robot);
 	float health_percentage = robot_data.current_health / robot_data.max_health;
 	health_percentage = glm::clamp(health_percentage, 0.0f, 1.0f);
 	// Position the health bar above the robot and apply camera offset
-	Motion& motion = registry.motions.get(robot);
+	const Motion& motion = registry.motions.peek(robot);
 	float vertical_offset = motion.scale.y * -0.3f; 
 	vec2 bar_position; 
 	if (registry.iceRobotAnimations.has(robot)) {
-		bar_position = motion.position - camera_position + vec2(0.0f, vertical_offset - 20.f);
+		bar_position = motion.position - packet.camera_position + vec2(0.0f, vertical_offset - 20.f);
 	}
 	else {
-		bar_position = motion.position - camera_position + vec2(0.0f, vertical_offset);
+		bar_position = motion.position - packet.camera_position + vec2(0.0f, vertical_offset);
 	}
-	vec2 bar_size = vec2(30.f, 5.f);
+
+	SpriteDraw bar;
+	bar.kind = SpriteKind::HEALTH_BAR;
+	bar.position = bar_position;
+	bar.scale = vec2(30.f, 5.f);
+	bar.fill = health_percentage;
+	packet.sprites.push_back(bar);
+}
+
+void RenderSystem::drawHealthBar(const SpriteDraw& bar, const mat3& projection) {
+	if (!robot_healthbar_vbo_initialized)
+		return;
+
+	// Bind the shader program for coloring
+	glUseProgram(effects[(GLuint)EFFECT_ASSET_ID::COLOURED]);
+	gl_has_errors();
+
+	vec2 bar_position = bar.position;
+	vec2 bar_size = bar.scale;
+	float health_percentage = bar.fill;
 
 	TexturedVertex full_bar_vertices[4] = {
 		{ vec3(bar_position.x - bar_size.x / 2, bar_position.y, 0.f), vec2(0.f, 1.f) },
@@ -2241,272 +1699,102 @@ void RenderSystem::initRobotHealthBarVBO() {
 	}
 }
 
-void RenderSystem::drawBossRobotHealthBar(Entity boss_robot, const mat3& projection) {
-	if ( !robot_healthbar_vbo_initialized) {
-		return;
-	}
+void RenderSystem::extractBossRobotHealthBar(Entity boss_robot, RenderPacket& packet) {
 	if (!registry.bossRobots.has(boss_robot)) {
 		return;
 	}
-	// Bind the shader program for coloring
-	glUseProgram(effects[(GLuint)EFFECT_ASSET_ID::COLOURED]);
-	gl_has_errors();
 
-	// Retrieve the robot�s health information
-	BossRobot& robot_data = registry.bossRobots.get(boss_robot);
+	// Retrieve the robot's health information
+	const BossRobot& robot_data = registry.bossRobots.peek(boss_robot);
 	float health_percentage = robot_data.current_health / robot_data.max_health;
 	health_percentage = glm::clamp(health_percentage, 0.0f, 1.0f);
 	// Position the health bar above the robot and apply camera offset
-	Motion& motion = registry.motions.get(boss_robot);
+	const Motion& motion = registry.motions.peek(boss_robot);
 	float vertical_offset = motion.scale.y * -0.3f - 50.0f; 
-	vec2 bar_position = motion.position - camera_position + vec2(0.0f, vertical_offset);
-	vec2 bar_size = vec2(150.f, 20.f); 
-
-	TexturedVertex full_bar_vertices[4] = {
-		{ vec3(bar_position.x - bar_size.x / 2, bar_position.y, 0.f), vec2(0.f, 1.f) },
-		{ vec3(bar_position.x + bar_size.x / 2, bar_position.y, 0.f), vec2(1.f, 1.f) },
-		{ vec3(bar_position.x + bar_size.x / 2, bar_position.y + bar_size.y, 0.f), vec2(1.f, 0.f) },
-		{ vec3(bar_position.x - bar_size.x / 2, bar_position.y + bar_size.y, 0.f), vec2(0.f, 0.f) }
-	};
-
-	// Bind the VBO and load vertex data
-	glBindBuffer(GL_ARRAY_BUFFER, robot_healthbar_vbo);
-	glBufferData(GL_ARRAY_BUFFER, sizeof(full_bar_vertices), full_bar_vertices, GL_DYNAMIC_DRAW);
-	gl_has_errors();
-
-	// Get and enable position attribute location
-	GLint in_position_loc = glGetAttribLocation(effects[(GLuint)EFFECT_ASSET_ID::COLOURED], "in_position");
-	if (in_position_loc == -1) {
-		std::cerr << "Error: Position attribute not found in shader" << std::endl;
-		return;
-	}
-	glEnableVertexAttribArray(in_position_loc);
-	glVertexAttribPointer(in_position_loc, 3, GL_FLOAT, GL_FALSE, sizeof(TexturedVertex), (void*)0);
-	gl_has_errors();
-
-	// Set the color for the background bar
-	GLint color_uloc = glGetUniformLocation(effects[(GLuint)EFFECT_ASSET_ID::COLOURED], "fcolor");
-	vec3 background_color = vec3(0.7f, 0.7f, 0.7f);  // Gray
-	glUniform3fv(color_uloc, 1, (float*)&background_color);
-
-	// Use projection matrix for screen positioning
-	GLuint transform_loc = glGetUniformLocation(effects[(GLuint)EFFECT_ASSET_ID::COLOURED], "transform");
-	GLuint projection_loc = glGetUniformLocation(effects[(GLuint)EFFECT_ASSET_ID::COLOURED], "projection");
-	mat3 identity_transform = mat3(1.0f);  // No extra transformations
-	glUniformMatrix3fv(transform_loc, 1, GL_FALSE, (float*)&identity_transform);
-	glUniformMatrix3fv(projection_loc, 1, GL_FALSE, (float*)&projection);
-
-	// Draw the background bar
-	glDrawArrays(GL_TRIANGLE_FAN, 0, 4);
-
-	// vertices for the filled health bar portion
-	TexturedVertex health_bar_vertices[4] = {
-		{ vec3(bar_position.x - bar_size.x / 2, bar_position.y, 0.f), vec2(0.f, 1.f) },
-		{ vec3(bar_position.x - bar_size.x / 2 + bar_size.x * health_percentage, bar_position.y, 0.f), vec2(1.f, 1.f) },
-		{ vec3(bar_position.x - bar_size.x / 2 + bar_size.x * health_percentage, bar_position.y + bar_size.y, 0.f), vec2(1.f, 0.f) },
-		{ vec3(bar_position.x - bar_size.x / 2, bar_position.y + bar_size.y, 0.f), vec2(0.f, 0.f) }
-	};
-
-	// Update VBO data and set health color
-	glBufferData(GL_ARRAY_BUFFER, sizeof(health_bar_vertices), health_bar_vertices, GL_DYNAMIC_DRAW);
-	vec3 health_color = glm::mix(vec3(1.0f, 0.0f, 0.0f), vec3(0.0f, 1.0f, 0.0f), health_percentage);
-	glUniform3fv(color_uloc, 1, (float*)&health_color);
-	glDrawArrays(GL_TRIANGLE_FAN, 0, 4);
 
-	glDisableVertexAttribArray(in_position_loc);
+	SpriteDraw bar;
+	bar.kind = SpriteKind::HEALTH_BAR;
+	bar.position = motion.position - packet.camera_position + vec2(0.0f, vertical_offset);
+	bar.scale = vec2(150.f, 20.f);
+	bar.fill = health_percentage;
+	packet.sprites.push_back(bar);
 }
 
 
-void RenderSystem::renderCaptureUI(const Robot& robot, Entity entity) {
-	currentRobotEntity = entity;
-	//  the inventory screen position and size
-
+void RenderSystem::buildCaptureUI(UiDrawList& ui, const Robot& robot, Entity entity) {
 	vec2 screen_position = vec2(50.f, 50.f);
 	vec2 screen_size = vec2(window_width_px - 100.f, window_height_px - 100.f);
-
-	TexturedVertex screen_vertices[4] = {
-		{ vec3(screen_position.x, screen_position.y, 0.f), vec2(0.f, 0.f) },                  // Bottom-left
-		{ vec3(screen_position.x + screen_size.x, screen_position.y, 0.f), vec2(1.f, 0.f) },  // Bottom-right
-		{ vec3(screen_position.x + screen_size.x, screen_position.y + screen_size.y, 0.f), vec2(1.f, 1.f) }, // Top-right
-		{ vec3(screen_position.x, screen_position.y + screen_size.y, 0.f), vec2(0.f, 1.f) }   // Top-left
-	};
-
-	glUseProgram(effects[(GLuint)EFFECT_ASSET_ID::TEXTURED]);
-	glBindBuffer(GL_ARRAY_BUFFER, ui_vbo);
-	glBufferData(GL_ARRAY_BUFFER, sizeof(screen_vertices), screen_vertices, GL_DYNAMIC_DRAW);
-	gl_has_errors();
-
-	GLint in_position_loc = glGetAttribLocation(effects[(GLuint)EFFECT_ASSET_ID::TEXTURED], "in_position");
-	GLint in_texcoord_loc = glGetAttribLocation(effects[(GLuint)EFFECT_ASSET_ID::TEXTURED], "in_texcoord");
-
-	glEnableVertexAttribArray(in_position_loc);
-	glVertexAttribPointer(in_position_loc, 3, GL_FLOAT, GL_FALSE, sizeof(TexturedVertex), (void*)0);
-	glEnableVertexAttribArray(in_texcoord_loc);
-	glVertexAttribPointer(in_texcoord_loc, 2, GL_FLOAT, GL_FALSE, sizeof(TexturedVertex), (void*)sizeof(vec3));
-	gl_has_errors();
-
-	GLuint ui_texture_id = texture_gl_handles[(GLuint)TEXTURE_ASSET_ID::CAPTURE_UI];
-	glBindTexture(GL_TEXTURE_2D, ui_texture_id);
-	glDrawArrays(GL_TRIANGLE_FAN, 0, 4);
-	gl_has_errors();
+	ui.quad(screen_position, screen_size, texture_gl_handles[(GLuint)TEXTURE_ASSET_ID::CAPTURE_UI]);
 
 	vec2 crocbot_position = vec2((window_width_px - 210.f) / 2.f, (window_height_px - 120.f) / 2.f); // Centered position
 	vec2 crocbot_size = vec2(300.f, 200.f) * 0.9f;
+	TEXTURE_ASSET_ID crockbot_texture = registry.iceRobotAnimations.has(entity) ? TEXTURE_ASSET_ID::ICE_ROBOT : TEXTURE_ASSET_ID::COMPANION_CROCKBOT;
+	ui.quad(crocbot_position, crocbot_size, texture_gl_handles[(GLuint)crockbot_texture]);
 
-	TexturedVertex crocbot_vertices[4] = {
-		{ vec3(crocbot_position.x, crocbot_position.y, 0.f), vec2(0.f, 0.f) },
-		{ vec3(crocbot_position.x + crocbot_size.x, crocbot_position.y, 0.f), vec2(1.f, 0.f) },
-		{ vec3(crocbot_position.x + crocbot_size.x, crocbot_position.y + crocbot_size.y, 0.f), vec2(1.f, 1.f) },
-		{ vec3(crocbot_position.x, crocbot_position.y + crocbot_size.y, 0.f), vec2(0.f, 1.f) }
-	};
-	glBindBuffer(GL_ARRAY_BUFFER, ui_vbo);
-	glBufferData(GL_ARRAY_BUFFER, sizeof(crocbot_vertices), crocbot_vertices, GL_DYNAMIC_DRAW);
-	if (registry.iceRobotAnimations.has(currentRobotEntity)) {
-		GLuint crockbot_texture = texture_gl_handles[(GLuint)TEXTURE_ASSET_ID::ICE_ROBOT];
-		glBindTexture(GL_TEXTURE_2D, crockbot_texture);
-		glDrawArrays(GL_TRIANGLE_FAN, 0, 4);
-		gl_has_errors();
-	}
-	else {
-	GLuint crockbot_texture = texture_gl_handles[(GLuint)TEXTURE_ASSET_ID::COMPANION_CROCKBOT];
-	glBindTexture(GL_TEXTURE_2D, crockbot_texture);
-	glDrawArrays(GL_TRIANGLE_FAN, 0, 4);
-	gl_has_errors();
-}
+	addButton(ui, vec2(850.f, 410.f), vec2(110.f, 110.f), TEXTURE_ASSET_ID::C_BUTTON, TEXTURE_ASSET_ID::C_BUTTON_HOVER, mousePosition);
+	addButton(ui, vec2(375.f, 410.f), vec2(110.f, 110.f), TEXTURE_ASSET_ID::D_BUTTON, TEXTURE_ASSET_ID::D_BUTTON_HOVER, mousePosition);
 
-	renderButton(vec2(850.f, 410.f), vec2(110.f, 110.f), TEXTURE_ASSET_ID::C_BUTTON, TEXTURE_ASSET_ID::C_BUTTON_HOVER, mousePosition);
-	renderButton(vec2(375.f, 410.f), vec2(110.f, 110.f), TEXTURE_ASSET_ID::D_BUTTON, TEXTURE_ASSET_ID::D_BUTTON_HOVER, mousePosition);
-	
-	vec2 start_position = vec2(335.f, 270.f); 
-	vec2 item_size = vec2(50.f, 50.f);      
-	float horizontal_spacing = 80.f;      
-	float vertical_spacing = 30.f;     
-	int items_per_row = 2;           
-	// First loop: Render item icons
+	vec2 start_position = vec2(335.f, 270.f);
+	vec2 item_size = vec2(50.f, 50.f);
+	float vertical_spacing = 30.f;
+	// First loop: item icons
 	for (size_t i = 0; i < robot.disassembleItems.size(); ++i) {
 		const Item& item = robot.disassembleItems[i];
 
 		vec2 item_position = start_position + vec2(0.f, i * (item_size.y + vertical_spacing));
 
-		TEXTURE_ASSET_ID item_texture_id = getTextureIDFromItemName(item.name);
+		TEXTURE_ASSET_ID item_texture_id = item_def(item.id).texture;
 
 		if (item_texture_id == TEXTURE_ASSET_ID::TEXTURE_COUNT) {
-			std::cerr << "Error: No texture found for item " << item.name << std::endl;
+			std::cerr << "Error: No texture found for item " << item.name() << std::endl;
 			continue;
 		}
 
 		GLuint texture_id = texture_gl_handles[(GLuint)item_texture_id];
 		if (!texture_id) {
-			std::cerr << "Error: Texture ID not found for item " << item.name << std::endl;
+			std::cerr << "Error: Texture ID not found for item " << item.name() << std::endl;
 			continue;
 		}
-
-		TexturedVertex item_vertices[4] = {
-			{ vec3(item_position.x, item_position.y, 0.f), vec2(0.f, 0.f) },
-			{ vec3(item_position.x + item_size.x, item_position.y, 0.f), vec2(1.f, 0.f) },
-			{ vec3(item_position.x + item_size.x, item_position.y + item_size.y, 0.f), vec2(1.f, 1.f) },
-			{ vec3(item_position.x, item_position.y + item_size.y, 0.f), vec2(0.f, 1.f) }
-		};
-
-		glBindBuffer(GL_ARRAY_BUFFER, ui_vbo);
-		glBufferData(GL_ARRAY_BUFFER, sizeof(item_vertices), item_vertices, GL_DYNAMIC_DRAW);
-		glBindTexture(GL_TEXTURE_2D, texture_id);
-		glDrawArrays(GL_TRIANGLE_FAN, 0, 4);
+		ui.quad(item_position, item_size, texture_id);
 	}
 	for (size_t i = 0; i < robot.disassembleItems.size(); ++i) {
 		const Item& item = robot.disassembleItems[robot.disassembleItems.size() - 1 - i]; // Access items in reverse order
 
 		vec2 item_position = start_position + vec2(-10.f, i * (item_size.y + 25.0f)) + vec2(0.f, 70.0f); // Shift upwards by 20.0f
 
-		std::string quantity_text = std::to_string(item.quantity) + "x " + item.name;
-		renderText(quantity_text, item_position.x + 65.f, item_position.y, 0.4f, vec3(1.0f, 1.0f, 1.0f), mat4(1.0f));
+		std::string quantity_text = std::to_string(item.quantity) + "x " + item.name();
+		addText(ui, quantity_text, item_position.x + 65.f, item_position.y, 0.4f, vec3(1.0f, 1.0f, 1.0f));
 	}
 
-
-
-
-	renderStatBar(vec2(830.f, 270.f), vec2(150.f, 20.f), robot.attack, robot.max_attack);
-	renderStatBar(vec2(830.f, 320.f), vec2(150.f, 20.f), robot.current_health, robot.max_health);
-	renderStatBar(vec2(830.f, 370.f), vec2(150.f, 20.f), robot.speed, robot.max_speed);
-	
+	addStatBar(ui, vec2(830.f, 270.f), vec2(150.f, 20.f), robot.attack, robot.max_attack);
+	addStatBar(ui, vec2(830.f, 320.f), vec2(150.f, 20.f), robot.current_health, robot.max_health);
+	addStatBar(ui, vec2(830.f, 370.f), vec2(150.f, 20.f), robot.speed, robot.max_speed);
 }
-void RenderSystem::renderStatBar(const vec2& bar_position, const vec2& bar_size, float current_value, float max_value) {
-
-	float percentage = std::max(0.0f, std::min(current_value / max_value, 1.0f));
 
-	//std::cout << "Current Value: " << current_value
-	//	<< ", Max Value: " << max_value
-	//	<< ", Percentage: " << percentage << std::endl;
-
-	glUseProgram(effects[(GLuint)EFFECT_ASSET_ID::COLOURED]);
-
-	TexturedVertex full_bar_vertices[4] = {
-		{ vec3(bar_position.x, bar_position.y, 0.f), vec2(0.f, 1.f) },
-		{ vec3(bar_position.x + bar_size.x, bar_position.y, 0.f), vec2(1.f, 1.f) },
-		{ vec3(bar_position.x + bar_size.x, bar_position.y + bar_size.y, 0.f), vec2(1.f, 0.f) },
-		{ vec3(bar_position.x, bar_position.y + bar_size.y, 0.f), vec2(0.f, 0.f) }
-	};
-
-	glBindBuffer(GL_ARRAY_BUFFER, ui_vbo);
-	glBufferData(GL_ARRAY_BUFFER, sizeof(full_bar_vertices), full_bar_vertices, GL_DYNAMIC_DRAW);
+void RenderSystem::addStatBar(UiDrawList& ui, const vec2& bar_position, const vec2& bar_size, float current_value, float max_value) {
 
-	GLint in_position_loc = glGetAttribLocation(effects[(GLuint)EFFECT_ASSET_ID::COLOURED], "in_position");
-	glEnableVertexAttribArray(in_position_loc);
-	glVertexAttribPointer(in_position_loc, 3, GL_FLOAT, GL_FALSE, sizeof(TexturedVertex), (void*)0);
+	float percentage = std::max(0.0f, std::min(current_value / max_value, 1.0f));
 
-	GLint color_uloc = glGetUniformLocation(effects[(GLuint)EFFECT_ASSET_ID::COLOURED], "fcolor");
 	vec3 background_color = vec3(0.7f, 0.7f, 0.7f);
-	glUniform3fv(color_uloc, 1, (float*)&background_color);
-	glDrawArrays(GL_TRIANGLE_FAN, 0, 4);
-
-	TexturedVertex filled_bar_vertices[4] = {
-		{ vec3(bar_position.x, bar_position.y, 0.f), vec2(0.f, 1.f) },
-		{ vec3(bar_position.x + bar_size.x * percentage, bar_position.y, 0.f), vec2(percentage, 1.f) },
-		{ vec3(bar_position.x + bar_size.x * percentage, bar_position.y + bar_size.y, 0.f), vec2(percentage, 0.f) },
-		{ vec3(bar_position.x, bar_position.y + bar_size.y, 0.f), vec2(0.f, 0.f) }
-	};
-
-	glBufferData(GL_ARRAY_BUFFER, sizeof(filled_bar_vertices), filled_bar_vertices, GL_DYNAMIC_DRAW);
-
 	vec3 filled_color = glm::mix(vec3(1.0f, 0.0f, 0.0f), vec3(0.0f, 1.0f, 0.0f), percentage);
-	glUniform3fv(color_uloc, 1, (float*)&filled_color);
-	glDrawArrays(GL_TRIANGLE_FAN, 0, 4);
-
-	glDisableVertexAttribArray(in_position_loc);
+	ui.rect(bar_position, bar_size, background_color);
+	ui.rect(bar_position, vec2(bar_size.x * percentage, bar_size.y), filled_color);
 
 	std::string stat_text = std::to_string(static_cast<int>(current_value)) + "/" + std::to_string(static_cast<int>(max_value));
 	vec3 text_color = vec3(1.0f, 1.0f, 1.0f);  // White
 	float text_scale = 0.4f;
 
 	float text_width = stat_text.length() * 7.0f * text_scale;
-	renderText(stat_text,
+	addText(ui, stat_text,
 		bar_position.x + bar_size.x - text_width - 30.0f,
 		bar_position.y + 75.0f + text_width,
-		text_scale, text_color, mat4(1.0f));
+		text_scale, text_color);
 }
 
-
-
-void RenderSystem::renderButton(const vec2& position, const vec2& size, TEXTURE_ASSET_ID texture_id, TEXTURE_ASSET_ID hover_texture_id, const vec2& mouse_position) {
-	// Check if the mouse is over the button
-	bool is_hovered = mouse_position.x >= position.x && mouse_position.x <= (position.x + size.x) &&
-		mouse_position.y >= position.y && mouse_position.y <= (position.y + size.y);
-
-	// Use the hover texture if hovered, otherwise use the normal texture
-	GLuint button_texture_id = is_hovered ? texture_gl_handles[(GLuint)hover_texture_id] : texture_gl_handles[(GLuint)texture_id];
-
-	TexturedVertex button_vertices[4] = {
-		{ vec3(position.x, position.y, 0.f), vec2(0.f, 0.f) },
-		{ vec3(position.x + size.x, position.y, 0.f), vec2(1.f, 0.f) },
-		{ vec3(position.x + size.x, position.y + size.y, 0.f), vec2(1.f, 1.f) },
-		{ vec3(position.x, position.y + size.y, 0.f), vec2(0.f, 1.f) }
-	};
-
-	glBindBuffer(GL_ARRAY_BUFFER, ui_vbo);
-	glBufferData(GL_ARRAY_BUFFER, sizeof(button_vertices), button_vertices, GL_DYNAMIC_DRAW);
-	glBindTexture(GL_TEXTURE_2D, button_texture_id);
-	glDrawArrays(GL_TRIANGLE_FAN, 0, 4);
-	gl_has_errors();
+void RenderSystem::addButton(UiDrawList& ui, const vec2& position, const vec2& size, TEXTURE_ASSET_ID texture_id, TEXTURE_ASSET_ID hover_texture_id, const vec2& mouse_position) {
+	// Use the hover texture if the mouse is over the button
+	TEXTURE_ASSET_ID button_texture = is_hovered(mouse_position, position, size) ? hover_texture_id : texture_id;
+	ui.quad(position, size, texture_gl_handles[(GLuint)button_texture]);
 }
 
 void RenderSystem::renderStartScreen() {
@@ -2524,8 +1812,7 @@ void RenderSystem::renderStartScreen() {
 		{"Quit Game", 0.0f, 100.0f, glm::vec3(1.0f, 1.0f, 0.0f), glm::vec3(0.8f, 0.8f, 0.0f)},
 	};
 
-	double mouse_x, mouse_y;
-	glfwGetCursorPos(window, &mouse_x, &mouse_y);
+	double mouse_x = cursor_position.x, mouse_y = cursor_position.y;
 	mouse_y = window_height_px - mouse_y;
 
 	hovered_menu_index = -1;
@@ -2555,9 +1842,6 @@ void RenderSystem::renderStartScreen() {
 }
 
 void RenderSystem::renderGameOverScreen() {
-	int w, h;
-	glfwGetFramebufferSize(window, &w, &h);
-
 	glBindFramebuffer(GL_FRAMEBUFFER, 0);
 	gl_has_errors();
 
@@ -2614,8 +1898,7 @@ void RenderSystem::renderGameOverScreen() {
 		{"Quit Game", 0.0f, 100.0f, glm::vec3(1.0f, 1.0f, 0.0f), glm::vec3(0.8f, 0.8f, 0.0f)},
 	};
 
-	double mouse_x, mouse_y;
-	glfwGetCursorPos(window, &mouse_x, &mouse_y);
+	double mouse_x = cursor_position.x, mouse_y = cursor_position.y;
 	mouse_y = window_height_px - mouse_y;
 
 	hovered_menu_index = -1;
@@ -2681,8 +1964,6 @@ void RenderSystem::startCutscene(const std::vector<TEXTURE_ASSET_ID>& images) {
 	current_cutscene_index = 0;
 	cutscene_timer = 0.f;
 	playing_cutscene = true;
-
-	initCutsceneVBO();
 }
 
 //void RenderSystem::updateCutscene(float elapsed_time) {
@@ -2758,8 +2039,8 @@ void RenderSystem::renderCutscene() {
 		return;
 	}
 
-	int w, h;
-	glfwGetFramebufferSize(window, &w, &h);
+	// created here rather than in startCutscene, the GL context lives on the render thread
+	initCutsceneVBO();
 
 	glBindFramebuffer(GL_FRAMEBUFFER, 0);
 	glClearColor(0.f, 0.f, 0.f, 1.0f);
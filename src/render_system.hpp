@@ -11,10 +11,83 @@
 #include "tileset.hpp"
 #include <map>
 #include "help_overlay.hpp"
+#include "particle_system.hpp"
+#include "debug_draw.hpp"
+#include "path_stats.hpp"
+#include "shader_manager.hpp"
+#include "ui_draw_list.hpp"
 // fonts
 #include <ft2build.h>
 #include FT_FREETYPE_H
 #include <map>	
+
+// What a world pass entry draws
+enum class SpriteKind {
+	SPRITE,
+	SPACESHIP_TEXTURE, // textured hull over the spaceship mesh
+	HEALTH_BAR,
+	PARTICLES // one instanced draw of an emitter's particles
+};
+
+// Where a sprite's texture coordinates come from
+enum class SpriteUV {
+	FULL,  // the whole texture
+	TILE,  // a cell of the tile atlas
+	SHEET  // the current frame of an animation sheet
+};
+
+// One draw of the world pass, copied out of the registry so the render thread never reads it
+struct SpriteDraw {
+	SpriteKind kind = SpriteKind::SPRITE;
+	vec2 position = { 0.f, 0.f }; // relative to the camera
+	float angle = 0.f;
+	vec2 scale = { 1.f, 1.f };    // HEALTH_BAR: bar size
+	TEXTURE_ASSET_ID texture = TEXTURE_ASSET_ID::TEXTURE_COUNT;
+	EFFECT_ASSET_ID effect = EFFECT_ASSET_ID::TEXTURED;
+	GEOMETRY_BUFFER_ID geometry = GEOMETRY_BUFFER_ID::SPRITE;
+	SpriteUV uv = SpriteUV::FULL;
+	vec2 top_left = { 0.f, 0.f };
+	vec2 bottom_right = { 1.f, 1.f };
+	vec3 color = { 1.f, 1.f, 1.f };
+	float fill = 1.f; // HEALTH_BAR: remaining health
+	// PARTICLES: range in RenderPacket::particles
+	unsigned int particle_first = 0;
+	unsigned int particle_count = 0;
+};
+
+// Effects of the post pass, as bits. Each combination is its own build of the screen
+// shader with only those effects in it.
+const uint32_t POST_FADE = 1u << 0;
+const uint32_t POST_DARKEN = 1u << 1;
+const uint32_t POST_NIGHT = 1u << 2;
+const uint32_t post_variant_count = 1u << 3;
+
+// Everything the world pass of one frame needs, filled on the main thread by
+// RenderSystem::extract and drawn on the render thread. RenderThread keeps two.
+struct RenderPacket {
+	int frame_width = 0;
+	int frame_height = 0;
+	vec2 cursor = { 0.f, 0.f };
+	vec2 camera_position = { 0.f, 0.f };
+	bool start_screen = false;
+	bool cutscene = false;
+
+	// screen shader
+	float fade_in_factor = 0.f;
+	float darken_screen_factor = -1.f;
+	float nighttime_factor = 0.f;
+	bool spotlight = false;
+	vec2 spotlight_center = { 0.f, 0.f };
+	// share of the framebuffer's width and height the world is drawn at
+	float render_scale = 1.f;
+
+	// in draw order
+	std::vector<SpriteDraw> sprites;
+	// debug mode: line segments over the sprites, two vertices each
+	std::vector<DebugVertex> debug_lines;
+	std::vector<ParticleInstance> particles;
+};
+
 // System responsible for setting up OpenGL and for rendering all the
 // visual entities in the game
 class RenderSystem {
@@ -216,10 +289,8 @@ public:
 	}
 
 	void updateCameraPosition(vec2 player_position);
-	void RenderSystem::drawHUD(Entity player, const mat3& projection);
-	void RenderSystem::initHealthBarVBO();
+	vec2 getCameraPosition() const { return camera_position; }
 	void RenderSystem::initUIVBO();
-	void RenderSystem::renderCaptureUI(const Robot& robot, Entity entity);
 	Entity player;
 
 	//GLuint tile_vbo;
@@ -231,8 +302,10 @@ public:
 		shader_path("textured"),
 		shader_path("screen"),
 		shader_path("box"),
-		shader_path("box"), // comment from ashish -> not sure but shouldn't here be font instead of having box twice??
-		shader_path("spaceship")
+		shader_path("font"),
+		shader_path("spaceship"),
+		shader_path("particle"),
+		shader_path("ui")
 	};
 
 
@@ -244,7 +317,6 @@ public:
 	std::array<Mesh, geometry_count> meshes;
 
 public:
-	std::string pickup_item_name;
 	// Initialize the window
 	bool init(GLFWwindow* window);
 
@@ -258,13 +330,7 @@ public:
 	void initializeGlMeshes();
 	Mesh& getMesh(GEOMETRY_BUFFER_ID id) { return meshes[(int)id]; };
 
-	void RenderSystem::drawBoundingBox(Entity entity, const mat3& projection);
 	void toggleHelp() { helpOverlay.toggle(); }
-	void RenderSystem::drawSpaceshipTexture(Entity entity, const mat3& projection);
-	void RenderSystem::drawReactionBox(Entity entity, const mat3& projection);
-	void RenderSystem::drawBossReactionBox(Entity entity, const mat3& projection);
-	void RenderSystem::renderButton(const vec2& position, const vec2& size, TEXTURE_ASSET_ID texture_id, TEXTURE_ASSET_ID hover_texture_id, const vec2& mouse_position);
-	void RenderSystem::renderStatBar(const vec2& bar_position, const vec2& bar_size, float percentage, float stat_value);
 	void initializeGlGeometryBuffers();
 	// Initialize the screen texture used as intermediate render target
 	// The draw loop first renders to this texture, then it is used for the wind
@@ -274,24 +340,42 @@ public:
 	// Destroy resources associated to one or all entities created by the system
 	~RenderSystem();
 
-	// Draw all entities
-	void draw();
+	// Main thread: copies what the world pass draws this frame out of the registry
+	void extract(RenderPacket& packet);
+	// Render thread: the world pass and post-processing, reads only the packet
+	void drawWorld(const RenderPacket& packet);
+	// Render thread: HUD, menus and cutscenes, these still read the registry so
+	// RenderThread only runs this while the main thread is parked
+	void drawOverlay(const RenderPacket& packet);
+
+	// HUD, inventory and capture screens, emitted into ui_list only when makeUIKey() changes
+	void makeUIKey(UiKey& key);
+	void buildHUD(UiDrawList& ui);
+	void buildInventoryUI(UiDrawList& ui);
+	void buildCaptureUI(UiDrawList& ui, const Robot& robot, Entity entity);
+	void addButton(UiDrawList& ui, const vec2& position, const vec2& size, TEXTURE_ASSET_ID texture_id, TEXTURE_ASSET_ID hover_texture_id, const vec2& mouse_position);
+	void addStatBar(UiDrawList& ui, const vec2& bar_position, const vec2& bar_size, float current_value, float max_value);
+	void addInventoryItem(UiDrawList& ui, const Item& item, const vec2& position, const vec2& size);
+	// Same placement as renderText, x and y are the start of the baseline with y going up
+	void addText(UiDrawList& ui, const std::string& text, float x, float y, float scale, const vec3& color);
+	void drawUIList(UiDrawList& ui, const mat3& projection);
 
 
 	mat3 createProjectionMatrix();
 	mat3 createOrthographicProjection(float left, float right, float top, float bottom);
-	void RenderSystem::drawInventoryUI();
-	TEXTURE_ASSET_ID RenderSystem::getTextureIDFromItemName(const std::string& itemName);
 	bool RenderSystem::initializeFont(const std::string& fontPath, unsigned int fontSize);
 	void RenderSystem::renderText(std::string text, float x, float y, float scale, const glm::vec3& color, const glm::mat4& trans);
-	void RenderSystem::renderInventoryItem(const Item& item, const vec2& position, const vec2& size);
-	void RenderSystem::drawRobotHealthBar(Entity robot, const mat3& projection);
 	void RenderSystem::initRobotHealthBarVBO();
-	void RenderSystem::drawBossRobotHealthBar(Entity robot, const mat3& projection);
 	float RenderSystem::getTextWidth(const std::string& text, float scale);
 	TutorialState tutorial_state;
 // FPS functions
 	bool show_fps = false;
+	// world resolution as a share of the framebuffer's, cycled with G for slow GPUs
+	float render_scale = 1.f;
+	float save_capture_ms = 0.f; // main thread cost of the last autosave, shown with the FPS counter
+	PathFrameStats path_frame_stats; // robots' path queries of the last step, shown with the FPS counter
+	unsigned int stolen_voices = 0; // audio voice counters since start, shown with the FPS counter
+	unsigned int dropped_sounds = 0;
 	void updateFPS();
 	void drawFPSCounter(const mat3& projection);
 	std::vector<Item> droppedItems;
@@ -339,13 +423,45 @@ public:
 	bool cutscene_vbo_initialized = false;
 	void initCutsceneVBO();
 
+	// unit quad plus a per-instance buffer that grows to the largest batch drawn
+	GLuint particle_vao = 0, particle_quad_vbo = 0, particle_instance_vbo = 0;
+	size_t particle_instance_capacity = 0;
+	void initParticleVBO();
+
+	// RenderPacket::debug_lines, grows to the most lines drawn in a frame
+	GLuint debug_line_vao = 0, debug_line_vbo = 0;
+	size_t debug_line_capacity = 0;
+	void initDebugLines();
+
 	HelpOverlay helpOverlay;
 private:
 	// Internal drawing functions for each entity type
-	void drawTexturedMesh(Entity entity, const mat3& projection);
-	void drawToScreen();
+	void extractSprite(Entity entity, RenderPacket& packet);
+	void extractProjectiles(RenderPacket& packet);
+	void extractParticles(RenderPacket& packet);
+	void extractRobotHealthBar(Entity robot, RenderPacket& packet);
+	void extractBossRobotHealthBar(Entity boss_robot, RenderPacket& packet);
+	void extractDebugBoxes(Entity entity, RenderPacket& packet);
+	void drawSprite(const SpriteDraw& sprite, const mat3& projection);
+	void drawSpaceshipTexture(const SpriteDraw& sprite, const mat3& projection);
+	void drawHealthBar(const SpriteDraw& bar, const mat3& projection);
+	void drawParticles(const SpriteDraw& batch, const RenderPacket& packet, const mat3& projection);
+	void drawDebugLines(const RenderPacket& packet, const mat3& projection);
+	void drawToScreen(const RenderPacket& packet);
 	// Window handle
 	GLFWwindow* window;
+	// cursor of the packet being drawn, GLFW input may only be queried on the main thread
+	vec2 cursor_position = { 0.f, 0.f };
+
+	// every GL program, effects and post_programs hold handles into it
+	ShaderManager shaders;
+	// post pass builds of the screen shader by effect bits, built on first use
+	std::array<GLuint, post_variant_count> post_programs = {};
+	GLuint postProgram(uint32_t passes);
+	// Debug builds pick up edited shader files, checked twice a second
+	void reloadShaders();
+	void setFontProjection();
+	double next_shader_check = 0.0;
 
 	// Screen texture handles
 	GLuint frame_buffer;
@@ -362,27 +478,29 @@ private:
 	GLuint text_vbo = 0;
 	GLuint ui_vbo;
 	GLuint ui_vao;
-	GLuint healthbar_vbo;
-	GLuint healthbar_vao;
 	GLuint startscreen_vbo;
 	GLuint startscreen_vao;
-	bool healthbar_vbo_initialized = false;
 	bool font_initialized = false;
 	bool tile_vbo_initialized = false;
 	bool ui_vbo_initialized = false;
 	bool startscreen_vbo_initialized = false;
 
+	// UI draw list, rebuilt when ui_key changes and uploaded to ui_list_vbo after each rebuild
+	UiDrawList ui_list;
+	UiKey ui_key;
+	UiKey next_ui_key;
+	std::vector<Entity> capture_robots;
+	GLuint ui_list_vao = 0, ui_list_vbo = 0;
+	size_t ui_list_capacity = 0;
+	GLuint white_texture = 0;
+	GLuint glyph_atlas = 0;
+	void initUIDrawList();
+
 	GLuint robot_healthbar_vbo;
 	GLuint robot_healthbar_vao;
 	bool robot_healthbar_vbo_initialized = false;
 
 
-	std::string vertexShaderSource;
-	std::string fragmentShaderSource;
-	const char* vertexShaderSource_c;
-	const char* fragmentShaderSource_c;
 
 };
 
-bool loadEffectFromFile(
-	const std::string& vs_path, const std::string& fs_path, GLuint& out_program);
@@ -14,6 +14,8 @@
 #include <glm/gtc/matrix_transform.hpp>
 #include <glm/gtc/type_ptr.hpp>
 // stlib
+#include <algorithm>
+#include <cstring>
 #include <iostream>
 #include <sstream>
 // fonts
@@ -66,15 +68,20 @@ bool RenderSystem::init(GLFWwindow* window_arg)
 	glBindVertexArray(default_vao);
 	gl_has_errors();
 
+	// Linked programs from earlier runs
+	shaders.init(shader_cache_path());
+
 	initScreenTexture();
 	std::string font_filename = PROJECT_SOURCE_DIR + std::string("data/fonts/PressStart2P.ttf");
 	unsigned int font_default_size = 22;
 	initializeFont(font_filename, font_default_size);
 
 	initUIVBO();
+	initUIDrawList();
 	initRobotHealthBarVBO();
-	initHealthBarVBO();
 	initStartScreenVBO();
+	initParticleVBO();
+	initDebugLines();
     initializeGlTextures();
 	initializeGlEffects();
 	initializeGlGeometryBuffers();
@@ -84,23 +91,6 @@ bool RenderSystem::init(GLFWwindow* window_arg)
 std::map<char, Character> Characters;
 FT_Library ft;
 FT_Face face;
-std::string readShaderFile(const std::string& filename)
-{
-	//std::cout << "Loading shader filename: " << filename << std::endl;
-
-	std::ifstream ifs(filename);
-
-	if (!ifs.good())
-	{
-		std::cerr << "ERROR: invalid filename loading shader from file: " << filename << std::endl;
-		return "";
-	}
-
-	std::ostringstream oss;
-	oss << ifs.rdbuf();
-	//std::cout << oss.str() << std::endl;
-	return oss.str();
-}
 bool RenderSystem::initializeFont(const std::string& font_path, unsigned int font_size) {
 
 	// apply orthographic projection matrix for font, i.e., screen space
@@ -108,10 +98,6 @@ bool RenderSystem::initializeFont(const std::string& font_path, unsigned int fon
 		// read in our shader files
 	
 	 if (!font_initialized) {
-		vertexShaderSource = readShaderFile(PROJECT_SOURCE_DIR + std::string("shaders/font.vs.glsl"));
-		fragmentShaderSource = readShaderFile(PROJECT_SOURCE_DIR + std::string("shaders/font.fs.glsl"));
-		vertexShaderSource_c = vertexShaderSource.c_str();
-		fragmentShaderSource_c = fragmentShaderSource.c_str();
 		// init FreeType fonts
 		FT_Library ft;
 		if (FT_Init_FreeType(&ft))
@@ -133,6 +119,12 @@ bool RenderSystem::initializeFont(const std::string& font_path, unsigned int fon
 		// disable byte-alignment restriction in OpenGL
 		glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
 
+		// every glyph is also copied into one atlas, so the UI draw list draws a text with one texture
+		const int atlas_width = 512;
+		const int atlas_height = 256;
+		std::vector<unsigned char> atlas(atlas_width * atlas_height, 0);
+		int pen_x = 1, pen_y = 1, row_height = 0;
+
 		// load each of the chars - note only first 128 ASCII chars
 		for (unsigned char c = (unsigned char)0; c < (unsigned char)128; c++)
 		{
@@ -176,8 +168,38 @@ bool RenderSystem::initializeFont(const std::string& font_path, unsigned int fon
 				static_cast<unsigned int>(face->glyph->advance.x),
 				(char)c
 			};
+
+			int glyph_width = (int)face->glyph->bitmap.width;
+			int glyph_height = (int)face->glyph->bitmap.rows;
+			if (pen_x + glyph_width + 1 > atlas_width) {
+				pen_x = 1;
+				pen_y += row_height + 1;
+				row_height = 0;
+			}
+			if (pen_y + glyph_height + 1 > atlas_height) {
+				std::cerr << "ERROR::FREETYPE: Glyph atlas is full" << std::endl;
+			}
+			else {
+				for (int row = 0; row < glyph_height; row++)
+					memcpy(&atlas[(pen_y + row) * atlas_width + pen_x], face->glyph->bitmap.buffer + row * face->glyph->bitmap.pitch, glyph_width);
+				character.atlas_top_left = vec2((float)pen_x / atlas_width, (float)pen_y / atlas_height);
+				character.atlas_bottom_right = vec2((float)(pen_x + glyph_width) / atlas_width, (float)(pen_y + glyph_height) / atlas_height);
+				pen_x += glyph_width + 1;
+				row_height = std::max(row_height, glyph_height);
+			}
 			Characters.insert(std::pair<char, Character>(c, character));
 		}
+
+		glGenTextures(1, &glyph_atlas);
+		glBindTexture(GL_TEXTURE_2D, glyph_atlas);
+		glTexImage2D(GL_TEXTURE_2D, 0, GL_R8, atlas_width, atlas_height, 0, GL_RED, GL_UNSIGNED_BYTE, atlas.data());
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+		// reads as white with the coverage in alpha, like any other UI texture
+		GLint swizzle[] = { GL_ONE, GL_ONE, GL_ONE, GL_RED };
+		glTexParameteriv(GL_TEXTURE_2D, GL_TEXTURE_SWIZZLE_RGBA, swizzle);
 		glBindTexture(GL_TEXTURE_2D, 0);
 
 		// clean up
@@ -190,35 +212,26 @@ bool RenderSystem::initializeFont(const std::string& font_path, unsigned int fon
 		glGenVertexArrays(1, &text_vao);
 		glGenBuffers(1, &text_vbo);
 
-		// font vertex shader
-		unsigned int font_vertexShader;
-		font_vertexShader = glCreateShader(GL_VERTEX_SHADER);
-		glShaderSource(font_vertexShader, 1, &vertexShaderSource_c, NULL);
-		glCompileShader(font_vertexShader);
-
-		// font fragement shader
-		unsigned int font_fragmentShader;
-		font_fragmentShader = glCreateShader(GL_FRAGMENT_SHADER);
-		glShaderSource(font_fragmentShader, 1, &fragmentShaderSource_c, NULL);
-		glCompileShader(font_fragmentShader);
-
-		// font shader program
-		fontShaderProgram = glCreateProgram();
-		glAttachShader(fontShaderProgram, font_vertexShader);
-		glAttachShader(fontShaderProgram, font_fragmentShader);
-		glLinkProgram(fontShaderProgram);
-		glUseProgram(fontShaderProgram);
-		glm::mat4 projection = glm::ortho(0.0f, static_cast<float>(window_width_px), 0.0f, static_cast<float>(window_height_px));
-		GLint project_location = glGetUniformLocation(fontShaderProgram, "projection");
-		assert(project_location > -1);
-		//std::cout << "project_location: " << project_location << std::endl;
-		glUniformMatrix4fv(project_location, 1, GL_FALSE, glm::value_ptr(projection));
+		// font shader program, the same one as effects[FONT]
+		fontShaderProgram = shaders.get(shader_path("font"));
+		assert(fontShaderProgram != 0);
+		setFontProjection();
 
 	}
 	
 	
 	return true;
 }
+
+// screen space, set again whenever the font program is relinked
+void RenderSystem::setFontProjection() {
+	glUseProgram(fontShaderProgram);
+	glm::mat4 projection = glm::ortho(0.0f, static_cast<float>(window_width_px), 0.0f, static_cast<float>(window_height_px));
+	GLint project_location = glGetUniformLocation(fontShaderProgram, "projection");
+	assert(project_location > -1);
+	glUniformMatrix4fv(project_location, 1, GL_FALSE, glm::value_ptr(projection));
+}
+
 // load generated tile map array here, figure out how to load and append tiles together
 void RenderSystem::initializeGlTextures()
 {
@@ -254,12 +267,11 @@ void RenderSystem::initializeGlEffects()
 {
 	for(uint i = 0; i < effect_paths.size(); i++)
 	{
-		const std::string vertex_shader_name = effect_paths[i] + ".vs.glsl";
-		const std::string fragment_shader_name = effect_paths[i] + ".fs.glsl";
-
-		bool is_valid = loadEffectFromFile(vertex_shader_name, fragment_shader_name, effects[i]);
-		assert(is_valid && (GLuint)effects[i] != 0);
+		effects[i] = shaders.get(effect_paths[i]);
+		assert((GLuint)effects[i] != 0);
 	}
+	printf("Shaders: %d from the cache, %d built\n", shaders.cache_hits, shaders.cache_misses);
+	shaders.save_cache();
 }
 
 // One could merge the following two functions as a template function...
@@ -391,9 +403,9 @@ RenderSystem::~RenderSystem()
 	glDeleteRenderbuffers(1, &off_screen_render_buffer_depth);
 	gl_has_errors();
 
-	for(uint i = 0; i < effect_count; i++) {
-		glDeleteProgram(effects[i]);
-	}
+	// keeps the post pass builds made while playing
+	shaders.save_cache();
+	shaders.clear();
 	// delete allocated resources
 	glDeleteFramebuffers(1, &frame_buffer);
 	gl_has_errors();
@@ -430,104 +442,3 @@ bool RenderSystem::initScreenTexture()
 	return true;
 }
 
-bool gl_compile_shader(GLuint shader)
-{
-	glCompileShader(shader);
-	gl_has_errors();
-	GLint success = 0;
-	glGetShaderiv(shader, GL_COMPILE_STATUS, &success);
-	if (success == GL_FALSE)
-	{
-		GLint log_len;
-		glGetShaderiv(shader, GL_INFO_LOG_LENGTH, &log_len);
-		std::vector<char> log(log_len);
-		glGetShaderInfoLog(shader, log_len, &log_len, log.data());
-		glDeleteShader(shader);
-
-		gl_has_errors();
-
-		fprintf(stderr, "GLSL: %s", log.data());
-		return false;
-	}
-
-	return true;
-}
-
-bool loadEffectFromFile(
-	const std::string& vs_path, const std::string& fs_path, GLuint& out_program)
-{
-	// Opening files
-	std::ifstream vs_is(vs_path);
-	std::ifstream fs_is(fs_path);
-	if (!vs_is.good() || !fs_is.good())
-	{
-		fprintf(stderr, "Failed to load shader files %s, %s", vs_path.c_str(), fs_path.c_str());
-		assert(false);
-		return false;
-	}
-
-	// Reading sources
-	std::stringstream vs_ss, fs_ss;
-	vs_ss << vs_is.rdbuf();
-	fs_ss << fs_is.rdbuf();
-	std::string vs_str = vs_ss.str();
-	std::string fs_str = fs_ss.str();
-	const char* vs_src = vs_str.c_str();
-	const char* fs_src = fs_str.c_str();
-	GLsizei vs_len = (GLsizei)vs_str.size();
-	GLsizei fs_len = (GLsizei)fs_str.size();
-
-	GLuint vertex = glCreateShader(GL_VERTEX_SHADER);
-	glShaderSource(vertex, 1, &vs_src, &vs_len);
-	GLuint fragment = glCreateShader(GL_FRAGMENT_SHADER);
-	glShaderSource(fragment, 1, &fs_src, &fs_len);
-	gl_has_errors();
-
-	// Compiling
-	if (!gl_compile_shader(vertex))
-	{
-		fprintf(stderr, "Vertex compilation failed");
-		assert(false);
-		return false;
-	}
-	if (!gl_compile_shader(fragment))
-	{
-		fprintf(stderr, "Vertex compilation failed");
-		assert(false);
-		return false;
-	}
-
-	// Linking
-	out_program = glCreateProgram();
-	glAttachShader(out_program, vertex);
-	glAttachShader(out_program, fragment);
-	glLinkProgram(out_program);
-	gl_has_errors();
-
-	{
-		GLint is_linked = GL_FALSE;
-		glGetProgramiv(out_program, GL_LINK_STATUS, &is_linked);
-		if (is_linked == GL_FALSE)
-		{
-			GLint log_len;
-			glGetProgramiv(out_program, GL_INFO_LOG_LENGTH, &log_len);
-			std::vector<char> log(log_len);
-			glGetProgramInfoLog(out_program, log_len, &log_len, log.data());
-			gl_has_errors();
-
-			fprintf(stderr, "Link error: %s", log.data());
-			assert(false);
-			return false;
-		}
-	}
-
-	// No need to carry this around. Keeping these objects is only useful if we recycle
-	// the same shaders over and over, which we don't, so no need and this is simpler.
-	glDetachShader(out_program, vertex);
-	glDetachShader(out_program, fragment);
-	glDeleteShader(vertex);
-	glDeleteShader(fragment);
-	gl_has_errors();
-
-	return true;
-}
@@ -0,0 +1,89 @@
+#include "render_thread.hpp"
+
+RenderThread::~RenderThread()
+{
+	stop();
+}
+
+void RenderThread::start(GLFWwindow* window_arg, RenderSystem* renderer_arg)
+{
+	if (running)
+		return;
+	window = window_arg;
+	renderer = renderer_arg;
+	running = true;
+	// a context can only be current on one thread at a time
+	glfwMakeContextCurrent(nullptr);
+	thread = std::thread(&RenderThread::thread_loop, this);
+}
+
+void RenderThread::stop()
+{
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		if (!running)
+			return;
+		running = false;
+	}
+	cv.notify_all();
+	thread.join();
+	ready = false;
+	in_flight = false;
+	overlay_turn = false;
+	// the RenderSystem destructor frees its GL objects on this thread
+	glfwMakeContextCurrent(window);
+}
+
+void RenderThread::submit()
+{
+	// the render thread only reads packets[front]
+	renderer->extract(packets[back]);
+
+	std::unique_lock<std::mutex> lock(mutex);
+	if (in_flight) {
+		overlay_turn = true;
+		cv.notify_all();
+		cv.wait(lock, [this] { return !in_flight; });
+	}
+	std::swap(front, back);
+	ready = true;
+	in_flight = true;
+	cv.notify_all();
+}
+
+void RenderThread::thread_loop()
+{
+	glfwMakeContextCurrent(window);
+	while (true) {
+		int index;
+		{
+			std::unique_lock<std::mutex> lock(mutex);
+			cv.wait(lock, [this] { return ready || !running; });
+			if (!ready)
+				break;
+			ready = false;
+			index = front;
+		}
+		const RenderPacket& packet = packets[index];
+
+		renderer->drawWorld(packet);
+
+		{
+			// once stopping the main thread is done with the registry as well
+			std::unique_lock<std::mutex> lock(mutex);
+			cv.wait(lock, [this] { return overlay_turn || !running; });
+			overlay_turn = false;
+		}
+		renderer->drawOverlay(packet);
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			in_flight = false;
+		}
+		cv.notify_all();
+
+		// flicker-free display with a double buffer
+		glfwSwapBuffers(window);
+		gl_has_errors();
+	}
+	glfwMakeContextCurrent(nullptr);
+}
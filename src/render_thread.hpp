@@ -0,0 +1,52 @@
+#pragma once
+
+// stlib
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+// internal
+#include "render_system.hpp"
+
+// Runs the renderer on its own thread, which owns the GL context while it is started.
+//
+// Each frame the main thread extracts the world into one of two RenderPackets while
+// the render thread draws the other, so the world pass and the buffer swap overlap
+// with the next simulation step. The HUD and menus still read the registry, so the
+// render thread only draws them while the main thread is parked inside submit().
+class RenderThread
+{
+public:
+	~RenderThread();
+
+	// Hands the window's GL context over to a new render thread
+	void start(GLFWwindow* window, RenderSystem* renderer);
+	// Finishes the frame in flight and makes the GL context current on the calling thread again
+	void stop();
+
+	// Main thread, once per frame after the simulation step. Extracts the next packet,
+	// waits for the overlay of the frame in flight and then queues the new one.
+	void submit();
+
+private:
+	void thread_loop();
+
+	GLFWwindow* window = nullptr;
+	RenderSystem* renderer = nullptr;
+	std::thread thread;
+
+	RenderPacket packets[2];
+	// the packet submit() fills next, the other one may be on the render thread
+	int back = 0;
+	int front = 1;
+
+	std::mutex mutex;
+	std::condition_variable cv;
+	bool running = false;
+	// front was queued and the render thread has not picked it up yet
+	bool ready = false;
+	// the render thread is drawing front
+	bool in_flight = false;
+	// the main thread is parked, the overlay may read the registry
+	bool overlay_turn = false;
+};
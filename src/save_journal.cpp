@@ -0,0 +1,260 @@
+#include "save_journal.hpp"
+#include "world_system.hpp"
+#include "projectile_system.hpp"
+
+// stlib
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+
+// Block layout: cleared flag, removed entity ids, then ids and data of the dirty components
+template <typename Component>
+static void write_container_delta(SnapshotWriter& w, SnapshotBlock tag, ComponentContainer<Component>& container, const ComponentContainer<Tile>* skip) {
+	if (container.dirty.size() != container.components.size())
+		container.dirty.resize(container.components.size(), 1);
+
+	std::vector<unsigned int> changed;
+	for (unsigned int i = 0; i < container.components.size(); i++) {
+		if (!container.dirty[i])
+			continue;
+		if (skip && skip->map_entity_componentID.count(container.entities[i].id) > 0)
+			continue;
+		changed.push_back(i);
+	}
+
+	if (!changed.empty() || !container.removed_entities.empty() || container.cleared) {
+		size_t block = w.begin_block(tag, (uint32_t)changed.size());
+		w.write((uint8_t)container.cleared);
+		w.write((uint32_t)container.removed_entities.size());
+		for (unsigned int id : container.removed_entities)
+			w.write(id);
+		for (unsigned int i : changed)
+			w.write(container.entities[i].id);
+		for (unsigned int i : changed)
+			write_one(w, container.components[i], is_plain_component<Component>());
+		w.end_block(block);
+	}
+	container.clear_dirty();
+}
+
+// Reads a delta into an empty staging container: the cleared flag and removed ids go into
+// its own cleared and removed_entities, the dirty components are inserted
+template <typename Component>
+static bool read_container_delta(SnapshotReader& r, ComponentContainer<Component>& staged, uint32_t count) {
+	uint8_t cleared = 0;
+	uint32_t removed = 0;
+	r.read(cleared);
+	r.read(removed);
+	if (r.failed || removed > (r.size - r.pos) / sizeof(uint32_t))
+		return false;
+
+	staged.cleared = cleared != 0;
+	staged.removed_entities.resize(removed);
+	if (removed > 0)
+		r.read_bytes(staged.removed_entities.data(), removed * sizeof(unsigned int));
+
+	if (count > (r.size - r.pos) / sizeof(uint32_t))
+		return false;
+	std::vector<unsigned int> ids(count);
+	if (count > 0)
+		r.read_bytes(ids.data(), count * sizeof(unsigned int));
+	for (unsigned int id : ids) {
+		Component c;
+		read_one(r, c, is_plain_component<Component>());
+		if (r.failed)
+			return false;
+		Entity e;
+		e.id = id;
+		if (staged.has(e))
+			staged.components[staged.map_entity_componentID[e]] = std::move(c);
+		else
+			staged.insert(e, std::move(c));
+	}
+	return !r.failed;
+}
+
+// Applies a staged delta in the order it was recorded: clear, removals, then the components
+template <typename Component>
+static void commit_container_delta(ComponentContainer<Component>& container, ComponentContainer<Component>& staged) {
+	if (staged.cleared)
+		container.clear();
+	for (unsigned int id : staged.removed_entities) {
+		Entity e;
+		e.id = id;
+		container.remove(e);
+	}
+	for (size_t i = 0; i < staged.components.size(); i++) {
+		Entity e = staged.entities[i];
+		if (container.has(e))
+			container.components[container.map_entity_componentID[e]] = std::move(staged.components[i]);
+		else
+			container.insert(e, std::move(staged.components[i]));
+	}
+}
+
+// One record decoded, nothing in it has touched the game yet
+struct StagedRecord {
+	ECSRegistry registry;
+	SavedWorld world;
+	bool has_world = false;
+	ProjectileSystem projectiles;
+	bool has_projectiles = false;
+};
+
+void start_journaling(ECSRegistry& reg) {
+	visit_saved_containers(reg, [](SnapshotBlock, auto& container) {
+		container.journaling = true;
+		container.clear_dirty();
+	});
+}
+
+void clear_dirty_components(ECSRegistry& reg) {
+	visit_saved_containers(reg, [](SnapshotBlock, auto& container) {
+		container.clear_dirty();
+	});
+}
+
+void build_journal_record(ECSRegistry& reg, const WorldSystem& world, SnapshotWriter& w) {
+	JournalRecordHeader header;
+	header.id_count = Entity::id_count;
+	header.map_width = map_width;
+	header.map_height = map_height;
+	size_t record = w.buffer.size();
+	w.write(header);
+	uint32_t blocks_before = w.block_count;
+
+	// the world block is tiny, it goes into every record
+	write_world_block(w, world);
+	visit_saved_containers(reg, [&](SnapshotBlock tag, auto& container) {
+		write_container_delta(w, tag, container, skips_tiles(tag) ? &reg.tiles : nullptr);
+	});
+	// parked robots aren't dirty tracked, the whole set goes in after the removals that parked them
+	write_dormant_block(w, world);
+	// neither are projectiles, the pool is small enough to go in whole
+	write_projectile_block(w);
+
+	header.block_count = w.block_count - blocks_before;
+	header.payload_size = (uint32_t)(w.buffer.size() - record - sizeof(header));
+	memcpy(w.buffer.data() + record, &header, sizeof(header));
+}
+
+bool reset_journal(const std::string& path, uint32_t epoch) {
+	JournalFileHeader header;
+	header.epoch = epoch;
+	return write_snapshot_file(path, reinterpret_cast<const char*>(&header), sizeof(header));
+}
+
+bool append_journal_record(const std::string& path, const char* data, size_t size) {
+	FILE* file = fopen(path.c_str(), "ab");
+	if (!file) {
+		std::cerr << "Failed to open " << path << " for appending." << std::endl;
+		return false;
+	}
+	bool ok = fwrite(data, 1, size, file) == size;
+	ok = (fflush(file) == 0) && ok;
+	fclose(file);
+	if (!ok)
+		std::cerr << "Failed to append to " << path << std::endl;
+	return ok;
+}
+
+static bool read_record_block(SnapshotReader& r, StagedRecord& staged, const SnapshotBlockHeader& block) {
+	if (block.tag == (uint32_t)SnapshotBlock::WORLD) {
+		staged.has_world = true;
+		return read_world_block(r, staged.world);
+	}
+	if (block.tag == (uint32_t)SnapshotBlock::PROJECTILE_POOL) {
+		staged.has_projectiles = true;
+		return staged.projectiles.read(r, block.count);
+	}
+	// the parked robots were removed earlier in this record, so staging them next to the
+	// removals still ends with them in the registry
+	if (block.tag == (uint32_t)SnapshotBlock::DORMANT_ENTITIES)
+		return read_dormant_block(r, staged.registry, block.count);
+
+	bool known = false;
+	bool ok = true;
+	visit_saved_containers(staged.registry, [&](SnapshotBlock tag, auto& container) {
+		if ((uint32_t)tag == block.tag) {
+			known = true;
+			ok = read_container_delta(r, container, block.count);
+		}
+	});
+	if (!known)
+		r.pos += block.payload_size;
+	return ok;
+}
+
+static void commit_record(ECSRegistry& reg, WorldSystem& world, StagedRecord& staged) {
+	if (staged.has_world)
+		apply_world_block(staged.world, world);
+#define JOURNAL_COMMIT_CONTAINER(type, name, block) commit_container_delta(reg.name, staged.registry.name);
+	ECS_COMPONENT_LIST(JOURNAL_COMMIT_CONTAINER)
+#undef JOURNAL_COMMIT_CONTAINER
+	if (staged.has_projectiles)
+		projectiles = staged.projectiles;
+}
+
+int replay_journal(ECSRegistry& reg, WorldSystem& world, const std::string& path, SnapshotHeader& header) {
+	std::ifstream in(path, std::ios::binary);
+	if (!in.is_open())
+		return 0;
+	std::vector<char> data((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+
+	SnapshotReader r(data.data(), data.size());
+	JournalFileHeader file_header;
+	if (!r.read(file_header) || file_header.magic != JOURNAL_MAGIC || file_header.version != SNAPSHOT_VERSION)
+		return 0;
+	if (file_header.epoch != header.journal_epoch) {
+		// written for another snapshot, e.g. the game died between a checkpoint and the journal reset
+		std::cout << "Save journal " << path << " is stale, ignoring it." << std::endl;
+		return 0;
+	}
+
+	int applied = 0;
+	while (r.pos < r.size) {
+		JournalRecordHeader record;
+		if (!r.read(record) || record.marker != JOURNAL_RECORD_MARKER || record.payload_size > r.size - r.pos) {
+			std::cerr << "Save journal " << path << " ends in a torn record." << std::endl;
+			break;
+		}
+		size_t record_end = r.pos + record.payload_size;
+
+		// A record is applied whole or not at all: its block table is checked first, then
+		// every block is decoded into a StagedRecord, which is committed once all of them read
+		SnapshotReader check(data.data(), record_end);
+		check.pos = r.pos;
+		bool intact = true;
+		for (uint32_t i = 0; i < record.block_count && intact; i++) {
+			SnapshotBlockHeader block;
+			intact = check.read(block) && block.payload_size <= check.size - check.pos;
+			if (intact)
+				check.pos += block.payload_size;
+		}
+		if (!intact || check.pos != record_end) {
+			std::cerr << "Save journal " << path << " has a corrupt record." << std::endl;
+			break;
+		}
+
+		StagedRecord staged;
+		for (uint32_t i = 0; i < record.block_count; i++) {
+			SnapshotBlockHeader block;
+			r.read(block);
+			size_t payload_end = r.pos + block.payload_size;
+			if (!read_record_block(r, staged, block) || r.pos != payload_end) {
+				std::cerr << "Save journal block " << block.tag << " is corrupt." << std::endl;
+				return applied;
+			}
+		}
+		commit_record(reg, world, staged);
+		header.id_count = record.id_count;
+		header.map_width = record.map_width;
+		header.map_height = record.map_height;
+		applied++;
+	}
+
+	if (applied > 0)
+		printf("Replayed %d save journal records\n", applied);
+	return applied;
+}
@@ -0,0 +1,53 @@
+#pragma once
+
+// stlib
+#include <cstdint>
+#include <string>
+
+// internal
+#include "snapshot.hpp"
+
+// Append-only log of the changes made since the last full snapshot.
+// Each record holds, per container, the components dirtied since the previous record
+// plus the entities removed, and the parked robots and projectiles whole, so a crash loses
+// at most one autosave interval.
+// The file starts with the epoch of the snapshot it applies to; a snapshot with a
+// newer epoch makes the whole journal stale.
+const uint32_t JOURNAL_MAGIC = 0x4C4A5345; // "ESJL"
+const uint32_t JOURNAL_RECORD_MARKER = 0x43524A45; // "EJRC"
+
+inline std::string journal_path(const std::string& snapshot) { return snapshot + ".journal"; };
+
+struct JournalFileHeader {
+	uint32_t magic = JOURNAL_MAGIC;
+	uint32_t version = SNAPSHOT_VERSION;
+	uint32_t epoch = 0;
+};
+
+struct JournalRecordHeader {
+	uint32_t marker = JOURNAL_RECORD_MARKER;
+	uint32_t block_count = 0;
+	uint32_t payload_size = 0;
+	uint32_t id_count = 0;
+	int32_t map_width = 0;
+	int32_t map_height = 0;
+};
+
+// Turns on removal tracking for the saved containers and marks everything clean
+void start_journaling(ECSRegistry& reg);
+
+// Marks every saved container clean, after a full snapshot has captured it
+void clear_dirty_components(ECSRegistry& reg);
+
+// Captures everything dirtied since the last record (or snapshot) into w and marks it clean
+void build_journal_record(ECSRegistry& reg, const WorldSystem& world, SnapshotWriter& w);
+
+// Truncates the journal so it starts over on top of the snapshot with this epoch
+bool reset_journal(const std::string& path, uint32_t epoch);
+
+// Appends one record built by build_journal_record
+bool append_journal_record(const std::string& path, const char* data, size_t size);
+
+// Applies the records that belong to the snapshot described by header, stopping at the first
+// torn or corrupt record. id_count and the map size in header are updated to the last record.
+int replay_journal(ECSRegistry& reg, WorldSystem& world, const std::string& path, SnapshotHeader& header);
@@ -0,0 +1,329 @@
+#include "shader_manager.hpp"
+
+// stlib
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <sstream>
+#include <sys/types.h>
+#include <sys/stat.h>
+
+static const uint32_t SHADER_CACHE_MAGIC = 0x43444853; // "SHDC"
+static const uint32_t SHADER_CACHE_VERSION = 1;
+
+static bool read_file(const std::string& path, std::string& out) {
+	std::ifstream is(path);
+	if (!is.good())
+		return false;
+	std::stringstream ss;
+	ss << is.rdbuf();
+	out = ss.str();
+	return true;
+}
+
+// 0 when the file is missing
+static int64_t file_time(const std::string& path) {
+	struct stat info;
+	if (stat(path.c_str(), &info) != 0)
+		return 0;
+	return (int64_t)info.st_mtime;
+}
+
+// #version has to stay the first line
+static std::string insert_defines(const std::string& src, const std::string& defines) {
+	if (defines.empty())
+		return src;
+	size_t version_end = src.find('\n');
+	if (version_end == std::string::npos)
+		return src;
+	std::string out = src;
+	out.insert(version_end + 1, defines);
+	return out;
+}
+
+// FNV-1a over both stages
+static uint64_t source_hash(const std::string& vs_src, const std::string& fs_src) {
+	uint64_t hash = 14695981039346656037ull;
+	for (const std::string* src : { &vs_src, &fs_src }) {
+		for (char c : *src) {
+			hash ^= (unsigned char)c;
+			hash *= 1099511628211ull;
+		}
+		// keeps the boundary between the stages in the hash
+		hash ^= 0xff;
+		hash *= 1099511628211ull;
+	}
+	return hash;
+}
+
+static bool compile_stage(GLenum type, const std::string& src, const std::string& name, GLuint& shader) {
+	const char* c_src = src.c_str();
+	GLint len = (GLint)src.size();
+	shader = glCreateShader(type);
+	glShaderSource(shader, 1, &c_src, &len);
+	glCompileShader(shader);
+	GLint success = GL_FALSE;
+	glGetShaderiv(shader, GL_COMPILE_STATUS, &success);
+	if (success == GL_FALSE) {
+		GLint log_len = 0;
+		glGetShaderiv(shader, GL_INFO_LOG_LENGTH, &log_len);
+		std::vector<char> log(log_len + 1, '\0');
+		glGetShaderInfoLog(shader, log_len, &log_len, log.data());
+		fprintf(stderr, "GLSL %s: %s\n", name.c_str(), log.data());
+		glDeleteShader(shader);
+		shader = 0;
+		return false;
+	}
+	return true;
+}
+
+static bool link_program(GLuint program, GLuint vertex, GLuint fragment) {
+	glAttachShader(program, vertex);
+	glAttachShader(program, fragment);
+	glLinkProgram(program);
+	glDetachShader(program, vertex);
+	glDetachShader(program, fragment);
+
+	GLint is_linked = GL_FALSE;
+	glGetProgramiv(program, GL_LINK_STATUS, &is_linked);
+	if (is_linked == GL_FALSE) {
+		GLint log_len = 0;
+		glGetProgramiv(program, GL_INFO_LOG_LENGTH, &log_len);
+		std::vector<char> log(log_len + 1, '\0');
+		glGetProgramInfoLog(program, log_len, &log_len, log.data());
+		fprintf(stderr, "Link error: %s\n", log.data());
+		return false;
+	}
+	return true;
+}
+
+void ShaderManager::init(const std::string& cache_path) {
+	cache_file = cache_path;
+	driver.clear();
+	for (GLenum name : { GL_VENDOR, GL_RENDERER, GL_VERSION }) {
+		const GLubyte* value = glGetString(name);
+		driver += value ? (const char*)value : "";
+		driver += '\n';
+	}
+
+	GLint formats = 0;
+	if (glGetProgramBinary != nullptr && glProgramBinary != nullptr && glProgramParameteri != nullptr)
+		glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formats);
+	binaries_supported = formats > 0;
+	gl_has_errors();
+
+	binaries.clear();
+	cache_changed = false;
+	cache_hits = 0;
+	cache_misses = 0;
+	if (!binaries_supported)
+		return;
+
+	std::ifstream in(cache_file, std::ios::binary);
+	if (!in.is_open())
+		return;
+	std::vector<char> data((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+
+	size_t pos = 0;
+	auto read = [&](void* out, size_t size) {
+		if (size > data.size() - pos)
+			return false;
+		memcpy(out, data.data() + pos, size);
+		pos += size;
+		return true;
+	};
+	uint32_t magic = 0, version = 0, driver_size = 0, count = 0;
+	if (!read(&magic, 4) || !read(&version, 4) || magic != SHADER_CACHE_MAGIC || version != SHADER_CACHE_VERSION)
+		return;
+	if (!read(&driver_size, 4) || driver_size > data.size() - pos)
+		return;
+	// another driver can't load these, they get rebuilt and the file rewritten
+	if (std::string(data.data() + pos, driver_size) != driver) {
+		printf("Shader cache was written by another GL driver, rebuilding it\n");
+		return;
+	}
+	pos += driver_size;
+	if (!read(&count, 4))
+		return;
+	for (uint32_t i = 0; i < count; i++) {
+		uint64_t hash = 0;
+		uint32_t format = 0, size = 0;
+		if (!read(&hash, 8) || !read(&format, 4) || !read(&size, 4) || size > data.size() - pos)
+			break;
+		Binary& binary = binaries[hash];
+		binary.format = format;
+		binary.data.assign(data.begin() + pos, data.begin() + pos + size);
+		pos += size;
+	}
+}
+
+void ShaderManager::save_cache() {
+	if (!binaries_supported || !cache_changed)
+		return;
+
+	FILE* file = fopen(cache_file.c_str(), "wb");
+	if (!file) {
+		fprintf(stderr, "Failed to open %s for writing\n", cache_file.c_str());
+		return;
+	}
+	uint32_t driver_size = (uint32_t)driver.size();
+	uint32_t count = 0;
+	for (const auto& entry : binaries)
+		count += entry.second.used ? 1 : 0;
+	bool ok = fwrite(&SHADER_CACHE_MAGIC, 4, 1, file) == 1;
+	ok = ok && fwrite(&SHADER_CACHE_VERSION, 4, 1, file) == 1;
+	ok = ok && fwrite(&driver_size, 4, 1, file) == 1;
+	ok = ok && fwrite(driver.data(), 1, driver_size, file) == driver_size;
+	ok = ok && fwrite(&count, 4, 1, file) == 1;
+	for (const auto& entry : binaries) {
+		if (!entry.second.used)
+			continue;
+		uint32_t format = entry.second.format;
+		uint32_t size = (uint32_t)entry.second.data.size();
+		ok = ok && fwrite(&entry.first, 8, 1, file) == 1;
+		ok = ok && fwrite(&format, 4, 1, file) == 1;
+		ok = ok && fwrite(&size, 4, 1, file) == 1;
+		ok = ok && fwrite(entry.second.data.data(), 1, size, file) == size;
+	}
+	fclose(file);
+	if (!ok) {
+		// a torn file would only be ignored on the next start, but don't leave it around
+		fprintf(stderr, "Failed to write the shader cache %s\n", cache_file.c_str());
+		remove(cache_file.c_str());
+		return;
+	}
+	cache_changed = false;
+}
+
+void ShaderManager::clear() {
+	for (auto& entry : programs)
+		glDeleteProgram(entry.second.program);
+	programs.clear();
+}
+
+GLuint ShaderManager::get(const std::string& path, const std::string& defines) {
+	std::string key = path + '\n' + defines;
+	auto found = programs.find(key);
+	if (found != programs.end())
+		return found->second.program;
+
+	Program p;
+	p.path = path;
+	p.defines = defines;
+	std::string vs_src, fs_src;
+	if (!read_file(path + ".vs.glsl", vs_src) || !read_file(path + ".fs.glsl", fs_src)) {
+		fprintf(stderr, "Failed to load shader files %s.vs.glsl, %s.fs.glsl\n", path.c_str(), path.c_str());
+		return 0;
+	}
+	p.vs_time = file_time(path + ".vs.glsl");
+	p.fs_time = file_time(path + ".fs.glsl");
+	vs_src = insert_defines(vs_src, defines);
+	fs_src = insert_defines(fs_src, defines);
+	uint64_t hash = source_hash(vs_src, fs_src);
+
+	auto cached = binaries.find(hash);
+	if (cached != binaries.end()) {
+		p.program = glCreateProgram();
+		glProgramBinary(p.program, cached->second.format, cached->second.data.data(), (GLsizei)cached->second.data.size());
+		GLint is_linked = GL_FALSE;
+		glGetProgramiv(p.program, GL_LINK_STATUS, &is_linked);
+		if (is_linked == GL_TRUE) {
+			cached->second.used = true;
+			cache_hits++;
+		}
+		else {
+			// drivers may refuse their own binaries after an update
+			glDeleteProgram(p.program);
+			p.program = 0;
+			binaries.erase(cached);
+			cache_changed = true;
+		}
+	}
+	if (p.program == 0) {
+		if (!build(vs_src, fs_src, p.program))
+			return 0;
+		cache_misses++;
+		keep_binary(hash, p.program);
+	}
+	gl_has_errors();
+
+	programs[key] = p;
+	return p.program;
+}
+
+int ShaderManager::reload_changed() {
+	int reloaded = 0;
+	for (auto& entry : programs) {
+		Program& p = entry.second;
+		int64_t vs_time = file_time(p.path + ".vs.glsl");
+		int64_t fs_time = file_time(p.path + ".fs.glsl");
+		if (vs_time == p.vs_time && fs_time == p.fs_time)
+			continue;
+		// a broken edit is tried again on the next save, not every check
+		p.vs_time = vs_time;
+		p.fs_time = fs_time;
+
+		std::string vs_src, fs_src;
+		if (!read_file(p.path + ".vs.glsl", vs_src) || !read_file(p.path + ".fs.glsl", fs_src))
+			continue;
+		vs_src = insert_defines(vs_src, p.defines);
+		fs_src = insert_defines(fs_src, p.defines);
+		if (!build(vs_src, fs_src, p.program)) {
+			fprintf(stderr, "Keeping the previous build of %s\n", p.path.c_str());
+			continue;
+		}
+		keep_binary(source_hash(vs_src, fs_src), p.program);
+		printf("Reloaded shader %s\n", p.path.c_str());
+		reloaded++;
+	}
+	return reloaded;
+}
+
+bool ShaderManager::build(const std::string& vs_src, const std::string& fs_src, GLuint& program) {
+	GLuint vertex = 0, fragment = 0;
+	if (!compile_stage(GL_VERTEX_SHADER, vs_src, "vertex", vertex))
+		return false;
+	if (!compile_stage(GL_FRAGMENT_SHADER, fs_src, "fragment", fragment)) {
+		glDeleteShader(vertex);
+		return false;
+	}
+
+	// linked on its own first, a failed link would leave program unusable
+	GLuint linked = glCreateProgram();
+	if (binaries_supported)
+		glProgramParameteri(linked, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+	bool ok = link_program(linked, vertex, fragment);
+	if (ok && program != 0) {
+		// relinked so the handles given out stay valid
+		glDeleteProgram(linked);
+		if (binaries_supported)
+			glProgramParameteri(program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+		ok = link_program(program, vertex, fragment);
+	}
+	else if (ok) {
+		program = linked;
+	}
+	else {
+		glDeleteProgram(linked);
+	}
+	glDeleteShader(vertex);
+	glDeleteShader(fragment);
+	gl_has_errors();
+	return ok;
+}
+
+void ShaderManager::keep_binary(uint64_t hash, GLuint program) {
+	if (!binaries_supported)
+		return;
+	GLint size = 0;
+	glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &size);
+	if (size <= 0)
+		return;
+	Binary& binary = binaries[hash];
+	binary.data.resize(size);
+	glGetProgramBinary(program, size, &size, &binary.format, binary.data.data());
+	binary.data.resize(size);
+	binary.used = true;
+	cache_changed = true;
+}
@@ -0,0 +1,75 @@
+#pragma once
+
+// stlib
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// internal
+#include "common.hpp"
+
+inline std::string shader_cache_path() { return data_path() + "/shader_cache.bin"; };
+
+// Owns every GL program of the renderer. A shader pair is built once per set of defines,
+// asking again for the same path and defines gives back the same program.
+//
+// Linked programs are kept in a binary cache file, keyed by a hash of their sources and
+// defines and only valid for the GL driver that wrote it, so later starts load them with
+// glProgramBinary instead of compiling. Drivers without program binaries always compile.
+//
+// Debug builds reload a program when its source files change. It is relinked in place, so
+// its handle stays valid, but uniforms set only once have to be set again.
+class ShaderManager
+{
+public:
+	// Reads the binary cache, the GL context has to be current
+	void init(const std::string& cache_path);
+	// Rewrites the binary cache with the programs asked for since init, when some of them
+	// had to be built from source
+	void save_cache();
+	// Deletes every program
+	void clear();
+
+	// path is without the .vs.glsl and .fs.glsl. defines go right after the #version line of
+	// both stages. 0 when the sources don't build.
+	GLuint get(const std::string& path, const std::string& defines = "");
+	// Relinks the programs whose source files changed, returns how many
+	int reload_changed();
+
+	// since init, programs loaded from the cache and built from source
+	int cache_hits = 0;
+	int cache_misses = 0;
+
+private:
+	struct Program {
+		std::string path;
+		std::string defines;
+		GLuint program = 0;
+		// modification times of the sources it was built from
+		int64_t vs_time = 0;
+		int64_t fs_time = 0;
+	};
+
+	struct Binary {
+		GLenum format = 0;
+		std::vector<char> data;
+		// asked for this run, only those are written back
+		bool used = false;
+	};
+
+	// Links the sources into program, a new one when it is 0. Keeps the program as it was
+	// when they fail to build.
+	bool build(const std::string& vs_src, const std::string& fs_src, GLuint& program);
+	void keep_binary(uint64_t hash, GLuint program);
+
+	// by path and defines
+	std::unordered_map<std::string, Program> programs;
+	// by source hash
+	std::unordered_map<uint64_t, Binary> binaries;
+	std::string cache_file;
+	// vendor, renderer and version, a binary only loads on the driver that made it
+	std::string driver;
+	bool binaries_supported = false;
+	bool cache_changed = false;
+};
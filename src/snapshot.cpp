@@ -0,0 +1,647 @@
+#include "snapshot.hpp"
+#include "world_system.hpp"
+#include "projectile_system.hpp"
+#include "save_journal.hpp"
+
+// stlib
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <iostream>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+size_t SnapshotWriter::begin_block(SnapshotBlock tag, uint32_t count) {
+	size_t offset = buffer.size();
+	SnapshotBlockHeader header;
+	header.tag = (uint32_t)tag;
+	header.count = count;
+	write(header);
+	block_count++;
+	return offset;
+}
+
+void SnapshotWriter::end_block(size_t block_offset) {
+	SnapshotBlockHeader header;
+	memcpy(&header, buffer.data() + block_offset, sizeof(header));
+	header.payload_size = (uint32_t)(buffer.size() - block_offset - sizeof(header));
+	memcpy(buffer.data() + block_offset, &header, sizeof(header));
+}
+
+// Read-only view of a whole file, memory mapped so the loader copies straight out of the page cache
+class MappedFile {
+public:
+	MappedFile(const std::string& path) {
+#ifdef _WIN32
+		file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+		if (file == INVALID_HANDLE_VALUE)
+			return;
+		LARGE_INTEGER file_size;
+		if (!GetFileSizeEx(file, &file_size) || file_size.QuadPart == 0)
+			return;
+		mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+		if (mapping == NULL)
+			return;
+		data = static_cast<const char*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+		if (data)
+			size = (size_t)file_size.QuadPart;
+#else
+		fd = open(path.c_str(), O_RDONLY);
+		if (fd < 0)
+			return;
+		struct stat st;
+		if (fstat(fd, &st) != 0 || st.st_size == 0)
+			return;
+		void* p = mmap(nullptr, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+		if (p == MAP_FAILED)
+			return;
+		data = static_cast<const char*>(p);
+		size = (size_t)st.st_size;
+#endif
+	}
+
+	~MappedFile() {
+#ifdef _WIN32
+		if (data) UnmapViewOfFile(data);
+		if (mapping) CloseHandle(mapping);
+		if (file != INVALID_HANDLE_VALUE) CloseHandle(file);
+#else
+		if (data) munmap((void*)data, size);
+		if (fd >= 0) close(fd);
+#endif
+	}
+
+	MappedFile(const MappedFile&) = delete;
+	MappedFile& operator=(const MappedFile&) = delete;
+
+	const char* data = nullptr;
+	size_t size = 0;
+
+private:
+#ifdef _WIN32
+	HANDLE file = INVALID_HANDLE_VALUE;
+	HANDLE mapping = NULL;
+#else
+	int fd = -1;
+#endif
+};
+
+static void write_item(SnapshotWriter& w, const Item& item) {
+	// by name, ids may be renumbered between versions
+	w.write_string(item.name());
+	w.write(item.quantity);
+	w.write(item.isRobotCompanion);
+	w.write(item.health);
+	w.write(item.damage);
+	w.write(item.speed);
+}
+
+static void read_item(SnapshotReader& r, Item& item) {
+	std::string name;
+	r.read_string(name);
+	item.id = item_id_from_name(name);
+	r.read(item.quantity);
+	r.read(item.isRobotCompanion);
+	r.read(item.health);
+	r.read(item.damage);
+	r.read(item.speed);
+}
+
+void write_component(SnapshotWriter& w, const Player& player) {
+	const Inventory& inv = player.inventory;
+	w.write((int32_t)inv.get_rows());
+	w.write((int32_t)inv.get_columns());
+	w.write(inv.get_slotSize());
+	w.write((int32_t)inv.getSelectedSlot());
+	w.write(inv.isOpen);
+	w.write((uint32_t)inv.slots.size());
+	for (const InventorySlot& slot : inv.slots) {
+		w.write(slot.type);
+		write_item(w, slot.item);
+		w.write(slot.position);
+	}
+
+	w.write(player.speed);
+	w.write(player.current_health);
+	w.write(player.max_health);
+	w.write(player.current_stamina);
+	w.write(player.max_stamina);
+	w.write(player.can_sprint);
+	w.write(player.slow);
+	w.write(player.slow_count_down);
+	w.write(player.armor_stat);
+	w.write(player.weapon_stat);
+	w.write(player.dashSpeed);
+	w.write(player.dashTarget);
+	w.write(player.dashStartPosition);
+	w.write(player.dashTargetSet);
+	w.write(player.dashDuration);
+	w.write(player.lastDashDirection);
+	w.write(player.dashTimer);
+	w.write(player.dashCooldown);
+	w.write(player.isDashing);
+}
+
+void read_component(SnapshotReader& r, Player& player) {
+	int32_t rows = 0, columns = 0, selected = 0;
+	vec2 slot_size;
+	bool is_open = false;
+	uint32_t slot_count = 0;
+	r.read(rows);
+	r.read(columns);
+	r.read(slot_size);
+	r.read(selected);
+	r.read(is_open);
+	r.read(slot_count);
+	if (r.failed || slot_count > r.size - r.pos) {
+		r.failed = true;
+		return;
+	}
+
+	player.inventory = Inventory(rows, columns, slot_size);
+	player.inventory.setSelectedSlot(selected);
+	player.inventory.isOpen = is_open;
+	player.inventory.slots.resize(slot_count);
+	for (InventorySlot& slot : player.inventory.slots) {
+		r.read(slot.type);
+		read_item(r, slot.item);
+		r.read(slot.position);
+	}
+
+	r.read(player.speed);
+	r.read(player.current_health);
+	r.read(player.max_health);
+	r.read(player.current_stamina);
+	r.read(player.max_stamina);
+	r.read(player.can_sprint);
+	r.read(player.slow);
+	r.read(player.slow_count_down);
+	r.read(player.armor_stat);
+	r.read(player.weapon_stat);
+	r.read(player.dashSpeed);
+	r.read(player.dashTarget);
+	r.read(player.dashStartPosition);
+	r.read(player.dashTargetSet);
+	r.read(player.dashDuration);
+	r.read(player.lastDashDirection);
+	r.read(player.dashTimer);
+	r.read(player.dashCooldown);
+	r.read(player.isDashing);
+}
+
+void write_component(SnapshotWriter& w, const Robot& robot) {
+	w.write(robot.current_health);
+	w.write(robot.max_health);
+	w.write(robot.should_die);
+	w.write(robot.death_cd);
+	w.write(robot.ice_proj);
+	w.write(robot.isCapturable);
+	w.write(robot.showCaptureUI);
+	w.write(robot.speed);
+	w.write(robot.attack);
+	w.write(robot.max_attack);
+	w.write(robot.max_speed);
+	w.write(robot.search_box);
+	w.write(robot.attack_box);
+	w.write(robot.panic_box);
+	w.write(robot.companion);
+	w.write((uint32_t)robot.disassembleItems.size());
+	for (const Item& item : robot.disassembleItems)
+		write_item(w, item);
+}
+
+void read_component(SnapshotReader& r, Robot& robot) {
+	r.read(robot.current_health);
+	r.read(robot.max_health);
+	r.read(robot.should_die);
+	r.read(robot.death_cd);
+	r.read(robot.ice_proj);
+	r.read(robot.isCapturable);
+	r.read(robot.showCaptureUI);
+	r.read(robot.speed);
+	r.read(robot.attack);
+	r.read(robot.max_attack);
+	r.read(robot.max_speed);
+	r.read(robot.search_box);
+	r.read(robot.attack_box);
+	r.read(robot.panic_box);
+	r.read(robot.companion);
+	uint32_t item_count = 0;
+	if (!r.read(item_count) || item_count > r.size - r.pos) {
+		r.failed = true;
+		return;
+	}
+	robot.disassembleItems.resize(item_count);
+	for (Item& item : robot.disassembleItems)
+		read_item(r, item);
+}
+
+void write_component(SnapshotWriter& w, const Notification& n) {
+	w.write_string(n.text);
+	w.write(n.duration);
+	w.write(n.elapsed_time);
+	w.write(n.position);
+	w.write(n.color);
+	w.write(n.scale);
+}
+
+void read_component(SnapshotReader& r, Notification& n) {
+	r.read_string(n.text);
+	r.read(n.duration);
+	r.read(n.elapsed_time);
+	r.read(n.position);
+	r.read(n.color);
+	r.read(n.scale);
+}
+
+// Same fields as to_json(WorldSystem)
+void write_world_block(SnapshotWriter& w, const WorldSystem& ws) {
+	size_t block = w.begin_block(SnapshotBlock::WORLD, 0);
+	w.write((int32_t)ws.get_current_level());
+	w.write(ws.get_player().id);
+	w.write(ws.get_spaceship().id);
+	w.write(ws.tutorial_state);
+	w.write(ws.introNotificationsAdded);
+	w.write(ws.armorPickedUp);
+	w.write(ws.potionPickedUp);
+	w.write(ws.movementHintShown);
+	w.write(ws.pickupHintShown);
+	w.write(ws.sprintHintShown);
+	w.write((int32_t)ws.robotPartsCount);
+	w.write(ws.inventoryOpened);
+	w.write(ws.inventoryClosed);
+	w.write(ws.inventoryHintShown);
+	w.write(ws.attackNotificationsAdded);
+	w.write(ws.keyPickedUp);
+
+	std::queue<std::pair<std::string, float>> temp = ws.notificationQueue;
+	w.write((uint32_t)temp.size());
+	while (!temp.empty()) {
+		w.write_string(temp.front().first);
+		w.write(temp.front().second);
+		temp.pop();
+	}
+	w.end_block(block);
+}
+
+bool read_world_block(SnapshotReader& r, SavedWorld& out) {
+	// robot_parts sits between the sixth and the seventh flag
+	r.read(out.level);
+	r.read(out.player.id);
+	r.read(out.spaceship.id);
+	r.read(out.tutorial_state);
+	for (int i = 0; i < 6; i++)
+		r.read(out.flags[i]);
+	r.read(out.robot_parts);
+	for (int i = 6; i < SavedWorld::flag_count; i++)
+		r.read(out.flags[i]);
+
+	uint32_t queued = 0;
+	r.read(queued);
+	for (uint32_t i = 0; i < queued && !r.failed; i++) {
+		std::pair<std::string, float> n;
+		r.read_string(n.first);
+		r.read(n.second);
+		out.notifications.push(n);
+	}
+	return !r.failed;
+}
+
+void apply_world_block(const SavedWorld& saved, WorldSystem& ws) {
+	bool* targets[SavedWorld::flag_count] = { &ws.introNotificationsAdded, &ws.armorPickedUp, &ws.potionPickedUp,
+		&ws.movementHintShown, &ws.pickupHintShown, &ws.sprintHintShown, &ws.inventoryOpened,
+		&ws.inventoryClosed, &ws.inventoryHintShown, &ws.attackNotificationsAdded, &ws.keyPickedUp };
+	ws.tutorial_state = saved.tutorial_state;
+	for (int i = 0; i < SavedWorld::flag_count; i++)
+		*targets[i] = saved.flags[i];
+	ws.set_current_level(saved.level);
+	ws.set_player(saved.player);
+	ws.set_spaceship(saved.spaceship);
+	ws.robotPartsCount = saved.robot_parts;
+	ws.notificationQueue = saved.notifications;
+}
+
+bool read_world_block(SnapshotReader& r, WorldSystem& ws) {
+	// a truncated block leaves the world as it was
+	SavedWorld saved;
+	if (!read_world_block(r, saved))
+		return false;
+	apply_world_block(saved, ws);
+	return true;
+}
+
+void build_snapshot(const ECSRegistry& reg, const WorldSystem& world, SnapshotWriter& w, uint32_t journal_epoch) {
+	SnapshotHeader header;
+	header.id_count = Entity::id_count;
+	header.map_width = map_width;
+	header.map_height = map_height;
+	header.journal_epoch = journal_epoch;
+	w.write(header);
+
+	write_world_block(w, world);
+	visit_saved_containers(reg, [&](SnapshotBlock tag, const auto& container) {
+		if (skips_tiles(tag))
+			write_container_except(w, tag, container, reg.tiles);
+		else
+			write_container(w, tag, container);
+	});
+	write_dormant_block(w, world);
+	write_projectile_block(w);
+
+	// Patch the final block count into the header
+	header.block_count = w.block_count;
+	memcpy(w.buffer.data(), &header, sizeof(header));
+}
+
+// Tokens: 0x00-0x7F copy the next (token + 1) bytes as literals, 0x80-0xFF copy
+// (token - 0x80 + SNAPSHOT_MIN_MATCH) bytes from the 16 bit back offset that follows.
+static const size_t SNAPSHOT_MIN_MATCH = 4;
+static const size_t SNAPSHOT_MAX_MATCH = 0x7F + SNAPSHOT_MIN_MATCH;
+static const size_t SNAPSHOT_MAX_LITERALS = 0x80;
+static const int SNAPSHOT_HASH_BITS = 14;
+
+void compress_snapshot(const std::vector<char>& in, std::vector<char>& out) {
+	SnapshotPackedHeader header;
+	header.raw_size = (uint32_t)in.size();
+	out.clear();
+	out.reserve(sizeof(header) + in.size() + in.size() / SNAPSHOT_MAX_LITERALS + 1);
+	const char* h = reinterpret_cast<const char*>(&header);
+	out.insert(out.end(), h, h + sizeof(header));
+
+	const unsigned char* src = reinterpret_cast<const unsigned char*>(in.data());
+	size_t n = in.size();
+	size_t pos = 0;
+	size_t literal_start = 0;
+	std::vector<int32_t> last_seen(1 << SNAPSHOT_HASH_BITS, -1);
+
+	auto flush_literals = [&](size_t end) {
+		while (literal_start < end) {
+			size_t run = std::min(end - literal_start, SNAPSHOT_MAX_LITERALS);
+			out.push_back((char)(run - 1));
+			out.insert(out.end(), in.data() + literal_start, in.data() + literal_start + run);
+			literal_start += run;
+		}
+	};
+
+	while (pos + SNAPSHOT_MIN_MATCH <= n) {
+		uint32_t seq;
+		memcpy(&seq, src + pos, sizeof(seq));
+		uint32_t hash = (seq * 2654435761u) >> (32 - SNAPSHOT_HASH_BITS);
+		int32_t candidate = last_seen[hash];
+		last_seen[hash] = (int32_t)pos;
+
+		if (candidate >= 0 && pos - candidate <= 0xFFFF && memcmp(src + candidate, src + pos, SNAPSHOT_MIN_MATCH) == 0) {
+			size_t len = SNAPSHOT_MIN_MATCH;
+			while (len < SNAPSHOT_MAX_MATCH && pos + len < n && src[candidate + len] == src[pos + len])
+				len++;
+			flush_literals(pos);
+			uint16_t offset = (uint16_t)(pos - candidate);
+			out.push_back((char)(0x80 + len - SNAPSHOT_MIN_MATCH));
+			out.push_back((char)(offset & 0xFF));
+			out.push_back((char)(offset >> 8));
+			pos += len;
+			literal_start = pos;
+		}
+		else {
+			pos++;
+		}
+	}
+	flush_literals(n);
+}
+
+bool decompress_snapshot(const char* data, size_t size, std::vector<char>& out) {
+	SnapshotPackedHeader header;
+	if (size < sizeof(header))
+		return false;
+	memcpy(&header, data, sizeof(header));
+	if (header.magic != SNAPSHOT_PACKED_MAGIC)
+		return false;
+
+	// a match token turns 3 bytes into at most SNAPSHOT_MAX_MATCH, more than that is a corrupt header
+	if (header.raw_size > (size - sizeof(header)) / 3 * SNAPSHOT_MAX_MATCH + SNAPSHOT_MAX_MATCH)
+		return false;
+
+	const unsigned char* src = reinterpret_cast<const unsigned char*>(data);
+	size_t in_pos = sizeof(header);
+	size_t out_pos = 0;
+	out.resize(header.raw_size);
+	while (in_pos < size) {
+		unsigned int token = src[in_pos++];
+		if (token < 0x80) {
+			size_t run = token + 1;
+			if (run > size - in_pos || run > out.size() - out_pos)
+				return false;
+			memcpy(out.data() + out_pos, data + in_pos, run);
+			in_pos += run;
+			out_pos += run;
+		}
+		else {
+			size_t len = token - 0x80 + SNAPSHOT_MIN_MATCH;
+			if (size - in_pos < 2)
+				return false;
+			size_t offset = src[in_pos] | (src[in_pos + 1] << 8);
+			in_pos += 2;
+			if (offset == 0 || offset > out_pos || len > out.size() - out_pos)
+				return false;
+			// byte by byte on purpose, matches may overlap the bytes they produce
+			for (size_t i = 0; i < len; i++, out_pos++)
+				out[out_pos] = out[out_pos - offset];
+		}
+	}
+	return out_pos == out.size();
+}
+
+bool write_snapshot_file(const std::string& path, const char* data, size_t size) {
+	std::string tmp_path = path + ".tmp";
+	FILE* file = fopen(tmp_path.c_str(), "wb");
+	if (!file) {
+		std::cerr << "Failed to open " << tmp_path << " for writing." << std::endl;
+		return false;
+	}
+	bool ok = fwrite(data, 1, size, file) == size;
+	ok = (fflush(file) == 0) && ok;
+	fclose(file);
+	if (!ok) {
+		std::cerr << "Failed to write snapshot to " << tmp_path << std::endl;
+		remove(tmp_path.c_str());
+		return false;
+	}
+
+#ifdef _WIN32
+	ok = MoveFileExA(tmp_path.c_str(), path.c_str(), MOVEFILE_REPLACE_EXISTING) != 0;
+#else
+	ok = rename(tmp_path.c_str(), path.c_str()) == 0;
+#endif
+	if (!ok) {
+		std::cerr << "Failed to move " << tmp_path << " over " << path << std::endl;
+		remove(tmp_path.c_str());
+	}
+	return ok;
+}
+
+bool save_snapshot(const ECSRegistry& reg, const WorldSystem& world, const std::string& path, uint32_t journal_epoch) {
+	SnapshotWriter w;
+	w.buffer.reserve(1 << 20);
+	build_snapshot(reg, world, w, journal_epoch);
+
+	if (!write_snapshot_file(path, w.buffer.data(), w.buffer.size()))
+		return false;
+	std::cout << "Snapshot saved to " << path << " (" << w.buffer.size() << " bytes)" << std::endl;
+	return true;
+}
+
+void write_dormant_block(SnapshotWriter& w, const WorldSystem& world) {
+	size_t block = w.begin_block(SnapshotBlock::DORMANT_ENTITIES, (uint32_t)world.chunks.dormant_count());
+	world.chunks.write_dormant(w);
+	w.end_block(block);
+}
+
+bool read_dormant_block(SnapshotReader& r, ECSRegistry& reg, uint32_t count) {
+	for (uint32_t i = 0; i < count; i++) {
+		Entity e;
+		r.read(e.id);
+		if (r.failed || !read_entity(r, reg, e))
+			return false;
+	}
+	return true;
+}
+
+void write_projectile_block(SnapshotWriter& w) {
+	size_t block = w.begin_block(SnapshotBlock::PROJECTILE_POOL, projectiles.size());
+	projectiles.write(w);
+	w.end_block(block);
+}
+
+bool read_projectile_block(SnapshotReader& r, uint32_t count) {
+	return projectiles.read(r, count);
+}
+
+static bool read_block(SnapshotReader& r, ECSRegistry& reg, WorldSystem& world, const SnapshotBlockHeader& block) {
+	if (block.tag == (uint32_t)SnapshotBlock::WORLD)
+		return read_world_block(r, world);
+	if (block.tag == (uint32_t)SnapshotBlock::DORMANT_ENTITIES)
+		return read_dormant_block(r, reg, block.count);
+	if (block.tag == (uint32_t)SnapshotBlock::PROJECTILE_POOL)
+		return read_projectile_block(r, block.count);
+
+	bool known = false;
+	bool ok = true;
+	visit_saved_containers(reg, [&](SnapshotBlock tag, auto& container) {
+		if ((uint32_t)tag == block.tag) {
+			known = true;
+			ok = read_container(r, container, block.count);
+		}
+	});
+	// Unknown block from a newer build, skip over it
+	if (!known)
+		r.pos += block.payload_size;
+	return ok;
+}
+
+static bool load_snapshot_data(ECSRegistry& reg, WorldSystem& world, const char* data, size_t size, const std::string& path, SnapshotHeader& header) {
+	SnapshotReader r(data, size);
+	if (!r.read(header) || header.magic != SNAPSHOT_MAGIC || header.version != SNAPSHOT_VERSION) {
+		std::cerr << "Snapshot " << path << " has an unknown format, ignoring it." << std::endl;
+		return false;
+	}
+
+	// Walk the block table first so a truncated file is rejected before anything is overwritten
+	size_t blocks_start = r.pos;
+	for (uint32_t i = 0; i < header.block_count; i++) {
+		SnapshotBlockHeader block;
+		if (!r.read(block) || block.payload_size > r.size - r.pos) {
+			std::cerr << "Snapshot " << path << " is truncated, ignoring it." << std::endl;
+			return false;
+		}
+		r.pos += block.payload_size;
+	}
+
+	// Decoded into an empty scratch registry, pool and world state, they replace the live
+	// ones only once every block read back
+	ECSRegistry scratch;
+	ProjectileSystem scratch_projectiles;
+	SavedWorld scratch_world;
+	bool has_world = false;
+	r.pos = blocks_start;
+	for (uint32_t i = 0; i < header.block_count; i++) {
+		SnapshotBlockHeader block;
+		r.read(block);
+		size_t payload_end = r.pos + block.payload_size;
+		bool ok;
+		if (block.tag == (uint32_t)SnapshotBlock::WORLD) {
+			ok = read_world_block(r, scratch_world);
+			has_world = true;
+		}
+		else if (block.tag == (uint32_t)SnapshotBlock::PROJECTILE_POOL) {
+			ok = scratch_projectiles.read(r, block.count);
+		}
+		else {
+			ok = read_block(r, scratch, world, block);
+		}
+		if (!ok || r.pos != payload_end) {
+			std::cerr << "Snapshot block " << block.tag << " is corrupt." << std::endl;
+			return false;
+		}
+	}
+
+	// whatever init() spawned goes, it would otherwise keep its entity ids
+	if (has_world)
+		apply_world_block(scratch_world, world);
+	reg.take_contents(scratch);
+	projectiles = scratch_projectiles;
+	return true;
+}
+
+bool load_snapshot(ECSRegistry& reg, WorldSystem& world, const std::string& path, uint32_t* journal_epoch) {
+	MappedFile file(path);
+	if (!file.data) {
+		std::cerr << "No snapshot at " << path << std::endl;
+		return false;
+	}
+
+	uint32_t magic = 0;
+	if (file.size >= sizeof(magic))
+		memcpy(&magic, file.data, sizeof(magic));
+	SnapshotHeader header;
+	bool loaded = false;
+	if (magic == SNAPSHOT_PACKED_MAGIC) {
+		std::vector<char> unpacked;
+		if (!decompress_snapshot(file.data, file.size, unpacked)) {
+			std::cerr << "Snapshot " << path << " failed to decompress, ignoring it." << std::endl;
+			return false;
+		}
+		loaded = load_snapshot_data(reg, world, unpacked.data(), unpacked.size(), path, header);
+	}
+	else {
+		loaded = load_snapshot_data(reg, world, file.data, file.size, path, header);
+	}
+	if (!loaded)
+		return false;
+
+	// Changes made after the snapshot was taken; the journal keeps the globals up to date
+	replay_journal(reg, world, journal_path(path), header);
+
+	map_width = header.map_width;
+	map_height = header.map_height;
+	Entity::id_count = header.id_count;
+	if (journal_epoch)
+		*journal_epoch = header.journal_epoch;
+
+	// New tile entities are numbered after every saved one
+	world.build_level_geometry(world.get_current_level());
+
+	if (reg.players.size() > 0) {
+		Motion& m = reg.motions.get(reg.players.entities[0]);
+		m.target_velocity = { 0.f, 0.f };
+	}
+	std::cout << "Snapshot loaded from " << path << std::endl;
+	return true;
+}
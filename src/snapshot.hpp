@@ -0,0 +1,375 @@
+#pragma once
+
+// stlib
+#include <cstdint>
+#include <cstring>
+#include <queue>
+#include <string>
+#include <vector>
+#include <type_traits>
+
+// internal
+#include "common.hpp"
+#include "tiny_ecs_registry.hpp"
+
+class WorldSystem;
+
+// Binary save format. A fixed header is followed by one length-prefixed block per
+// component container, so a loader can bulk-copy plain components straight out of
+// the file and skip blocks it does not know about.
+// Only dynamic state is stored: tiles, their motions and render requests, the tileset
+// and the collision map are rebuilt from the saved level on load.
+// data.json is still written by generate_json() as a readable export for debugging.
+const uint32_t SNAPSHOT_MAGIC = 0x56415345; // "ESAV"
+const uint32_t SNAPSHOT_VERSION = 5;
+// Autosaves are written compressed, wrapped in a small header of their own
+const uint32_t SNAPSHOT_PACKED_MAGIC = 0x5A415345; // "ESAZ"
+
+inline std::string snapshot_path() { return data_path() + "/save.bin"; };
+
+enum class SnapshotBlock : uint32_t {
+	NONE = 0, // containers that are not saved, see ECS_COMPONENT_LIST
+	WORLD = 1,
+	DEATH_TIMERS,
+	MOTIONS,
+	PLAYERS,
+	PLAYER_ANIMATIONS,
+	ROBOT_ANIMATIONS,
+	BOSS_ROBOT_ANIMATIONS,
+	ICE_ROBOT_ANIMATIONS,
+	SPIDER_ROBOT_ANIMATIONS,
+	DOORS,
+	DOOR_ANIMATIONS,
+	RENDER_REQUESTS,
+	SCREEN_STATES,
+	ROBOTS,
+	BOSS_ROBOTS,
+	SPIDER_ROBOTS,
+	KEYS,
+	ARMORPLATES,
+	POTIONS,
+	SPACESHIPS,
+	BOIDS,
+	RADIATIONS,
+	DEBUG_COMPONENTS,
+	COLORS,
+	NOTIFICATIONS,
+	ATTACK_BOXES,
+	// no longer written, projectiles moved to ProjectileSystem
+	PROJECTILES,
+	BOSS_PROJECTILES,
+	// robots parked by WorldChunks, outside the registry
+	DORMANT_ENTITIES,
+	// ProjectileSystem, outside the registry
+	PROJECTILE_POOL
+};
+
+struct SnapshotHeader {
+	uint32_t magic = SNAPSHOT_MAGIC;
+	uint32_t version = SNAPSHOT_VERSION;
+	uint32_t block_count = 0;
+	uint32_t id_count = 0;
+	int32_t map_width = 0;
+	int32_t map_height = 0;
+	// the save journal only applies on top of the snapshot with the same epoch
+	uint32_t journal_epoch = 0;
+};
+
+struct SnapshotPackedHeader {
+	uint32_t magic = SNAPSHOT_PACKED_MAGIC;
+	uint32_t raw_size = 0;
+};
+
+// Every block starts with this, the payload (entity ids, then components) follows
+struct SnapshotBlockHeader {
+	uint32_t tag = 0;
+	uint32_t count = 0;
+	uint32_t payload_size = 0;
+};
+
+// Appends everything to one growable buffer that is written out with a single call
+class SnapshotWriter {
+public:
+	std::vector<char> buffer;
+	uint32_t block_count = 0;
+
+	void write_bytes(const void* data, size_t size) {
+		const char* bytes = static_cast<const char*>(data);
+		buffer.insert(buffer.end(), bytes, bytes + size);
+	}
+
+	template <typename T>
+	void write(const T& value) {
+		static_assert(std::is_trivially_copyable<T>::value, "write() only takes plain data");
+		write_bytes(&value, sizeof(T));
+	}
+
+	void write_string(const std::string& s) {
+		write((uint32_t)s.size());
+		write_bytes(s.data(), s.size());
+	}
+
+	// Returns the offset of the block header so the payload size can be patched in end_block
+	size_t begin_block(SnapshotBlock tag, uint32_t count);
+	void end_block(size_t block_offset);
+};
+
+// Reads from memory owned by someone else (the mapped save file).
+// A read past the end marks the reader as failed instead of throwing.
+class SnapshotReader {
+public:
+	SnapshotReader(const char* data, size_t size) : data(data), size(size) {}
+
+	bool read_bytes(void* out, size_t n) {
+		if (failed || n > size - pos) {
+			failed = true;
+			return false;
+		}
+		memcpy(out, data + pos, n);
+		pos += n;
+		return true;
+	}
+
+	template <typename T>
+	bool read(T& out) {
+		static_assert(std::is_trivially_copyable<T>::value, "read() only takes plain data");
+		return read_bytes(&out, sizeof(T));
+	}
+
+	bool read_string(std::string& out) {
+		uint32_t len = 0;
+		if (!read(len) || len > size - pos) {
+			failed = true;
+			return false;
+		}
+		out.assign(data + pos, len);
+		pos += len;
+		return true;
+	}
+
+	const char* data;
+	size_t size;
+	size_t pos = 0;
+	bool failed = false;
+};
+
+// Serializers for components that own heap memory and so can't be copied as bytes
+void write_component(SnapshotWriter& w, const Player& player);
+void read_component(SnapshotReader& r, Player& player);
+void write_component(SnapshotWriter& w, const Robot& robot);
+void read_component(SnapshotReader& r, Robot& robot);
+void write_component(SnapshotWriter& w, const Notification& n);
+void read_component(SnapshotReader& r, Notification& n);
+
+// Single component, used where a block holds a sparse selection of a container
+template <typename Component>
+void write_one(SnapshotWriter& w, const Component& c, std::true_type) { w.write(c); }
+template <typename Component>
+void write_one(SnapshotWriter& w, const Component& c, std::false_type) { write_component(w, c); }
+template <typename Component>
+void read_one(SnapshotReader& r, Component& c, std::true_type) { r.read(c); }
+template <typename Component>
+void read_one(SnapshotReader& r, Component& c, std::false_type) { read_component(r, c); }
+
+template <typename Component>
+using is_plain_component = std::integral_constant<bool, std::is_trivially_copyable<Component>::value>;
+
+// Plain components go out as one memcpy of the dense array
+template <typename Component>
+void write_components(SnapshotWriter& w, const std::vector<Component>& components, std::true_type) {
+	if (!components.empty())
+		w.write_bytes(components.data(), components.size() * sizeof(Component));
+}
+
+template <typename Component>
+void write_components(SnapshotWriter& w, const std::vector<Component>& components, std::false_type) {
+	for (const Component& c : components)
+		write_component(w, c);
+}
+
+template <typename Component>
+bool read_components(SnapshotReader& r, std::vector<Component>& components, uint32_t count, std::true_type) {
+	components.resize(count);
+	return count == 0 || r.read_bytes(components.data(), count * sizeof(Component));
+}
+
+template <typename Component>
+bool read_components(SnapshotReader& r, std::vector<Component>& components, uint32_t count, std::false_type) {
+	components.resize(count);
+	for (Component& c : components)
+		read_component(r, c);
+	return !r.failed;
+}
+
+template <typename Component>
+void write_container(SnapshotWriter& w, SnapshotBlock tag, const ComponentContainer<Component>& container) {
+	size_t block = w.begin_block(tag, (uint32_t)container.entities.size());
+	for (const Entity& e : container.entities)
+		w.write(e.id);
+	write_components(w, container.components, is_plain_component<Component>());
+	w.end_block(block);
+}
+
+// Same as write_container but leaves out the entities found in skip (the level's tiles)
+template <typename Component, typename Skip>
+void write_container_except(SnapshotWriter& w, SnapshotBlock tag, const ComponentContainer<Component>& container, const ComponentContainer<Skip>& skip) {
+	std::vector<unsigned int> kept;
+	kept.reserve(container.entities.size());
+	for (unsigned int i = 0; i < container.entities.size(); i++) {
+		if (skip.map_entity_componentID.count(container.entities[i].id) == 0)
+			kept.push_back(i);
+	}
+
+	size_t block = w.begin_block(tag, (uint32_t)kept.size());
+	for (unsigned int i : kept)
+		w.write(container.entities[i].id);
+	for (unsigned int i : kept)
+		write_one(w, container.components[i], is_plain_component<Component>());
+	w.end_block(block);
+}
+
+// Replaces the container contents; the entity -> index map is rebuilt rather than stored
+template <typename Component>
+bool read_container(SnapshotReader& r, ComponentContainer<Component>& container, uint32_t count) {
+	container.clear();
+	// Note, default constructing entities bumps Entity::id_count, which is restored from the header afterwards
+	container.entities.resize(count);
+	for (Entity& e : container.entities)
+		r.read(e.id);
+	if (!read_components(r, container.components, count, is_plain_component<Component>())) {
+		container.clear();
+		return false;
+	}
+	container.map_entity_componentID.reserve(count);
+	for (unsigned int i = 0; i < count; i++)
+		container.map_entity_componentID[container.entities[i]] = i;
+	return true;
+}
+
+// Picked at compile time, so containers that aren't saved never instantiate the visitor
+template <SnapshotBlock Tag, typename Container, typename Visitor>
+void visit_saved_container(std::integral_constant<SnapshotBlock, Tag>, Container& container, Visitor& visit) {
+	visit(Tag, container);
+}
+template <typename Container, typename Visitor>
+void visit_saved_container(std::integral_constant<SnapshotBlock, SnapshotBlock::NONE>, Container&, Visitor&) {
+}
+
+// Every container that goes into a save, with the tag of its block. Registry may be const.
+template <typename Registry, typename Visitor>
+void visit_saved_containers(Registry& reg, Visitor&& visit) {
+#define SNAPSHOT_VISIT_CONTAINER(type, name, block) \
+	visit_saved_container(std::integral_constant<SnapshotBlock, SnapshotBlock::block>(), reg.name, visit);
+	ECS_COMPONENT_LIST(SNAPSHOT_VISIT_CONTAINER)
+#undef SNAPSHOT_VISIT_CONTAINER
+}
+
+// Containers that tiles also live in, their tile entries are left out of saves
+inline bool skips_tiles(SnapshotBlock tag) {
+	return tag == SnapshotBlock::MOTIONS || tag == SnapshotBlock::RENDER_REQUESTS;
+}
+
+// One entity's saved components: uint32 count, then per component its block tag,
+// payload size and data. Used to park an entity outside the registry.
+template <typename Registry>
+void write_entity(SnapshotWriter& w, Registry& reg, Entity e) {
+	size_t count_at = w.buffer.size();
+	uint32_t count = 0;
+	w.write(count);
+	visit_saved_containers(reg, [&](SnapshotBlock tag, auto& container) {
+		auto it = container.map_entity_componentID.find(e.id);
+		if (it == container.map_entity_componentID.end())
+			return;
+		const auto& c = container.components[it->second];
+		w.write(tag);
+		size_t size_at = w.buffer.size();
+		w.write((uint32_t)0);
+		write_one(w, c, is_plain_component<std::decay_t<decltype(c)>>());
+		uint32_t size = (uint32_t)(w.buffer.size() - size_at - sizeof(uint32_t));
+		memcpy(w.buffer.data() + size_at, &size, sizeof(size));
+		count++;
+	});
+	memcpy(w.buffer.data() + count_at, &count, sizeof(count));
+}
+
+// Puts the components written by write_entity back on e, replacing ones it already has
+template <typename Registry>
+bool read_entity(SnapshotReader& r, Registry& reg, Entity e) {
+	uint32_t count = 0;
+	r.read(count);
+	for (uint32_t i = 0; i < count && !r.failed; i++) {
+		SnapshotBlock block = SnapshotBlock::NONE;
+		uint32_t size = 0;
+		r.read(block);
+		r.read(size);
+		if (r.failed || size > r.size - r.pos)
+			return false;
+		size_t end = r.pos + size;
+		bool ok = true;
+		visit_saved_containers(reg, [&](SnapshotBlock tag, auto& container) {
+			if (tag != block)
+				return;
+			typename std::decay_t<decltype(container.components)>::value_type c;
+			read_one(r, c, is_plain_component<decltype(c)>());
+			ok = !r.failed;
+			if (!ok)
+				return;
+			if (container.has(e))
+				container.components[container.map_entity_componentID[e]] = std::move(c);
+			else
+				container.insert(e, std::move(c));
+		});
+		if (!ok || r.pos > end)
+			return false;
+		// unknown tag from a newer build
+		r.pos = end;
+	}
+	return !r.failed;
+}
+
+// The WORLD block, WorldSystem state outside the registry
+void write_world_block(SnapshotWriter& w, const WorldSystem& world);
+bool read_world_block(SnapshotReader& r, WorldSystem& world);
+
+// A WORLD block read but not yet applied, so a load can check every block before touching
+// the world. The flags are in write_world_block order.
+struct SavedWorld {
+	int32_t level = 0;
+	Entity player;
+	Entity spaceship;
+	TutorialState tutorial_state = TutorialState::INTRO;
+	static const int flag_count = 11;
+	bool flags[flag_count] = {};
+	int32_t robot_parts = 0;
+	std::queue<std::pair<std::string, float>> notifications;
+};
+bool read_world_block(SnapshotReader& r, SavedWorld& out);
+void apply_world_block(const SavedWorld& saved, WorldSystem& world);
+
+// The DORMANT_ENTITIES block, loading it puts the parked robots back into the registry
+// and WorldChunks parks them again on its next update
+void write_dormant_block(SnapshotWriter& w, const WorldSystem& world);
+bool read_dormant_block(SnapshotReader& r, ECSRegistry& reg, uint32_t count);
+
+// The PROJECTILE_POOL block, replaces the projectiles in flight
+void write_projectile_block(SnapshotWriter& w);
+bool read_projectile_block(SnapshotReader& r, uint32_t count);
+
+// Serializes the whole game state into w.buffer
+void build_snapshot(const ECSRegistry& reg, const WorldSystem& world, SnapshotWriter& w, uint32_t journal_epoch = 0);
+
+// Byte-oriented LZ compression of a finished snapshot buffer, output starts with a SnapshotPackedHeader
+void compress_snapshot(const std::vector<char>& in, std::vector<char>& out);
+bool decompress_snapshot(const char* data, size_t size, std::vector<char>& out);
+
+// Writes to a temporary file next to path and renames it over the old save,
+// so a crash mid-write never leaves a half written save behind
+bool write_snapshot_file(const std::string& path, const char* data, size_t size);
+
+// Writes the save with a single buffered write. Returns false if the file could not be written.
+bool save_snapshot(const ECSRegistry& reg, const WorldSystem& world, const std::string& path = snapshot_path(), uint32_t journal_epoch = 0);
+
+// Maps the save file, restores the registry from it and replays the matching save journal.
+// Returns false, leaving the registry untouched, when there is no save or its header/block
+// layout doesn't check out. journal_epoch receives the epoch of the loaded snapshot.
+bool load_snapshot(ECSRegistry& reg, WorldSystem& world, const std::string& path = snapshot_path(), uint32_t* journal_epoch = nullptr);
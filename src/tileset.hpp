@@ -19,22 +19,8 @@ public:
     // get texture coordinates for a given tile ID
     const TileData& getTileData(int tile_id) const;
 
-    std::vector<std::vector<int>> initializeRemoteLocationMap();
-    std::vector<std::vector<int>> initializeObstacleMap();
-
     int map_width = 50;  // Set your desired initial width
     int map_height = 30; // Set your desired initial height
-    std::vector<std::vector<int>> TileSet::initializeTutorialLevelMap();
-    std::vector<std::vector<int>> TileSet::initializeTutorialLevelObstacleMap();
-    std::vector<std::vector<int>> TileSet::initializeFirstLevelMap();
-    std::vector<std::vector<int>> TileSet::initializeFirstLevelObstacleMap();
-    std::vector<std::vector<int>> TileSet::initializeSecondLevelMap();
-    std::vector<std::vector<int>> TileSet::initializeSecondLevelObstacleMap();
-    std::vector<std::vector<int>> TileSet::initializeThirdLevelMap();
-    std::vector<std::vector<int>> TileSet::initializeThirdLevelObstacleMap();
-
-    std::vector<std::vector<int>> TileSet::initializeFinalLevelMap();
-    std::vector<std::vector<int>> TileSet::initializeFinalLevelObstacleMap();
 
     // map storing the texture coordinates
     std::unordered_map<int, TileData> tile_textures;
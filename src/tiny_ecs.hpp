@@ -7,6 +7,7 @@
 #include <functional>
 #include <typeindex>
 #include <assert.h>
+#include <cstdint>
 
 #include "../ext/json.hpp"
 
@@ -27,18 +28,11 @@ public:
 	operator unsigned int() { return id; } // this enables automatic casting to int
 };
 
-// Common interface to refer to all containers in the ECS registry
-struct ContainerInterface
-{
-	virtual void clear() = 0;
-	virtual size_t size() = 0;
-	virtual void remove(Entity e) = 0;
-	virtual bool has(Entity entity) = 0;
-};
-
+// Per-entity bitmask with one bit per container, owned by the registry
+using ComponentMask = uint64_t;
 
 template <typename Component> // A component can be any class
-class ComponentContainer : public ContainerInterface
+class ComponentContainer
 {
 private:
 	// The hash map from Entity -> array index.
@@ -52,6 +46,45 @@ public:
 	// The corresponding entities
 	std::vector<Entity> entities;
 
+	// Change tracking for the save journal, one flag per component.
+	// get() and insert() set the flag, code writing through components[i] directly calls mark_dirty(i).
+	std::vector<unsigned char> dirty;
+	// Removals and clears are only recorded while journaling, so they can't pile up otherwise
+	bool journaling = false;
+	bool cleared = false;
+	std::vector<unsigned int> removed_entities;
+
+	void mark_dirty(unsigned int cID) {
+		// containers filled directly (json, snapshots) start out dirty
+		if (dirty.size() != components.size())
+			dirty.resize(components.size(), 1);
+		dirty[cID] = 1;
+	}
+
+	// Called once a journal record holding the current changes has been captured
+	void clear_dirty() {
+		dirty.assign(components.size(), 0);
+		cleared = false;
+		removed_entities.clear();
+	}
+
+	// Set by the registry, insert and remove keep the owning entity's mask up to date
+	std::vector<ComponentMask>* entity_masks = nullptr;
+	ComponentMask mask_bit = 0;
+
+	void set_mask(unsigned int id) {
+		if (!entity_masks)
+			return;
+		if (id >= entity_masks->size())
+			entity_masks->resize(id + 1, 0);
+		(*entity_masks)[id] |= mask_bit;
+	}
+
+	void unset_mask(unsigned int id) {
+		if (entity_masks && id < entity_masks->size())
+			(*entity_masks)[id] &= ~mask_bit;
+	}
+
 	// Constructor that registers the type
 	ComponentContainer()
 	{
@@ -73,6 +106,8 @@ public:
 		map_entity_componentID[e] = (unsigned int)components.size();
 		components.push_back(std::move(c)); // the move enforces move instead of copy constructor
 		entities.push_back(e);
+		set_mask(e.id);
+		mark_dirty((unsigned int)components.size() - 1);
 		return components.back();
 	};
 
@@ -99,7 +134,16 @@ public:
 			assert(false); // Trigger the assertion failure explicitly
 		}
 		assert(has(e) && "Entity not contained in ECS registry");
-		return components[map_entity_componentID[e]];
+		unsigned int cID = map_entity_componentID[e];
+		mark_dirty(cID);
+		return components[cID];
+	}
+
+	// Read-only access that leaves the dirty flag alone, so it is safe from job system threads
+	const Component& peek(Entity e) const {
+		auto it = map_entity_componentID.find(e.id);
+		assert(it != map_entity_componentID.end() && "Entity not contained in ECS registry");
+		return components[it->second];
 	}
 
 	// Check if entity has a component of type 'Component'
@@ -114,6 +158,13 @@ public:
 		{
 			// Get the current position
 			int cID = map_entity_componentID[e];
+			if (dirty.size() != components.size())
+				dirty.resize(components.size(), 1);
+			dirty[cID] = dirty.back();
+			dirty.pop_back();
+			if (journaling)
+				removed_entities.push_back(e);
+			unset_mask(e.id);
 
 			// Move the last element to position cID using the move operator
 			// Note, components[cID] = components.back() would trigger the copy instead of move operator
@@ -132,9 +183,30 @@ public:
 	// Remove all components of type 'Component'
 	void clear()
 	{
+		for (Entity e : entities)
+			unset_mask(e.id);
 		map_entity_componentID.clear();
 		components.clear();
 		entities.clear();
+		dirty.clear();
+		if (journaling) {
+			cleared = true;
+			removed_entities.clear();
+		}
+	}
+
+	// Swaps in other's components, as if this was cleared and refilled with them.
+	// The entity masks are left to the registry.
+	void take_contents(ComponentContainer& other)
+	{
+		map_entity_componentID.swap(other.map_entity_componentID);
+		components.swap(other.components);
+		entities.swap(other.entities);
+		dirty.swap(other.dirty);
+		if (journaling) {
+			cleared = true;
+			removed_entities.clear();
+		}
 	}
 
 	// Report the number of components of type 'Component'
@@ -156,6 +228,8 @@ public:
 		// Fill the new hashmap
 		for (unsigned int i = 0; i < entities.size(); i++)
 			map_entity_componentID[entities[i]] = i;
+		// cheaper than permuting the flags along with the components
+		dirty.assign(components.size(), 1);
 	}
 };
 
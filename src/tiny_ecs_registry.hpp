@@ -1,117 +1,134 @@
 #pragma once
 #include <vector>
+#include <typeinfo>
 
 #include "tiny_ecs.hpp"
 #include "components.hpp"
 
+// All components this game has: X(type, registry member, snapshot block).
+// The registry storage, removal, clearing and the snapshot format are generated from
+// this list, so a new container only needs a line here. Use NONE as the snapshot
+// block for containers that are rebuilt instead of saved.
+// TODO: A1 add a LightUp component
+#define ECS_COMPONENT_LIST(X) \
+	X(DeathTimer, deathTimers, DEATH_TIMERS) \
+	X(Motion, motions, MOTIONS) \
+	X(CollisionFilter, collisionFilters, NONE) \
+	X(Player, players, PLAYERS) \
+	X(PlayerAnimation, animations, PLAYER_ANIMATIONS) \
+	X(RobotAnimation, robotAnimations, ROBOT_ANIMATIONS) \
+	X(BossRobotAnimation, bossRobotAnimations, BOSS_ROBOT_ANIMATIONS) \
+	X(IceRobotAnimation, iceRobotAnimations, ICE_ROBOT_ANIMATIONS) \
+	X(SpiderRobotAnimation, spiderRobotAnimations, SPIDER_ROBOT_ANIMATIONS) \
+	X(Door, doors, DOORS) \
+	X(DoorAnimation, doorAnimations, DOOR_ANIMATIONS) \
+	X(Mesh*, meshPtrs, NONE) \
+	X(RenderRequest, renderRequests, RENDER_REQUESTS) \
+	X(ScreenState, screenStates, SCREEN_STATES) \
+	X(Robot, robots, ROBOTS) \
+	X(BossRobot, bossRobots, BOSS_ROBOTS) \
+	X(SpiderRobot, spiderRobots, SPIDER_ROBOTS) \
+	X(Tile, tiles, NONE) \
+	X(TileSetComponent, tilesets, NONE) \
+	X(Key, keys, KEYS) \
+	X(ArmorPlate, armorplates, ARMORPLATES) \
+	X(Potion, potions, POTIONS) \
+	X(Boid, boids, BOIDS) \
+	X(Radiation, radiations, RADIATIONS) \
+	X(DebugComponent, debugComponents, DEBUG_COMPONENTS) \
+	X(vec3, colors, COLORS) \
+	X(Notification, notifications, NOTIFICATIONS) \
+	X(T_map, maps, NONE) \
+	X(attackBox, attackbox, ATTACK_BOXES) \
+	X(Spaceship, spaceships, SPACESHIPS)
+
 class ECSRegistry
 {
-	// Callbacks to remove a particular or all entities in the system
-	std::vector<ContainerInterface*> registry_list;
+	// One mask per entity id, bit i set when the entity has a component in container i
+	std::vector<ComponentMask> component_masks;
 
 public:
-	// Manually created list of all components this game has
-	// TODO: A1 add a LightUp component
-	ComponentContainer<DeathTimer> deathTimers;
-	ComponentContainer<Motion> motions;
-	ComponentContainer<Collision> collisions;
-	ComponentContainer<Player> players;
-	ComponentContainer<PlayerAnimation> animations;
-	ComponentContainer<RobotAnimation> robotAnimations;
-	ComponentContainer<BossRobotAnimation> bossRobotAnimations;
-	ComponentContainer<Door> doors;
-	ComponentContainer<DoorAnimation> doorAnimations;
-	ComponentContainer<Mesh*> meshPtrs; 
-	ComponentContainer<RenderRequest> renderRequests;
-	ComponentContainer<ScreenState> screenStates;
-	ComponentContainer<Robot> robots;
-	ComponentContainer<BossRobot> bossRobots;
-	ComponentContainer<Tile> tiles;
-	ComponentContainer<TileSetComponent> tilesets;
-	ComponentContainer<Key> keys;
-	ComponentContainer<ArmorPlate> armorplates;
-	ComponentContainer<Potion> potions;
-	ComponentContainer<Particle> particles;
-	ComponentContainer<Boid> boids;
-	ComponentContainer<Radiation> radiations;
-	ComponentContainer<DebugComponent> debugComponents;
-	ComponentContainer<vec3> colors;
-	ComponentContainer<Notification> notifications;
-	ComponentContainer<T_map> maps;
-
-	ComponentContainer<attackBox> attackbox;
+#define ECS_DECLARE_CONTAINER(type, name, block) ComponentContainer<type> name;
+	ECS_COMPONENT_LIST(ECS_DECLARE_CONTAINER)
+#undef ECS_DECLARE_CONTAINER
 
-	ComponentContainer<Spaceship> spaceships;
-	ComponentContainer<projectile> projectile;
-	ComponentContainer<bossProjectile> bossProjectile;
-
-	ComponentContainer<IceRobotAnimation> iceRobotAnimations;
-	ComponentContainer<SpiderRobotAnimation> spiderRobotAnimations;
-	ComponentContainer<SpiderRobot> spiderRobots;
-	// constructor that adds all containers for looping over them
-	// IMPORTANT: Don't forget to add any newly added containers!
 	ECSRegistry()
 	{
-		registry_list.push_back(&deathTimers);
-		registry_list.push_back(&motions);
-		registry_list.push_back(&collisions);
-		registry_list.push_back(&players);
-		registry_list.push_back(&animations);
-		registry_list.push_back(&robotAnimations);
-		registry_list.push_back(&bossRobotAnimations);
-		registry_list.push_back(&doors);
-		registry_list.push_back(&doorAnimations);
-		registry_list.push_back(&meshPtrs);
-		registry_list.push_back(&renderRequests);
-		registry_list.push_back(&screenStates);
-		registry_list.push_back(&robots);
-		registry_list.push_back(&bossRobots);
-		registry_list.push_back(&tiles);
-		registry_list.push_back(&debugComponents);
-		registry_list.push_back(&colors);
-		registry_list.push_back(&maps);
-		registry_list.push_back(&keys);
-		registry_list.push_back(&potions);
-		registry_list.push_back(&particles);
-		registry_list.push_back(&boids);
+		ComponentMask bit = 1;
+		for_each_container([&](auto& container) {
+			container.entity_masks = &component_masks;
+			container.mask_bit = bit;
+			bit <<= 1;
+		});
+		assert(bit != 0 && "More containers than bits in ComponentMask");
+	}
 
-		registry_list.push_back(&attackbox);
+	// The containers point into this registry's mask table
+	ECSRegistry(const ECSRegistry&) = delete;
+	ECSRegistry& operator=(const ECSRegistry&) = delete;
 
-		registry_list.push_back(&armorplates);
+	// Calls f(container) for every container, expanded at compile time
+	template <typename F>
+	void for_each_container(F&& f) {
+#define ECS_VISIT_CONTAINER(type, name, block) f(name);
+		ECS_COMPONENT_LIST(ECS_VISIT_CONTAINER)
+#undef ECS_VISIT_CONTAINER
+	}
 
-		registry_list.push_back(&spaceships);
+	ComponentMask mask_of(Entity e) const {
+		return e.id < component_masks.size() ? component_masks[e.id] : 0;
+	}
 
-		registry_list.push_back(&projectile);
+	// Recomputes the masks after containers were filled without insert(), e.g. from a save
+	void rebuild_component_masks() {
+		component_masks.clear();
+		for_each_container([&](auto& container) {
+			for (Entity e : container.entities)
+				container.set_mask(e.id);
+		});
+	}
 
-		registry_list.push_back(&bossProjectile);
-		
-		registry_list.push_back(&iceRobotAnimations);
-		registry_list.push_back(&spiderRobots);
+	// Replaces every container's contents with other's, other gets the old ones
+	void take_contents(ECSRegistry& other) {
+#define ECS_TAKE_CONTAINER(type, name, block) name.take_contents(other.name);
+		ECS_COMPONENT_LIST(ECS_TAKE_CONTAINER)
+#undef ECS_TAKE_CONTAINER
+		rebuild_component_masks();
+		other.rebuild_component_masks();
 	}
 
 	void clear_all_components() {
-		for (ContainerInterface* reg : registry_list)
-			reg->clear();
+		for_each_container([](auto& container) { container.clear(); });
+		component_masks.clear();
 	}
 
 	void list_all_components() {
 		printf("Debug info on all registry entries:\n");
-		for (ContainerInterface* reg : registry_list)
-			if (reg->size() > 0)
-				printf("%4d components of type %s\n", (int)reg->size(), typeid(*reg).name());
+		for_each_container([](auto& container) {
+			if (container.size() > 0)
+				printf("%4d components of type %s\n", (int)container.size(), typeid(container).name());
+		});
 	}
 
 	void list_all_components_of(Entity e) {
 		printf("Debug info on components of entity %u:\n", (unsigned int)e);
-		for (ContainerInterface* reg : registry_list)
-			if (reg->has(e))
-				printf("type %s\n", typeid(*reg).name());
+		ComponentMask mask = mask_of(e);
+		for_each_container([&](auto& container) {
+			if (mask & container.mask_bit)
+				printf("type %s\n", typeid(container).name());
+		});
 	}
 
+	// Only the containers in the entity's mask are touched
 	void remove_all_components_of(Entity e) {
-		for (ContainerInterface* reg : registry_list)
-			reg->remove(e);
+		ComponentMask mask = mask_of(e);
+		if (mask == 0)
+			return;
+		for_each_container([&](auto& container) {
+			if (mask & container.mask_bit)
+				container.remove(e);
+		});
 	}
 };
 
-extern ECSRegistry registry;
\ No newline at end of file
+extern ECSRegistry registry;
@@ -0,0 +1,29 @@
+#include "ui_draw_list.hpp"
+
+void UiDrawList::clear() {
+	vertices.clear();
+	commands.clear();
+	changed = true;
+}
+
+void UiDrawList::quad(vec2 position, vec2 size, GLuint texture, vec2 uv_top_left, vec2 uv_bottom_right, vec4 color) {
+	if (commands.empty() || commands.back().texture != texture)
+		commands.push_back({ texture, (uint32_t)vertices.size(), 0 });
+	commands.back().count += 6;
+
+	vec2 bottom_right = position + size;
+	UiVertex top_left_vertex = { position, uv_top_left, color };
+	UiVertex top_right_vertex = { vec2(bottom_right.x, position.y), vec2(uv_bottom_right.x, uv_top_left.y), color };
+	UiVertex bottom_right_vertex = { bottom_right, uv_bottom_right, color };
+	UiVertex bottom_left_vertex = { vec2(position.x, bottom_right.y), vec2(uv_top_left.x, uv_bottom_right.y), color };
+	vertices.push_back(top_left_vertex);
+	vertices.push_back(top_right_vertex);
+	vertices.push_back(bottom_right_vertex);
+	vertices.push_back(top_left_vertex);
+	vertices.push_back(bottom_right_vertex);
+	vertices.push_back(bottom_left_vertex);
+}
+
+void UiDrawList::rect(vec2 position, vec2 size, vec3 color) {
+	quad(position, size, white_texture, { 0.f, 0.f }, { 1.f, 1.f }, vec4(color, 1.f));
+}
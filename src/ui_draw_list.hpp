@@ -0,0 +1,73 @@
+#pragma once
+
+// stlib
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+// internal
+#include "common.hpp"
+#include <glm/vec4.hpp>
+
+// Vertex of the UI shader, in window pixels with y going down
+struct UiVertex {
+	vec2 position;
+	vec2 texcoord;
+	vec4 color;
+};
+
+// A run of vertices sharing a texture, drawn with one call
+struct UiDrawCommand {
+	GLuint texture;
+	uint32_t first;
+	uint32_t count;
+};
+
+// What a UI list was built from, packed into bytes so a frame's values compare with
+// the last build's in one go. Add fields one by one, padding inside a struct would
+// make equal values compare different.
+class UiKey
+{
+public:
+	void clear() { bytes.clear(); }
+
+	template <typename T>
+	void add(const T& value) {
+		static_assert(std::is_trivially_copyable<T>::value, "add() only takes plain data");
+		const unsigned char* p = reinterpret_cast<const unsigned char*>(&value);
+		bytes.insert(bytes.end(), p, p + sizeof(T));
+	}
+
+	void add(const std::string& text) {
+		add((uint32_t)text.size());
+		bytes.insert(bytes.end(), text.begin(), text.end());
+	}
+
+	bool operator==(const UiKey& other) const { return bytes == other.bytes; }
+	bool operator!=(const UiKey& other) const { return bytes != other.bytes; }
+
+	std::vector<unsigned char> bytes;
+};
+
+// Retained UI geometry. The widgets append their quads when what they show changes and
+// the render system draws the list every frame, uploading it only after a rebuild, with
+// one draw call per run of quads sharing a texture. Flat quads sample white_texture so
+// they join the runs around them.
+class UiDrawList
+{
+public:
+	void clear();
+
+	// uv_top_left and uv_bottom_right are the texture coordinates at those corners
+	void quad(vec2 position, vec2 size, GLuint texture, vec2 uv_top_left = { 0.f, 0.f }, vec2 uv_bottom_right = { 1.f, 1.f }, vec4 color = vec4(1.f));
+	void rect(vec2 position, vec2 size, vec3 color);
+
+	std::vector<UiVertex> vertices;
+	std::vector<UiDrawCommand> commands;
+	// 1x1 white, owned by the render system
+	GLuint white_texture = 0;
+	// set by clear(), the render system uploads the vertices and resets it
+	bool changed = false;
+};
@@ -0,0 +1,152 @@
+#include "world_chunks.hpp"
+#include "snapshot.hpp"
+#include "tiny_ecs_registry.hpp"
+#include "debug_draw.hpp"
+
+// stlib
+#include <cstdlib>
+
+void WorldChunks::build(const LevelData& level, const std::vector<PreparedTile>& tiles) {
+	clear();
+	chunk_px = (float)(level.tile_size * CHUNK_TILES);
+	chunks_x = (level.base.width + CHUNK_TILES - 1) / CHUNK_TILES;
+	chunks_y = (level.base.height + CHUNK_TILES - 1) / CHUNK_TILES;
+	chunks.resize((size_t)chunks_x * chunks_y);
+	for (const PreparedTile& tile : tiles)
+		chunks[chunk_index(tile.motion.position)].tiles.push_back(tile);
+}
+
+void WorldChunks::clear() {
+	// the caller removes the tile entities, after a snapshot load their ids may belong to something else
+	chunks.clear();
+	chunks_x = chunks_y = 0;
+	center_chunk = -1;
+}
+
+int WorldChunks::chunk_index(vec2 position) const {
+	int x = (int)floor(position.x / chunk_px);
+	int y = (int)floor(position.y / chunk_px);
+	x = max(0, min(x, chunks_x - 1));
+	y = max(0, min(y, chunks_y - 1));
+	return y * chunks_x + x;
+}
+
+void WorldChunks::update(vec2 center, bool force) {
+	if (chunks.empty())
+		return;
+	int index = chunk_index(center);
+	if (index == center_chunk && !force)
+		return;
+	center_chunk = index;
+
+	int cx = index % chunks_x;
+	int cy = index / chunks_x;
+	for (int y = 0; y < chunks_y; y++) {
+		for (int x = 0; x < chunks_x; x++) {
+			WorldChunk& chunk = chunks[y * chunks_x + x];
+			bool in_range = abs(x - cx) <= CHUNK_ACTIVE_RADIUS && abs(y - cy) <= CHUNK_ACTIVE_RADIUS;
+			if (in_range && !chunk.active)
+				activate(chunk);
+			else if (!in_range && chunk.active)
+				deactivate(chunk);
+		}
+	}
+
+	// also catches robots that wandered out of the active area since the last update.
+	// Everything that moves on its own goes, inactive chunks have no walls to stop it.
+	park_outside_active(registry.robots);
+	park_outside_active(registry.spiderRobots);
+	park_outside_active(registry.bossRobots);
+	park_outside_active(registry.boids);
+}
+
+void WorldChunks::draw_debug() const {
+	if (!debug_draw.enabled(DEBUG_CATEGORY::CHUNKS))
+		return;
+	for (int y = 0; y < chunks_y; y++) {
+		for (int x = 0; x < chunks_x; x++) {
+			if (!chunks[y * chunks_x + x].active)
+				continue;
+			vec2 center = (vec2((float)x, (float)y) + 0.5f) * chunk_px;
+			debug_draw.rect(DEBUG_CATEGORY::CHUNKS, center, vec2(chunk_px), vec3(0.3f, 0.5f, 1.f));
+		}
+	}
+}
+
+void WorldChunks::activate(WorldChunk& chunk) {
+	chunk.tile_entities.reserve(chunk.tiles.size());
+	for (const PreparedTile& prepared : chunk.tiles) {
+		Entity tile_entity = Entity();
+		registry.motions.insert(tile_entity, prepared.motion);
+		registry.tiles.insert(tile_entity, prepared.tile);
+		registry.renderRequests.insert(
+			tile_entity,
+			{ TEXTURE_ASSET_ID::TILE_ATLAS, EFFECT_ASSET_ID::TEXTURED, GEOMETRY_BUFFER_ID::SPRITE }
+		);
+		chunk.tile_entities.push_back(tile_entity);
+	}
+
+	// robots come back under their old id, so references to them stay valid
+	for (const DormantEntity& dormant : chunk.dormant) {
+		Entity e;
+		e.id = dormant.id;
+		SnapshotReader r(dormant.data.data(), dormant.data.size());
+		if (!read_entity(r, registry, e))
+			printf("Dormant entity %u failed to restore\n", dormant.id);
+		if (dormant.mesh)
+			registry.meshPtrs.emplace(e, dormant.mesh);
+	}
+	chunk.dormant.clear();
+	chunk.active = true;
+}
+
+void WorldChunks::deactivate(WorldChunk& chunk) {
+	for (Entity e : chunk.tile_entities)
+		registry.remove_all_components_of(e);
+	chunk.tile_entities.clear();
+	chunk.active = false;
+}
+
+template <typename Component>
+void WorldChunks::park_outside_active(ComponentContainer<Component>& container) {
+	std::vector<Entity> to_park;
+	for (Entity e : container.entities) {
+		auto motion = registry.motions.map_entity_componentID.find(e.id);
+		if (motion == registry.motions.map_entity_componentID.end())
+			continue;
+		// companions follow the player around
+		auto robot = registry.robots.map_entity_componentID.find(e.id);
+		if (robot != registry.robots.map_entity_componentID.end() && registry.robots.components[robot->second].companion)
+			continue;
+		if (!chunks[chunk_index(registry.motions.components[motion->second].position)].active)
+			to_park.push_back(e);
+	}
+
+	for (Entity e : to_park) {
+		DormantEntity dormant;
+		dormant.id = e.id;
+		if (registry.meshPtrs.has(e))
+			dormant.mesh = registry.meshPtrs.components[registry.meshPtrs.map_entity_componentID[e]];
+		SnapshotWriter w;
+		write_entity(w, registry, e);
+		dormant.data = std::move(w.buffer);
+		chunks[chunk_index(registry.motions.components[registry.motions.map_entity_componentID[e]].position)].dormant.push_back(std::move(dormant));
+		registry.remove_all_components_of(e);
+	}
+}
+
+size_t WorldChunks::dormant_count() const {
+	size_t count = 0;
+	for (const WorldChunk& chunk : chunks)
+		count += chunk.dormant.size();
+	return count;
+}
+
+void WorldChunks::write_dormant(SnapshotWriter& w) const {
+	for (const WorldChunk& chunk : chunks) {
+		for (const DormantEntity& dormant : chunk.dormant) {
+			w.write(dormant.id);
+			w.write_bytes(dormant.data.data(), dormant.data.size());
+		}
+	}
+}
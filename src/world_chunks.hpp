@@ -0,0 +1,68 @@
+#pragma once
+
+// stlib
+#include <vector>
+
+// internal
+#include "common.hpp"
+#include "level_preloader.hpp"
+
+class SnapshotWriter;
+
+// Chunks are square blocks of tiles
+const int CHUNK_TILES = 16;
+// Chunks within this many chunks of the player are live, 5x5 chunks covers the screen with margin
+const int CHUNK_ACTIVE_RADIUS = 2;
+
+// A robot taken out of the registry while its chunk is inactive, in write_entity format
+struct DormantEntity {
+	unsigned int id = 0;
+	Mesh* mesh = nullptr;
+	std::vector<char> data;
+};
+
+struct WorldChunk {
+	// static geometry, turned into tile entities while the chunk is active
+	std::vector<PreparedTile> tiles;
+	std::vector<Entity> tile_entities;
+	std::vector<DormantEntity> dormant;
+	bool active = false;
+};
+
+// Splits a level into fixed-size chunks and keeps only those around the player live.
+// Inactive chunks have no tile entities, so collision, rendering and AI only pay for
+// the active area. Robots, the boss and bats in them are parked as DormantEntity and put
+// back with their entity id when the player comes close again.
+class WorldChunks
+{
+public:
+	// Buckets the level's tiles into chunks, nothing is live until update().
+	// level gives the map size, tiles are the prepared tiles of that level.
+	void build(const LevelData& level, const std::vector<PreparedTile>& tiles);
+
+	// Forgets the chunks and their dormant robots, the level is being replaced
+	void clear();
+
+	// Activates the chunks around center and parks robots outside of them.
+	// Does nothing while center stays in the same chunk, unless force is set.
+	void update(vec2 center, bool force = false);
+
+	// Outlines the active chunks in debug mode
+	void draw_debug() const;
+
+	size_t dormant_count() const;
+	void write_dormant(SnapshotWriter& w) const;
+
+private:
+	void activate(WorldChunk& chunk);
+	void deactivate(WorldChunk& chunk);
+	int chunk_index(vec2 position) const;
+	template <typename Component>
+	void park_outside_active(ComponentContainer<Component>& container);
+
+	int chunks_x = 0;
+	int chunks_y = 0;
+	float chunk_px = 0.f;
+	int center_chunk = -1;
+	std::vector<WorldChunk> chunks;
+};
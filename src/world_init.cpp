@@ -20,7 +20,7 @@ Entity createPlayer(RenderSystem* renderer, vec2 pos)
 	Inventory& inventory = player.inventory;
 
 	auto& animation = registry.animations.emplace(entity);
-	animation = PlayerAnimation(64, 448, 1792);
+	animation = PlayerAnimation();
 
 	motion.bb = vec2(64, 64);
 	registry.renderRequests.insert(
@@ -59,7 +59,7 @@ Entity createCompanionRobot(RenderSystem* renderer, vec2 position, const Item& c
 	robot.companion = true;
 
 	auto& robotAnimation = registry.robotAnimations.emplace(entity);
-	robotAnimation = RobotAnimation(64, 640, 1280);
+	robotAnimation = RobotAnimation();
 	robotAnimation.setState(RobotState::IDLE, Direction::LEFT);
 
 	registry.renderRequests.insert(
@@ -99,7 +99,7 @@ Entity createCompanionIceRobot(RenderSystem* renderer, vec2 position, const Item
 	r.ice_proj = true;
 	r.companion = true;
 	auto& robotAnimation = registry.iceRobotAnimations.emplace(entity);
-	robotAnimation = IceRobotAnimation(64, 832, 1024);
+	robotAnimation = IceRobotAnimation();
 	robotAnimation.setState(IceRobotState::IDLE, Direction::LEFT);
 	registry.renderRequests.insert(
 		entity,
@@ -137,7 +137,7 @@ Entity createRobot(RenderSystem* renderer, vec2 position)
 	r.panic_box = { 0 * 64.f,0 * 64.f };
 
 	auto& robotAnimation = registry.robotAnimations.emplace(entity);
-	robotAnimation = RobotAnimation(64, 640, 1280);
+	robotAnimation = RobotAnimation();
 	robotAnimation.setState(RobotState::IDLE, Direction::LEFT);
 	registry.renderRequests.insert(
 		entity,
@@ -177,7 +177,7 @@ Entity createBossRobot(RenderSystem* renderer, vec2 position)
 	r.panic_box = { 4 * 64.f,4 * 64.f };
 
 	auto& bossRobotAnimation = registry.bossRobotAnimations.emplace(entity);
-	bossRobotAnimation = BossRobotAnimation(128, 1792, 384);
+	bossRobotAnimation = BossRobotAnimation();
 	bossRobotAnimation.setState(BossRobotState::IDLE, Direction::LEFT);
 	registry.renderRequests.insert(
 		entity,
@@ -215,7 +215,7 @@ Entity createSpiderRobot(RenderSystem* renderer, vec2 position)
 	r.panic_box = { 0 * 64.f,0 * 64.f };
 
 	auto& bossRobotAnimation = registry.spiderRobotAnimations.emplace(entity);
-	bossRobotAnimation = SpiderRobotAnimation(16, 64, 64);
+	bossRobotAnimation = SpiderRobotAnimation();
 	bossRobotAnimation.setState(SpiderRobotState::IDLE, Direction::LEFT);
 	registry.renderRequests.insert(
 		entity,
@@ -253,7 +253,7 @@ Entity createIceRobot(RenderSystem* renderer, vec2 position)
 	r.panic_box = { 0 * 64.f,0 * 64.f };
 	r.ice_proj = true;
 	auto& robotAnimation = registry.iceRobotAnimations.emplace(entity);
-	robotAnimation = IceRobotAnimation(64, 832, 1024);
+	robotAnimation = IceRobotAnimation();
 	robotAnimation.setState(IceRobotState::IDLE, Direction::LEFT);
 	registry.renderRequests.insert(
 		entity,
@@ -428,9 +428,12 @@ Entity createLine(vec2 position, vec2 scale)
 	return entity;
 }
 
-Entity createTile_map(std::vector<std::vector<int>> tile_map, int tile_size) {
+Entity createTile_map(const LevelGrid& obstacles, int tile_size) {
 	T_map t;
-	t.tile_map = tile_map;
+	t.tile_map.assign(obstacles.height, std::vector<int>(obstacles.width));
+	for (int y = 0; y < obstacles.height; y++)
+		for (int x = 0; x < obstacles.width; x++)
+			t.tile_map[y][x] = obstacles.at(x, y);
 	t.tile_size = tile_size;
 	Entity T_ent = Entity();
 	registry.maps.insert(T_ent, t);
@@ -461,101 +464,17 @@ Entity createNotification(const std::string& text, float duration, vec2 position
 
 
 
-Entity createProjectile(vec2 position,vec2 speed,float angle,bool ice, bool player_projectile) {
-	auto entity = Entity();
-
-
-	Motion& motion = registry.motions.emplace(entity);
-	motion.position = position;
-	motion.angle = angle;
-	motion.velocity = speed;
-	motion.target_velocity = speed;
-	// need to find the BB of the key
-	motion.scale = vec2({ 127, 123 });
-	//motion.scale.y *= -1; // point front to the right
-
-	// create an empty component for the projectile
-	projectile& temp = registry.projectile.emplace(entity);
-	if (player_projectile) {
-		temp.dmg = ice ? 5 : 10;
-		temp.friendly = true; 
-	}
-	else {
-		temp.dmg = ice ? 5 : 10; 
-		temp.friendly = false;
-	}
-	temp.ice = ice;
-	motion.bb = {32.f,32.f};
-
-
-	if (player_projectile) {
-		if (ice) {
-			registry.renderRequests.insert(
-				entity,
-				{ TEXTURE_ASSET_ID::ICE_PROJ,
-				  EFFECT_ASSET_ID::TEXTURED,
-				  GEOMETRY_BUFFER_ID::SPRITE });
-		}
-		else {
-			registry.renderRequests.insert(
-				entity,
-				{ TEXTURE_ASSET_ID::PROJECTILE,
-				  EFFECT_ASSET_ID::TEXTURED,
-				  GEOMETRY_BUFFER_ID::SPRITE });
-		}
-	}
-	else {
-		if (ice) {
-			registry.renderRequests.insert(
-				entity,
-				{ TEXTURE_ASSET_ID::ICE_PROJ,
-				  EFFECT_ASSET_ID::TEXTURED,
-				  GEOMETRY_BUFFER_ID::SPRITE });
-		}
-		else {
-			registry.renderRequests.insert(
-				entity,
-				{ TEXTURE_ASSET_ID::PROJECTILE,
-				  EFFECT_ASSET_ID::TEXTURED,
-				  GEOMETRY_BUFFER_ID::SPRITE });
-		}
-	}
-
-
-	return entity;
+ProjectileHandle createProjectile(vec2 position,vec2 speed,float angle,bool ice, bool player_projectile) {
+	uint8_t flags = 0;
+	if (ice)
+		flags |= PROJECTILE_ICE;
+	if (player_projectile)
+		flags |= PROJECTILE_FRIENDLY;
+	return projectiles.spawn(position, speed, angle, ice ? 5 : 10, flags);
 }
 
-Entity createBossProjectile(vec2 position,vec2 speed,float angle,int dmg) {
-	auto entity = Entity();
-
-
-	Motion& motion = registry.motions.emplace(entity);
-	motion.position = position;
-	motion.angle = angle;
-	motion.velocity = speed;
-	motion.target_velocity = speed;
-	// need to find the BB of the key
-	motion.scale = vec2({ 127, 123 });
-	//motion.scale.y *= -1; // point front to the right
-
-	// create an empty component for the key
-	bossProjectile& temp = registry.bossProjectile.emplace(entity);
-	temp.dmg = dmg;
-	temp.amplitude = 2.5f;
-	temp.frequency = 4.0f;
-	temp.time = 0.0f;
-
-	motion.bb = {32.f,32.f};
-
-
-
-	registry.renderRequests.insert(
-		entity,
-		{ TEXTURE_ASSET_ID::PROJECTILE,
-		  EFFECT_ASSET_ID::TEXTURED,
-		  GEOMETRY_BUFFER_ID::SPRITE });
-
-	return entity;
+ProjectileHandle createBossProjectile(vec2 position,vec2 speed,float angle,int dmg) {
+	return projectiles.spawn(position, speed, angle, dmg, PROJECTILE_BOSS);
 }
 
 
@@ -618,35 +537,6 @@ Entity createBottomDoor(RenderSystem* renderer, vec2 position) {
 }
 
 
-Entity createSmokeParticle(RenderSystem* renderer, vec2 position)
-{
-	auto entity = Entity();
-	Motion& motion = registry.motions.emplace(entity);
-	motion.position = position;
-
-	float base_size = 20.0f + static_cast<float>(rand()) / RAND_MAX * 15.0f;
-	motion.scale = vec2(base_size);
-
-	float random_x = -30.0f + static_cast<float>(rand()) / RAND_MAX * 60.0f;
-	float random_y = -15.0f + static_cast<float>(rand()) / RAND_MAX * 10.0f;
-	motion.velocity = { random_x, random_y };
-	motion.bb = motion.scale;
-
-	Particle& particle = registry.particles.emplace(entity);
-	particle.lifetime = 0.f;
-	particle.max_lifetime = 2.0f + static_cast<float>(rand()) / RAND_MAX * 1.0f;
-	particle.opacity = 0.3f + static_cast<float>(rand()) / RAND_MAX * 0.2f;
-	particle.size = motion.scale.x;
-
-	registry.renderRequests.insert(
-		entity,
-		{ TEXTURE_ASSET_ID::SMOKE,
-		  EFFECT_ASSET_ID::TEXTURED,
-		  GEOMETRY_BUFFER_ID::SPRITE });
-
-	return entity;
-}
-
 Entity createBat(RenderSystem* renderer, vec2 position) {
 	auto entity = Entity();
 
@@ -682,4 +572,37 @@ Entity createBat(RenderSystem* renderer, vec2 position) {
 		  GEOMETRY_BUFFER_ID::SPRITE });
 
 	return entity;
-}
\ No newline at end of file
+}
+
+CollisionFilter collision_filter_for(Entity entity) {
+	// what each layer has contact handling with, see WorldSystem::handle_contact
+	// projectiles are not entities, ProjectileSystem tests them against these masks
+	const uint32_t PROJECTILES = LAYER_PROJECTILE_FRIENDLY | LAYER_PROJECTILE_HOSTILE;
+	CollisionFilter filter;
+	if (registry.players.has(entity)) {
+		filter.layer = LAYER_PLAYER;
+		filter.mask = LAYER_ENEMY | LAYER_COMPANION | LAYER_PROJECTILE_HOSTILE | LAYER_PICKUP | LAYER_DOOR;
+	}
+	else if (registry.robots.has(entity) && registry.robots.peek(entity).companion) {
+		filter.layer = LAYER_COMPANION;
+		filter.mask = LAYER_PLAYER | LAYER_PROJECTILE_HOSTILE | LAYER_DOOR;
+	}
+	else if (registry.robots.has(entity) || registry.bossRobots.has(entity) || registry.spiderRobots.has(entity) || registry.boids.has(entity)) {
+		filter.layer = LAYER_ENEMY;
+		filter.mask = LAYER_PLAYER | PROJECTILES | LAYER_DOOR;
+	}
+	else if (registry.keys.has(entity) || registry.armorplates.has(entity) || registry.potions.has(entity)) {
+		filter.layer = LAYER_PICKUP;
+		filter.mask = LAYER_PLAYER;
+	}
+	else if (registry.doors.has(entity)) {
+		// doors stop whatever walks or flies into them
+		filter.layer = LAYER_DOOR;
+		filter.mask = LAYER_PLAYER | LAYER_ENEMY | LAYER_COMPANION | PROJECTILES;
+	}
+	else if (registry.tiles.has(entity) || registry.spaceships.has(entity)) {
+		// walls and the spaceship have their own passes in the physics step
+		filter.layer = LAYER_STATIC;
+	}
+	return filter;
+}
@@ -4,6 +4,8 @@
 #include "tiny_ecs.hpp"
 #include "render_system.hpp"
 #include "tileset.hpp"
+#include "level_data.hpp"
+#include "projectile_system.hpp"
 // These are hardcoded to the dimensions of the entity texture
 // BB = bounding box
 const float ROBOT_BB_WIDTH   = 0.5f * 300.f;	// 1001
@@ -41,23 +43,26 @@ Entity createCompanionIceRobot(RenderSystem* renderer, vec2 position, const Item
 Entity createLine(vec2 position, vec2 size);
 
 // For the DFS search
-Entity createTile_map(std::vector<std::vector<int>> tile_map, int tile_size);
+Entity createTile_map(const LevelGrid& obstacles, int tile_size);
 
 Entity createSpaceship(RenderSystem* renderer, vec2 pos);
 
 attackBox initAB(vec2 pos, vec2 size, int dmg, bool friendly);
 
-Entity createProjectile(vec2 position, vec2 speed, float angle,bool ice, bool player_projectile = false);
+ProjectileHandle createProjectile(vec2 position, vec2 speed, float angle,bool ice, bool player_projectile = false);
 
-Entity createBossProjectile(vec2 position, vec2 speed, float angle, int dmg);
+ProjectileHandle createBossProjectile(vec2 position, vec2 speed, float angle, int dmg);
 
 Entity createRightDoor(RenderSystem* renderer, vec2 position);
 
 Entity createBottomDoor(RenderSystem* renderer, vec2 position);
 
-Entity createSmokeParticle(RenderSystem* renderer, vec2 pos);
 
 Entity createNotification(const std::string& text, float duration, vec2 position = vec2(-1, 176), vec3 color = vec3(1.0f, 1.0f, 1.0f), float scale = 0.7f);
 Entity createSpiderRobot(RenderSystem* renderer, vec2 position);
 
-Entity createBat(RenderSystem* renderer, vec2 position);
\ No newline at end of file
+Entity createBat(RenderSystem* renderer, vec2 position);
+
+// The collision layer and mask that fit an entity's components. The physics step fills
+// in missing filters with it, so factories and save loading don't have to.
+CollisionFilter collision_filter_for(Entity entity);
\ No newline at end of file
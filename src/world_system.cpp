@@ -12,18 +12,50 @@
 #include <iostream>
 #include <unordered_set>
 #include "physics_system.hpp"
+#include "particle_system.hpp"
+#include "audio_system.hpp"
+#include "animation_system.hpp"
+#include "pathfinder.hpp"
 
 // Game configuration
 const size_t MAX_NUM_ROBOTS = 15; //15 originally
 const size_t MAX_NUM_BOSS_ROBOTS = 1;
 const size_t TOTAL_ROBOTS = 14;
+const int FINAL_LEVEL = 5;
 const size_t TOTAL_BOSS_ROBOTS = 1;
 const size_t ROBOT_SPAWN_DELAY_MS = 2000 * 3;
 const size_t BOSS_ROBOT_SPAWN_DELAY_MS = 2000 * 3;
 const size_t MAX_NUM_KEYS = 1;
 const size_t KEY_SPAWN_DELAY = 8000;
 constexpr float DOOR_INTERACTION_RANGE = 100.f;
-const size_t MAX_PARTICLES = 20;
+
+// Drifts up from behind the crashed spaceship
+static ParticleEmitterDef spaceship_smoke() {
+	ParticleEmitterDef def;
+	def.texture = TEXTURE_ASSET_ID::SMOKE;
+	def.interval_ms = 50.f;
+	def.burst_count = 3;
+	def.max_alive = 20;
+	def.offset_min = { -300.f, 50.f };
+	def.offset_max = { -220.f, 70.f };
+	def.velocity_min = { -30.f, -15.f };
+	def.velocity_max = { 30.f, -5.f };
+	def.size_min = 20.f;
+	def.size_max = 35.f;
+	def.lifetime_min = 2.f;
+	def.lifetime_max = 3.f;
+	def.opacity_min = 0.3f;
+	def.opacity_max = 0.5f;
+	def.rise = 2.f;
+	def.rise_growth = 2.f;
+	def.wiggle = 10.f;
+	def.wiggle_growth = 6.f;
+	def.wiggle_frequency = 0.8f;
+	def.drag = 0.999f;
+	def.size_growth = 2.f;
+	def.fade = 0.8f;
+	return def;
+}
 
 
 // create the world
@@ -38,40 +70,9 @@ WorldSystem::WorldSystem()
 }
 
 WorldSystem::~WorldSystem() {
+	preloader.stop();
 
-	// destroy music components
-	if (background_music != nullptr)
-		Mix_FreeMusic(background_music);
-	if (player_dead_sound != nullptr)
-		Mix_FreeChunk(player_dead_sound);
-	if (key_sound != nullptr)
-		Mix_FreeChunk(key_sound);
-	if (collision_sound != nullptr)
-		Mix_FreeChunk(collision_sound);
-	if (attack_sound != nullptr)
-		Mix_FreeChunk(attack_sound);
-	if (armor_break != nullptr)
-		Mix_FreeChunk(armor_break);
-	if (door_open != nullptr)
-		Mix_FreeChunk(door_open);
-	if (robot_attack != nullptr)
-		Mix_FreeChunk(robot_attack);
-	if (robot_ready_attack != nullptr)
-		Mix_FreeChunk(robot_ready_attack);
-	if (robot_death != nullptr)
-		Mix_FreeChunk(robot_death);
-	if (robot_awake != nullptr)
-		Mix_FreeChunk(robot_awake);
-	if (Upgrade != nullptr)
-		Mix_FreeChunk(Upgrade);
-	if (teleport_sound != nullptr)
-		Mix_FreeChunk(teleport_sound);
-	if (using_item != nullptr)
-		Mix_FreeChunk(using_item);
-	if (insert_card != nullptr)
-		Mix_FreeChunk(insert_card);
-
-	Mix_CloseAudio();
+	audio.stop();
 
 	// Destroy all created components
 	registry.clear_all_components();
@@ -132,55 +133,16 @@ GLFWwindow* WorldSystem::create_window() {
 	glfwSetCursorPosCallback(window, cursor_pos_redirect);
 
 	//////////////////////////////////////
-	// Loading music and sounds with SDL
-	if (SDL_Init(SDL_INIT_AUDIO) < 0) {
-		fprintf(stderr, "Failed to initialize SDL Audio");
-		return nullptr;
-	}
-	if (Mix_OpenAudio(44100, MIX_DEFAULT_FORMAT, 2, 2048) == -1) {
-		fprintf(stderr, "Failed to open audio device");
-		return nullptr;
+	// Loading music and sounds, they play on the audio system's thread.
+	// Without an audio device the game still runs, silently.
+	if (!audio.start(make_sdl_audio_backend())) {
+		fprintf(stderr, "No audio device, running without sound\n");
+		audio.start(std::unique_ptr<AudioBackend>(new NullAudioBackend()));
 	}
 
-	background_music = Mix_LoadMUS(audio_path("Galactic.wav").c_str());
-	player_dead_sound = Mix_LoadWAV(audio_path("death_hq.wav").c_str());
-	key_sound = Mix_LoadWAV(audio_path("win.wav").c_str());
-	collision_sound = Mix_LoadWAV(audio_path("wall_contact.wav").c_str());
-	attack_sound = Mix_LoadWAV(audio_path("attack_sound.wav").c_str());
-	armor_break = Mix_LoadWAV(audio_path("armor_break.wav").c_str());
-	door_open = Mix_LoadWAV(audio_path("door_open.wav").c_str());
-	robot_attack = Mix_LoadWAV(audio_path("robot_attack.wav").c_str());
-	robot_ready_attack = Mix_LoadWAV(audio_path("robot_ready_attack.wav").c_str());
-	robot_death = Mix_LoadWAV(audio_path("robot_death.wav").c_str());
-	robot_awake = Mix_LoadWAV(audio_path("robot_awake.wav").c_str());
-	Upgrade = Mix_LoadWAV(audio_path("Upgrade.wav").c_str());
-	teleport_sound = Mix_LoadWAV(audio_path("teleport_sound.wav").c_str());
-	using_item = Mix_LoadWAV(audio_path("using_item.wav").c_str());
-	insert_card = Mix_LoadWAV(audio_path("insert_card.wav").c_str());
-
-
-	if (background_music == nullptr || player_dead_sound == nullptr || key_sound == nullptr || collision_sound == nullptr || attack_sound == nullptr 
-		|| door_open == nullptr || robot_attack == nullptr || robot_ready_attack == nullptr || robot_death == nullptr || Upgrade == nullptr
-		|| robot_awake == nullptr || teleport_sound == nullptr || using_item == nullptr || insert_card == nullptr) {
-		fprintf(stderr, "Failed to load sounds\n %s\n %s\n %s\n make sure the data directory is present",
-			audio_path("Galactic.wav").c_str(),
-			audio_path("death_hq.wav").c_str(),
-			audio_path("win.wav").c_str(),
-			audio_path("wall_contact.wav").c_str(),
-			audio_path("attack_sound.wav").c_str(),
-			audio_path("armor_break.wav").c_str(),
-			audio_path("door_open.wav").c_str(),
-			audio_path("robot_attack.wav").c_str(),
-			audio_path("robot_ready_attack.wav").c_str(),
-			audio_path("robot_death.wav").c_str(),
-			audio_path("robot_awake.wav").c_str(),
-			audio_path("Upgrade.wav").c_str(),
-			audio_path("teleport_sound.wav").c_str(),
-			audio_path("using_item.wav").c_str(),
-			audio_path("insert_card.wav").c_str()
-		);
+	// Frame counts and timings of the character sprite sheets
+	if (!load_sprite_sheets(data_path() + "/animations.json"))
 		return nullptr;
-	}
 
 	return window;
 }
@@ -190,44 +152,14 @@ void WorldSystem::init(RenderSystem* renderer_arg) {
 	this->renderer->show_start_screen = show_start_screen;
 
 	// Playing background music indefinitely
-	Mix_PlayMusic(background_music, -1);
-	fprintf(stderr, "Loaded music\n");
+	audio.play_music();
 
+	preloader.start();
 
 	// Set all states to default
 	restart_game();
 }
 
-void WorldSystem::play_collision_sound() {
-	if (collision_sound) {
-		Mix_PlayChannel(-1, collision_sound, 0);
-	}
-}
-
-void WorldSystem::play_attack_sound() {
-	if (robot_attack) {
-		Mix_PlayChannel(-1, robot_attack, 0);
-	}
-}
-
-void WorldSystem::play_ready_attack_sound() {
-	if (robot_ready_attack) {
-		Mix_PlayChannel(-1, robot_ready_attack, 0);
-	}
-}
-
-void WorldSystem::play_death_sound() {
-	if (robot_death) {
-		Mix_PlayChannel(-1, robot_death, 0);
-	}
-}
-
-void WorldSystem::play_awake_sound() {
-	if (robot_awake) {
-		Mix_PlayChannel(-1, robot_awake, 0);
-	}
-}
-
 float lerp(float a, float b, float t) {
 	return a + t * (b - a);
 }
@@ -253,7 +185,7 @@ void WorldSystem::updateDoorAnimations(float elapsed_ms) {
 		if (animation.is_opening && !door.is_open) {
 			animation.update(elapsed_ms);
 			// add door_open sound
-			Mix_PlayChannel(-1, door_open, 0);
+			audio.play(SOUND_ID::DOOR_OPEN, registry.motions.peek(entity).position);
 
 			if (animation.current_frame == 5) {
 				door.is_open = true;
@@ -264,74 +196,28 @@ void WorldSystem::updateDoorAnimations(float elapsed_ms) {
 }
 
 void WorldSystem::updateParticles(float elapsed_ms) {
-	if (registry.particles.entities.size() >= MAX_PARTICLES) {
-		size_t to_remove = registry.particles.entities.size() - MAX_PARTICLES + 3;
-		for (size_t i = 0; i < to_remove; i++) {
-			if (!registry.particles.entities.empty()) {
-				registry.remove_all_components_of(registry.particles.entities[0]);
-			}
-		}
+	// the spaceship smokes for as long as it is in the level
+	if (registry.spaceships.entities.size() > 0) {
+		const Motion& spaceship_motion = registry.motions.peek(registry.spaceships.entities[0]);
+		if (smoke_emitter < 0)
+			smoke_emitter = particles.add_emitter(spaceship_smoke(), spaceship_motion.position);
+		else
+			particles.move_emitter(smoke_emitter, spaceship_motion.position);
 	}
-
-	for (unsigned int i = 0; i < registry.particles.entities.size(); i++) {
-		Entity entity = registry.particles.entities[i];
-		Motion& motion = registry.motions.get(entity);
-		Particle& particle = registry.particles.get(entity);
-
-		particle.lifetime += elapsed_ms / 1000.f;
-		if (particle.lifetime >= particle.max_lifetime) {
-			registry.remove_all_components_of(entity);
-			continue;
-		}
-
-		float life_ratio = particle.lifetime / particle.max_lifetime;
-
-		motion.velocity.y += (-2.0f - life_ratio * 2.0f) * (elapsed_ms / 1000.f);
-
-		float wiggle = sin(particle.lifetime * 0.8f) * (10.f + life_ratio * 6.f);
-		motion.velocity.x += wiggle * (elapsed_ms / 1000.f);
-
-		motion.velocity *= 0.999f;
-
-		motion.position += motion.velocity * (elapsed_ms / 1000.f);
-
-		float size_increase = 2.0f;
-		motion.scale = vec2(particle.size * (1.f + life_ratio * size_increase));
-
-		float opacity_curve = 1.0f - (life_ratio * life_ratio * 0.8f);
-		particle.opacity = std::max(0.0f, particle.opacity * opacity_curve);
+	else if (smoke_emitter >= 0) {
+		particles.remove_emitter(smoke_emitter);
+		smoke_emitter = -1;
 	}
-	static float spawn_timer = 0.f;
-	spawn_timer += elapsed_ms;
 
-	if (registry.spaceships.entities.size() > 0 && registry.particles.entities.size() < MAX_PARTICLES) {
-		Entity spaceship_entity = registry.spaceships.entities[0];
-		const Motion& spaceship_motion = registry.motions.get(spaceship_entity);
-
-		if (spawn_timer >= 50.0f) {
-			vec2 spawn_pos = spaceship_motion.position;
-			spawn_pos.y += 60.f;
-			spawn_pos.x -= 260.f;
-
-			// clamped spawning
-			size_t available_slots = MAX_PARTICLES - registry.particles.entities.size();
-			size_t particles_to_spawn = std::min(size_t(3), available_slots);
-
-			for (size_t i = 0; i < particles_to_spawn; i++) {
-				vec2 offset = {
-					static_cast<float>(rand() % 80 - 40),
-					static_cast<float>(rand() % 20 - 10)
-				};
-				createSmokeParticle(renderer, spawn_pos + offset);
-			}
-			spawn_timer = 0.f;
-		}
-	}
+	particles.update(elapsed_ms);
 }
 
 bool WorldSystem::hasNonCompanionRobots() {
+	// only robots get parked, and companions never are
+	if (chunks.dormant_count() > 0)
+		return true;
 	for (auto entity : registry.robots.entities) {
-		const Robot& robot = registry.robots.get(entity);
+		const Robot& robot = registry.robots.peek(entity);
 		if (!robot.companion) {
 			return true;
 		}
@@ -383,7 +269,7 @@ bool WorldSystem::playerNearPotion() {
 	return false;
 }
 bool WorldSystem::playerPickedUpArmor() {
-	return playerInventory && playerInventory->containsItem("ArmorPlate");
+	return playerInventory && playerInventory->containsItem(ItemId::ARMOR_PLATE);
 }
 
 bool WorldSystem::playerUsedArmor() {
@@ -542,7 +428,7 @@ void WorldSystem::updateTutorialState() {
 		//	if (playerHasAttacked()) {
 	
 			for (auto& slot : playerInventory->slots) {
-				if (slot.item.name == "Robot Parts") {
+				if (slot.item.id == ItemId::ROBOT_PARTS) {
 					robotPartsCount += slot.item.quantity;
 					if (robotPartsCount >= 5) {
 						tutorial_state = TutorialState::ROBOT_PARTS_HINT;
@@ -690,25 +576,7 @@ bool WorldSystem::step(float elapsed_ms_since_last_update) {
 	}
 	// Update item dragging
 	updateItemDragging();
-	for (auto entity : registry.animations.entities) {
-		auto& anim = registry.animations.get(entity);
-		anim.update(elapsed_ms_since_last_update);
-	}
-
-	for (auto entity : registry.robotAnimations.entities) {
-		auto& anim = registry.robotAnimations.get(entity);
-		anim.update(elapsed_ms_since_last_update);
-	}
-
-	for (auto entity : registry.iceRobotAnimations.entities) {
-		auto& anim = registry.iceRobotAnimations.get(entity);
-		anim.update(elapsed_ms_since_last_update);
-	}
-
-	for (auto entity : registry.bossRobotAnimations.entities) {
-		auto& anim = registry.bossRobotAnimations.get(entity);
-		anim.update(elapsed_ms_since_last_update);
-	}
+	update_sprite_animations(elapsed_ms_since_last_update);
 
 	if (registry.players.has(player)) {
 		Motion& player_motion = registry.motions.get(player);
@@ -785,7 +653,7 @@ bool WorldSystem::step(float elapsed_ms_since_last_update) {
 				registry.deathTimers.emplace(player);
 				PlayerAnimation& pa = registry.animations.get(player);
 				pa.setState(AnimationState::DEAD, pa.current_dir);
-				Mix_PlayChannel(-1, player_dead_sound, 0);
+				audio.play(SOUND_ID::PLAYER_DEAD);
 			}
 		}
 	}
@@ -805,6 +673,10 @@ bool WorldSystem::step(float elapsed_ms_since_last_update) {
 		}
 	}
 
+	if (registry.motions.has(player))
+		chunks.update(registry.motions.peek(player).position);
+	chunks.draw_debug();
+
 	ai_system.step(elapsed_ms_since_last_update);
 
 	
@@ -889,7 +761,7 @@ bool WorldSystem::step(float elapsed_ms_since_last_update) {
 		if (!registry.deathTimers.has(player)) {
 			registry.deathTimers.emplace(player);
 			pa.setState(AnimationState::DEAD, pa.current_dir);
-			Mix_PlayChannel(-1, player_dead_sound, 0);
+			audio.play(SOUND_ID::PLAYER_DEAD);
 		}
 	}*/
 
@@ -938,128 +810,22 @@ void WorldSystem::load_second_level(int map_width, int map_height) {
 	renderer->key_spawned = false;
 	total_robots_spawned = 0;
 
-	// Clear any previous tilesets
-	registry.tilesets.clear();  // Clear the tilesets
-	registry.tiles.clear();
-
-	// Load a new tileset (for the new scene)
-	auto new_tileset_entity = Entity();
-	TileSetComponent& new_tileset_component = registry.tilesets.emplace(new_tileset_entity);
-	new_tileset_component.tileset.initializeTileTextureMap(7, 52);  // Initialize with new tileset
-
-	// Load the new grass and obstacle maps for the new scene
-	std::vector<std::vector<int>> new_grass_map = new_tileset_component.tileset.initializeSecondLevelMap();
-	obstacle_map = new_tileset_component.tileset.initializeSecondLevelObstacleMap();
-
-
-	// Set tile size (assumed to be 64)
-	int tilesize = 64;
-
-	// Render the new grass layer
-	for (int y = 0; y < new_grass_map.size(); y++) {
-		for (int x = 0; x < new_grass_map[y].size(); x++) {
-			int tile_id = new_grass_map[y][x];
-			vec2 position = { x * tilesize - (tilesize / 2) + tilesize, y * tilesize - (tilesize / 2) + tilesize };
-			Entity tile_entity = createTileEntity(renderer, new_tileset_component.tileset, position, tilesize, tile_id);
-			Tile& tile = registry.tiles.get(tile_entity);
-			tile.walkable = true;  // Mark tiles as walkable
-			tile.atlas = TEXTURE_ASSET_ID::TILE_ATLAS_LEVELS;  // Set new atlas for this tile
-		}
-	}
-
-	// Render the new obstacle layer
-	for (int y = 0; y < obstacle_map.size(); y++) {
-		for (int x = 0; x < obstacle_map[y].size(); x++) {
-			int tile_id = obstacle_map[y][x];
-			if (tile_id != 0) {
-				vec2 position = { x * tilesize - (tilesize / 2) + tilesize, y * tilesize - (tilesize / 2) + tilesize };
-				Entity tile_entity = createTileEntity(renderer, new_tileset_component.tileset, position, tilesize, tile_id);
-				Tile& tile = registry.tiles.get(tile_entity);
-				tile.walkable = false;  // Mark as non-walkable
-				tile.atlas = TEXTURE_ASSET_ID::TILE_ATLAS_LEVELS;  // Use the new tile atlas
-			}
-		}
-	}
-
-	createTile_map(obstacle_map, tilesize);
-
-	float new_spawn_x = tilesize;
-	float new_spawn_y = tilesize * 2;
+	float new_spawn_x = level_data.player_x;
+	float new_spawn_y = level_data.player_y;
 	Motion& player_motion = registry.motions.get(player);
 	player_motion.position = { new_spawn_x, new_spawn_y };
 
-	createBottomDoor(renderer, { tilesize * 24, tilesize * 35 });
-
 	renderer->updateCameraPosition({ new_spawn_x, new_spawn_y });
 
-	const std::vector<std::pair<float, float>> ROBOT_SPAWN_POSITIONS = {
-	{64.f * 11, 64.f * 3},
-	{64.f * 4, 64.f * 16},
-	{64.f * 14, 64.f * 12},
-	{64.f * 16, 64.f * 18},
-	{64.f * 22, 64.f * 2},
-	{64.f * 28, 64.f * 2},
-	{64.f * 21, 64.f * 8},
-	{64.f * 8, 64.f * 23},
-	{64.f * 16, 64.f * 24},
-	{64.f * 24, 64.f * 18},
-	{64.f * 37, 64.f * 6},
-	{64.f * 29, 64.f * 24},
-	{64.f * 34, 64.f * 23},
-	{64.f * 28, 64.f * 8}
-	};
-
-	for (size_t i = 0; i < ROBOT_SPAWN_POSITIONS.size(); i++) {
+	for (const LevelEntry& spawn : level_data.spawns) {
+		if (spawn.kind != LevelEntityKind::ICE_ROBOT)
+			continue;
 		if (registry.robots.components.size() >= MAX_NUM_ROBOTS) {
 			break;
 		}
 
-
-
-		const auto& pos = ROBOT_SPAWN_POSITIONS[i];
-		Entity new_robot = createIceRobot(renderer, vec2(pos.first, pos.second));
-		Robot& robot = registry.robots.get(new_robot);
-
-		std::uniform_int_distribution<int> attack_dist(7, robot.max_attack);
-		std::uniform_int_distribution<int> speed_dist(90, robot.max_speed);
-
-		robot.attack = attack_dist(rng);
-		robot.speed = speed_dist(rng);
-
-		if (i == 1 || i == 8) {
-			robot.isCapturable = true;
-
-			std::vector<Item> potential_items = Inventory::disassembleItems;
-			std::shuffle(potential_items.begin(), potential_items.end(), rng);
-
-			size_t added_items = 0;
-			for (const Item& item : potential_items) {
-				if (added_items >= 2) break;
-
-				int min_drop = 1;
-				int max_drop = 1;
-
-				if (item.name == "Energy Core") {
-					min_drop = 1; max_drop = 1;
-				}
-				else if (item.name == "Robot Parts") {
-					min_drop = 1; max_drop = 3;
-				}
-				else if (item.name == "Teleporter") {
-					min_drop = 1; max_drop = 3;
-				}
-				else if (item.name == "Armor Plate") {
-					min_drop = 1; max_drop = 2;
-				}
-
-				int quantity = std::uniform_int_distribution<int>(min_drop, max_drop)(rng);
-
-				if (quantity > 0) {
-					robot.disassembleItems.emplace_back(item.name, quantity);
-					++added_items;
-				}
-			}
-		}
+		Entity new_robot = createIceRobot(renderer, vec2(spawn.x, spawn.y));
+		setup_spawned_robot(new_robot, (spawn.flags & LEVEL_ENTRY_CAPTURABLE) != 0);
 		total_robots_spawned++;
 	}
 
@@ -1071,9 +837,7 @@ void WorldSystem::load_second_level(int map_width, int map_height) {
 
 	createNotification("Press Spacebar to use your heavy attack", 3.0f);*/
 
-	createPotion(renderer, { tilesize * 36, tilesize * 3 });
-	createPotion(renderer, { tilesize * 24, tilesize * 8 });
-	createArmorPlate(renderer, { tilesize * 20, tilesize * 18 });
+	spawn_level_entities();
 }
 
 void WorldSystem::load_third_level(int map_width, int map_height) {
@@ -1089,67 +853,17 @@ void WorldSystem::load_third_level(int map_width, int map_height) {
 	renderer->key_spawned = false;
 	total_robots_spawned = 0;
 
-	// Clear any previous tilesets
-	registry.tilesets.clear();  // Clear the tilesets
-	registry.tiles.clear();
-
-	// Load a new tileset (for the new scene)
-	auto new_tileset_entity = Entity();
-	TileSetComponent& new_tileset_component = registry.tilesets.emplace(new_tileset_entity);
-	new_tileset_component.tileset.initializeTileTextureMap(7, 52);// Initialize with new tileset
-
-	// Load the new grass and obstacle maps for the new scene
-	std::vector<std::vector<int>> new_grass_map = new_tileset_component.tileset.initializeThirdLevelMap();
-	obstacle_map = new_tileset_component.tileset.initializeThirdLevelObstacleMap();
-
-
-	// Set tile size (assumed to be 64)
-	int tilesize = 64;
-
-	// Render the new grass layer
-	for (int y = 0; y < new_grass_map.size(); y++) {
-		for (int x = 0; x < new_grass_map[y].size(); x++) {
-			int tile_id = new_grass_map[y][x];
-			vec2 position = { x * tilesize - (tilesize / 2) + tilesize, y * tilesize - (tilesize / 2) + tilesize };
-			Entity tile_entity = createTileEntity(renderer, new_tileset_component.tileset, position, tilesize, tile_id);
-			Tile& tile = registry.tiles.get(tile_entity);
-			tile.walkable = true;  // Mark tiles as walkable
-			tile.atlas = TEXTURE_ASSET_ID::TILE_ATLAS_LEVELS;  // Set new atlas for this tile
-		}
-	}
-
-	// Render the new obstacle layer
-	for (int y = 0; y < obstacle_map.size(); y++) {
-		for (int x = 0; x < obstacle_map[y].size(); x++) {
-			int tile_id = obstacle_map[y][x];
-			if (tile_id != 0) {
-				vec2 position = { x * tilesize - (tilesize / 2) + tilesize, y * tilesize - (tilesize / 2) + tilesize };
-				Entity tile_entity = createTileEntity(renderer, new_tileset_component.tileset, position, tilesize, tile_id);
-				Tile& tile = registry.tiles.get(tile_entity);
-				tile.walkable = false;  // Mark as non-walkable
-				tile.atlas = TEXTURE_ASSET_ID::TILE_ATLAS_LEVELS;  // Use the new tile atlas
-			}
-		}
-	}
-
-	createTile_map(obstacle_map, tilesize);
-
-	float new_spawn_x = tilesize * 9;
-	float new_spawn_y = tilesize * 1;
+	float new_spawn_x = level_data.player_x;
+	float new_spawn_y = level_data.player_y;
 	Motion& player_motion = registry.motions.get(player);
 	player_motion.position = { new_spawn_x, new_spawn_y };
 
 
 	//renderer->updateCameraPosition({ new_spawn_x, new_spawn_y });
 
-	spawnBatSwarm(vec2(tilesize * 9, tilesize * 5), 15);
-
 	createNotification("The boss fight is in the next room!", 3.0f);
 
-	createPotion(renderer, { tilesize * 6, tilesize * 8 });
-
-	createArmorPlate(renderer, { tilesize * 12, tilesize * 8 });
-
+	spawn_level_entities();
 }
 
 void WorldSystem::load_boss_level(int map_width, int map_height) {
@@ -1160,58 +874,13 @@ void WorldSystem::load_boss_level(int map_width, int map_height) {
 		}
 	}
 
-	// Clear any previous tilesets
-	registry.tilesets.clear();  // Clear the tilesets
-	registry.tiles.clear();
-
-	// Load a new tileset (for the new scene)
-	auto new_tileset_entity = Entity();
-	TileSetComponent& new_tileset_component = registry.tilesets.emplace(new_tileset_entity);
-	new_tileset_component.tileset.initializeTileTextureMap(7, 52);  // Initialize with new tileset
-
-	// Load the new grass and obstacle maps for the new scene
-	std::vector<std::vector<int>> new_grass_map = new_tileset_component.tileset.initializeFinalLevelMap();
-	obstacle_map = new_tileset_component.tileset.initializeFinalLevelObstacleMap();
-
-	// Set tile size (assumed to be 64)
-	int tilesize = 64;
-
-	// Render the new grass layer
-	for (int y = 0; y < new_grass_map.size(); y++) {
-		for (int x = 0; x < new_grass_map[y].size(); x++) {
-			int tile_id = new_grass_map[y][x];
-			vec2 position = { x * tilesize - (tilesize / 2) + tilesize, y * tilesize - (tilesize / 2) + tilesize };
-			Entity tile_entity = createTileEntity(renderer, new_tileset_component.tileset, position, tilesize, tile_id);
-			Tile& tile = registry.tiles.get(tile_entity);
-			tile.walkable = true;  // Mark tiles as walkable
-			tile.atlas = TEXTURE_ASSET_ID::TILE_ATLAS_LEVELS;  // Set new atlas for this tile
-		}
-	}
-
-	// Render the new obstacle layer
-	for (int y = 0; y < obstacle_map.size(); y++) {
-		for (int x = 0; x < obstacle_map[y].size(); x++) {
-			int tile_id = obstacle_map[y][x];
-			if (tile_id != 0) {
-				vec2 position = { x * tilesize - (tilesize / 2) + tilesize, y * tilesize - (tilesize / 2) + tilesize };
-				Entity tile_entity = createTileEntity(renderer, new_tileset_component.tileset, position, tilesize, tile_id);
-				Tile& tile = registry.tiles.get(tile_entity);
-				tile.walkable = false;  // Mark as non-walkable
-				tile.atlas = TEXTURE_ASSET_ID::TILE_ATLAS_LEVELS;  // Use the new tile atlas
-			}
-		}
-	}
-
-	createTile_map(obstacle_map, tilesize);
-	float new_spawn_x = tilesize * 36;
-	float new_spawn_y = tilesize * 2;
+	float new_spawn_x = level_data.player_x;
+	float new_spawn_y = level_data.player_y;
 	Motion& player_motion = registry.motions.get(player);
 	player_motion.position = { new_spawn_x, new_spawn_y };
 
 	// Update the camera to center on the player in the new map
 	renderer->updateCameraPosition({ new_spawn_x, new_spawn_y });
-	createBossRobot(renderer, { 64.f * 35, 64.f * 37 });
-	total_boss_robots_spawned++;
 	// comment out below
 	//// Spawn the boss robot
 	//if (registry.robots.components.size() == 0) {
@@ -1223,78 +892,25 @@ void WorldSystem::load_boss_level(int map_width, int map_height) {
 	//	printf("Max number of boss robots already spawned.\n");
 	//}
 
-	const std::vector<std::pair<float, float>> ROBOT_SPAWN_POSITIONS = {
-	{64.f * 19, 64.f * 11},
-	{64.f * 14, 64.f * 35},
-	{64.f * 52, 64.f * 18},
-	{64.f * 47, 64.f * 10},
-	{64.f * 33, 64.f * 6},
-	{64.f * 39, 64.f * 6}
-	};
-
-	for (size_t i = 0; i < ROBOT_SPAWN_POSITIONS.size(); i++) {
-		if (registry.robots.components.size() >= MAX_NUM_ROBOTS) {
-			break;
-		}
-
-
-
-		const auto& pos = ROBOT_SPAWN_POSITIONS[i];
-		Entity new_robot = createRobot(renderer, vec2(pos.first, pos.second));
-		Robot& robot = registry.robots.get(new_robot);
-
-		std::uniform_int_distribution<int> attack_dist(7, robot.max_attack);
-		std::uniform_int_distribution<int> speed_dist(90, robot.max_speed);
-
-		robot.attack = attack_dist(rng);
-		robot.speed = speed_dist(rng);
-	}
-
-	const std::vector<std::pair<float, float>> ICE_ROBOT_SPAWN_POSITIONS = {
-	{64.f * 6, 64.f * 11},
-	{64.f * 10, 64.f * 7},
-	{64.f * 3, 64.f * 26},
-	{64.f * 31, 64.f * 16},
-	{64.f * 61, 64.f * 11},
-	{64.f * 59, 64.f * 29}
-	};
-
-	for (size_t i = 0; i < ICE_ROBOT_SPAWN_POSITIONS.size(); i++) {
+	// the boss guards are never capturable
+	for (const LevelEntry& spawn : level_data.spawns) {
+		if (spawn.kind != LevelEntityKind::ROBOT && spawn.kind != LevelEntityKind::ICE_ROBOT)
+			continue;
 		if (registry.robots.components.size() >= MAX_NUM_ROBOTS) {
 			break;
 		}
 
-
-
-		const auto& i_pos = ICE_ROBOT_SPAWN_POSITIONS[i];
-		Entity new_robot_i = createIceRobot(renderer, vec2(i_pos.first, i_pos.second));
-		Robot& ice_robot = registry.robots.get(new_robot_i);
-
-		std::uniform_int_distribution<int> attack_dist(7, ice_robot.max_attack);
-		std::uniform_int_distribution<int> speed_dist(90, ice_robot.max_speed);
-
-		ice_robot.attack = attack_dist(rng);
-		ice_robot.speed = speed_dist(rng);
+		vec2 pos = { spawn.x, spawn.y };
+		Entity new_robot = spawn.kind == LevelEntityKind::ROBOT ? createRobot(renderer, pos) : createIceRobot(renderer, pos);
+		setup_spawned_robot(new_robot, false);
 	}
 
-	createSpiderRobot(renderer, { tilesize * 14, tilesize * 17 });
-	createSpiderRobot(renderer, { tilesize * 13, tilesize * 19 });
-	createSpiderRobot(renderer, { tilesize * 15, tilesize * 19 });
-	createSpiderRobot(renderer, { tilesize * 41, tilesize * 17 });
-	createSpiderRobot(renderer, { tilesize * 40, tilesize * 19 });
-	createSpiderRobot(renderer, { tilesize * 42, tilesize * 19 });
-
-
 	registry.notifications.clear();
 	notificationQueue.emplace("Defeat all robots to make the boss robot spawn!", 3.0f);
 	notificationQueue.emplace("Press [T] to use projectile attack! Uses stamina.", 3.0f);
 
 	//createNotification("Press [T] to use projectile attack! Uses stamina.", 3.0f);
-	createPotion(renderer, { tilesize * 38, tilesize * 15 });
-	createPotion(renderer, { tilesize * 43, tilesize * 35 });
-	//createArmorPlate(renderer, { tilesize * 37, tilesize * 4 });
-	createArmorPlate(renderer, { tilesize * 62, tilesize * 25 });
-	createArmorPlate(renderer, { tilesize * 28, tilesize * 29 });
+	spawn_level_entities();
 
 }
 
@@ -1399,71 +1015,19 @@ void WorldSystem::load_first_level(int map_width, int map_height) {
 	printf("map_height: %d\n", map_height);
 	printf("map_width: %d\n", map_width);
 
-	const std::vector<std::pair<float, float>> ROBOT_SPAWN_POSITIONS = {
-	{64.f * 15, 64.f * 7},
-	{64.f * 4, 64.f * 17},
-	{64.f * 13, 64.f * 13},
-	{64.f * 16, 64.f * 17},
-	{64.f * 19, 64.f * 2},
-	{64.f * 25, 64.f * 2},
-	{64.f * 11, 64.f * 23},
-	{64.f * 23, 64.f * 19},
-	{64.f * 24, 64.f * 23},
-	{64.f * 28, 64.f * 16},
-	{64.f * 37, 64.f * 8},
-	{64.f * 31, 64.f * 23},
-	{64.f * 34, 64.f * 23},
-	{64.f * 37, 64.f * 23}
-	};
-	for (size_t i = total_robots_spawned; i < ROBOT_SPAWN_POSITIONS.size(); ++i) {
+	size_t robot_index = 0;
+	for (const LevelEntry& spawn : level_data.spawns) {
+		if (spawn.kind != LevelEntityKind::ROBOT)
+			continue;
+		// robots spawned on an earlier visit are not spawned again
+		if (robot_index++ < total_robots_spawned)
+			continue;
 		if (registry.robots.components.size() >= MAX_NUM_ROBOTS) {
 			break;
 		}
 
-		const auto& pos = ROBOT_SPAWN_POSITIONS[i];
-		Entity new_robot = createRobot(renderer, vec2(pos.first, pos.second));
-		Robot& robot = registry.robots.get(new_robot);
-
-		std::uniform_int_distribution<int> attack_dist(7, robot.max_attack);
-		std::uniform_int_distribution<int> speed_dist(90, robot.max_speed);
-
-		robot.attack = attack_dist(rng);
-		robot.speed = speed_dist(rng);
-
-		if (i == 0 || i == 3 || i == 10) {
-			robot.isCapturable = true;
-
-			std::vector<Item> potential_items = Inventory::disassembleItems;
-			std::shuffle(potential_items.begin(), potential_items.end(), rng);
-
-			size_t added_items = 0;
-			for (const Item& item : potential_items) {
-				if (added_items >= 2) break;
-
-				int min_drop = 1;
-				int max_drop = 1;
-
-				if (item.name == "Energy Core") {
-					min_drop = 1; max_drop = 1;
-				}
-				else if (item.name == "Robot Parts") {
-					min_drop = 1; max_drop = 3;
-				}
-				else if (item.name == "Teleporter") {
-					min_drop = 1; max_drop = 3;
-				}
-				else if (item.name == "Armor Plate") {
-					min_drop = 1; max_drop = 2;
-				}
-
-				int quantity = std::uniform_int_distribution<int>(min_drop, max_drop)(rng);
-
-				if (quantity > 0) {
-					robot.disassembleItems.emplace_back(item.name, quantity);
-					++added_items;
-				}
-			}
-		}
+		Entity new_robot = createRobot(renderer, vec2(spawn.x, spawn.y));
+		setup_spawned_robot(new_robot, (spawn.flags & LEVEL_ENTRY_CAPTURABLE) != 0);
 
 		total_robots_spawned++;
 		if (total_robots_spawned >= TOTAL_ROBOTS) {
@@ -1471,54 +1035,9 @@ void WorldSystem::load_first_level(int map_width, int map_height) {
 		}
 	}
 
-
-	// initialize the grass tileset (base layer)
-	auto grass_tileset_entity = Entity();
-	TileSetComponent& grass_tileset_component = registry.tilesets.emplace(grass_tileset_entity);
-	grass_tileset_component.tileset.initializeTileTextureMap(7, 52); // atlas size
-
-	int tilesize = 64;
-
-	std::vector<std::vector<int>> grass_map = grass_tileset_component.tileset.initializeFirstLevelMap();
-	obstacle_map = grass_tileset_component.tileset.initializeFirstLevelObstacleMap();
-
-	// render grass layer (base)
-	printf("map_height: %d\n", grass_map.size());
-	printf("map_width: %d\n", grass_map.size());
-
-	for (int y = 0; y < grass_map.size(); y++) {
-		for (int x = 0; x < grass_map[y].size(); x++) {
-			int tile_id = grass_map[y][x];
-			vec2 position = { x * tilesize - (tilesize / 2) + tilesize, y * tilesize - (tilesize / 2) + tilesize };
-			Entity tile_entity = createTileEntity(renderer, grass_tileset_component.tileset, position, tilesize, tile_id);
-			Tile& tile = registry.tiles.get(tile_entity);
-			tile.walkable = true;
-			tile.atlas = TEXTURE_ASSET_ID::TILE_ATLAS;
-		}
-	}
-
-	// render obstacle layer (second)
-	for (int y = 0; y < obstacle_map.size(); y++) {
-		for (int x = 0; x < obstacle_map[y].size(); x++) {
-			int tile_id = obstacle_map[y][x];
-			if (tile_id != 0) {
-				vec2 position = { x * tilesize - (tilesize / 2) + tilesize, y * tilesize - (tilesize / 2) + tilesize };
-				Entity tile_entity = createTileEntity(renderer, grass_tileset_component.tileset, position, tilesize, tile_id);
-
-				Tile& tile = registry.tiles.get(tile_entity);
-				tile.walkable = false;
-				tile.atlas = TEXTURE_ASSET_ID::TILE_ATLAS;
-			}
-		}
-	}
-	createTile_map(obstacle_map, tilesize);
-	// Create the player entity
-	float spawn_x = (map_width / 2) * tilesize;
-	float spawn_y = (map_height / 2) * tilesize;
-
 	// Respawn the player at the new starting position in the new scene
-	float new_spawn_x = tilesize;  // Adjust the spawn position if necessary
-	float new_spawn_y = tilesize * 8;
+	float new_spawn_x = level_data.player_x;
+	float new_spawn_y = level_data.player_y;
 	Motion& player_motion = registry.motions.get(player);  // Get player's motion component
 	player_motion.position = { new_spawn_x, new_spawn_y };
 
@@ -1526,492 +1045,245 @@ void WorldSystem::load_first_level(int map_width, int map_height) {
 	// Update the camera to center on the player in the new map
 	renderer->updateCameraPosition({ new_spawn_x, new_spawn_y });
 
-	createRightDoor(renderer, { tilesize * 49, tilesize * 3 });
-
 	registry.notifications.clear();
 	notificationQueue.emplace("Defeat all robots and use keycard to progress to the next level!", 3.0f);
 	notificationQueue.emplace("[Right Click] to block robot attacks! Uses stamina.", 3.0f);
 
-
-	createPotion(renderer, { tilesize * 22, tilesize * 7 });
-	createPotion(renderer, { tilesize * 18, tilesize * 23 });
-	createArmorPlate(renderer, { tilesize * 31, tilesize * 11 });
+	spawn_level_entities();
 }
 
 void WorldSystem::load_tutorial_level(int map_width, int map_height) {
-	auto spawn_tileset_entity = Entity();
-	TileSetComponent& spawn_tileset_component = registry.tilesets.emplace(spawn_tileset_entity);
-	spawn_tileset_component.tileset.initializeTileTextureMap(7, 52);
-
-	int tilesize = 64;
-
-	std::vector<std::vector<int>> grass_map = spawn_tileset_component.tileset.initializeTutorialLevelMap();
-	obstacle_map = spawn_tileset_component.tileset.initializeTutorialLevelObstacleMap();
-
-
-	// render grass layer (base)
-	for (int y = 0; y < map_height; y++) {
-		for (int x = 0; x < map_width; x++) {
-			int tile_id = grass_map[y][x];
-			vec2 position = { x * tilesize - (tilesize / 2) + tilesize, y * tilesize - (tilesize / 2) + tilesize };
-			Entity tile_entity = createTileEntity(renderer, spawn_tileset_component.tileset, position, tilesize, tile_id);
-			Tile& tile = registry.tiles.get(tile_entity);
-			tile.walkable = true;
-			tile.atlas = TEXTURE_ASSET_ID::TILE_ATLAS;
-		}
-	}
-
-	// render obstacle layer (second)
-	for (int y = 0; y < obstacle_map.size(); y++) {
-		for (int x = 0; x < obstacle_map[y].size(); x++) {
-			int tile_id = obstacle_map[y][x];
-			if (tile_id != 0) {
-				vec2 position = { x * tilesize - (tilesize / 2) + tilesize, y * tilesize - (tilesize / 2) + tilesize };
-				Entity tile_entity = createTileEntity(renderer, spawn_tileset_component.tileset, position, tilesize, tile_id);
-
-				Tile& tile = registry.tiles.get(tile_entity);
-				tile.walkable = false;
-				tile.atlas = TEXTURE_ASSET_ID::TILE_ATLAS;
-			}
-		}
-	}
-	
-	createTile_map(obstacle_map, tilesize);
-
-	// Create the player entity
-	float spawn_x = (map_width / 2) * tilesize;
-	float spawn_y = (map_height / 2) * tilesize;
 	tutorial_state = TutorialState::INTRO;
-	player = createPlayer(renderer, { tilesize * 9, tilesize * 7 });
-	/*createArmorPlate(renderer, { tilesize * 9, tilesize * 7 });
-	createPotion(renderer, { tilesize * 9, tilesize * 7 });
-	createKey(renderer, { tilesize * 9, tilesize * 7 });*/
-	createRightDoor(renderer, { tilesize * 18, tilesize * 5 });
-	createArmorPlate(renderer, { tilesize * 14, tilesize * 5 });
-	createPotion(renderer, { tilesize * 11, tilesize * 9 });
-	createKey(renderer, { tilesize * 6, tilesize * 7 });
+	player = createPlayer(renderer, { level_data.player_x, level_data.player_y });
+	spawn_level_entities();
 	registry.colors.insert(player, glm::vec3(1.f, 1.f, 1.f));
 	renderer->player = player;
 }
 void WorldSystem::load_remote_location(int map_width, int map_height) {
-	auto spawn_tileset_entity = Entity();
-	TileSetComponent& spawn_tileset_component = registry.tilesets.emplace(spawn_tileset_entity);
-	spawn_tileset_component.tileset.initializeTileTextureMap(7, 52);
-
-	int tilesize = 64;
-
-	std::vector<std::vector<int>> grass_map = spawn_tileset_component.tileset.initializeRemoteLocationMap();
-	obstacle_map = spawn_tileset_component.tileset.initializeObstacleMap();
-
-
-	// render grass layer (base)
-	for (int y = 0; y < map_height; y++) {
-		for (int x = 0; x < map_width; x++) {
-			int tile_id = grass_map[y][x];
-			vec2 position = { x * tilesize - (tilesize / 2) + tilesize, y * tilesize - (tilesize / 2) + tilesize };
-			Entity tile_entity = createTileEntity(renderer, spawn_tileset_component.tileset, position, tilesize, tile_id);
-			Tile& tile = registry.tiles.get(tile_entity);
-			tile.walkable = true;
-			tile.atlas = TEXTURE_ASSET_ID::TILE_ATLAS;
-		}
-	}
-
-	// render obstacle layer (second)
-	for (int y = 0; y < obstacle_map.size(); y++) {
-		for (int x = 0; x < obstacle_map[y].size(); x++) {
-			int tile_id = obstacle_map[y][x];
-			if (tile_id != 0) {
-				vec2 position = { x * tilesize - (tilesize / 2) + tilesize, y * tilesize - (tilesize / 2) + tilesize };
-				Entity tile_entity = createTileEntity(renderer, spawn_tileset_component.tileset, position, tilesize, tile_id);
-
-				Tile& tile = registry.tiles.get(tile_entity);
-				tile.walkable = false;
-				tile.atlas = TEXTURE_ASSET_ID::TILE_ATLAS;
-			}
-		}
-	}
-	createTile_map(obstacle_map, tilesize);
-	// Create the player entity
-	float new_spawn_x = tilesize * 16;  // Adjust the spawn position if necessary
-	float new_spawn_y = tilesize * 10;
+	float new_spawn_x = level_data.player_x;
+	float new_spawn_y = level_data.player_y;
 	Motion& player_motion = registry.motions.get(player);  // Get player's motion component
 	player_motion.position = { new_spawn_x, new_spawn_y };
 
-	// the player position at the remote location
-	//player = createPlayer(renderer, { tilesize * 15, tilesize * 15 });
-	//createKey(renderer, { tilesize * 15, tilesize * 10 });
-	//createKey(renderer, { tilesize * 7, tilesize * 10 });
-	spaceship = createSpaceship(renderer, { tilesize * 7, tilesize * 10 });
-	registry.colors.insert(spaceship, { 0.761f, 0.537f, 0.118f });
-	//createPotion(renderer, { tilesize * 7, tilesize * 10 });
-	//createPotion(renderer, { tilesize * 7, tilesize * 10 });
-	//createArmorPlate(renderer, { tilesize * 7, tilesize * 10 });
-	//createKey(renderer, { tilesize * 7, tilesize * 10 });
 	renderer->player = player;
-	createSpiderRobot(renderer, { tilesize * 13, tilesize * 6 });
-	createSpiderRobot(renderer, { tilesize * 10, tilesize * 7 });
-	createSpiderRobot(renderer, { tilesize * 9, tilesize * 6 });
-	createSpiderRobot(renderer, { tilesize * 12, tilesize * 7 });
-	createSpiderRobot(renderer, { tilesize * 14, tilesize * 7 });
+	// the spaceship and the spiders
+	spawn_level_entities();
 
 }
 // Compute collisions between entities
 void WorldSystem::handle_collisions() {
-	// Loop over all collisions detected by the physics system
 	pickup_allowed = false;
 	pickup_entity = Entity{};
-	pickup_item_name.clear();
-	auto& collisionsRegistry = registry.collisions;
-
-	for (uint i = 0; i < collisionsRegistry.components.size(); i++) {
-		// The entity and its collider
-		Entity entity = collisionsRegistry.entities[i];
-		Entity entity_other = collisionsRegistry.components[i].other;
-
-		if (registry.spiderRobots.has(entity) && registry.players.has(entity_other)) {
-			SpiderRobot& spider = registry.spiderRobots.get(entity);
-			Player& player = registry.players.get(entity_other);
-
-			// Check if the spider can attack
-			if (spider.attack_timer <= 0.0f) {
-				float attack_damage = 3.0f;
-				player.current_health -= attack_damage;
-
-				spider.attack_timer = spider.attack_cooldown;
-
-				if (player.current_health <= 0) {
-					if (!registry.deathTimers.has(entity_other)) {
-						registry.deathTimers.emplace(entity_other);
-						PlayerAnimation& pa = registry.animations.get(entity_other);
-						pa.setState(AnimationState::DEAD, pa.current_dir);
-						Mix_PlayChannel(-1, player_dead_sound, 0);
-					}
-				}
-			}
-		}
+	pickup_item = ItemId::NONE;
 
-		if (registry.projectile.has(entity)) {
-			projectile pj = registry.projectile.get(entity);
+	// each event type is handled in one pass, in the order of EVENT_LIST
+	for (const ContactEvent& contact : events.queue<ContactEvent>()) {
+		handle_contact(contact.entity, contact.entity_layer, contact.other, contact.other_layer);
+		handle_contact(contact.other, contact.other_layer, contact.entity, contact.entity_layer);
+	}
 
-			if (pj.friendly) {
-				if (registry.robots.has(entity_other)) {
-					Robot& robot = registry.robots.get(entity_other);
-					if (robot.isCapturable && robot.showCaptureUI) {
-						return;
-					}
-					if (!robot.companion) {
-						robot.current_health -= pj.dmg;
-						//printf("Robot hit! Health remaining: %.2f\n", robot.current_health);
+	for (const ProjectileHitEvent& hit : events.queue<ProjectileHitEvent>()) {
+		handle_projectile_hit(hit);
+	}
 
-						registry.remove_all_components_of(entity);
-					}
+	for (const DamageEvent& damage : events.queue<DamageEvent>()) {
+		handle_damage(damage);
+	}
 
-				}
-				else if (registry.bossRobots.has(entity_other)) {
-					BossRobot& boss = registry.bossRobots.get(entity_other);
-					boss.current_health -= pj.dmg;
-					registry.remove_all_components_of(entity);
-				}
-			}
-			if (!pj.friendly && registry.robots.has(entity_other)) {
-				Robot& robot = registry.robots.get(entity_other);
-				if (robot.isCapturable && robot.showCaptureUI) {
-					return;
-				}
-				else if (robot.companion) {
-					robot.current_health -= pj.dmg;
-					registry.remove_all_components_of(entity);
-				}
-			}
-		}
-		else if (registry.projectile.has(entity_other)) {
-			projectile pj = registry.projectile.get(entity_other);
+	// the last item touched is the one picked up
+	for (const PickupEvent& pickup : events.queue<PickupEvent>()) {
+		if (!registry.motions.has(pickup.item))
+			continue;
+		pickup_allowed = true;
+		pickup_entity = pickup.item;
+		pickup_item = pickup.item_id;
+	}
 
-			if (pj.friendly) {
-				if (registry.robots.has(entity)) {
-					Robot& robot = registry.robots.get(entity);
-					if (robot.isCapturable && robot.showCaptureUI) {
-						return;
-					}
-					if (!robot.companion) {
-						robot.current_health -= pj.dmg;
-						//printf("Robot hit! Health remaining: %.2f\n", robot.current_health);
+	// also catches health lost outside of the damage events
+	for (const ContactEvent& contact : events.queue<ContactEvent>()) {
+		if (registry.players.has(contact.entity))
+			kill_player_if_dead(contact.entity);
+		else if (registry.players.has(contact.other))
+			kill_player_if_dead(contact.other);
+	}
 
-						registry.remove_all_components_of(entity_other);
-					}
-				}
-				else if (registry.bossRobots.has(entity)) {
-					BossRobot& boss = registry.bossRobots.get(entity);
-					boss.current_health -= pj.dmg;
-					registry.remove_all_components_of(entity_other);
-				}
-			}
+	// Remove all events from this simulation step
+	events.clear();
+}
 
-			if (!pj.friendly && registry.robots.has(entity)) {
-				Robot& robot = registry.robots.get(entity);
-				if (robot.isCapturable && robot.showCaptureUI) {
-					return;
-				}
-				else if (robot.companion) {
-					robot.current_health -= pj.dmg;
-					registry.remove_all_components_of(entity_other);
-				}
-			}
-		}
+void WorldSystem::handle_contact(Entity entity, uint32_t entity_layer, Entity other, uint32_t other_layer) {
+	if (entity_layer == LAYER_ENEMY && other_layer == LAYER_PLAYER && registry.spiderRobots.has(entity)) {
+		SpiderRobot& spider = registry.spiderRobots.get(entity);
 
-		// Check if the boss projectile hits the player
-		if (registry.bossProjectile.has(entity)) {
-			bossProjectile& pj = registry.bossProjectile.get(entity);
-			if (registry.players.has(entity_other)) {
-				Player& p = registry.players.get(entity_other);
-				PlayerAnimation& pa = registry.animations.get(entity_other);
-				if (pa.current_state != AnimationState::BLOCK) {
-					if (p.current_health > 0) {
-						if (p.armor_stat > 0) {
-							float remaining_damage = pj.dmg - p.armor_stat;
-							p.armor_stat -= pj.dmg;
-							if (p.armor_stat <= 0) {
-								p.armor_stat = 0;
-								Mix_PlayChannel(-1, armor_break, 0);
-							}
-							if (remaining_damage > 0) {
-								p.current_health = std::max(0.f, p.current_health - remaining_damage);
-							}
-						}
-						else {
-							p.current_health = std::max(0.f, p.current_health - pj.dmg);
-						}
-					}
-					if (p.current_health <= 0) {
-						if (!registry.deathTimers.has(entity_other)) {
-							registry.deathTimers.emplace(entity_other);
-							pa.setState(AnimationState::DEAD, pa.current_dir);
-							Mix_PlayChannel(-1, player_dead_sound, 0);
-						}
-					}
-				}
-				if (pa.current_state != AnimationState::BLOCK) {
-					registry.remove_all_components_of(entity);
-				}
+		// Check if the spider can attack
+		if (spider.attack_timer <= 0.0f) {
+			float attack_damage = 3.0f;
+			events.emit(DamageEvent{ other, attack_damage, false, false });
+			spider.attack_timer = spider.attack_cooldown;
+		}
+	}
 
+	// for now, we are only interested in collisions that involve the player
+	if (entity_layer != LAYER_PLAYER) {
+		return;
+	}
 
-				//registry.remove_all_components_of(entity_other);
-			}
-			else if (registry.robots.has(entity_other)) {
-				Robot& robot = registry.robots.get(entity_other);
-				if (robot.companion) {
-					robot.current_health -= pj.dmg;
-					registry.remove_all_components_of(entity);
-				}
-			}
+	if (other_layer == LAYER_COMPANION) {
+		events.emit(PickupEvent{ other, registry.iceRobotAnimations.has(other) ? ItemId::ICE_ROBOT : ItemId::COMPANION_ROBOT });
+	}
+	else if (other_layer == LAYER_PICKUP) {
+		if (registry.keys.has(other)) {
+			events.emit(PickupEvent{ other, ItemId::KEY });
 		}
-
-		// Check if a player projectile hits the boss robot
-		if (registry.projectile.has(entity)) {
-			projectile& pj = registry.projectile.get(entity);
-			if (registry.bossRobots.has(entity_other)) {
-				BossRobot& bossRobot = registry.bossRobots.get(entity_other);
-				if (!pj.friendly) { // Ensure the projectile is not friendly
-					bossRobot.current_health -= pj.dmg; // Apply damage to the boss robot
-					if (bossRobot.current_health <= 0) {
-						// Handle boss robot death
-						registry.remove_all_components_of(entity_other); // Remove the boss robot entity
-					}
-					registry.remove_all_components_of(entity); // Remove the player projectile
+		else if (registry.armorplates.has(other)) {
+			events.emit(PickupEvent{ other, ItemId::ARMOR_PLATE });
+		}
+		else if (registry.potions.has(other)) {
+			events.emit(PickupEvent{ other, ItemId::HEALTH_POTION });
+		}
+	}
+	else if (other_layer == LAYER_DOOR && registry.doors.has(other)) {
+		Door& door = registry.doors.get(other);
+		door.in_range = true;  // Player is in range of door
+		if (current_level == 0 && door.is_locked) {
+			if (playerInventory->containsItem(ItemId::KEY)) {
+				registry.notifications.clear();
+				while (!notificationQueue.empty()) {
+					notificationQueue.pop();
 				}
+				createNotification("Hint: Press [Q] to use an item.", 3.0f);
+			}
+			else {
+				registry.notifications.clear();
+				createNotification("You need a keycard to open this.", 3.0f);
 			}
 		}
-
-		// for now, we are only interested in collisions that involve the player
-		if (registry.players.has(entity)) {
-			//Player& player = registry.players.get(entity);
-
-			Inventory& inventory = registry.players.get(entity).inventory;
-			// Checking Player - Deadly collisions
-			if (registry.robots.has(entity_other)) {
-				Robot& robot = registry.robots.get(entity_other);
-				if (robot.companion) {
-					pickup_allowed = true;
-					pickup_entity = entity_other;
-					if (registry.iceRobotAnimations.has(entity_other)) {
-						pickup_item_name = "IceRobot";
-						renderer->pickup_item_name = pickup_item_name;
-					}
-					else {
-						pickup_item_name = "CompanionRobot";
-						renderer->pickup_item_name = pickup_item_name;
-					}
+		else {
+			if (playerInventory->containsItem(ItemId::KEY)) {
+				registry.notifications.clear();
+				while (!notificationQueue.empty()) {
+					notificationQueue.pop();
 				}
-
-			}
-
-			if (registry.keys.has(entity_other)) {
-				pickup_allowed = true;               // Allow pickup
-				pickup_entity = entity_other;        // Set the entity to be picked up
-				pickup_item_name = "Key";            // Set item name for inventory addition
-				renderer->pickup_item_name = pickup_item_name;
+				createNotification("Hint: Press [Q] to use an item.", 3.0f);
 			}
+			// the door entity is still there so this notification is extra
+			/*else {
+				registry.notifications.clear();
+				createNotification("Locked. I need a keycard. Maybe one of these robots would have it.", 3.0f);
+			}*/
+		}
+	}
+}
 
-			// Check if the other entity is an armor plate
-			if (registry.armorplates.has(entity_other)) {
-				pickup_allowed = true;
-				pickup_entity = entity_other;
-				pickup_item_name = "ArmorPlate";
-				renderer->pickup_item_name = pickup_item_name;
-			}
+void WorldSystem::handle_projectile_hit(const ProjectileHitEvent& hit) {
+	Entity target = hit.target;
+	// an earlier hit this step may have used it up
+	int i = projectiles.index_of(hit.projectile);
+	if (i < 0) {
+		return;
+	}
+	uint8_t flags = projectiles.flags[i];
+	int dmg = projectiles.dmg[i];
+	bool friendly = (flags & PROJECTILE_FRIENDLY) != 0;
 
-			if (registry.potions.has(entity_other)) {
-				pickup_allowed = true;               // Allow pickup
-				pickup_entity = entity_other;        // Set the entity to be picked up
-				pickup_item_name = "HealthPotion";            // Set item name for inventory addition
-				renderer->pickup_item_name = pickup_item_name;
+	if (flags & PROJECTILE_BOSS) {
+		if (registry.players.has(target)) {
+			PlayerAnimation& pa = registry.animations.get(target);
+			if (pa.current_state != AnimationState::BLOCK) {
+				events.emit(DamageEvent{ target, (float)dmg, true, false });
+				projectiles.release(hit.projectile);
 			}
-
-			if (registry.doors.has(entity_other)) {
-				Door& door = registry.doors.get(entity_other);
-				door.in_range = true;  // Player is in range of door
-				if (current_level == 0 && door.is_locked) {
-					if (playerInventory->containsItem("Key")) {
-						registry.notifications.clear();
-						while (!notificationQueue.empty()) {
-							notificationQueue.pop();
-						}
-						createNotification("Hint: Press [Q] to use an item.", 3.0f);
-					}
-					else {
-						registry.notifications.clear();
-						createNotification("You need a keycard to open this.", 3.0f);
-					}
-				}
-				else {
-					if (playerInventory->containsItem("Key")) {
-						registry.notifications.clear();
-						while (!notificationQueue.empty()) {
-							notificationQueue.pop();
-						}
-						createNotification("Hint: Press [Q] to use an item.", 3.0f);
-					}
-					// the door entity is still there so this notification is extra
-					/*else {
-						registry.notifications.clear();
-						createNotification("Locked. I need a keycard. Maybe one of these robots would have it.", 3.0f);
-					}*/
-				}
-
+		}
+		else if (registry.robots.has(target)) {
+			Robot& robot = registry.robots.get(target);
+			if (robot.companion) {
+				events.emit(DamageEvent{ target, (float)dmg, false, false });
+				projectiles.release(hit.projectile);
 			}
+		}
+		return;
+	}
 
-			if (registry.projectile.has(entity_other)) {
-				projectile& pj = registry.projectile.get(entity_other);
-
-				if (registry.players.has(entity) && !pj.friendly) {
-					Player& p = registry.players.get(entity);
-					PlayerAnimation& pa = registry.animations.get(entity);
-					if (pa.current_state != AnimationState::BLOCK) {
-						if (p.current_health > 0) {
-							if (p.armor_stat > 0) {
-								float remaining_damage = pj.dmg - p.armor_stat;
-								p.armor_stat -= pj.dmg;
-								if (p.armor_stat <= 0) {
-									p.armor_stat = 0;
-									Mix_PlayChannel(-1, armor_break, 0);
-								}
-								if (remaining_damage > 0) {
-									p.current_health = std::max(0.f, p.current_health - remaining_damage);
-								}
-							}
-							else {
-								p.current_health = std::max(0.f, p.current_health - pj.dmg);
-							}
-						}
-						if (p.current_health <= 0) {
-							if (!registry.deathTimers.has(entity)) {
-								registry.deathTimers.emplace(entity);
-								pa.setState(AnimationState::DEAD, pa.current_dir);
-								Mix_PlayChannel(-1, player_dead_sound, 0);
-							}
-						}
-					}
-					if (pj.ice) {
-						p.slow_count_down = 1000.f;
-						p.slow = true;
-					}
-					if (pa.current_state != AnimationState::BLOCK) {
-						registry.remove_all_components_of(entity_other);
-					}
-					else {
-						Motion& m = registry.motions.get(entity_other);
-						m.target_velocity = -m.target_velocity;
-						m.velocity = -m.velocity;
-						m.angle += 3.14;
-						pj.friendly = true;
-					}
-					//registry.remove_all_components_of(entity_other);
-				}
-			}
+	if (registry.robots.has(target)) {
+		Robot& robot = registry.robots.get(target);
+		// the capture screen is up for this robot
+		if (robot.isCapturable && robot.showCaptureUI) {
+			return;
+		}
+		// friendly projectiles hurt enemies, the others hurt companions
+		if (friendly != robot.companion) {
+			events.emit(DamageEvent{ target, (float)dmg, false, false });
+			projectiles.release(hit.projectile);
+		}
+	}
+	else if (registry.bossRobots.has(target)) {
+		events.emit(DamageEvent{ target, (float)dmg, false, !friendly });
+		projectiles.release(hit.projectile);
+	}
+	else if (registry.players.has(target) && !friendly) {
+		Player& p = registry.players.get(target);
+		PlayerAnimation& pa = registry.animations.get(target);
+		if (flags & PROJECTILE_ICE) {
+			p.slow_count_down = 1000.f;
+			p.slow = true;
+		}
+		if (pa.current_state != AnimationState::BLOCK) {
+			events.emit(DamageEvent{ target, (float)dmg, true, false });
+			projectiles.release(hit.projectile);
+		}
+		else {
+			// blocked, send it back
+			projectiles.reflect(hit.projectile);
+		}
+	}
+}
 
-			if (registry.bossProjectile.has(entity_other)) {
-				bossProjectile& pj = registry.bossProjectile.get(entity_other);
-
-				if (registry.players.has(entity)) {
-					Player& p = registry.players.get(entity);
-					PlayerAnimation& pa = registry.animations.get(entity);
-					if (pa.current_state != AnimationState::BLOCK) {
-						if (p.current_health > 0) {
-							if (p.armor_stat > 0) {
-								float remaining_damage = pj.dmg - p.armor_stat;
-								p.armor_stat -= pj.dmg;
-								if (p.armor_stat <= 0) {
-									p.armor_stat = 0;
-									Mix_PlayChannel(-1, armor_break, 0);
-								}
-								if (remaining_damage > 0) {
-									p.current_health = std::max(0.f, p.current_health - remaining_damage);
-								}
-							}
-							else {
-								p.current_health = std::max(0.f, p.current_health - pj.dmg);
-							}
-						}
-						if (p.current_health <= 0) {
-							if (!registry.deathTimers.has(entity)) {
-								registry.deathTimers.emplace(entity);
-								pa.setState(AnimationState::DEAD, pa.current_dir);
-								Mix_PlayChannel(-1, player_dead_sound, 0);
-							}
-						}
-					}
-					if (pa.current_state != AnimationState::BLOCK) {
-						registry.remove_all_components_of(entity_other);
-					}
-					
-			
-					//registry.remove_all_components_of(entity_other);
+void WorldSystem::handle_damage(const DamageEvent& damage) {
+	Entity target = damage.target;
+
+	if (registry.players.has(target)) {
+		Player& p = registry.players.get(target);
+		if (!damage.armor) {
+			p.current_health -= damage.amount;
+		}
+		else if (p.current_health > 0) {
+			if (p.armor_stat > 0) {
+				float remaining_damage = damage.amount - p.armor_stat;
+				p.armor_stat -= damage.amount;
+				if (p.armor_stat <= 0) {
+					p.armor_stat = 0;
+					audio.play(SOUND_ID::ARMOR_BREAK);
 				}
-
-				else if (registry.robots.has(entity)) {
-					Robot& robot = registry.robots.get(entity);
-					if (robot.companion) {
-						robot.current_health -= pj.dmg;
-						registry.remove_all_components_of(entity_other);
-					}
-
+				if (remaining_damage > 0) {
+					p.current_health = std::max(0.f, p.current_health - remaining_damage);
 				}
 			}
-			
-			Player& player = registry.players.get(entity);
-			PlayerAnimation& pa = registry.animations.get(entity);
-			if (player.current_health <= 0) {
-				if (!registry.deathTimers.has(entity)) {
-					registry.deathTimers.emplace(entity);
-					pa.setState(AnimationState::DEAD, pa.current_dir);
-					Mix_PlayChannel(-1, player_dead_sound, 0);
-				}
+			else {
+				p.current_health = std::max(0.f, p.current_health - damage.amount);
 			}
 		}
+		kill_player_if_dead(target);
+	}
+	else if (registry.robots.has(target)) {
+		registry.robots.get(target).current_health -= damage.amount;
 	}
+	else if (registry.bossRobots.has(target)) {
+		BossRobot& boss = registry.bossRobots.get(target);
+		boss.current_health -= damage.amount;
+		if (damage.remove_on_death && boss.current_health <= 0) {
+			registry.remove_all_components_of(target);
+		}
+	}
+}
 
-	// Remove all collisions from this simulation step
-	registry.collisions.clear();
+void WorldSystem::kill_player_if_dead(Entity player_entity) {
+	if (registry.players.peek(player_entity).current_health > 0 || registry.deathTimers.has(player_entity)) {
+		return;
+	}
+	registry.deathTimers.emplace(player_entity);
+	PlayerAnimation& pa = registry.animations.get(player_entity);
+	pa.setState(AnimationState::DEAD, pa.current_dir);
+	audio.play(SOUND_ID::PLAYER_DEAD);
 }
 
 // Should the game be over ?
@@ -2191,7 +1463,7 @@ void WorldSystem::on_key(int key, int, int action, int mod) {
 			is_sprinting = false;
 
 			Motion& motion = registry.motions.get(player);
-			float playerSpeed = registry.players.get(player).speed;
+			float playerSpeed = registry.players.peek(player).speed;
 			if (motion.target_velocity.x != 0.f) {
 				motion.target_velocity.x = (motion.target_velocity.x > 0 ? 1.f : -1.f) * playerSpeed;
 			}
@@ -2236,7 +1508,7 @@ void WorldSystem::on_key(int key, int, int action, int mod) {
 	auto& animation = registry.animations.get(player);
 	Motion& motion = registry.motions.get(player);
 	Inventory& inventory = registry.players.get(player).inventory;
-	float playerSpeed = registry.players.get(player).speed * (is_sprinting ? sprint_multiplyer : 1.f);
+	float playerSpeed = registry.players.peek(player).speed * (is_sprinting ? sprint_multiplyer : 1.f);
 	Player& player_data = registry.players.get(player);
 
 	if (inventory.isOpen) {
@@ -2284,19 +1556,19 @@ void WorldSystem::on_key(int key, int, int action, int mod) {
 				case Direction::DOWN:
 					a = initAB(vec2(motion.position.x, motion.position.y + 48), vec2(64.f), player_data.weapon_stat, true);
 					registry.attackbox.emplace_with_duplicates(player, a);
-					Mix_PlayChannel(-1, attack_sound, 0);
+					audio.play(SOUND_ID::ATTACK);
 				case Direction::UP:
 					a = initAB(vec2(motion.position.x, motion.position.y - 48), vec2(64.f), player_data.weapon_stat, true);
 					registry.attackbox.emplace_with_duplicates(player, a);
-					Mix_PlayChannel(-1, attack_sound, 0);
+					audio.play(SOUND_ID::ATTACK);
 				case Direction::LEFT:
 					a = initAB(vec2(motion.position.x - 48, motion.position.y), vec2(64.f), player_data.weapon_stat, true);
 					registry.attackbox.emplace_with_duplicates(player, a);
-					Mix_PlayChannel(-1, attack_sound, 0);
+					audio.play(SOUND_ID::ATTACK);
 				case Direction::RIGHT:
 					a = initAB(vec2(motion.position.x + 48, motion.position.y), vec2(64.f), player_data.weapon_stat, true);
 					registry.attackbox.emplace_with_duplicates(player, a);
-					Mix_PlayChannel(-1, attack_sound, 0);
+					audio.play(SOUND_ID::ATTACK);
 				}
 			}
 			return;
@@ -2321,6 +1593,11 @@ void WorldSystem::on_key(int key, int, int action, int mod) {
 			renderer->show_fps = !renderer->show_fps;
 			printf("FPS counter %s\n", renderer->show_fps ? "enabled" : "disabled");
 			break;
+		case GLFW_KEY_G:
+			// Cycle the world's render resolution: full, three quarters, half
+			renderer->render_scale = renderer->render_scale > 0.9f ? 0.75f : renderer->render_scale > 0.6f ? 0.5f : 1.f;
+			printf("Render scale %.2f\n", renderer->render_scale);
+			break;
 		case GLFW_KEY_I:
 			// Toggle inventory open/close
 			inventory.isOpen = !inventory.isOpen;
@@ -2337,10 +1614,10 @@ void WorldSystem::on_key(int key, int, int action, int mod) {
 				auto& armorSlot = inventory.getArmorSlot();
 				auto& weaponSlot = inventory.getWeaponSlot();
 
-				if (!armorSlot.item.name.empty()) {
+				if (!armorSlot.item.empty()) {
 					bool addedToInventory = false;
 					for (auto& slot : inventory.slots) {
-						if (slot.item.name.empty() && slot.type != InventorySlotType::ARMOR && slot.type != InventorySlotType::WEAPON) {
+						if (slot.item.empty() && slot.type != InventorySlotType::ARMOR && slot.type != InventorySlotType::WEAPON) {
 							slot.item = armorSlot.item; // Move item to the first empty slot
 							addedToInventory = true;
 							break;
@@ -2348,17 +1625,17 @@ void WorldSystem::on_key(int key, int, int action, int mod) {
 					}
 
 					if (!addedToInventory) {
-						printf("No available slot to move armor item '%s'.\n", armorSlot.item.name.c_str());
+						printf("No available slot to move armor item '%s'.\n", armorSlot.item.name());
 						// Optionally handle this scenario (e.g., drop item, notify player, etc.)
 					}
 
 					armorSlot.item = {}; // Clear armor slot
 				}
 
-				if (!weaponSlot.item.name.empty()) {
+				if (!weaponSlot.item.empty()) {
 					bool addedToInventory = false;
 					for (auto& slot : inventory.slots) {
-						if (slot.item.name.empty() && slot.type != InventorySlotType::ARMOR && slot.type != InventorySlotType::WEAPON) {
+						if (slot.item.empty() && slot.type != InventorySlotType::ARMOR && slot.type != InventorySlotType::WEAPON) {
 							slot.item = weaponSlot.item; // Move item to the first empty slot
 							addedToInventory = true;
 							break;
@@ -2366,7 +1643,7 @@ void WorldSystem::on_key(int key, int, int action, int mod) {
 					}
 
 					if (!addedToInventory) {
-						printf("No available slot to move weapon item '%s'.\n", weaponSlot.item.name.c_str());
+						printf("No available slot to move weapon item '%s'.\n", weaponSlot.item.name());
 						// Optionally handle this scenario (e.g., drop item, notify player, etc.)
 					}
 
@@ -2385,27 +1662,27 @@ void WorldSystem::on_key(int key, int, int action, int mod) {
 				Inventory& inventory = registry.players.get(player).inventory;
 
 				if (inventory.isFull()) {
-					notificationQueue.emplace("Inventory is full! Cannot pick up " + pickup_item_name, 3.0f);
+					notificationQueue.emplace(std::string("Inventory is full! Cannot pick up ") + item_def(pickup_item).name, 3.0f);
 				//	Mix_PlayChannel(-1, error_sound, 0);
 					break;
 				}
 
-				Mix_PlayChannel(-1, key_sound, 0);
+				audio.play(SOUND_ID::KEY);
 
-				if (pickup_item_name == "CompanionRobot") {
+				if (pickup_item == ItemId::COMPANION_ROBOT) {
 					Robot& robot = registry.robots.get(pickup_entity);
 					inventory.addCompanionRobot(
-						"CompanionRobot",
+						ItemId::COMPANION_ROBOT,
 						robot.current_health,
 						robot.attack,
 						robot.speed
 					);
 				}
 				else {
-					inventory.addItem(pickup_item_name, 1);
+					inventory.addItem(pickup_item, 1);
 				}
 
-				if (pickup_item_name == "Key") {
+				if (pickup_item == ItemId::KEY) {
 					key_collected = true;
 				}
 			/*	for (Entity entity : registry.notifications.entities) {
@@ -2419,7 +1696,7 @@ void WorldSystem::on_key(int key, int, int action, int mod) {
 				}
 
 				createNotification(
-					"Picked up " + pickup_item_name,
+					std::string("Picked up ") + item_def(pickup_item).name,
 					2.0f, 
 					vec2(window_width_px - 241.0f, 40.0f),
 					vec3(1.0f, 1.0f, 1.0f),
@@ -2431,7 +1708,7 @@ void WorldSystem::on_key(int key, int, int action, int mod) {
 
 				pickup_allowed = false;
 				pickup_entity = Entity{};
-				pickup_item_name.clear();
+				pickup_item = ItemId::NONE;
 			}
 			break;
 
@@ -2572,7 +1849,7 @@ void WorldSystem::on_key(int key, int, int action, int mod) {
 					vec2 proj_speed = normalize(proj_dir) * 300.f;
 					float angle = atan2(proj_dir.y, proj_dir.x);
 
-					Entity proj = createProjectile(motion.position, proj_speed, angle, false, true);
+					createProjectile(motion.position, proj_speed, angle, false, true);
 
 				}
 			}
@@ -2595,6 +1872,12 @@ void WorldSystem::on_key(int key, int, int action, int mod) {
 		else
 			debugging.in_debug_mode = true;
 	}
+	// F1, F2, ... switch the debug shape categories shown while TAB is held
+	if (action == GLFW_PRESS && key >= GLFW_KEY_F1 && key < GLFW_KEY_F1 + debug_category_count) {
+		DEBUG_CATEGORY category = (DEBUG_CATEGORY)(key - GLFW_KEY_F1);
+		bool on = debug_draw.toggle(category);
+		printf("Debug %s %s\n", debug_category_name(category), on ? "on" : "off");
+	}
 	// inventory slot selection
 	if (key == GLFW_KEY_1) {
 		inventory.setSelectedSlot(0);
@@ -2610,7 +1893,7 @@ void WorldSystem::on_key(int key, int, int action, int mod) {
 		int selectedSlotIndex = inventory.getSelectedSlot();
 		InventorySlot& selectedSlot = inventory.slots[selectedSlotIndex];
 
-		if (!selectedSlot.item.name.empty()) {
+		if (!selectedSlot.item.empty()) {
 			useSelectedItem();
 		}
 		else {
@@ -2638,11 +1921,11 @@ void WorldSystem::useSelectedItem() {
 	}
 
 	Item& selectedItem = playerInventory->slots[slot].item;
-	if (selectedItem.name.empty()) {
+	if (selectedItem.empty()) {
 		printf("No item in the selected slot.\n");
 		return;
 	}
-	if (selectedItem.name == "Key") {
+	if (selectedItem.id == ItemId::KEY) {
 		for (Entity door_entity : registry.doors.entities) {
 			Door& door = registry.doors.get(door_entity);
 
@@ -2650,10 +1933,10 @@ void WorldSystem::useSelectedItem() {
 				auto& door_anim = registry.doorAnimations.get(door_entity);
 				door_anim.is_opening = true;
 				door.is_locked = false;
-				Mix_PlayChannel(-1, insert_card, 0);
-				playerInventory->removeItem(selectedItem.name, 1);
+				audio.play(SOUND_ID::INSERT_CARD);
+				playerInventory->removeItem(selectedItem.id, 1);
 				//	printf("removing key");
-				if (playerInventory->slots[slot].item.name.empty() && slot < playerInventory->slots.size() - 1) {
+				if (playerInventory->slots[slot].item.empty() && slot < playerInventory->slots.size() - 1) {
 					playerInventory->setSelectedSlot(slot);
 				}
 				return;
@@ -2667,15 +1950,15 @@ void WorldSystem::useSelectedItem() {
 		return;
 	}
 
-	else if (selectedItem.name == "CompanionRobot") {
+	else if (selectedItem.id == ItemId::COMPANION_ROBOT) {
 
 		if (current_level != 4) {
 			vec2 placementPosition = getPlayerPlacementPosition();
 			createCompanionRobot(renderer, placementPosition, selectedItem);
 
-			playerInventory->removeItem(selectedItem.name, 1);
+			playerInventory->removeItem(selectedItem.id, 1);
 
-			if (playerInventory->slots[slot].item.name.empty() && slot < playerInventory->slots.size() - 1) {
+			if (playerInventory->slots[slot].item.empty() && slot < playerInventory->slots.size() - 1) {
 				playerInventory->setSelectedSlot(slot);
 			}
 		}
@@ -2683,26 +1966,26 @@ void WorldSystem::useSelectedItem() {
 			notificationQueue.emplace("Uh, too high pressure - can't place companion!", 2.0f);
 		}
 	}
-	else if (selectedItem.name == "ArmorPlate") {
+	else if (selectedItem.id == ItemId::ARMOR_PLATE) {
 		Entity player_e = registry.players.entities[0];
 		Player& player = registry.players.get(player_e);
 		player.armor_stat += 15.0f;
-		Mix_PlayChannel(-1, using_item, 0);
-		playerInventory->removeItem(selectedItem.name, 1);
+		audio.play(SOUND_ID::USING_ITEM);
+		playerInventory->removeItem(selectedItem.id, 1);
 
-		if (playerInventory->slots[slot].item.name.empty() && slot < playerInventory->slots.size() - 1) {
+		if (playerInventory->slots[slot].item.empty() && slot < playerInventory->slots.size() - 1) {
 			playerInventory->setSelectedSlot(slot);
 		}
 	}
-	else if (selectedItem.name == "IceRobot") {
+	else if (selectedItem.id == ItemId::ICE_ROBOT) {
 
 		if (current_level != 4) {
 			vec2 placementPosition = getPlayerPlacementPosition();
 			createCompanionIceRobot(renderer, placementPosition, selectedItem);
 
-			playerInventory->removeItem(selectedItem.name, 1);
+			playerInventory->removeItem(selectedItem.id, 1);
 
-			if (playerInventory->slots[slot].item.name.empty() && slot < playerInventory->slots.size() - 1) {
+			if (playerInventory->slots[slot].item.empty() && slot < playerInventory->slots.size() - 1) {
 				playerInventory->setSelectedSlot(slot);
 			}
 		}
@@ -2710,18 +1993,18 @@ void WorldSystem::useSelectedItem() {
 			notificationQueue.emplace("Uh, too high pressure - can't place companion!", 2.0f);
 		}
 	}
-	else if (selectedItem.name == "HealthPotion") {
+	else if (selectedItem.id == ItemId::HEALTH_POTION) {
 		Entity player_e = registry.players.entities[0];
 		Player& player = registry.players.get(player_e);
 		if (player.current_health < player.max_health) {
 			player.current_health += 30.f;
-			Mix_PlayChannel(-1, using_item, 0);
+			audio.play(SOUND_ID::USING_ITEM);
 			if (player.current_health > player.max_health) {
 				player.current_health = player.max_health;
 			}
-			playerInventory->removeItem(selectedItem.name, 1);
+			playerInventory->removeItem(selectedItem.id, 1);
 
-			if (playerInventory->slots[slot].item.name.empty() && slot < playerInventory->slots.size() - 1) {
+			if (playerInventory->slots[slot].item.empty() && slot < playerInventory->slots.size() - 1) {
 				playerInventory->setSelectedSlot(slot);
 			}
 		}
@@ -2737,7 +2020,7 @@ void WorldSystem::useSelectedItem() {
 			return;
 		}
 	}
-	else if (selectedItem.name == "Teleporter") {
+	else if (selectedItem.id == ItemId::TELEPORTER) {
 		Motion& player_motion = registry.motions.get(player);
 		float edge_proximity = 64.0f; // needs some work
 		float map_width_px = map_width * 64;
@@ -2777,7 +2060,7 @@ void WorldSystem::useSelectedItem() {
 		if (current_level != 4) {
 
 			// Calculate the teleport destination
-			vec2 teleportDirection = normalize(registry.motions.get(player_e).target_velocity);
+			vec2 teleportDirection = normalize(registry.motions.peek(player_e).target_velocity);
 			if (glm::length(teleportDirection) == 0) {
 				teleportDirection = vec2(1.f, 0.f); // Default direction
 			}
@@ -2789,9 +2072,8 @@ void WorldSystem::useSelectedItem() {
 			int tile_y = static_cast<int>(teleportDestination.y / 64.0f);
 
 			// Validate the teleportation destination
-			if (tile_y < 0 || tile_y >= obstacle_map.size() ||
-				tile_x < 0 || tile_x >= obstacle_map[0].size() ||
-				obstacle_map[tile_y][tile_x] != 0) {
+			if (!level_data.obstacles.in_bounds(tile_x, tile_y) ||
+				level_data.obstacles.at(tile_x, tile_y) != 0) {
 				std::queue<std::pair<std::string, float>> tempQueue;
 				tempQueue.emplace("Can't use that here.", 3.0f);
 
@@ -2804,7 +2086,7 @@ void WorldSystem::useSelectedItem() {
 			}
 
 		// Perform the teleport
-		Mix_PlayChannel(-1, teleport_sound, 0);
+		audio.play(SOUND_ID::TELEPORT);
 		player_motion.position = teleportDestination;
 
 			// Update player state
@@ -2813,8 +2095,8 @@ void WorldSystem::useSelectedItem() {
 			player.dashCooldown = 2.0f;
 			player.lastDashDirection = teleportDirection;
 
-			playerInventory->removeItem(selectedItem.name, 1);
-			if (playerInventory->slots[slot].item.name.empty() && slot < playerInventory->slots.size() - 1) {
+			playerInventory->removeItem(selectedItem.id, 1);
+			if (playerInventory->slots[slot].item.empty() && slot < playerInventory->slots.size() - 1) {
 				playerInventory->setSelectedSlot(slot);
 			}
 		}
@@ -2825,11 +2107,11 @@ void WorldSystem::useSelectedItem() {
 
 
 
-	else if (selectedItem.name == "Energy Core") {
+	else if (selectedItem.id == ItemId::ENERGY_CORE) {
 		Entity player_e = registry.players.entities[0];
 		Player& player = registry.players.get(player_e);
 		player.max_stamina += 5.f;
-		Mix_PlayChannel(-1, using_item, 0);
+		audio.play(SOUND_ID::USING_ITEM);
 		player.current_stamina = std::min(player.current_stamina + 20.f, player.max_stamina);
 		std::queue<std::pair<std::string, float>> tempQueue;
 		tempQueue.emplace("Stamina increased!", 3.0f);
@@ -2839,9 +2121,9 @@ void WorldSystem::useSelectedItem() {
 			notificationQueue.pop();
 		}
 		std::swap(notificationQueue, tempQueue);
-		playerInventory->removeItem(selectedItem.name, 1);
+		playerInventory->removeItem(selectedItem.id, 1);
 
-		if (playerInventory->slots[slot].item.name.empty() && slot < playerInventory->slots.size() - 1) {
+		if (playerInventory->slots[slot].item.empty() && slot < playerInventory->slots.size() - 1) {
 			playerInventory->setSelectedSlot(slot);
 		}
 	}
@@ -2905,7 +2187,7 @@ void WorldSystem::onMouseClick(int button, int action, int mods) {
 				renderer->mousePosition.y >= armor_slot_position.y &&
 				renderer->mousePosition.y <= armor_slot_position.y + armor_slot_size.y) {
 
-				if (!playerInventory->slots[10].item.name.empty()) {
+				if (!playerInventory->slots[10].item.empty()) {
 					renderer->isDragging = true;
 					renderer->draggedSlot = 10;
 					renderer->dragOffset = renderer->mousePosition - armor_slot_position;
@@ -2919,7 +2201,7 @@ void WorldSystem::onMouseClick(int button, int action, int mods) {
 				renderer->mousePosition.y >= weapon_slot_position.y &&
 				renderer->mousePosition.y <= weapon_slot_position.y + weapon_slot_size.y) {
 
-				if (!playerInventory->slots[11].item.name.empty()) {
+				if (!playerInventory->slots[11].item.empty()) {
 					renderer->isDragging = true;
 					renderer->draggedSlot = 11;
 					renderer->dragOffset = renderer->mousePosition - weapon_slot_position;
@@ -2947,7 +2229,7 @@ void WorldSystem::onMouseClick(int button, int action, int mods) {
 					renderer->mousePosition.y >= slotPosition.y &&
 					renderer->mousePosition.y <= slotPosition.y + slotSize.y) {
 
-					if (!playerInventory->slots[i].item.name.empty()) {
+					if (!playerInventory->slots[i].item.empty()) {
 						renderer->isDragging = true;
 						renderer->draggedSlot = i;
 						renderer->dragOffset = renderer->mousePosition - slotPosition;
@@ -2965,10 +2247,10 @@ void WorldSystem::onMouseClick(int button, int action, int mods) {
 				renderer->mousePosition.y >= armor_slot_position.y &&
 				renderer->mousePosition.y <= armor_slot_position.y + armor_slot_size.y) {
 
-				if (!playerInventory->slots[10].item.name.empty()) {
+				if (!playerInventory->slots[10].item.empty()) {
 					bool placedInNormalSlot = false;
 					for (int i = 0; i < 10; ++i) {
-						if (playerInventory->slots[i].item.name.empty()) {
+						if (playerInventory->slots[i].item.empty()) {
 							playerInventory->slots[i].item = playerInventory->slots[10].item;
 							placedInNormalSlot = true;
 							break;
@@ -2987,10 +2269,10 @@ void WorldSystem::onMouseClick(int button, int action, int mods) {
 				renderer->mousePosition.y >= weapon_slot_position.y &&
 				renderer->mousePosition.y <= weapon_slot_position.y + weapon_slot_size.y) {
 				printf("WEAPON SLOT");
-				if (!playerInventory->slots[11].item.name.empty()) {
+				if (!playerInventory->slots[11].item.empty()) {
 					bool placedInNormalSlot = false;
 					for (int i = 0; i < 10; ++i) {
-						if (playerInventory->slots[i].item.name.empty()) {
+						if (playerInventory->slots[i].item.empty()) {
 							playerInventory->slots[i].item = playerInventory->slots[11].item;
 							placedInNormalSlot = true;
 							break;
@@ -3014,7 +2296,7 @@ void WorldSystem::onMouseClick(int button, int action, int mods) {
 						renderer->mousePosition.y >= targetSlotPosition.y &&
 						renderer->mousePosition.y <= targetSlotPosition.y + slotSize.y) {
 
-						if (playerInventory->slots[i].item.name.empty()) {
+						if (playerInventory->slots[i].item.empty()) {
 							playerInventory->slots[i].item = playerInventory->slots[renderer->draggedSlot].item;
 							playerInventory->slots[renderer->draggedSlot].item = {};
 						}
@@ -3045,15 +2327,14 @@ void WorldSystem::handleCaptureButtonClick() {
 
 	if (registry.iceRobotAnimations.has(renderer->currentRobotEntity)) {
 		printf("Hello, World!\n");
-		playerInventory->addCompanionRobot("IceRobot", robot.current_health, robot.attack, robot.speed);
+		playerInventory->addCompanionRobot(ItemId::ICE_ROBOT, robot.current_health, robot.attack, robot.speed);
 		renderer->show_capture_ui = false;
 		robot.showCaptureUI = false;
 		uiScreenShown = false;
 		registry.remove_all_components_of(renderer->currentRobotEntity);
 	}
 	else if (registry.robots.has(renderer->currentRobotEntity)) {
-		std::string robotName = "CompanionRobot";
-		playerInventory->addCompanionRobot(robotName, robot.current_health, robot.attack, robot.speed);
+		playerInventory->addCompanionRobot(ItemId::COMPANION_ROBOT, robot.current_health, robot.attack, robot.speed);
 		renderer->show_capture_ui = false;
 		robot.showCaptureUI = false;
 		uiScreenShown = false;
@@ -3078,13 +2359,13 @@ void WorldSystem::handleDisassembleButtonClick() {
 
 	for (const Item& item : robot.disassembleItems) {
 		if (playerInventory->isFull()) {
-			printf("Inventory is full! Cannot add %s.\n", item.name.c_str());
-			notificationQueue.emplace("Inventory is full! Cannot add " + item.name, 3.0f);
+			printf("Inventory is full! Cannot add %s.\n", item.name());
+			notificationQueue.emplace(std::string("Inventory is full! Cannot add ") + item.name(), 3.0f);
 			continue; // Skip this item and move to the next
 		}
 
-		playerInventory->addItem(item.name, item.quantity);
-		printf("Added %d x %s to inventory.\n", item.quantity, item.name.c_str());
+		playerInventory->addItem(item.id, item.quantity);
+		printf("Added %d x %s to inventory.\n", item.quantity, item.name());
 	}
 
 	uiScreenShown = false;
@@ -3103,19 +2384,19 @@ void WorldSystem::handleUpgradeButtonClick() {
 	const int armor_slot_index = 10;
 	const int weapon_slot_index = 11;
 
-	if ((inventory_slots[armor_slot_index].item.name == "CompanionRobot" ||
-		inventory_slots[armor_slot_index].item.name == "IceRobot") &&
+	if ((inventory_slots[armor_slot_index].item.id == ItemId::COMPANION_ROBOT ||
+		inventory_slots[armor_slot_index].item.id == ItemId::ICE_ROBOT) &&
 		inventory_slots[armor_slot_index].item.quantity > 0) {
 
 		int total_upgrade = 0;
 
 		for (auto& slot : inventory_slots) {
-			if ((slot.item.name == "CompanionRobot" || slot.item.name == "IceRobot") && slot.item.quantity > 0) {
+			if ((slot.item.id == ItemId::COMPANION_ROBOT || slot.item.id == ItemId::ICE_ROBOT) && slot.item.quantity > 0) {
 				total_upgrade += 10 * slot.item.quantity;
 			}
 		}
 
-		if (inventory_slots[weapon_slot_index].item.name == "Robot Parts" && inventory_slots[weapon_slot_index].item.quantity > 0) {
+		if (inventory_slots[weapon_slot_index].item.id == ItemId::ROBOT_PARTS && inventory_slots[weapon_slot_index].item.quantity > 0) {
 			Item& equipped_robot = inventory_slots[armor_slot_index].item;
 
 			equipped_robot.speed = static_cast<int>(equipped_robot.speed * 1.15f);
@@ -3123,10 +2404,10 @@ void WorldSystem::handleUpgradeButtonClick() {
 			equipped_robot.damage = static_cast<int>(equipped_robot.damage * 1.15f);
 
 
-			Mix_PlayChannel(-1, Upgrade, 0);
-			std::cout << equipped_robot.name << " in the armor slot upgraded: +5% to speed, health, and damage!" << std::endl;
+			audio.play(SOUND_ID::UPGRADE);
+			std::cout << equipped_robot.name() << " in the armor slot upgraded: +5% to speed, health, and damage!" << std::endl;
 
-			player_data.inventory.removeItem("Robot Parts", 1);
+			player_data.inventory.removeItem(ItemId::ROBOT_PARTS, 1);
 		}
 	}
 	else {
@@ -3137,91 +2418,226 @@ void WorldSystem::handleUpgradeButtonClick() {
 
 
 
+// Tileset, tile entities and the collision map are derived from the level alone,
+// so saves don't store them and call this to rebuild them instead
+// Makes level the one in level_data and level_geometry. Usually the preloader already
+// has it ready, otherwise it is read and built right here.
+bool WorldSystem::load_level_file(int level) {
+	if (level == level_data_index)
+		return true;
+	level_data_index = -1;
+	if (!preloader.take(level, level_geometry) && !prepare_level(level, level_geometry))
+		return false;
+	level_data = std::move(level_geometry.data);
+	level_data_index = level;
+	return true;
+}
+
+// Sound banks a level needs on top of CORE. Companions bring robot sounds anywhere,
+// those load the first time they are heard.
+static uint32_t level_sound_banks(const LevelData& level) {
+	uint32_t banks = 0;
+	if (!level.doors.empty())
+		banks |= bank_bit(SOUND_BANK::DOORS);
+	for (const LevelEntry& spawn : level.spawns) {
+		if (spawn.kind == LevelEntityKind::ROBOT || spawn.kind == LevelEntityKind::ICE_ROBOT
+			|| spawn.kind == LevelEntityKind::SPIDER_ROBOT || spawn.kind == LevelEntityKind::BOSS_ROBOT)
+			banks |= bank_bit(SOUND_BANK::ROBOTS);
+	}
+	return banks;
+}
+
+// Spawns the level's doors, items and the enemies that need no per-level setup
+void WorldSystem::spawn_level_entities() {
+	for (const LevelEntry& door : level_data.doors) {
+		vec2 pos = { door.x, door.y };
+		if (door.kind == LevelEntityKind::RIGHT_DOOR)
+			createRightDoor(renderer, pos);
+		else if (door.kind == LevelEntityKind::BOTTOM_DOOR)
+			createBottomDoor(renderer, pos);
+	}
+
+	for (const LevelEntry& item : level_data.items) {
+		vec2 pos = { item.x, item.y };
+		switch (item.kind) {
+		case LevelEntityKind::POTION:
+			createPotion(renderer, pos);
+			break;
+		case LevelEntityKind::ARMOR_PLATE:
+			createArmorPlate(renderer, pos);
+			break;
+		case LevelEntityKind::KEY:
+			createKey(renderer, pos);
+			break;
+		default:
+			break;
+		}
+	}
+
+	// robots are spawned by the load_*_level functions, their setup differs per level
+	for (const LevelEntry& spawn : level_data.spawns) {
+		vec2 pos = { spawn.x, spawn.y };
+		switch (spawn.kind) {
+		case LevelEntityKind::SPIDER_ROBOT:
+			createSpiderRobot(renderer, pos);
+			break;
+		case LevelEntityKind::BOSS_ROBOT:
+			createBossRobot(renderer, pos);
+			total_boss_robots_spawned++;
+			break;
+		case LevelEntityKind::BAT_SWARM:
+			spawnBatSwarm(pos, (int)spawn.count);
+			break;
+		case LevelEntityKind::SPACESHIP:
+			spaceship = createSpaceship(renderer, pos);
+			registry.colors.insert(spaceship, { 0.761f, 0.537f, 0.118f });
+			break;
+		default:
+			break;
+		}
+	}
+}
+
+// Rolls the stats of a freshly spawned robot, capturable ones also get the parts they drop
+void WorldSystem::setup_spawned_robot(Entity robot_entity, bool capturable) {
+	Robot& robot = registry.robots.get(robot_entity);
+
+	std::uniform_int_distribution<int> attack_dist(7, robot.max_attack);
+	std::uniform_int_distribution<int> speed_dist(90, robot.max_speed);
+
+	robot.attack = attack_dist(rng);
+	robot.speed = speed_dist(rng);
+
+	if (!capturable)
+		return;
+	robot.isCapturable = true;
+
+	std::vector<ItemId> potential_items;
+	for (int i = 0; i < item_count; i++) {
+		if (item_defs[i].disassemble_max > 0)
+			potential_items.push_back((ItemId)i);
+	}
+	std::shuffle(potential_items.begin(), potential_items.end(), rng);
+
+	size_t added_items = 0;
+	for (ItemId id : potential_items) {
+		if (added_items >= 2) break;
+
+		const ItemDef& def = item_def(id);
+		int quantity = std::uniform_int_distribution<int>(def.disassemble_min, def.disassemble_max)(rng);
+
+		if (quantity > 0) {
+			robot.disassembleItems.emplace_back(id, quantity);
+			++added_items;
+		}
+	}
+}
+
+void WorldSystem::build_level_geometry(int level) {
+	while (registry.tiles.entities.size() > 0) {
+		registry.remove_all_components_of(registry.tiles.entities.back());
+	}
+	chunks.clear();
+	pathfinder.clear();
+	registry.tilesets.clear();
+	registry.maps.clear();
+	if (!load_level_file(level))
+		return;
+
+	// copied, a restart builds the same level again
+	auto tileset_entity = Entity();
+	registry.tilesets.insert(tileset_entity, { level_geometry.tileset });
+
+	// tiles only become entities in the chunks around the player
+	chunks.build(level_data, level_geometry.tiles);
+	if (registry.motions.has(player))
+		chunks.update(registry.motions.peek(player).position, true);
+	Entity map_entity = createTile_map(level_data.obstacles, level_data.tile_size);
+	const T_map& map = registry.maps.peek(map_entity);
+	pathfinder.build(map.tile_map, map.tile_size);
+
+	// the next level gets built in the background while this one is played
+	if (level < FINAL_LEVEL)
+		preloader.request(level + 1);
+}
 
 void WorldSystem::load_level(int level) {
 	for (auto entity : registry.motions.entities) {
 		if (entity != player) registry.remove_all_components_of(entity);
 	}
-	/*registry.tilesets.clear();
-	registry.tiles.clear();*/
+	projectiles.clear();
+	particles.clear();
+	smoke_emitter = -1;
 	ScreenState& screen = registry.screenStates.components[0];
 	// Level-specific setup
 	Entity radiation_entity = *registry.radiations.entities.begin();
 	Radiation& radiation = registry.radiations.get(radiation_entity);
+	// the layout, spawns and map size all come from the level file
+	if (!load_level_file(level)) {
+		radiation = { 0.0f, 0.0f };
+		return;
+	}
+	map_width = level_data.base.width;
+	map_height = level_data.base.height;
+	// the sounds load in the background while the level is set up
+	audio.use_banks(level_sound_banks(level_data));
 	switch (level) {
 
 	case 0:
-		//registry.maps.clear();
-		map_width = 20;
-		map_height = 12;
 		printf("loading remote level");
 		screen.is_nighttime = false;
 		radiation = { 0.0f, 0.0f };
 
-		load_tutorial_level(20, 12);
+		load_tutorial_level(map_width, map_height);
 		break;
 	case 1:
-		//registry.maps.clear();
-		map_width = 21;
-		map_height = 18;
-		registry.maps.clear();
 		printf("loading remote level");
 		screen.is_nighttime = true;
 		radiation = { 0.1f, 2.0f };
 
-		load_remote_location(21, 18);
+		load_remote_location(map_width, map_height);
 		break;
 	case 2:
 		// Setup for Level 2
-		map_width = 40;
-		map_height = 27;
 		printf("map_height: %d" + map_height);
 		printf("map_width: %d" + map_width);
-		registry.maps.clear();
 		screen.is_nighttime = false;
 		renderer->show_capture_ui = false;
 		radiation = { 0.3f, 3.0f };
-		load_first_level(40, 27);
+		load_first_level(map_width, map_height);
 		//generate_json(registry);
 		break;
 	case 3:
 		// Setup for Level 3
-		registry.maps.clear();
-		map_width = 40;
-		map_height = 28;
 		//screen.is_nighttime = false;
 		renderer->show_capture_ui = false;
 		radiation = { 0.6f, 4.0f };
-		load_second_level(40, 28);
+		load_second_level(map_width, map_height);
 		//generate_json(registry);
 		break;
 	case 4:
 		// Setup for level 4
-		registry.maps.clear();
-		map_width = 20;
-		map_height = 12;
 		screen.is_nighttime = false;
 		renderer->show_capture_ui = false;
 		radiation = { 0.6f, 4.0f };
-		load_third_level(20, 12);
+		load_third_level(map_width, map_height);
 		//generate_json(registry);
 		break;
 
 	case 5:
 		// Setup for final level
-		registry.maps.clear();
-		map_width = 64;
-		map_height = 40;
 		screen.is_nighttime = true;
 		renderer->show_capture_ui = false;
 		radiation = { 1.0f, 5.0f };
-		load_boss_level(64, 40);
+		load_boss_level(map_width, map_height);
 		//generate_json(registry);
 		break;
 	default:
 		radiation = { 0.0f, 0.0f };
 		return;
 	}
+	// after the spawns, the load functions above clear every entity with a motion
+	build_level_geometry(level);
 
 }
 void WorldSystem::updateItemDragging() {
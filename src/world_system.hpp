@@ -9,10 +9,13 @@
 #include <queue>
 #define SDL_MAIN_HANDLED
 #include <SDL.h>
-#include <SDL_mixer.h>
 
 #include "render_system.hpp"
 #include "ai_system.hpp"
+#include "level_data.hpp"
+#include "level_preloader.hpp"
+#include "world_chunks.hpp"
+#include "event_bus.hpp"
 
 #include "../ext/json.hpp"
 using json = nlohmann::json;
@@ -37,7 +40,12 @@ public:
 	bool attackNotificationsAdded = false;
 	bool keyPickedUp = false;
 
-	std::vector<std::vector<int>> obstacle_map;
+	// layout and spawn tables of the current level
+	LevelData level_data;
+	// the live part of the level around the player
+	WorldChunks chunks;
+	// contacts from the physics step and what they lead to, consumed by handle_collisions
+	EventBus events;
 
 	WorldSystem();
 
@@ -53,24 +61,12 @@ public:
 	// Steps the game ahead by ms milliseconds
 	bool step(float elapsed_ms);
 
-	// Check for collisions
+	// Handles this step's contact events and the events they emit
 	void handle_collisions();
 
 	// Should the game be over ?
 	bool is_over()const;
 
-	Mix_Chunk* collision_sound;
-
-	void play_collision_sound();
-
-	void play_attack_sound();
-
-	void play_ready_attack_sound();
-
-	void play_death_sound();
-
-	void play_awake_sound();
-
 	void printInventory();
 	bool  is_tile_walkable(vec2 position);
 
@@ -78,6 +74,8 @@ public:
 	void updateItemDragging();
 
 	void updateParticles(float elapsed_ms);
+	// ParticleSystem emitter behind the spaceship, -1 while there is none
+	int smoke_emitter = -1;
 	bool is_sprinting = false;
 	float sprint_multiplyer = 2.f;
 
@@ -124,6 +122,9 @@ public:
 	//bool get_key_handling() const { return key_handling; }
 	//int get_current_level() const { return current_level; }
 
+	// Rebuilds the tileset, tile entities and collision map of a level
+	void build_level_geometry(int level);
+
 	void WorldSystem::triggerCutscene(const std::vector<TEXTURE_ASSET_ID>& images);
 	void WorldSystem::end_game();
 
@@ -142,6 +143,9 @@ private:
 	void WorldSystem::load_tutorial_level(int map_width, int map_height);
 	void load_remote_location(int width, int height);
 	void load_first_level(int width, int height);
+	bool load_level_file(int level);
+	void spawn_level_entities();
+	void setup_spawned_robot(Entity robot_entity, bool capturable);
 	void updateDoorAnimations(float elapsed_ms);
 	bool hasNonCompanionRobots();
 	void WorldSystem::restart_level();
@@ -151,6 +155,11 @@ private:
 	bool WorldSystem::playerPickedUpArmor();
 	bool WorldSystem::playerUsedArmor();
 	bool WorldSystem::playerNearPotion();
+	// event handlers of handle_collisions, contacts come in once per direction
+	void handle_contact(Entity entity, uint32_t entity_layer, Entity other, uint32_t other_layer);
+	void handle_projectile_hit(const ProjectileHitEvent& hit);
+	void handle_damage(const DamageEvent& damage);
+	void kill_player_if_dead(Entity player_entity);
 	// OpenGL window handle
 	GLFWwindow* window;
 	int current_level = 1;
@@ -161,7 +170,7 @@ private:
 	bool key_collected = false;
 	Entity pickup_entity;
 
-	std::string pickup_item_name;
+	ItemId pickup_item = ItemId::NONE;
 	Entity armor_entity_to_pickup;
 	bool pickupHintForE;
 	bool hintForUsingItemsShown;
@@ -178,26 +187,16 @@ private:
 	Entity player;
 	size_t total_robots_spawned = 0;
 	size_t total_boss_robots_spawned = 0;
+	// level number held in level_data, -1 before the first load
+	int level_data_index = -1;
+	// tiles and tileset of that level, its LevelData has been moved into level_data
+	PreparedLevel level_geometry;
+	LevelPreloader preloader;
 	bool key_spawned = false;
 	Entity spaceship;
 	AISystem ai_system;
 
 
-	// music references
-	Mix_Music* background_music;
-	Mix_Chunk* player_dead_sound;
-	Mix_Chunk* key_sound;
-	Mix_Chunk* attack_sound;
-	Mix_Chunk* armor_break;
-	Mix_Chunk* door_open;
-	Mix_Chunk* robot_attack;
-	Mix_Chunk* robot_ready_attack;
-	Mix_Chunk* robot_death;
-	Mix_Chunk* robot_awake;
-	Mix_Chunk* Upgrade;
-	Mix_Chunk* teleport_sound;
-	Mix_Chunk* using_item;
-	Mix_Chunk* insert_card;
 	// C++ random number generator
 	std::default_random_engine rng;
 	std::uniform_real_distribution<float> uniform_dist; // number between 0..1
@@ -0,0 +1,575 @@
+// Converts the level layouts that used to be compiled into the game into the
+// binary level files under data/levels (see src/level_data.hpp).
+// Usage: export_levels [output dir], defaults to data/levels in the source tree.
+// Edit the tables here and re-run it to change a level.
+#include "../src/level_data.hpp"
+#include "../ext/project_path.hpp"
+
+// stlib
+#include <cstdio>
+#include <string>
+#include <vector>
+
+static std::vector<std::vector<int>> initializeRemoteLocationMap() {
+    std::vector<std::vector<int>> grass_map = {
+    {100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100},
+    {100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100},
+    {100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100},
+    {100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100},
+    {100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100},
+    {100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100,  91},
+    {100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100,  91},
+    {100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100,  91},
+    {100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100,  91},
+    {100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100,  91},
+    {100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100,  91},
+    {100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100,  91},
+    {100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100,  91},
+    {100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100},
+    {100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100},
+    {100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100},
+    {100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100},
+    {100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100}
+    };
+    return grass_map;
+}
+
+
+// Function to initialize the obstacle map
+static std::vector<std::vector<int>> initializeObstacleMap() {
+    std::vector<std::vector<int>> obstacle_map = {
+    {69, 69, 69, 69, 69, 69, 69, 69, 69, 69, 69, 69, 69, 69, 69, 69, 69, 69, 69, 69, 11},
+    {61, 61, 61, 61, 61, 61, 61, 61, 61, 61, 61, 61, 61, 61, 61, 61, 61, 61, 61, 61, 11},
+    {69, 69, 69, 69, 69, 69, 69, 69, 69, 69, 69, 69, 69, 69, 69, 69, 69, 69, 69, 69, 11},
+    {61, 61, 61, 61, 61, 61, 61, 61, 61, 61, 61, 61, 61, 61, 61, 61, 61, 61, 61, 61, 11},
+    {69, 69, 69, 69, 69, 69, 69, 69, 69, 69, 69, 69, 69, 69, 69, 69, 69, 69, 69, 69, 18},
+    { 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0},
+    { 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0},
+    { 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0},
+    { 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0},
+    { 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0},
+    { 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0},
+    { 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0},
+    { 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0},
+    {61, 61, 61, 61, 61, 61, 61, 61, 61, 61, 61, 61, 61, 61, 61, 61, 61, 61, 61, 61,  4},
+    {69, 69, 69, 69, 69, 69, 69, 69, 69, 69, 69, 69, 69, 69, 69, 69, 69, 69, 69, 69, 11},
+    {61, 61, 61, 61, 61, 61, 61, 61, 61, 61, 61, 61, 61, 61, 61, 61, 61, 61, 61, 61, 11},
+    {69, 69, 69, 69, 69, 69, 69, 69, 69, 69, 69, 69, 69, 69, 69, 69, 69, 69, 69, 69, 11},
+    {61, 61, 61, 61, 61, 61, 61, 61, 61, 61, 61, 61, 61, 61, 61, 61, 61, 61, 61, 61, 11},
+    };
+    return obstacle_map;
+}
+
+static std::vector<std::vector<int>> initializeTutorialLevelMap() {
+    std::vector<std::vector<int>> grass_map = {
+    { 53,  53,  53,  53,  53,  53,  53,  53,  53,  53,  53,  53,  53,  53,  53,  53,  53,  53,  53,  53},
+    { 53,  53,  53,  53,  53, 303, 303, 303, 303, 303, 303, 303, 303, 303, 303, 303, 303, 303, 304, 305},
+    { 53,  53,  53,  53,  53, 310, 310, 310, 310, 310, 310, 310, 310, 310, 310, 310, 310, 310, 311, 312},
+    { 53,  53,  53,  53,  53, 315, 315, 315, 315, 315, 315, 315, 315, 315, 315, 315, 315, 315, 315, 315},
+    { 53, 303, 303, 303, 303, 315, 315, 315, 315, 315, 315, 315, 315, 315, 315, 315, 315, 315, 315, 315},
+    { 53, 310, 310, 310, 310, 315, 315, 315, 315, 315, 315, 315, 315, 315, 315, 315, 315, 315, 315, 315},
+    { 53, 315, 315, 315, 315, 315, 315, 315, 315, 315, 315, 315, 315, 315, 315, 315, 315, 315, 315, 315},
+    { 53, 315, 315, 315, 315, 315, 315, 315, 315, 315, 315, 315, 315, 315, 315, 315, 315, 315,  53,  53},
+    { 53, 315, 315, 315, 315, 315, 315, 315, 315, 315, 315, 315, 315, 315, 315, 315, 315, 315,  53,  53},
+    { 53, 315, 315, 315, 315, 315, 315, 315, 315, 315, 315, 315, 315, 315, 315, 315, 315, 315,  53,  53},
+    { 53, 315, 315, 315, 315, 315, 315, 315, 315, 315, 315, 315, 315, 315, 315, 315, 315, 315,  53,  53},
+    { 53,  53,  53,  53,  53,  53,  53,  53,  53,  53,  53,  53,  53,  53,  53,  53,  53,  53,  53,  53},
+    };
+    return grass_map;
+}
+
+// Function to initialize the obstacle map
+static std::vector<std::vector<int>> initializeTutorialLevelObstacleMap() {
+    std::vector<std::vector<int>> obstacle_map = {
+    {  0,   0,   0,   0, 330, 331, 331, 331, 331, 331, 331, 331, 331, 331, 331, 331, 331, 331, 331, 331},
+    {  0,   0,   0,   0, 343, 303, 303, 303, 303, 303, 303, 303, 303, 303, 264, 265, 303, 303, 304, 305},
+    {  0,   0,   0,   0, 343, 310, 310, 355, 356, 310, 334, 335, 310, 361, 362, 363, 272, 277, 278, 312},
+    {330, 331, 331, 331, 337, 306, 307,   0,   0,   0, 341, 342, 348, 349, 299, 300, 279,   0,   0,   0},
+    {343, 320, 321, 257, 302, 313, 314,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0},
+    {343, 327, 328, 300, 309,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0},
+    {343,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0},
+    {343,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0, 353, 359},
+    {343,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0, 347,   0},
+    {343,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0, 347,   0},
+    {343,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0, 347,   0},
+    {350, 359, 359, 359, 359, 359, 359, 359, 359, 359, 359, 359, 359, 359, 359, 359, 359, 359, 360,   0},
+    };
+    return obstacle_map;
+}
+
+
+
+static std::vector<std::vector<int>> initializeFirstLevelMap() {
+    std::vector<std::vector<int>> grass_map = {
+    {19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19},
+    {19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19,  8,  9},
+    {19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19,  8,  9},
+    {19, 19, 19, 19, 19, 19,  0, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19,  3, 19, 19, 19, 19, 19, 19, 19, 19, 19,  8,  9},
+    {19, 19, 19, 19, 19, 19,  7, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 10, 19, 19, 19, 19, 19, 19, 19, 19, 19,  8,  9},
+    {19, 19, 19, 19, 19, 19,  7, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 10, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19},
+    { 8,  9, 19, 19, 19, 19, 14, 15, 15, 15, 15, 16, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 17, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19},
+    { 8,  9, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19},
+    { 8,  9, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19},
+    {19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19},
+    {19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19},
+    {19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19},
+    {19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19},
+    {19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19},
+    {19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19},
+    {19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19},
+    {19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19},
+    {19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19},
+    {19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19},
+    {19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19},
+    {19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19},
+    {19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19},
+    {19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19},
+    {19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19},
+    {19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19},
+    {19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19},
+    {19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19},
+    };
+    return grass_map;
+}
+
+
+// Function to initialize the obstacle map
+static std::vector<std::vector<int>> initializeFirstLevelObstacleMap() {
+    std::vector<std::vector<int>> obstacle_map = {
+    {12, 12, 13, 21, 21, 21, 21, 21, 21, 21, 21, 21, 21, 21, 21, 21, 21, 21, 21, 21, 21, 21, 21, 21, 21, 21, 21, 21, 21, 21, 21, 11, 12, 12, 13, 21, 21, 21, 21, 21},
+    {12, 12, 13,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0, 11, 12, 12, 13,  0,  0,  0,  0,  0},
+    {12, 12, 13,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0, 11, 12, 12, 13,  0,  0,  0,  0,  0},
+    {12, 12, 13,  0,  0,  0,  0,  4,  5,  5,  5,  5,  5,  5,  5,  5,  5,  5,  5,  5,  5,  5,  5,  5,  5,  5,  5,  6,  0,  0,  0, 11, 12, 12, 13,  0,  0,  0,  0,  0},
+    {12, 12, 13,  0,  0,  0,  0, 11, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 13,  0,  0,  0, 11, 12, 12, 13,  0,  0,  0,  0,  0},
+    {22, 21, 21,  0,  0,  0,  0, 21, 28, 21, 21, 23, 21, 21, 21, 21, 21, 21, 21, 21, 21, 21, 21, 21, 21, 21, 21, 21,  0,  0,  0, 11, 12, 12, 13,  0,  0,  0,  4,  5},
+    { 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0, 11, 12, 12, 13,  0,  0,  0, 11, 12},
+    { 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0, 21, 21, 11, 13,  0,  0,  0, 11, 12},
+    { 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0, 11, 13,  0,  0,  0, 11, 12},
+    { 5,  5,  6,  0,  0,  0,  0,  4,  5,  5,  5,  5,  5,  6,  0,  0,  0,  4,  5,  5,  6,  0,  0,  0,  0,  4,  6,  0,  0,  0,  0,  0,  0, 11, 13,  0,  0,  0, 11, 12},
+    {12, 12, 13,  0,  0,  0,  0, 11, 12, 12, 12, 12, 12, 13,  0,  0,  0, 11, 12, 12, 13,  0,  0,  0,  4, 12, 12,  6,  0,  0,  0,  0,  0, 11, 13,  0,  0,  0, 11, 12},
+    {12, 12, 13,  0,  0,  0,  0, 11, 12, 13, 22, 22, 22, 22,  0,  0,  0, 11, 12, 12, 13,  0,  0,  0, 28, 11, 13, 28,  0,  0,  0,  0,  0, 11, 13,  0,  0,  0, 11, 12},
+    {12, 12, 13,  0,  0,  0,  0, 11, 12, 13,  0,  0,  0,  0,  0,  0,  0, 11, 12, 12, 13,  0,  0,  0,  0, 11, 13,  0,  0,  0,  0,  4,  5, 12, 13,  0,  0,  0, 11, 12},
+    {12, 12, 13,  0,  0,  0,  0, 11, 12, 13,  0,  0,  0,  0,  0,  0,  0, 11, 12, 12, 13,  0,  0,  0,  0, 11, 13,  0,  0,  0,  0, 11, 12, 12, 13,  0,  0,  0, 11, 12},
+    {12, 12, 13,  0,  0,  0,  0, 22, 22, 22,  0,  0,  0,  0,  0,  0,  0, 11, 12, 12, 13,  0,  0,  0,  0, 28, 28,  0,  0,  0,  0, 21, 21, 21, 21,  0,  0,  0, 11, 12},
+    {12, 12, 13,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0, 11, 12, 12, 13,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0, 11, 12},
+    {12, 12, 13,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0, 11, 12, 12, 13,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0, 11, 12},
+    {12, 12, 13,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0, 11, 12, 12, 13,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0, 11, 12},
+    {12, 12, 13,  0,  0,  0,  0,  4,  5,  5,  5,  5,  5,  5,  5,  5,  5, 12, 12, 12, 13,  0,  0,  0,  0,  4,  5,  5,  5,  5,  5,  5,  5,  5,  6,  0,  0,  0, 11, 12},
+    {12, 12, 13,  0,  0,  0,  0, 11, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 13,  0,  0,  0,  0, 11, 12, 12, 12, 12, 12, 12, 12, 12, 13,  0,  0,  0, 11, 12},
+    {12, 12, 13,  0,  0,  0,  0, 11, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 13,  0,  0,  0,  0, 11, 12, 12, 12, 12, 12, 12, 12, 12, 13,  0,  0,  0, 11, 12},
+    {12, 12, 13,  0,  0,  0,  0, 22, 22, 22, 22, 22, 22, 22, 22, 22, 22, 22, 22, 11, 13,  0,  0,  0,  0, 11, 12, 13, 22, 22, 22, 22, 22, 22, 22,  0,  0,  0, 11, 12},
+    {12, 12, 13,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0, 11, 13,  0,  0,  0,  0, 11, 12, 13,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0, 11, 12},
+    {12, 12, 13,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0, 11, 13,  0,  0,  0,  0, 11, 12, 13,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0, 11, 12},
+    {12, 12, 12,  5,  5,  5,  5,  5,  5,  5,  5,  5,  5,  5,  5,  5,  5,  5,  5, 12, 12,  5,  5,  5,  5, 12, 12, 12,  5,  5,  5,  5,  5,  5,  5,  5,  5,  5, 12, 12},
+    {12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12},
+    {12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12},
+    };
+    return obstacle_map;
+}
+
+
+
+static std::vector<std::vector<int>> initializeSecondLevelMap() {
+    std::vector<std::vector<int>> grass_map = {
+    {40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 36, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40},
+    {39, 39, 39, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 36, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40},
+    {42, 42, 42, 42, 42, 42, 42, 42, 42, 42, 42, 42, 42, 43, 42, 42, 42, 42, 42, 42, 42, 42, 42, 42, 42, 42, 42, 42, 42, 42, 42, 42, 42, 42, 42, 42, 38, 40, 40, 40},
+    {42, 42, 42, 42, 38, 40, 40, 40, 40, 40, 40, 40, 40, 36, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 36, 40, 40, 40},
+    {39, 39, 39, 40, 36, 40, 40, 40, 40, 40, 40, 40, 40, 36, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 36, 40, 40, 40},
+    {40, 40, 40, 40, 36, 40, 40, 40, 40, 40, 40, 40, 40, 36, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 36, 40, 40, 40},
+    {40, 40, 40, 40, 36, 40, 40, 40, 40, 40, 40, 40, 40, 36, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 36, 40, 40, 40},
+    {40, 40, 40, 40, 36, 40, 40, 40, 40, 40, 40, 40, 40, 36, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 36, 40, 40, 40},
+    {40, 40, 40, 40, 36, 40, 40, 40, 40, 40, 40, 40, 40, 44, 42, 42, 42, 42, 42, 42, 42, 42, 42, 42, 42, 42, 42, 42, 38, 40, 40, 40, 40, 40, 40, 40, 36, 40, 40, 40},
+    {40, 40, 40, 40, 36, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 36, 40, 40, 40, 40, 40, 40, 40, 36, 40, 40, 40},
+    {40, 40, 40, 40, 36, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 36, 40, 40, 40, 40, 40, 40, 40, 36, 40, 40, 40},
+    {40, 40, 40, 40, 36, 40, 37, 42, 42, 42, 42, 42, 42, 42, 42, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 36, 40, 40, 40, 40, 40, 40, 40, 36, 40, 40, 40},
+    {40, 40, 40, 40, 36, 40, 36, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 36, 40, 40, 40, 40, 40, 40, 40, 36, 40, 40, 40},
+    {40, 40, 40, 40, 36, 40, 36, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 36, 40, 40, 40, 40, 40, 40, 40, 36, 40, 40, 40},
+    {40, 40, 40, 40, 36, 40, 36, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 36, 40, 40, 40, 40, 40, 40, 40, 36, 40, 40, 40},
+    {40, 40, 40, 40, 36, 40, 36, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 36, 40, 40, 40, 40, 40, 40, 40, 36, 40, 40, 40},
+    {40, 40, 40, 40, 36, 40, 36, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 36, 40, 40, 40, 40, 40, 40, 40, 36, 40, 40, 40},
+    {40, 40, 40, 40, 44, 42, 43, 42, 42, 42, 42, 42, 42, 42, 42, 42, 42, 42, 42, 42, 42, 42, 42, 42, 42, 42, 42, 42, 43, 42, 42, 42, 42, 42, 42, 42, 45, 40, 40, 40},
+    {40, 40, 40, 40, 40, 40, 36, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 36, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40},
+    {40, 40, 40, 40, 40, 40, 36, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 36, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40},
+    {40, 40, 40, 40, 40, 40, 36, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 36, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40},
+    {40, 40, 40, 40, 40, 40, 36, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 36, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40},
+    {40, 40, 40, 40, 40, 40, 36, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 36, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40},
+    {40, 40, 40, 40, 40, 40, 44, 42, 42, 42, 42, 42, 42, 42, 42, 42, 42, 42, 42, 42, 42, 42, 42, 38, 37, 42, 42, 42, 45, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40},
+    {40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 36, 36, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40},
+    {40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 36, 36, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40},
+    {40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 36, 36, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40},
+    {40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 36, 36, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40},
+    };
+    return grass_map;
+}
+
+
+// Function to initialize the obstacle map
+static std::vector<std::vector<int>> initializeSecondLevelObstacleMap() {
+    std::vector<std::vector<int>> obstacle_map = {
+    {29, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 27, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 31, 49, 50},
+    { 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0, 52, 53},
+    { 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0, 52, 53},
+    { 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0, 52, 53},
+    { 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0, 50, 50, 50, 50, 50, 50, 50, 50, 50, 51,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0, 52, 53},
+    {50, 50, 51,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0, 49, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 51,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0, 52, 53},
+    {53, 53, 54,  0,  0,  0,  0,  0,  0,  0, 49, 51,  0,  0,  0, 41, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 55,  0,  0,  0, 49, 51,  0,  0,  0,  0,  0,  0, 52, 53},
+    {53, 53, 54,  0,  0,  0,  0,  0,  0, 49, 53, 54,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0, 52, 53, 51,  0,  0,  0,  0,  0, 52, 53},
+    {53, 53, 54,  0,  0,  0,  0,  0, 49, 53, 53, 54,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0, 52, 53, 53, 51,  0,  0,  0,  0, 52, 53},
+    {53, 53, 54,  0,  0,  0,  0,  0, 41, 48, 48, 55,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0, 41, 48, 48, 55,  0,  0,  0,  0, 52, 53},
+    {53, 53, 54,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0, 49, 50, 24, 50, 50, 50, 50, 50, 50, 24, 50, 51,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0, 52, 53},
+    {53, 53, 54,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0, 25, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 54,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0, 52, 53},
+    {53, 53, 54,  0,  0,  0,  0,  0, 49, 50, 50, 51,  0,  0,  0, 52, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 54,  0,  0,  0, 49, 50, 50, 51,  0,  0,  0,  0, 52, 53},
+    {53, 53, 54,  0,  0,  0,  0,  0, 52, 53, 53, 54,  0,  0,  0, 25, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 26,  0,  0,  0, 52, 53, 53, 54,  0,  0,  0,  0, 52, 53},
+    {53, 53, 54,  0,  0,  0,  0,  0, 52, 53, 53, 54,  0,  0,  0, 52, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 54,  0,  0,  0, 52, 53, 53, 54,  0,  0,  0,  0, 52, 53},
+    {53, 53, 54,  0,  0,  0,  0,  0, 41, 48, 48, 55,  0,  0,  0, 52, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 54,  0,  0,  0, 41, 48, 48, 55,  0,  0,  0,  0, 52, 53},
+    {53, 53, 54,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0, 41, 48, 48, 48, 48, 48, 48, 48, 32, 48, 27, 55,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0, 52, 53},
+    {53, 53, 54,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0, 52, 53},
+    {53, 53, 54,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0, 52, 53},
+    {53, 53, 54,  0,  0,  0,  0,  0, 49, 50, 50, 51,  0,  0,  0, 49, 50, 50, 50, 50, 50, 50, 50, 50, 50, 50, 51,  0,  0,  0, 49, 50, 50, 51,  0,  0,  0,  0, 52, 53},
+    {53, 53, 54,  0,  0,  0,  0,  0, 41, 53, 53, 54,  0,  0,  0, 41, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 55,  0,  0,  0, 52, 53, 53, 55,  0,  0,  0,  0, 52, 53},
+    {53, 53, 54,  0,  0,  0,  0,  0,  0, 41, 53, 54,  0,  0,  0,  0, 41, 48, 48, 48, 48, 48, 48, 48, 48, 55,  0,  0,  0,  0, 52, 53, 55,  0,  0,  0,  0,  0, 52, 53},
+    {53, 53, 54,  0,  0,  0,  0,  0,  0,  0, 41, 55,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0, 41, 55,  0,  0,  0,  0,  0,  0, 52, 53},
+    {53, 53, 54,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0, 52, 53},
+    {53, 53, 54,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0, 52, 53},
+    {53, 53, 53, 50, 50, 50, 50, 50, 50, 50, 50, 50, 50, 50, 50, 50, 50, 50, 50, 50, 50, 51,  0,  0,  0,  0, 49, 50, 50, 50, 50, 50, 50, 50, 50, 50, 50, 50, 53, 53},
+    {53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 54,  0,  0,  0,  0, 52, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53},
+    {53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 54,  0,  0,  0,  0, 52, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53, 53},
+    };
+    return obstacle_map;
+}
+
+
+
+
+
+static std::vector<std::vector<int>> initializeThirdLevelMap() {
+    std::vector<std::vector<int>> grass_map = {
+    {40, 40, 40, 40, 40, 40, 40, 40, 39, 39, 39, 40, 40, 40, 40, 40, 40, 40, 40, 40},
+    {40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40},
+    {40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40},
+    {40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40},
+    {40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40},
+    {40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40},
+    {40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40},
+    {40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40},
+    {40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40},
+    {40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40},
+    {40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40},
+    {40, 40, 40, 40, 40, 40, 40, 40, 36, 36, 36, 40, 40, 40, 40, 40, 40, 40, 40, 40},
+    };
+    return grass_map;
+}
+
+
+
+// Function to initialize the obstacle map
+static std::vector<std::vector<int>> initializeThirdLevelObstacleMap() {
+    std::vector<std::vector<int>> obstacle_map = {
+    {54, 29, 30, 30, 30, 30, 30, 30, 0,  0,  0, 30, 30, 30, 30, 30, 30, 30, 31, 52},
+    {54,  0,  0,  0,  0, 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0, 52},
+    {54,  0,  0,  0,  0, 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0, 52},
+    {54,  0,  0,  0,  0, 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0, 52},
+    {54,  0,  0,  0,  0, 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0, 52},
+    {54,  0,  0,  0,  0, 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0, 52},
+    {54,  0,  0,  0,  0, 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0, 52},
+    {54,  0,  0,  0,  0, 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0, 52},
+    {54,  0,  0,  0,  0, 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0, 52},
+    {54,  0,  0,  0,  0, 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0, 52},
+    {54,  0,  0,  0,  0, 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0, 52},
+    {54, 29, 30, 30, 30, 30, 30, 30, 0,  0, 0, 30, 30, 30, 30, 30, 30, 30, 31, 52},
+    };
+    return obstacle_map;
+}
+
+
+
+
+
+// for boss level
+static std::vector<std::vector<int>> initializeFinalLevelMap() {
+    std::vector<std::vector<int>> grass_map = {
+    { 53, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100,  40,  36,  36,  40, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100,  53},
+    { 53, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100,  53},
+    { 53, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100,  53},
+    { 53, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100,  53},
+    { 53, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100,  53},
+    { 53, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100,  53},
+    { 53, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100,  53},
+    { 53, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100,  53},
+    { 53, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100,  53},
+    { 53, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100,  53},
+    { 53, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100,  53},
+    { 53, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100,  53},
+    { 53, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100,  53},
+    { 53, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100,  53},
+    { 53, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100,  53},
+    { 53, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100,  53},
+    { 53, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100,  53},
+    { 53, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100,  53},
+    { 53, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100,  53},
+    { 53, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100,  53},
+    { 53, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100,  53},
+    { 53, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100,  53},
+    { 53, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100,  53},
+    { 53, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100,  53},
+    { 53, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100,  53},
+    { 53, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100,  53},
+    { 53, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100,  53},
+    { 53, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100,  53},
+    { 53, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100,  53},
+    { 53, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100,  53},
+    { 53, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100,  53},
+    { 53, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100,  53},
+    { 53, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100,  53},
+    { 53, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100,  53},
+    { 53, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100,  53},
+    { 53, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100,  53},
+    { 53, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100,  53},
+    { 53, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100,  53},
+    { 53, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100,  53},
+    { 53, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100,  53}
+    };
+    return grass_map;
+}
+
+
+
+
+// for boss level
+static std::vector<std::vector<int>> initializeFinalLevelObstacleMap() {
+    std::vector<std::vector<int>> obstacle_map = {
+    {118,  30,  30,  30,  30,  30,  30,  30,  30,  30,  30,  30,  30,  30,  30,  30,  30,  30,  30,  30,  30,  30,  30,  30,  30,  30,  30,  30,  30,  30,  30,  30,  30,  31,   0,   0,   0,   0,  29,  30,  30,  30,  30,  30,  30,  30,  30,  30,  30,  30,  31,  30,  30,  30,  30,  30,  30,  30,  30,  30,  30,  30,  30, 120},
+    {111,   0,  61,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0, 110, 189, 190, 191,   0,   0,   0, 189, 190, 191,   0,   0,   0, 110},
+    {118,   0,  69,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0, 117, 196, 197, 198 ,199,   0,   0, 196, 197, 198 ,199,   0,   0, 117},
+    {125,   0,   0,   0,   0,   0,  61,  61,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0, 124, 203, 204, 205, 206, 214, 215, 203, 204, 205, 206,   0,   0, 124},
+    {111,   0,   0,   0,   0,   0,  69,  69,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0, 216,   0,   0,   0,   0,   0, 216,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0, 110, 210, 211, 212, 213, 221, 222, 210, 211, 212, 213,   0,   0, 110},
+    {118,   0,   0,   0,   0,   0, 193, 194,   0,   0,   0,  61,   0,   0,   0,   0,   0,   0, 223,   0,   0,   0,   0,   0, 223,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0, 188,   0,   0,   0,   0,   0,   0,   0,   0,  61,   0,   0,   0,   0,   0, 117,   0, 218, 219,   0, 228, 229,   0, 218, 219,   0,   0,   0, 117},
+    {125,   0,   0,   0,   0,   0, 200, 201,   0,   0,   0,  69,   0,   0,   0, 216,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0, 216,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,  69,   0,   0,   0,   0,   0, 124,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0, 124},
+    {118,   0,   0,  61,   0,   0, 207, 208,   0,   0,   0,   0,   0,   0,   0, 223,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0, 223,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0, 117,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0, 117},
+    {125,   0,   0,  69,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0, 167,   0,   0,   0, 165,   0,   0,   0, 181,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0, 124,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0, 124},
+    {111,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0, 174,   0,   0, 171, 172, 173,   0,   0, 188,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0, 110,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0, 110},
+    {118,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0, 216,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0, 216,   0,   0,   0,   0,   0,   0, 179,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0, 175, 176, 119, 120, 109, 120, 119, 120, 146,   0,   0,   0,   0, 117},
+    {125,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0, 223,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0, 223,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0, 182, 183, 126, 127, 116, 127, 126, 127, 153,   0,   0,   0,   0, 124},
+    {111,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0, 110},
+    {125, 119, 120, 119, 120, 119, 120, 119, 120, 119, 120, 117,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0, 188,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0, 124},
+    {111,   0,   0,   0,   0,   0,   0,   0,   0, 185,   0, 110,   0,   0,   0, 216,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0, 216,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0, 110},
+    {118,   0,   0,   0,   0,   0,   0,   0,   0, 192,   0, 124,   0,   0,   0, 223,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0, 223,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0, 190, 191,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0, 117},
+    {125,   0,   0,   0, 190, 191,   0,   0,   0,   0,   0, 117,   0,   0,   0,   0,   0,   0, 216,   0,   0,   0,   0,   0, 216,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0, 196, 197, 198 ,199,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0, 124},
+    {111,   0,   0, 196, 197, 198 ,199,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0, 223,   0,   0,   0,   0,   0, 223,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0, 203, 204, 205, 206,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0, 110},
+    {118,   0,   0, 203, 204, 205, 206,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0, 231, 232, 233, 234, 235,   0,   0,   0,   0,   0, 210, 211, 212, 213,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0, 117},
+    {125,   0,   0, 210, 211, 212, 213,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0, 238, 239, 240, 241, 242,   0,   0,   0,   0,   0,   0, 218, 219,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0, 124},
+    {111,   0,   0,   0, 218, 219,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0, 245, 246, 247, 248, 249,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0, 110},
+    {118,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0, 252, 253, 254, 255, 256,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0, 117},
+    {118,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0, 119, 120, 119, 120, 119, 120, 119, 118, 119, 120, 119, 120, 119, 120, 119, 120, 119, 120, 119, 120, 119, 120, 119, 120, 119, 120, 119, 120, 119, 120, 119, 120, 119, 120, 119, 120, 119, 120, 119, 124,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0, 117},
+    {125,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0, 125,   0, 185,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0, 185,   0, 110,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0, 124},
+    {111,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0, 111,   0, 192,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0, 192,   0, 117,   0,   0,   0,  61,   0,   0,   0,   0,   0,   0,   0,   0, 110},
+    {125,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0, 125,   0,   0, 195, 195, 195, 195,   0,   0,   0,   0, 195, 195,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0, 110,   0,   0,   0,  69,   0,   0,   0,   0,   0,   0,   0,   0, 124},
+    {111,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0, 111,   0,   0, 202, 202, 202, 202, 195,   0,   0,   0, 202, 202,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0, 195, 195,   0,   0,   0,   0,   0,   0, 119,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0, 110},
+    {118,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0, 118,   0,   0, 202, 202, 202, 202, 202,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0, 202, 202,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0, 117},
+    {125,  61,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,  61,   0,   0,   0, 125,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0, 195, 195,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0, 124},
+    {111,  69,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,  69,   0,   0,   0, 111,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0, 195, 202, 202, 195,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0, 110},
+    {118,   0,   0,   0,   0,   0,   0, 274, 275,   0,   0,   0,   0,   0,   0,   0,   0,   0, 118,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0, 202, 202, 202, 202,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0, 117},
+    {118,   0,   0,   0,   0,   0, 280, 281, 282, 283,   0,   0,   0,   0,   0,   0,   0,   0, 118,   0,   0,   0,   0, 202, 202, 202, 195, 195,   0,   0,   0, 216,   0,   0,   0,   0,   0,   0,   0,   0, 216,   0,   0,   0,   0,   0,   0,   0,   0,   0, 119,   0,   0,   0, 190, 191,   0,   0,   0,   0,   0,   0,   0, 117},
+    {125,   0,   0,   0,   0,   0, 287, 288, 289, 290,   0,   0,   0,   0,   0,   0,   0,   0, 125,   0,   0,   0,   0, 202, 202, 202, 202, 202,   0,   0,   0, 223,   0,   0,   0,   0,   0,   0,   0,   0, 223,   0,   0,   0,   0,   0,   0,   0,   0,   0, 110,   0,   0, 196, 197, 198 ,199,   0,   0,   0,   0,   0,   0, 124},
+    {111,   0,   0,   0,   0,   0,   0, 295, 296,   0,   0,   0,   0,   0,   0,   0,   0,   0, 111,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0, 117,   0,   0, 203, 204, 205, 206,   0,   0,   0,   0,   0,   0, 110},
+    {118,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0, 118,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0, 124,   0,   0, 210, 211, 212, 213,   0,   0,   0,   0,   0,   0, 117},
+    {125,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0, 125,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0, 110,   0,   0,   0, 218, 219,   0,   0,   0,   0,   0,   0,   0, 124},
+    {118,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0, 118,   0, 185,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0, 185,   0, 124,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0, 117},
+    {125,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0, 125,   0, 192,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0, 192,   0, 110,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0, 124},
+    {111, 120, 119, 120, 119, 120, 119, 120, 119, 120, 119, 120, 119, 120, 119, 120, 119, 120, 119, 120, 119, 120, 119, 120, 119, 120, 119, 120, 119, 120, 119, 120, 119, 120, 119, 120, 119, 120, 119, 120, 119, 120, 119, 120, 119, 120, 119, 120, 119, 120, 119, 120, 119, 120, 119, 120, 119, 120, 119, 120, 119, 120, 119, 110},
+    {118, 127, 126, 127, 126, 127, 126, 127, 126, 127, 126, 127, 126, 127, 126, 127, 126, 127, 126, 127, 126, 127, 126, 127, 126, 127, 126, 127, 126, 127, 126, 127, 126, 127, 126, 127, 126, 127, 126, 127, 126, 127, 126, 127, 126, 127, 126, 127, 126, 127, 126, 127, 126, 127, 126, 127, 126, 127, 126, 127, 126, 127, 126, 117},
+    };
+    return obstacle_map;
+}
+
+static bool to_grid(const std::vector<std::vector<int>>& rows, LevelGrid& grid) {
+    int height = (int)rows.size();
+    int width = height > 0 ? (int)rows[0].size() : 0;
+    grid.resize(width, height);
+    for (int y = 0; y < height; y++) {
+        if ((int)rows[y].size() != width) {
+            printf("row %d has %d tiles, expected %d\n", y, (int)rows[y].size(), width);
+            return false;
+        }
+        for (int x = 0; x < width; x++)
+            grid.at(x, y) = (uint16_t)rows[y][x];
+    }
+    return true;
+}
+
+// positions are given in tiles, like the spawn code they replace
+static LevelEntry entry(LevelEntityKind kind, float tile_x, float tile_y, uint16_t flags = 0, uint32_t count = 1) {
+    LevelEntry e;
+    e.kind = kind;
+    e.flags = flags;
+    e.count = count;
+    e.x = tile_x * 64.f;
+    e.y = tile_y * 64.f;
+    return e;
+}
+
+static void set_player(LevelData& level, float tile_x, float tile_y) {
+    level.player_x = tile_x * 64.f;
+    level.player_y = tile_y * 64.f;
+}
+
+static void tutorial_level(LevelData& level) {
+    set_player(level, 9, 7);
+    level.doors = { entry(LevelEntityKind::RIGHT_DOOR, 18, 5) };
+    level.items = {
+        entry(LevelEntityKind::ARMOR_PLATE, 14, 5),
+        entry(LevelEntityKind::POTION, 11, 9),
+        entry(LevelEntityKind::KEY, 6, 7)
+    };
+}
+
+static void remote_location(LevelData& level) {
+    set_player(level, 16, 10);
+    level.spawns = {
+        entry(LevelEntityKind::SPACESHIP, 7, 10),
+        entry(LevelEntityKind::SPIDER_ROBOT, 13, 6),
+        entry(LevelEntityKind::SPIDER_ROBOT, 10, 7),
+        entry(LevelEntityKind::SPIDER_ROBOT, 9, 6),
+        entry(LevelEntityKind::SPIDER_ROBOT, 12, 7),
+        entry(LevelEntityKind::SPIDER_ROBOT, 14, 7)
+    };
+}
+
+static void first_level(LevelData& level) {
+    const uint16_t C = LEVEL_ENTRY_CAPTURABLE;
+    set_player(level, 1, 8);
+    level.spawns = {
+        entry(LevelEntityKind::ROBOT, 15, 7, C),
+        entry(LevelEntityKind::ROBOT, 4, 17),
+        entry(LevelEntityKind::ROBOT, 13, 13),
+        entry(LevelEntityKind::ROBOT, 16, 17, C),
+        entry(LevelEntityKind::ROBOT, 19, 2),
+        entry(LevelEntityKind::ROBOT, 25, 2),
+        entry(LevelEntityKind::ROBOT, 11, 23),
+        entry(LevelEntityKind::ROBOT, 23, 19),
+        entry(LevelEntityKind::ROBOT, 24, 23),
+        entry(LevelEntityKind::ROBOT, 28, 16),
+        entry(LevelEntityKind::ROBOT, 37, 8, C),
+        entry(LevelEntityKind::ROBOT, 31, 23),
+        entry(LevelEntityKind::ROBOT, 34, 23),
+        entry(LevelEntityKind::ROBOT, 37, 23)
+    };
+    level.doors = { entry(LevelEntityKind::RIGHT_DOOR, 49, 3) };
+    level.items = {
+        entry(LevelEntityKind::POTION, 22, 7),
+        entry(LevelEntityKind::POTION, 18, 23),
+        entry(LevelEntityKind::ARMOR_PLATE, 31, 11)
+    };
+}
+
+static void second_level(LevelData& level) {
+    const uint16_t C = LEVEL_ENTRY_CAPTURABLE;
+    set_player(level, 1, 2);
+    level.spawns = {
+        entry(LevelEntityKind::ICE_ROBOT, 11, 3),
+        entry(LevelEntityKind::ICE_ROBOT, 4, 16, C),
+        entry(LevelEntityKind::ICE_ROBOT, 14, 12),
+        entry(LevelEntityKind::ICE_ROBOT, 16, 18),
+        entry(LevelEntityKind::ICE_ROBOT, 22, 2),
+        entry(LevelEntityKind::ICE_ROBOT, 28, 2),
+        entry(LevelEntityKind::ICE_ROBOT, 21, 8),
+        entry(LevelEntityKind::ICE_ROBOT, 8, 23),
+        entry(LevelEntityKind::ICE_ROBOT, 16, 24, C),
+        entry(LevelEntityKind::ICE_ROBOT, 24, 18),
+        entry(LevelEntityKind::ICE_ROBOT, 37, 6),
+        entry(LevelEntityKind::ICE_ROBOT, 29, 24),
+        entry(LevelEntityKind::ICE_ROBOT, 34, 23),
+        entry(LevelEntityKind::ICE_ROBOT, 28, 8)
+    };
+    level.doors = { entry(LevelEntityKind::BOTTOM_DOOR, 24, 35) };
+    level.items = {
+        entry(LevelEntityKind::POTION, 36, 3),
+        entry(LevelEntityKind::POTION, 24, 8),
+        entry(LevelEntityKind::ARMOR_PLATE, 20, 18)
+    };
+}
+
+static void third_level(LevelData& level) {
+    set_player(level, 9, 1);
+    level.spawns = { entry(LevelEntityKind::BAT_SWARM, 9, 5, 0, 15) };
+    level.items = {
+        entry(LevelEntityKind::POTION, 6, 8),
+        entry(LevelEntityKind::ARMOR_PLATE, 12, 8)
+    };
+}
+
+static void boss_level(LevelData& level) {
+    set_player(level, 36, 2);
+    level.spawns = {
+        entry(LevelEntityKind::BOSS_ROBOT, 35, 37),
+        entry(LevelEntityKind::ROBOT, 19, 11),
+        entry(LevelEntityKind::ROBOT, 14, 35),
+        entry(LevelEntityKind::ROBOT, 52, 18),
+        entry(LevelEntityKind::ROBOT, 47, 10),
+        entry(LevelEntityKind::ROBOT, 33, 6),
+        entry(LevelEntityKind::ROBOT, 39, 6),
+        entry(LevelEntityKind::ICE_ROBOT, 6, 11),
+        entry(LevelEntityKind::ICE_ROBOT, 10, 7),
+        entry(LevelEntityKind::ICE_ROBOT, 3, 26),
+        entry(LevelEntityKind::ICE_ROBOT, 31, 16),
+        entry(LevelEntityKind::ICE_ROBOT, 61, 11),
+        entry(LevelEntityKind::ICE_ROBOT, 59, 29),
+        entry(LevelEntityKind::SPIDER_ROBOT, 14, 17),
+        entry(LevelEntityKind::SPIDER_ROBOT, 13, 19),
+        entry(LevelEntityKind::SPIDER_ROBOT, 15, 19),
+        entry(LevelEntityKind::SPIDER_ROBOT, 41, 17),
+        entry(LevelEntityKind::SPIDER_ROBOT, 40, 19),
+        entry(LevelEntityKind::SPIDER_ROBOT, 42, 19)
+    };
+    level.items = {
+        entry(LevelEntityKind::POTION, 38, 15),
+        entry(LevelEntityKind::POTION, 43, 35),
+        entry(LevelEntityKind::ARMOR_PLATE, 62, 25),
+        entry(LevelEntityKind::ARMOR_PLATE, 28, 29)
+    };
+}
+
+struct LevelSource {
+    std::vector<std::vector<int>> (*base)();
+    std::vector<std::vector<int>> (*obstacles)();
+    LevelAtlas atlas;
+    void (*entities)(LevelData&);
+};
+
+int main(int argc, char* argv[]) {
+    std::string out_dir = argc > 1 ? argv[1] : std::string(PROJECT_SOURCE_DIR) + "data/levels";
+
+    // indexed by level number
+    const LevelSource levels[] = {
+        { initializeTutorialLevelMap, initializeTutorialLevelObstacleMap, LevelAtlas::OUTDOOR, tutorial_level },
+        { initializeRemoteLocationMap, initializeObstacleMap, LevelAtlas::OUTDOOR, remote_location },
+        { initializeFirstLevelMap, initializeFirstLevelObstacleMap, LevelAtlas::OUTDOOR, first_level },
+        { initializeSecondLevelMap, initializeSecondLevelObstacleMap, LevelAtlas::INDOOR, second_level },
+        { initializeThirdLevelMap, initializeThirdLevelObstacleMap, LevelAtlas::INDOOR, third_level },
+        { initializeFinalLevelMap, initializeFinalLevelObstacleMap, LevelAtlas::INDOOR, boss_level },
+    };
+
+    int failed = 0;
+    for (int i = 0; i < (int)(sizeof(levels) / sizeof(levels[0])); i++) {
+        LevelData level;
+        level.atlas = levels[i].atlas;
+        levels[i].entities(level);
+        bool ok = to_grid(levels[i].base(), level.base) && to_grid(levels[i].obstacles(), level.obstacles);
+        if (ok && (level.base.width != level.obstacles.width || level.base.height != level.obstacles.height)) {
+            printf("level %d: obstacle layer is %dx%d, base layer is %dx%d\n", i,
+                level.obstacles.width, level.obstacles.height, level.base.width, level.base.height);
+            ok = false;
+        }
+        std::string path = out_dir + "/level_" + std::to_string(i) + ".lvl";
+        if (ok && save_level_data(path, level)) {
+            printf("Wrote %s (%dx%d, %d spawns, %d items, %d doors)\n", path.c_str(), level.base.width, level.base.height,
+                (int)level.spawns.size(), (int)level.items.size(), (int)level.doors.size());
+        }
+        else {
+            printf("Failed to export level %d\n", i);
+            failed++;
+        }
+    }
+    return failed == 0 ? 0 : 1;
+}